@@ -0,0 +1,64 @@
+//
+//  GTAheadBehindMatrix.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTBranch;
+@class GTRepository;
+
+// How far a set of branches have diverged from their base branches, computed
+// in one traversal of the history.
+//
+// Every distinct tip gets a bit, and each commit reachable from a tip is
+// marked with the bits of all the tips it's reachable from. Commits are
+// visited in order of decreasing generation (see GTCommitGraph), so each one
+// is visited once no matter how many branches contain it, and the traversal
+// stops as soon as every remaining commit is either on both sides of every
+// comparison or on neither.
+//
+// Use -[GTRepository aheadBehindMatrixForLocalBranchesWithError:] or
+// -[GTRepository aheadBehindMatrixForLocalBranchesRelativeToBranch:error:] to
+// create one.
+@interface GTAheadBehindMatrix : NSObject
+
+// The branches which were compared, in the order they were given.
+@property (nonatomic, readonly, copy) NSArray *branches;
+
+// How long the traversal took.
+@property (nonatomic, readonly) NSTimeInterval wallTime;
+
+// The number of commits the traversal visited.
+@property (nonatomic, readonly) NSUInteger commitsVisited;
+
+// Compare each branch against the base branch at the same index.
+//
+// branches     - The branches to compare. Cannot be nil.
+// baseBranches - The branches to compare them to. Must have the same count as
+//                `branches`. Cannot be nil.
+// repository   - The repository the branches are in. Cannot be nil.
+// error(out)   - will be filled if an error occurs
+//
+// returns the matrix, or nil if an error occurred.
++ (id)matrixWithBranches:(NSArray *)branches baseBranches:(NSArray *)baseBranches inRepository:(GTRepository *)repository error:(NSError **)error;
+
+// The branch the given branch was compared against, or nil if it wasn't in
+// `branches`.
+- (GTBranch *)baseBranchForBranch:(GTBranch *)branch;
+
+// Get how far a branch has diverged from its base branch.
+//
+// ahead(out)  - Set to the number of commits on the branch which aren't on its
+//               base. May be NULL.
+// behind(out) - Set to the number of commits on the base which aren't on the
+//               branch. May be NULL.
+// branch      - One of the `branches`. Cannot be nil.
+//
+// returns NO if the branch wasn't in `branches`, YES otherwise.
+- (BOOL)getAhead:(NSUInteger *)ahead behind:(NSUInteger *)behind forBranch:(GTBranch *)branch;
+
+@end
@@ -0,0 +1,320 @@
+//
+//  GTAheadBehindMatrix.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTAheadBehindMatrix.h"
+#import "GTBranch.h"
+#import "GTRepository.h"
+#import "GTRepository+Private.h"
+#import "GTCommitGraph.h"
+#import "GTCommitGraph+Private.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+// A queued commit, ordered by generation.
+typedef struct {
+	uint32_t generation;
+	GTCommitGraphPosition position;
+} GTAheadBehindQueueEntry;
+
+static void GTAheadBehindQueuePush(GTAheadBehindQueueEntry *queue, NSUInteger *count, GTAheadBehindQueueEntry entry) {
+	NSUInteger i = (*count)++;
+	while (i > 0) {
+		NSUInteger parent = (i - 1) / 2;
+		if (queue[parent].generation >= entry.generation) break;
+
+		queue[i] = queue[parent];
+		i = parent;
+	}
+
+	queue[i] = entry;
+}
+
+static GTAheadBehindQueueEntry GTAheadBehindQueuePop(GTAheadBehindQueueEntry *queue, NSUInteger *count) {
+	GTAheadBehindQueueEntry top = queue[0];
+	GTAheadBehindQueueEntry last = queue[--(*count)];
+
+	NSUInteger i = 0;
+	while (YES) {
+		NSUInteger child = 2 * i + 1;
+		if (child >= *count) break;
+		if (child + 1 < *count && queue[child + 1].generation > queue[child].generation) child++;
+		if (last.generation >= queue[child].generation) break;
+
+		queue[i] = queue[child];
+		i = child;
+	}
+
+	if (*count > 0) queue[i] = last;
+
+	return top;
+}
+
+static inline BOOL GTAheadBehindBitIsSet(const uint64_t *bits, NSUInteger bit) {
+	return (bits[bit / 64] & (1ULL << (bit % 64))) != 0;
+}
+
+// The state of a traversal. Nodes are only allocated for the commits it
+// reaches, so their bits live in one arena rather than one per commit in the
+// graph.
+typedef struct {
+	NSUInteger pairCount;
+	const NSUInteger *branchBits;
+	const NSUInteger *baseBits;
+	NSUInteger wordCount;
+
+	// One more than the node index of each graph position, or 0 if the
+	// position hasn't been reached.
+	uint32_t *nodeIndexes;
+
+	NSUInteger nodeCount;
+	NSUInteger nodeCapacity;
+	uint64_t *bits;
+	BOOL *unbalanced;
+
+	GTAheadBehindQueueEntry *queue;
+	NSUInteger queueCount;
+
+	// The number of queued nodes which are on only one side of a comparison.
+	NSUInteger unbalancedCount;
+} GTAheadBehindTraversal;
+
+// Returns the node index for a position, creating and queueing the node if it
+// hasn't been reached yet.
+static NSUInteger GTAheadBehindTraversalNode(GTAheadBehindTraversal *traversal, GTCommitGraphPosition position, uint32_t generation) {
+	if (traversal->nodeIndexes[position] != 0) return traversal->nodeIndexes[position] - 1;
+
+	if (traversal->nodeCount == traversal->nodeCapacity) {
+		traversal->nodeCapacity *= 2;
+		traversal->bits = realloc(traversal->bits, traversal->nodeCapacity * traversal->wordCount * sizeof(*traversal->bits));
+		traversal->unbalanced = realloc(traversal->unbalanced, traversal->nodeCapacity * sizeof(*traversal->unbalanced));
+	}
+
+	NSUInteger node = traversal->nodeCount++;
+	memset(traversal->bits + node * traversal->wordCount, 0, traversal->wordCount * sizeof(*traversal->bits));
+	traversal->unbalanced[node] = NO;
+	traversal->nodeIndexes[position] = (uint32_t)(node + 1);
+
+	GTAheadBehindQueuePush(traversal->queue, &traversal->queueCount, (GTAheadBehindQueueEntry){ generation, position });
+
+	return node;
+}
+
+// Recomputes whether a queued node is on only one side of any comparison.
+static void GTAheadBehindTraversalUpdateBalance(GTAheadBehindTraversal *traversal, NSUInteger node) {
+	const uint64_t *bits = traversal->bits + node * traversal->wordCount;
+	BOOL unbalanced = NO;
+	for (NSUInteger i = 0; i < traversal->pairCount && !unbalanced; i++) {
+		unbalanced = GTAheadBehindBitIsSet(bits, traversal->branchBits[i]) != GTAheadBehindBitIsSet(bits, traversal->baseBits[i]);
+	}
+
+	if (unbalanced && !traversal->unbalanced[node]) traversal->unbalancedCount++;
+	if (!unbalanced && traversal->unbalanced[node]) traversal->unbalancedCount--;
+	traversal->unbalanced[node] = unbalanced;
+}
+
+@interface GTAheadBehindMatrix () {
+	NSUInteger *_aheadCounts;
+	NSUInteger *_behindCounts;
+}
+
+@property (nonatomic, copy) NSArray *branches;
+@property (nonatomic, copy) NSArray *baseBranches;
+@property (nonatomic, assign) NSTimeInterval wallTime;
+@property (nonatomic, assign) NSUInteger commitsVisited;
+
+// Maps branch names to their index in `branches`.
+@property (nonatomic, strong) NSDictionary *indexesByBranchName;
+
+@end
+
+@implementation GTAheadBehindMatrix
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> branches: %lu, commitsVisited: %lu, wallTime: %f", NSStringFromClass([self class]), self, (unsigned long)self.branches.count, (unsigned long)self.commitsVisited, self.wallTime];
+}
+
+- (void)dealloc {
+	free(_aheadCounts);
+	free(_behindCounts);
+}
+
+#pragma mark API
+
++ (id)matrixWithBranches:(NSArray *)branches baseBranches:(NSArray *)baseBranches inRepository:(GTRepository *)repository error:(NSError **)error {
+	NSParameterAssert(branches != nil);
+	NSParameterAssert(baseBranches != nil);
+	NSParameterAssert(branches.count == baseBranches.count);
+	NSParameterAssert(repository != nil);
+
+	GTAheadBehindMatrix *matrix = [[self alloc] init];
+	matrix.branches = branches;
+	matrix.baseBranches = baseBranches;
+
+	NSMutableDictionary *indexesByBranchName = [NSMutableDictionary dictionaryWithCapacity:branches.count];
+	[branches enumerateObjectsUsingBlock:^(GTBranch *branch, NSUInteger index, BOOL *stop) {
+		indexesByBranchName[branch.name] = @(index);
+	}];
+	matrix.indexesByBranchName = indexesByBranchName;
+
+	if (![matrix calculateInRepository:repository error:error]) return nil;
+
+	return matrix;
+}
+
+- (GTBranch *)baseBranchForBranch:(GTBranch *)branch {
+	NSNumber *index = self.indexesByBranchName[branch.name];
+	if (index == nil) return nil;
+
+	return self.baseBranches[index.unsignedIntegerValue];
+}
+
+- (BOOL)getAhead:(NSUInteger *)ahead behind:(NSUInteger *)behind forBranch:(GTBranch *)branch {
+	NSParameterAssert(branch != nil);
+
+	NSNumber *index = self.indexesByBranchName[branch.name];
+	if (index == nil) return NO;
+
+	if (ahead != NULL) *ahead = _aheadCounts[index.unsignedIntegerValue];
+	if (behind != NULL) *behind = _behindCounts[index.unsignedIntegerValue];
+
+	return YES;
+}
+
+#pragma mark Traversal
+
+- (BOOL)calculateInRepository:(GTRepository *)repository error:(NSError **)error {
+	CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+
+	NSUInteger pairCount = self.branches.count;
+	_aheadCounts = calloc(pairCount, sizeof(*_aheadCounts));
+	_behindCounts = calloc(pairCount, sizeof(*_behindCounts));
+
+	// Give every distinct tip a bit.
+	NSMutableDictionary *bitsByOID = [NSMutableDictionary dictionary];
+	NSMutableArray *tipOIDs = [NSMutableArray array];
+	NSMutableData *branchBitsData = [NSMutableData dataWithLength:pairCount * sizeof(NSUInteger)];
+	NSMutableData *baseBitsData = [NSMutableData dataWithLength:pairCount * sizeof(NSUInteger)];
+	NSUInteger *branchBits = branchBitsData.mutableBytes;
+	NSUInteger *baseBits = baseBitsData.mutableBytes;
+
+	for (NSUInteger i = 0; i < pairCount; i++) {
+		GTBranch *branch = self.branches[i];
+		GTBranch *baseBranch = self.baseBranches[i];
+		GTOID *branchOID = branch.OID;
+		GTOID *baseOID = baseBranch.OID;
+		if (branchOID == nil || baseOID == nil) {
+			if (error != NULL) *error = [NSError git_errorFor:GIT_ENOTFOUND withAdditionalDescription:[NSString stringWithFormat:@"%@ does not point at a commit.", (branchOID == nil ? branch.name : baseBranch.name)]];
+			return NO;
+		}
+
+		for (GTOID *oid in @[ branchOID, baseOID ]) {
+			if (bitsByOID[oid] != nil) continue;
+
+			bitsByOID[oid] = @(tipOIDs.count);
+			[tipOIDs addObject:oid];
+		}
+
+		branchBits[i] = [bitsByOID[branchOID] unsignedIntegerValue];
+		baseBits[i] = [bitsByOID[baseOID] unsignedIntegerValue];
+	}
+
+	// Without a commit graph on disk, this builds one in memory, which reads
+	// every commit reachable from the tips once. That's still cheaper than
+	// walking the shared history once per branch.
+	GTCommitGraph *graph = [repository walkableCommitGraphWithError:error];
+	if (graph == nil) return NO;
+
+	[graph lock];
+
+	// Add the tips (and so everything they reach) before sizing anything off
+	// the graph.
+	NSMutableData *tipPositionsData = [NSMutableData dataWithLength:tipOIDs.count * sizeof(GTCommitGraphPosition)];
+	GTCommitGraphPosition *tipPositions = tipPositionsData.mutableBytes;
+	for (NSUInteger i = 0; i < tipOIDs.count; i++) {
+		tipPositions[i] = [graph addGitOid:[tipOIDs[i] git_oid] error:error];
+		if (tipPositions[i] == GTCommitGraphPositionNotFound) {
+			[graph unlock];
+			return NO;
+		}
+	}
+
+	NSUInteger graphCount = graph.positionCount;
+	GTAheadBehindTraversal traversal = {
+		.pairCount = pairCount,
+		.branchBits = branchBits,
+		.baseBits = baseBits,
+		.wordCount = (tipOIDs.count + 63) / 64,
+		.nodeIndexes = calloc(graphCount, sizeof(uint32_t)),
+		.nodeCapacity = MAX(tipOIDs.count, (NSUInteger)64),
+		.queue = malloc(graphCount * sizeof(GTAheadBehindQueueEntry)),
+	};
+	traversal.bits = malloc(traversal.nodeCapacity * traversal.wordCount * sizeof(uint64_t));
+	traversal.unbalanced = malloc(traversal.nodeCapacity * sizeof(BOOL));
+
+	for (NSUInteger i = 0; i < tipOIDs.count; i++) {
+		NSUInteger node = GTAheadBehindTraversalNode(&traversal, tipPositions[i], [graph generationAtPosition:tipPositions[i]]);
+		traversal.bits[node * traversal.wordCount + i / 64] |= 1ULL << (i % 64);
+		GTAheadBehindTraversalUpdateBalance(&traversal, node);
+	}
+
+	// Once every queued commit is on both sides of each comparison or neither,
+	// so is everything behind them, and there's nothing left to count.
+	NSUInteger commitsVisited = 0;
+	while (traversal.queueCount > 0 && traversal.unbalancedCount > 0) {
+		GTCommitGraphPosition position = GTAheadBehindQueuePop(traversal.queue, &traversal.queueCount).position;
+		NSUInteger node = traversal.nodeIndexes[position] - 1;
+		commitsVisited++;
+
+		if (traversal.unbalanced[node]) {
+			traversal.unbalancedCount--;
+
+			const uint64_t *bits = traversal.bits + node * traversal.wordCount;
+			for (NSUInteger i = 0; i < pairCount; i++) {
+				BOOL onBranch = GTAheadBehindBitIsSet(bits, branchBits[i]);
+				BOOL onBase = GTAheadBehindBitIsSet(bits, baseBits[i]);
+				if (onBranch && !onBase) _aheadCounts[i]++;
+				if (onBase && !onBranch) _behindCounts[i]++;
+			}
+		}
+
+		// Parents have lower generations than their children, so they haven't
+		// been popped yet and can still pick up bits.
+		NSUInteger parentCount = 0;
+		const GTCommitGraphPosition *parents = [graph parentPositionsAtPosition:position count:&parentCount];
+		for (NSUInteger i = 0; i < parentCount; i++) {
+			NSUInteger parentNode = GTAheadBehindTraversalNode(&traversal, parents[i], [graph generationAtPosition:parents[i]]);
+
+			// Look the bits up after creating the parent, since that may have
+			// moved the arena.
+			uint64_t *parentBits = traversal.bits + parentNode * traversal.wordCount;
+			const uint64_t *childBits = traversal.bits + node * traversal.wordCount;
+			BOOL changed = NO;
+			for (NSUInteger word = 0; word < traversal.wordCount; word++) {
+				uint64_t merged = parentBits[word] | childBits[word];
+				if (merged != parentBits[word]) changed = YES;
+				parentBits[word] = merged;
+			}
+
+			if (changed) GTAheadBehindTraversalUpdateBalance(&traversal, parentNode);
+		}
+	}
+
+	free(traversal.nodeIndexes);
+	free(traversal.bits);
+	free(traversal.unbalanced);
+	free(traversal.queue);
+
+	[graph unlock];
+
+	self.commitsVisited = commitsVisited;
+	self.wallTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+	return YES;
+}
+
+@end
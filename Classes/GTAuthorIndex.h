@@ -0,0 +1,106 @@
+//
+//  GTAuthorIndex.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTRepository;
+@class GTOID;
+
+// Returned by -[GTAuthorIndex initWithRepository:fileURL:error:] when the file
+// isn't a valid index. In GTGitErrorDomain, kept clear of libgit2's codes.
+static const NSInteger GTAuthorIndexErrorCodeCorruptFile = -1003;
+
+// Which signatures of a commit to match an identity against.
+// These options may be bitwise-OR'd together
+enum {
+	GTAuthorIndexRoleAuthor = 1 << 0,
+	GTAuthorIndexRoleCommitter = 1 << 1,
+};
+
+typedef unsigned int GTAuthorIndexRoles;
+
+// A persistent index of who wrote and committed each commit.
+//
+// Commits are filed under the normalized identity (see
+// +normalizedIdentityWithName:email:) of their author and of their committer,
+// along with the date of each signature, so finding someone's commits in a
+// date range never reads a commit. Restricting the results to the history of
+// one ref uses the commit graph rather than the object database too.
+//
+// Adding commits only reads the ones which aren't in the index yet, so keeping
+// it up to date as refs move is cheap.
+//
+// This class is thread safe.
+@interface GTAuthorIndex : NSObject
+
+// The repository the index is for.
+@property (nonatomic, readonly, unsafe_unretained) GTRepository *repository;
+
+// The file the index is loaded from and written to.
+@property (nonatomic, readonly, strong) NSURL *fileURL;
+
+// The number of commits in the index.
+@property (nonatomic, readonly) NSUInteger count;
+
+// Whether commits have been added since the index was loaded or written.
+@property (nonatomic, readonly) BOOL hasUnsavedChanges;
+
+// The file URL a repository's index is kept at by default:
+// `objectivegit/authors` in its git directory.
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository;
+
+// The identity commits are filed under for a signature: the email address,
+// trimmed and lowercased, or the name if there's no email address.
++ (NSString *)normalizedIdentityWithName:(NSString *)name email:(NSString *)email;
+
+// Initializes the receiver, loading the index from `fileURL` if the file
+// exists.
+//
+// repository - The repository the index is for. Cannot be nil.
+// fileURL    - The file to load from and write to. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the index, or nil if the file exists but couldn't be read.
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error;
+
+// Add every commit reachable from the given commits which isn't in the index
+// yet.
+//
+// oids       - An array of GTOIDs of commits. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns NO if an error occurred.
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error;
+
+// Write the index to `fileURL`, atomically.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns NO if an error occurred.
+- (BOOL)writeWithError:(NSError **)error;
+
+// Whether the index has a commit.
+- (BOOL)containsOID:(GTOID *)oid;
+
+// Find the commits an identity authored or committed.
+//
+// identity   - An email address or name, normalized the same way identities
+//              are filed. Cannot be nil.
+// roles      - Which signatures to match against.
+// sinceDate  - The earliest signature date to return, or nil for no limit.
+// untilDate  - The latest signature date to return, or nil for no limit.
+// tipOID     - If not nil, only commits reachable from this commit are
+//              returned, as in "commits by X on master".
+// error(out) - will be filled if an error occurs
+//
+// returns an array of GTOIDs, newest first, or nil if an error occurred. A
+// commit which matches as both author and committer is only returned once,
+// at the newer of its dates in range.
+- (NSArray *)OIDsOfCommitsByIdentity:(NSString *)identity roles:(GTAuthorIndexRoles)roles sinceDate:(NSDate *)sinceDate untilDate:(NSDate *)untilDate reachableFromOID:(GTOID *)tipOID error:(NSError **)error;
+
+@end
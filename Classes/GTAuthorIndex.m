@@ -0,0 +1,494 @@
+//
+//  GTAuthorIndex.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTAuthorIndex.h"
+#import "GTCommitGraph.h"
+#import "GTCommitGraph+Private.h"
+#import "GTCommitRecord.h"
+#import "GTCommitRecord+Private.h"
+#import "GTIndexFile.h"
+#import "GTRepository.h"
+#import "GTRepository+Private.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+// The file format (see GTIndexFile.h), all integers big-endian:
+//
+//   "GTAI"                          magic
+//   uint32                          version
+//   uint32                          commit count (N)
+//   uint32                          identity count (M)
+//   N * 20 bytes                    commit oids, sorted
+//   M * identity:
+//     uint32                        identity length (L)
+//     L bytes                       identity, UTF-8
+//     uint32                        entry count (E)
+//     E * entry:
+//       int64                       signature time
+//       20 bytes                    commit oid
+//       uint8                       role
+//   20 bytes                        SHA1 of everything above
+static const char GTAuthorIndexMagic[4] = { 'G', 'T', 'A', 'I' };
+static const uint32_t GTAuthorIndexVersion = 1;
+static const NSUInteger GTAuthorIndexEntryLength = 8 + GIT_OID_RAWSZ + 1;
+
+// One signature of one commit.
+typedef struct {
+	int64_t time;
+	git_oid oid;
+	uint8_t role;
+} GTAuthorIndexEntry;
+
+// Newest first, then by oid, so lists sort the same way every time.
+static int GTAuthorIndexEntryCompare(const void *a, const void *b) {
+	const GTAuthorIndexEntry *entry1 = a;
+	const GTAuthorIndexEntry *entry2 = b;
+	if (entry1->time != entry2->time) return (entry1->time > entry2->time ? -1 : 1);
+
+	int comparison = git_oid_cmp(&entry1->oid, &entry2->oid);
+	if (comparison != 0) return comparison;
+
+	return (int)entry1->role - (int)entry2->role;
+}
+
+@interface GTAuthorIndex () {
+	// The loaded file, and a pointer to its sorted commit oids.
+	NSData *_loadedData;
+	NSUInteger _loadedCount;
+	const uint8_t *_loadedOids;
+}
+
+// The GTOIDs of commits added since loading.
+@property (nonatomic, strong) NSMutableSet *addedOIDs;
+
+// NSMutableData of GTAuthorIndexEntry, keyed by identity.
+@property (nonatomic, strong) NSMutableDictionary *entriesByIdentity;
+
+// The identities whose entries have been added to since they were sorted.
+@property (nonatomic, strong) NSMutableSet *unsortedIdentities;
+
+@property (nonatomic, assign) BOOL hasUnsavedChanges;
+
+@end
+
+@implementation GTAuthorIndex
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> fileURL: %@, count: %lu", NSStringFromClass([self class]), self, self.fileURL, (unsigned long)self.count];
+}
+
+#pragma mark API
+
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository {
+	return GTIndexFileURLForRepository(repository, @"authors", NO);
+}
+
++ (NSString *)normalizedIdentityWithName:(NSString *)name email:(NSString *)email {
+	NSCharacterSet *whitespace = NSCharacterSet.whitespaceAndNewlineCharacterSet;
+	NSString *identity = [email stringByTrimmingCharactersInSet:whitespace];
+	if (identity.length == 0) identity = [name stringByTrimmingCharactersInSet:whitespace];
+
+	return identity.lowercaseString ?: @"";
+}
+
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error {
+	NSParameterAssert(repository != nil);
+	NSParameterAssert(fileURL != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_repository = repository;
+	_fileURL = [fileURL copy];
+	_addedOIDs = [NSMutableSet set];
+	_entriesByIdentity = [NSMutableDictionary dictionary];
+	_unsortedIdentities = [NSMutableSet set];
+
+	NSData *data = nil;
+	if (!GTIndexFileReadData(fileURL, &data, error)) return nil;
+	if (data != nil && ![self loadData:data error:error]) return nil;
+
+	return self;
+}
+
+- (NSUInteger)count {
+	@synchronized (self) {
+		return _loadedCount + self.addedOIDs.count;
+	}
+}
+
+- (BOOL)containsOID:(GTOID *)oid {
+	NSParameterAssert(oid != nil);
+
+	@synchronized (self) {
+		return [self containsGitOid:oid.git_oid];
+	}
+}
+
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error {
+	NSParameterAssert(oids != nil);
+
+	NSData *pendingData = [self unindexedGitOidsReachableFromOIDs:oids error:error];
+	if (pendingData == nil) return NO;
+
+	git_odb *odb = NULL;
+	int gitError = git_repository_odb(&odb, self.repository.git_repository);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to open object database."];
+		return NO;
+	}
+
+	GTCommitRecordBatch batch;
+	GTCommitRecordBatchInit(&batch, GTCommitRecordDefaultBatchSize);
+
+	const git_oid *pending = pendingData.bytes;
+	NSUInteger pendingCount = pendingData.length / sizeof(git_oid);
+	BOOL success = YES;
+	for (NSUInteger start = 0; start < pendingCount && success; start += batch.capacity) {
+		@autoreleasepool {
+			GTCommitRecordBatchReset(&batch);
+
+			NSUInteger end = MIN(start + batch.capacity, pendingCount);
+			for (NSUInteger i = start; i < end && success; i++) {
+				success = GTCommitRecordBatchAppendFromOdb(&batch, odb, &pending[i], error);
+			}
+
+			if (success) [self addRecords:batch.records count:batch.count buffer:batch.buffer];
+		}
+	}
+
+	GTCommitRecordBatchFree(&batch);
+	git_odb_free(odb);
+
+	return success;
+}
+
+- (BOOL)writeWithError:(NSError **)error {
+	NSMutableData *data = nil;
+	@synchronized (self) {
+		data = [self serializedData];
+	}
+
+	if (!GTIndexFileWriteData(data, self.fileURL, error)) return NO;
+
+	@synchronized (self) {
+		self.hasUnsavedChanges = NO;
+	}
+
+	return YES;
+}
+
+- (NSArray *)OIDsOfCommitsByIdentity:(NSString *)identity roles:(GTAuthorIndexRoles)roles sinceDate:(NSDate *)sinceDate untilDate:(NSDate *)untilDate reachableFromOID:(GTOID *)tipOID error:(NSError **)error {
+	NSParameterAssert(identity != nil);
+
+	int64_t since = (sinceDate == nil ? INT64_MIN : (int64_t)floor(sinceDate.timeIntervalSince1970));
+	int64_t until = (untilDate == nil ? INT64_MAX : (int64_t)ceil(untilDate.timeIntervalSince1970));
+
+	NSString *key = [self.class normalizedIdentityWithName:nil email:identity];
+	NSMutableData *matches = [NSMutableData data];
+
+	@synchronized (self) {
+		NSMutableData *entryData = self.entriesByIdentity[key];
+		if (entryData != nil && [self.unsortedIdentities containsObject:key]) {
+			qsort(entryData.mutableBytes, entryData.length / sizeof(GTAuthorIndexEntry), sizeof(GTAuthorIndexEntry), GTAuthorIndexEntryCompare);
+			[self.unsortedIdentities removeObject:key];
+		}
+
+		const GTAuthorIndexEntry *entries = entryData.bytes;
+		NSUInteger entryCount = entryData.length / sizeof(GTAuthorIndexEntry);
+
+		// Skip past everything newer than `until`.
+		NSUInteger low = 0;
+		NSUInteger high = entryCount;
+		while (low < high) {
+			NSUInteger middle = low + (high - low) / 2;
+			if (entries[middle].time > until) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+
+		for (NSUInteger i = low; i < entryCount && entries[i].time >= since; i++) {
+			if ((entries[i].role & roles) == 0) continue;
+			[matches appendBytes:&entries[i] length:sizeof(entries[i])];
+		}
+	}
+
+	// A commit can match as both author and committer.
+	const GTAuthorIndexEntry *match = matches.bytes;
+	NSUInteger matchCount = matches.length / sizeof(GTAuthorIndexEntry);
+	NSMutableArray *oids = [NSMutableArray arrayWithCapacity:matchCount];
+	NSMutableSet *seenOIDs = [NSMutableSet setWithCapacity:matchCount];
+	for (NSUInteger i = 0; i < matchCount; i++) {
+		GTOID *oid = [GTOID oidWithGitOid:&match[i].oid];
+		if ([seenOIDs containsObject:oid]) continue;
+
+		[seenOIDs addObject:oid];
+		[oids addObject:oid];
+	}
+
+	if (tipOID == nil || oids.count == 0) return oids;
+
+	return [self OIDs:oids reachableFromOID:tipOID error:error];
+}
+
+#pragma mark Indexing
+
+// Must be called while synchronized on the receiver.
+- (BOOL)containsGitOid:(const git_oid *)oid {
+	NSUInteger low = 0;
+	NSUInteger high = _loadedCount;
+	while (low < high) {
+		NSUInteger middle = low + (high - low) / 2;
+		int comparison = memcmp(_loadedOids + middle * GIT_OID_RAWSZ, oid->id, GIT_OID_RAWSZ);
+		if (comparison == 0) return YES;
+
+		if (comparison < 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return [self.addedOIDs containsObject:[GTOID oidWithGitOid:oid]];
+}
+
+// Walks the commit graph for the commits which aren't indexed yet, and returns
+// their git_oids packed into data, or nil if an error occurred.
+- (NSData *)unindexedGitOidsReachableFromOIDs:(NSArray *)oids error:(NSError **)error {
+	GTCommitGraph *graph = [self.repository walkableCommitGraphWithError:error];
+	if (graph == nil) return nil;
+
+	NSMutableData *pendingData = [NSMutableData data];
+
+	[graph lock];
+
+	NSData *positionData = [graph positionsReachableFromOIDs:oids error:error];
+	const GTCommitGraphPosition *positions = positionData.bytes;
+	NSUInteger positionCount = positionData.length / sizeof(*positions);
+
+	@synchronized (self) {
+		for (NSUInteger i = 0; i < positionCount; i++) {
+			const git_oid *oid = [graph gitOidAtPosition:positions[i]];
+			if (![self containsGitOid:oid]) [pendingData appendBytes:oid length:sizeof(*oid)];
+		}
+	}
+
+	[graph unlock];
+
+	return (positionData != nil ? pendingData : nil);
+}
+
+- (void)addRecords:(const GTCommitRecord *)records count:(NSUInteger)count buffer:(const char *)buffer {
+	@synchronized (self) {
+		for (NSUInteger i = 0; i < count; i++) {
+			const GTCommitRecord *record = &records[i];
+			GTOID *oid = [GTOID oidWithGitOid:&record->oid];
+			if ([self containsGitOid:oid.git_oid]) continue;
+
+			NSString *author = [self.class normalizedIdentityWithName:GTCommitRecordString(buffer, record->authorName) email:GTCommitRecordString(buffer, record->authorEmail)];
+			NSString *committer = [self.class normalizedIdentityWithName:GTCommitRecordString(buffer, record->committerName) email:GTCommitRecordString(buffer, record->committerEmail)];
+
+			[self addEntry:(GTAuthorIndexEntry){ record->authorTime, record->oid, GTAuthorIndexRoleAuthor } forIdentity:author];
+			[self addEntry:(GTAuthorIndexEntry){ record->commitTime, record->oid, GTAuthorIndexRoleCommitter } forIdentity:committer];
+
+			[self.addedOIDs addObject:oid];
+			self.hasUnsavedChanges = YES;
+		}
+	}
+}
+
+// Must be called while synchronized on the receiver.
+- (void)addEntry:(GTAuthorIndexEntry)entry forIdentity:(NSString *)identity {
+	NSMutableData *entryData = self.entriesByIdentity[identity];
+	if (entryData == nil) {
+		entryData = [NSMutableData data];
+		self.entriesByIdentity[identity] = entryData;
+	}
+
+	[entryData appendBytes:&entry length:sizeof(entry)];
+	[self.unsortedIdentities addObject:identity];
+}
+
+#pragma mark Reachability
+
+// Filters OIDs down to the ones reachable from a commit, keeping their order.
+- (NSArray *)OIDs:(NSArray *)oids reachableFromOID:(GTOID *)tipOID error:(NSError **)error {
+	GTCommitGraph *graph = [self.repository walkableCommitGraphWithError:error];
+	if (graph == nil) return nil;
+
+	[graph lock];
+
+	GTCommitGraphPosition tip = [graph addGitOid:tipOID.git_oid error:error];
+	if (tip == GTCommitGraphPositionNotFound) {
+		[graph unlock];
+		return nil;
+	}
+
+	GTCommitGraphPosition *candidates = malloc(oids.count * sizeof(*candidates));
+	uint32_t minimumGeneration = UINT32_MAX;
+	for (NSUInteger i = 0; i < oids.count; i++) {
+		candidates[i] = [graph addGitOid:[oids[i] git_oid] error:error];
+		if (candidates[i] == GTCommitGraphPositionNotFound) {
+			free(candidates);
+			[graph unlock];
+			return nil;
+		}
+
+		minimumGeneration = MIN(minimumGeneration, [graph generationAtPosition:candidates[i]]);
+	}
+
+	// Ancestors always have smaller generations, so there's no need to go
+	// below the oldest candidate.
+	NSUInteger graphCount = graph.positionCount;
+	uint8_t *reachable = calloc(graphCount, sizeof(*reachable));
+	GTCommitGraphPosition *stack = malloc(graphCount * sizeof(*stack));
+	NSUInteger stackCount = 0;
+
+	if ([graph generationAtPosition:tip] >= minimumGeneration) {
+		reachable[tip] = 1;
+		stack[stackCount++] = tip;
+	}
+
+	while (stackCount > 0) {
+		GTCommitGraphPosition position = stack[--stackCount];
+
+		NSUInteger parentCount = 0;
+		const GTCommitGraphPosition *parents = [graph parentPositionsAtPosition:position count:&parentCount];
+		for (NSUInteger i = 0; i < parentCount; i++) {
+			if (reachable[parents[i]] || [graph generationAtPosition:parents[i]] < minimumGeneration) continue;
+
+			reachable[parents[i]] = 1;
+			stack[stackCount++] = parents[i];
+		}
+	}
+
+	NSMutableArray *reachableOIDs = [NSMutableArray arrayWithCapacity:oids.count];
+	for (NSUInteger i = 0; i < oids.count; i++) {
+		if (reachable[candidates[i]]) [reachableOIDs addObject:oids[i]];
+	}
+
+	free(reachable);
+	free(stack);
+	free(candidates);
+
+	[graph unlock];
+
+	return reachableOIDs;
+}
+
+#pragma mark Serialization
+
+// Must be called while synchronized on the receiver.
+- (NSMutableData *)serializedData {
+	NSMutableData *data = GTIndexFileCreateData(GTAuthorIndexMagic, GTAuthorIndexVersion, 0);
+	GTIndexFileAppendUInt32(data, (uint32_t)(_loadedCount + self.addedOIDs.count));
+	GTIndexFileAppendUInt32(data, (uint32_t)self.entriesByIdentity.count);
+
+	// Merge the loaded oids, which are already sorted, with the added ones.
+	NSArray *addedOIDs = [self.addedOIDs.allObjects sortedArrayUsingSelector:@selector(compare:)];
+	NSUInteger loadedIndex = 0;
+	NSUInteger addedIndex = 0;
+	while (loadedIndex < _loadedCount || addedIndex < addedOIDs.count) {
+		const uint8_t *loadedOid = (loadedIndex < _loadedCount ? _loadedOids + loadedIndex * GIT_OID_RAWSZ : NULL);
+		GTOID *addedOID = (addedIndex < addedOIDs.count ? addedOIDs[addedIndex] : nil);
+
+		if (addedOID == nil || (loadedOid != NULL && memcmp(loadedOid, addedOID.git_oid->id, GIT_OID_RAWSZ) < 0)) {
+			[data appendBytes:loadedOid length:GIT_OID_RAWSZ];
+			loadedIndex++;
+		} else {
+			[data appendBytes:addedOID.git_oid->id length:GIT_OID_RAWSZ];
+			addedIndex++;
+		}
+	}
+
+	NSArray *identities = [self.entriesByIdentity.allKeys sortedArrayUsingSelector:@selector(compare:)];
+	for (NSString *identity in identities) {
+		NSMutableData *entryData = self.entriesByIdentity[identity];
+		if ([self.unsortedIdentities containsObject:identity]) {
+			qsort(entryData.mutableBytes, entryData.length / sizeof(GTAuthorIndexEntry), sizeof(GTAuthorIndexEntry), GTAuthorIndexEntryCompare);
+		}
+
+		NSData *identityData = [identity dataUsingEncoding:NSUTF8StringEncoding];
+		GTIndexFileAppendUInt32(data, (uint32_t)identityData.length);
+		[data appendData:identityData];
+
+		const GTAuthorIndexEntry *entries = entryData.bytes;
+		NSUInteger entryCount = entryData.length / sizeof(GTAuthorIndexEntry);
+		GTIndexFileAppendUInt32(data, (uint32_t)entryCount);
+		for (NSUInteger i = 0; i < entryCount; i++) {
+			GTIndexFileAppendInt64(data, entries[i].time);
+			[data appendBytes:entries[i].oid.id length:GIT_OID_RAWSZ];
+			[data appendBytes:&entries[i].role length:1];
+		}
+	}
+
+	[self.unsortedIdentities removeAllObjects];
+
+	return data;
+}
+
+- (NSError *)corruptFileError {
+	return GTIndexFileCorruptError(GTAuthorIndexErrorCodeCorruptFile, @"The author index", self.fileURL);
+}
+
+// Only called from the initializer, before anyone else can see the receiver.
+- (BOOL)loadData:(NSData *)data error:(NSError **)error {
+	NSUInteger contentsLength = GTIndexFileContentsLength(data, GTAuthorIndexMagic, GTAuthorIndexVersion);
+	if (contentsLength == 0) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	GTIndexFileReader reader = GTIndexFileReaderMake(data, contentsLength);
+	uint32_t count = 0;
+	uint32_t identityCount = 0;
+	const uint8_t *oids = NULL;
+	BOOL valid = GTIndexFileReaderReadUInt32(&reader, &count) && GTIndexFileReaderReadUInt32(&reader, &identityCount) && GTIndexFileReaderReadArray(&reader, count, GIT_OID_RAWSZ, &oids);
+
+	for (uint32_t i = 0; valid && i < identityCount; i++) {
+		uint32_t identityLength = 0;
+		const uint8_t *identityBytes = NULL;
+		uint32_t entryCount = 0;
+		const uint8_t *entryBytes = NULL;
+		valid = GTIndexFileReaderReadUInt32(&reader, &identityLength) && GTIndexFileReaderReadBytes(&reader, identityLength, &identityBytes) && GTIndexFileReaderReadUInt32(&reader, &entryCount) && GTIndexFileReaderReadArray(&reader, entryCount, GTAuthorIndexEntryLength, &entryBytes);
+		if (!valid) break;
+
+		NSString *identity = [[NSString alloc] initWithBytes:identityBytes length:identityLength encoding:NSUTF8StringEncoding];
+		if (identity == nil) {
+			valid = NO;
+			break;
+		}
+
+		NSMutableData *entryData = [NSMutableData dataWithLength:entryCount * sizeof(GTAuthorIndexEntry)];
+		GTAuthorIndexEntry *entries = entryData.mutableBytes;
+		for (NSUInteger j = 0; j < entryCount; j++) {
+			const uint8_t *entry = entryBytes + j * GTAuthorIndexEntryLength;
+			entries[j].time = GTIndexFileReadInt64(entry);
+			memcpy(entries[j].oid.id, entry + 8, GIT_OID_RAWSZ);
+			entries[j].role = entry[8 + GIT_OID_RAWSZ];
+		}
+
+		self.entriesByIdentity[identity] = entryData;
+	}
+
+	if (!valid || !GTIndexFileReaderIsAtEnd(&reader) || self.entriesByIdentity.count != identityCount) {
+		[self.entriesByIdentity removeAllObjects];
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	_loadedData = data;
+	_loadedCount = count;
+	_loadedOids = oids;
+
+	return YES;
+}
+
+@end
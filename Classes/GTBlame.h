@@ -0,0 +1,80 @@
+//
+//  GTBlame.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTBlameHunk;
+@class GTCommit;
+@class GTOID;
+
+// Which commit last changed each line of a file, as of some commit.
+//
+// Only the commits which still have lines to hand on are visited, newest first,
+// and the walk stops as soon as every line has been blamed. Each commit hands
+// the lines it didn't change on to the parent they came from and is blamed for
+// the rest. As in `git blame`, a merge hands all of its lines to a
+// parent with the very same file, and otherwise tries its parents in order.
+// Renames aren't followed, so the lines of a moved file are blamed on the move.
+//
+// The repository caches how the file changed between each walked commit and
+// its parents, so any later blame walking through those commits, at a newer,
+// older or sibling commit, hands lines on without diffing again. Finished
+// blames are cached too, so blaming a file at a newer commit stops walking as
+// soon as it reaches a commit the file has already been blamed at, and takes
+// the rest of the answer from there.
+@interface GTBlame : NSObject
+
+// The path of the blamed file.
+@property (nonatomic, readonly, copy) NSString *path;
+
+// The commit the file was blamed at.
+@property (nonatomic, readonly, strong) GTOID *commitOID;
+
+// The number of lines in the file.
+@property (nonatomic, readonly) NSUInteger lineCount;
+
+// The GTBlameHunks covering the file, in order. Adjacent lines share a hunk
+// when they come from consecutive lines of the same commit.
+@property (nonatomic, readonly, copy) NSArray *hunks;
+
+// The number of diffs made to blame the file. Diffs which earlier blames in
+// the same repository already made are reused, and aren't counted.
+@property (nonatomic, readonly) NSUInteger diffCount;
+
+// Blame a file.
+//
+// path       - The path of the file in the commit's tree. Cannot be nil.
+// commit     - The commit to blame the file at. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the blame, or nil if the file isn't in the commit or an error
+// occurred.
++ (instancetype)blameForFileAtPath:(NSString *)path inCommit:(GTCommit *)commit error:(NSError **)error;
+
+// Blame a file, handing hunks to a block as soon as they're known.
+//
+// Lines are settled in history order rather than file order, so the block sees
+// hunks out of order, and may see several where the finished blame has one.
+//
+// path       - The path of the file in the commit's tree. Cannot be nil.
+// commit     - The commit to blame the file at. Cannot be nil.
+// error(out) - will be filled if an error occurs
+// block      - Called with each hunk as its lines are settled. May be nil.
+//
+// returns the blame, or nil if the file isn't in the commit or an error
+// occurred.
++ (instancetype)blameForFileAtPath:(NSString *)path inCommit:(GTCommit *)commit error:(NSError **)error usingBlock:(void (^)(GTBlameHunk *hunk))block;
+
+// The hunk a line is in.
+//
+// lineNumber - The number of the line, counting from 1.
+//
+// returns the hunk, or nil if there's no such line.
+- (GTBlameHunk *)hunkAtLineNumber:(NSUInteger)lineNumber;
+
+@end
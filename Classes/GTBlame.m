@@ -0,0 +1,472 @@
+//
+//  GTBlame.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTBlame.h"
+#import "GTBlameHunk.h"
+#import "GTBlob.h"
+#import "GTCommit.h"
+#import "GTDiff.h"
+#import "GTDiffHunk.h"
+#import "GTOID.h"
+#import "GTRepository.h"
+#import "GTRepository+Private.h"
+#import "GTTree.h"
+#import "NSError+Git.h"
+
+// Who a line of the blamed file belongs to.
+typedef struct {
+	git_oid commit;
+
+	// The line's index in the commit's version of the file.
+	uint32_t originalLine;
+} GTBlameLine;
+
+// Lines of the blamed file still looking for their commit, as they appear in
+// one commit's version of the file.
+typedef struct {
+	// The index of the first line in this version of the file.
+	NSUInteger start;
+	NSUInteger count;
+
+	// The index of the first line in the blamed file.
+	NSUInteger finalStart;
+} GTBlameEntry;
+
+// The old and new line ranges of a diff hunk.
+typedef struct {
+	NSRange oldLines;
+	NSRange newLines;
+} GTBlameChange;
+
+static NSUInteger GTBlameLineCount(NSData *data) {
+	const char *bytes = data.bytes;
+	NSUInteger length = data.length;
+	if (length == 0) return 0;
+
+	NSUInteger count = 0;
+	for (NSUInteger i = 0; i < length; i++) {
+		if (bytes[i] == '\n') count++;
+	}
+
+	// A last line without a newline still counts.
+	if (bytes[length - 1] != '\n') count++;
+
+	return count;
+}
+
+// Hand `entryData` on to `commit`, queueing the commit if it wasn't already.
+//
+// `queue` is kept sorted by commit time, oldest first, so the newest commit
+// with lines to hand on is always last.
+static void GTBlamePassEntries(NSData *entryData, GTCommit *commit, NSMutableDictionary *pending, NSMutableArray *queue) {
+	NSMutableData *pendingData = pending[commit.OID];
+	if (pendingData != nil) {
+		[pendingData appendData:entryData];
+		return;
+	}
+
+	pending[commit.OID] = [entryData mutableCopy];
+
+	NSUInteger index = [queue indexOfObject:commit inSortedRange:NSMakeRange(0, queue.count) options:NSBinarySearchingInsertionIndex usingComparator:^ NSComparisonResult (GTCommit *commit1, GTCommit *commit2) {
+		git_time_t time1 = git_commit_time(commit1.git_commit);
+		git_time_t time2 = git_commit_time(commit2.git_commit);
+		if (time1 < time2) return NSOrderedAscending;
+		if (time1 > time2) return NSOrderedDescending;
+		return NSOrderedSame;
+	}];
+
+	[queue insertObject:commit atIndex:index];
+}
+
+static NSString *GTBlameCacheKey(GTOID *commitOID, NSString *path) {
+	return [NSString stringWithFormat:@"%@:%@", commitOID.sha, path];
+}
+
+static NSString *GTBlameChangesCacheKey(GTOID *commitOID, NSString *path) {
+	return [NSString stringWithFormat:@"changes:%@:%@", commitOID.sha, path];
+}
+
+// How a file changed between a commit and its parents, which is all a blame
+// needs to hand the commit's lines on. It doesn't depend on which lines are
+// being blamed, so the repository caches it for any blame which walks through
+// the commit.
+@interface GTBlameCommitChanges : NSObject
+
+// The indexes of the parents to hand lines on to, in the order to try them.
+@property (nonatomic, readonly, copy) NSArray *parentIndexes;
+
+- (id)initWithParentIndexes:(NSArray *)parentIndexes;
+
+// The GTBlameChanges from the parent at `parentIndexes[idx]` to the commit, or
+// nil if they haven't been found yet. No changes means the file is the same.
+- (NSData *)changesAtIndex:(NSUInteger)idx;
+- (void)setChanges:(NSData *)changes atIndex:(NSUInteger)idx;
+
+@end
+
+@implementation GTBlameCommitChanges {
+	// NSNumber indexes into `parentIndexes` to NSData. Only accessed while
+	// synchronized on the receiver.
+	NSMutableDictionary *_changes;
+}
+
+- (id)initWithParentIndexes:(NSArray *)parentIndexes {
+	self = [super init];
+	if (self == nil) return nil;
+
+	_parentIndexes = [parentIndexes copy];
+	_changes = [NSMutableDictionary dictionary];
+
+	return self;
+}
+
+- (NSData *)changesAtIndex:(NSUInteger)idx {
+	@synchronized (self) {
+		return _changes[@(idx)];
+	}
+}
+
+- (void)setChanges:(NSData *)changes atIndex:(NSUInteger)idx {
+	@synchronized (self) {
+		_changes[@(idx)] = [changes copy];
+	}
+}
+
+@end
+
+@interface GTBlame ()
+
+// GTBlameLines for every line, in order.
+@property (nonatomic, readonly, copy) NSData *lineData;
+
+- (id)initWithPath:(NSString *)path commitOID:(GTOID *)commitOID lineData:(NSData *)lineData diffCount:(NSUInteger)diffCount;
+
+@end
+
+@implementation GTBlame
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> path: %@, commitOID: %@, lineCount: %lu", NSStringFromClass([self class]), self, self.path, self.commitOID, (unsigned long)self.lineCount];
+}
+
+- (id)initWithPath:(NSString *)path commitOID:(GTOID *)commitOID lineData:(NSData *)lineData diffCount:(NSUInteger)diffCount {
+	self = [super init];
+	if (self == nil) return nil;
+
+	_path = [path copy];
+	_commitOID = commitOID;
+	_lineData = [lineData copy];
+	_lineCount = lineData.length / sizeof(GTBlameLine);
+	_diffCount = diffCount;
+	_hunks = [self.class hunksForLines:lineData.bytes range:NSMakeRange(0, _lineCount)];
+
+	return self;
+}
+
+#pragma mark API
+
++ (instancetype)blameForFileAtPath:(NSString *)path inCommit:(GTCommit *)commit error:(NSError **)error {
+	return [self blameForFileAtPath:path inCommit:commit error:error usingBlock:nil];
+}
+
++ (instancetype)blameForFileAtPath:(NSString *)path inCommit:(GTCommit *)commit error:(NSError **)error usingBlock:(void (^)(GTBlameHunk *hunk))block {
+	NSParameterAssert(path != nil);
+	NSParameterAssert(commit != nil);
+
+	GTRepository *repository = commit.repository;
+
+	GTOID *blobOID = [self blobOIDAtPath:path inCommit:commit error:error];
+	if (blobOID == nil) return nil;
+
+	GTBlob *blob = (GTBlob *)[repository lookupObjectByOID:blobOID objectType:GTObjectTypeBlob error:error];
+	if (blob == nil) return nil;
+
+	NSUInteger lineCount = GTBlameLineCount(blob.data);
+	NSMutableData *lineData = [NSMutableData dataWithLength:lineCount * sizeof(GTBlameLine)];
+
+	// GTOIDs of commits to NSMutableData of the GTBlameEntries handed to them,
+	// and those commits, oldest first.
+	//
+	// Like `git blame`, this goes by commit time rather than sorting the
+	// history topologically, which would read all of it up front. Children are
+	// almost always newer than their parents, so a commit has usually been
+	// handed all of its lines by the time it comes up. If a clock was off and
+	// a child's lines reach a commit which has been visited, it's just queued
+	// again, and the lines are handed on from there.
+	NSMutableDictionary *pending = [NSMutableDictionary dictionary];
+	NSMutableArray *queue = [NSMutableArray array];
+	if (lineCount > 0) {
+		GTBlameEntry entry = { .start = 0, .count = lineCount, .finalStart = 0 };
+		GTBlamePassEntries([NSData dataWithBytes:&entry length:sizeof(entry)], commit, pending, queue);
+	}
+
+	NSUInteger diffCount = 0;
+	while (queue.count > 0) {
+		GTCommit *current = queue.lastObject;
+		[queue removeLastObject];
+
+		NSData *entryData = pending[current.OID];
+		[pending removeObjectForKey:current.OID];
+		if (![self blameEntries:entryData inCommit:current path:path pending:pending queue:queue lines:lineData.mutableBytes diffCount:&diffCount error:error usingBlock:block]) return nil;
+	}
+
+	[repository.blameCache setObject:[lineData copy] forKey:GTBlameCacheKey(commit.OID, path)];
+
+	return [[self alloc] initWithPath:path commitOID:commit.OID lineData:lineData diffCount:diffCount];
+}
+
+- (GTBlameHunk *)hunkAtLineNumber:(NSUInteger)lineNumber {
+	for (GTBlameHunk *hunk in self.hunks) {
+		if (NSLocationInRange(lineNumber, hunk.lineRange)) return hunk;
+	}
+
+	return nil;
+}
+
+#pragma mark Blaming
+
+// Hand the lines of `commit`'s version of the file which it got from its
+// parents on to them, and blame it for the rest.
++ (BOOL)blameEntries:(NSData *)entryData inCommit:(GTCommit *)commit path:(NSString *)path pending:(NSMutableDictionary *)pending queue:(NSMutableArray *)queue lines:(GTBlameLine *)lines diffCount:(NSUInteger *)diffCount error:(NSError **)error usingBlock:(void (^)(GTBlameHunk *hunk))block {
+	const GTBlameEntry *entries = entryData.bytes;
+	NSUInteger entryCount = entryData.length / sizeof(*entries);
+
+	// If the file's been blamed at this commit before, the answer's already
+	// known.
+	NSData *cachedData = [commit.repository.blameCache objectForKey:GTBlameCacheKey(commit.OID, path)];
+	if (cachedData != nil) {
+		const GTBlameLine *cachedLines = cachedData.bytes;
+		for (NSUInteger i = 0; i < entryCount; i++) {
+			memcpy(lines + entries[i].finalStart, cachedLines + entries[i].start, entries[i].count * sizeof(*lines));
+			[self settleLines:lines range:NSMakeRange(entries[i].finalStart, entries[i].count) usingBlock:block];
+		}
+
+		return YES;
+	}
+
+	GTBlameCommitChanges *commitChanges = [self changesInCommit:commit path:path error:error];
+	if (commitChanges == nil) return NO;
+
+	NSArray *parents = nil;
+	NSData *remainingData = entryData;
+	for (NSUInteger idx = 0; idx < commitChanges.parentIndexes.count; idx++) {
+		if (remainingData.length == 0) break;
+
+		if (parents == nil) parents = commit.parents;
+		GTCommit *parent = parents[[commitChanges.parentIndexes[idx] unsignedIntegerValue]];
+
+		NSData *changeData = [commitChanges changesAtIndex:idx];
+		if (changeData == nil) {
+			changeData = [self changesFromParent:parent toCommit:commit path:path error:error];
+			if (changeData == nil) return NO;
+
+			[commitChanges setChanges:changeData atIndex:idx];
+			(*diffCount)++;
+		}
+
+		if (changeData.length == 0) {
+			// Nothing changed, so everything came from this parent.
+			GTBlamePassEntries(remainingData, parent, pending, queue);
+			remainingData = nil;
+			break;
+		}
+
+		NSMutableData *passedData = [NSMutableData data];
+		NSMutableData *keptData = [NSMutableData data];
+		[self splitEntries:remainingData changes:changeData passedData:passedData keptData:keptData];
+
+		if (passedData.length > 0) GTBlamePassEntries(passedData, parent, pending, queue);
+		remainingData = keptData;
+	}
+
+	entries = remainingData.bytes;
+	entryCount = remainingData.length / sizeof(*entries);
+	for (NSUInteger i = 0; i < entryCount; i++) {
+		for (NSUInteger j = 0; j < entries[i].count; j++) {
+			GTBlameLine *line = &lines[entries[i].finalStart + j];
+			git_oid_cpy(&line->commit, commit.OID.git_oid);
+			line->originalLine = (uint32_t)(entries[i].start + j);
+		}
+
+		[self settleLines:lines range:NSMakeRange(entries[i].finalStart, entries[i].count) usingBlock:block];
+	}
+
+	return YES;
+}
+
+// The parents of `commit` which its lines can come from, from the repository's
+// cache if an earlier blame walked through the commit.
+//
+// As in `git blame`, if a parent has the very same file, every line came from
+// it, even if that isn't the first parent. Otherwise lines go to the parents
+// which have the file, trying them in order.
++ (GTBlameCommitChanges *)changesInCommit:(GTCommit *)commit path:(NSString *)path error:(NSError **)error {
+	NSCache *cache = commit.repository.blameCache;
+	GTBlameCommitChanges *commitChanges = [cache objectForKey:GTBlameChangesCacheKey(commit.OID, path)];
+	if (commitChanges != nil) return commitChanges;
+
+	GTOID *blobOID = [self blobOIDAtPath:path inCommit:commit error:error];
+	if (blobOID == nil) return nil;
+
+	NSMutableArray *parentIndexes = [NSMutableArray array];
+	NSUInteger identicalIndex = NSNotFound;
+	NSArray *parents = commit.parents;
+	for (NSUInteger i = 0; i < parents.count; i++) {
+		GTOID *parentBlobOID = [self blobOIDAtPath:path inCommit:parents[i] error:NULL];
+		if (parentBlobOID == nil) continue;
+
+		if ([parentBlobOID isEqual:blobOID]) {
+			identicalIndex = i;
+			break;
+		}
+
+		[parentIndexes addObject:@(i)];
+	}
+
+	if (identicalIndex != NSNotFound) {
+		commitChanges = [[GTBlameCommitChanges alloc] initWithParentIndexes:@[ @(identicalIndex) ]];
+		[commitChanges setChanges:[NSData data] atIndex:0];
+	} else {
+		commitChanges = [[GTBlameCommitChanges alloc] initWithParentIndexes:parentIndexes];
+	}
+
+	[cache setObject:commitChanges forKey:GTBlameChangesCacheKey(commit.OID, path)];
+
+	return commitChanges;
+}
+
+// The line ranges of the hunks which turn `parent`'s version of the file into
+// `commit`'s, as packed GTBlameChanges.
++ (NSData *)changesFromParent:(GTCommit *)parent toCommit:(GTCommit *)commit path:(NSString *)path error:(NSError **)error {
+	NSDictionary *options = @{
+		GTDiffOptionsPathSpecArrayKey: @[ path ],
+		GTDiffOptionsContextLinesKey: @0,
+		GTDiffOptionsFlagsKey: @(GTDiffOptionsFlagsDisablePathspecMatch | GTDiffOptionsFlagsForceText),
+	};
+
+	GTDiff *diff = [GTDiff diffOldTree:parent.tree withNewTree:commit.tree options:options error:error];
+	if (diff == nil) return nil;
+
+	NSMutableData *changeData = [NSMutableData data];
+	[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+		[delta enumerateHunksWithBlock:^(GTDiffHunk *hunk, BOOL *stop) {
+			GTBlameChange change = { .oldLines = hunk.oldLineRange, .newLines = hunk.newLineRange };
+			[changeData appendBytes:&change length:sizeof(change)];
+		}];
+	}];
+
+	return changeData;
+}
+
+// Sort entries into the lines which a parent has unchanged, renumbered to the
+// parent's version of the file, and the lines which changed.
++ (void)splitEntries:(NSData *)entryData changes:(NSData *)changeData passedData:(NSMutableData *)passedData keptData:(NSMutableData *)keptData {
+	const GTBlameEntry *entries = entryData.bytes;
+	NSUInteger entryCount = entryData.length / sizeof(*entries);
+	NSUInteger lineCount = 0;
+	for (NSUInteger i = 0; i < entryCount; i++) {
+		lineCount = MAX(lineCount, entries[i].start + entries[i].count);
+	}
+
+	// Where each line of the commit's version came from in the parent's, or
+	// NSNotFound if the commit changed it.
+	NSUInteger *parentLines = malloc(MAX(lineCount, (NSUInteger)1) * sizeof(*parentLines));
+	const GTBlameChange *changes = changeData.bytes;
+	NSUInteger changeCount = changeData.length / sizeof(*changes);
+	NSInteger offset = 0;
+	NSUInteger line = 0;
+	for (NSUInteger i = 0; i < changeCount; i++) {
+		// Hunk line numbers count from 1, but an empty range is numbered by
+		// the line before it.
+		NSUInteger changeStart = (changes[i].newLines.length == 0 ? changes[i].newLines.location : changes[i].newLines.location - 1);
+		NSUInteger changeEnd = changeStart + changes[i].newLines.length;
+
+		for (; line < MIN(changeStart, lineCount); line++) parentLines[line] = line + offset;
+		for (; line < MIN(changeEnd, lineCount); line++) parentLines[line] = NSNotFound;
+
+		offset += (NSInteger)changes[i].oldLines.length - (NSInteger)changes[i].newLines.length;
+	}
+
+	for (; line < lineCount; line++) parentLines[line] = line + offset;
+
+	for (NSUInteger i = 0; i < entryCount; i++) {
+		NSUInteger end = entries[i].start + entries[i].count;
+		NSUInteger runStart = entries[i].start;
+		while (runStart < end) {
+			// Extend the run while lines stay unchanged and consecutive in the
+			// parent, or stay changed.
+			BOOL changed = (parentLines[runStart] == NSNotFound);
+			NSUInteger runEnd = runStart + 1;
+			while (runEnd < end) {
+				if (changed != (parentLines[runEnd] == NSNotFound)) break;
+				if (!changed && parentLines[runEnd] != parentLines[runEnd - 1] + 1) break;
+				runEnd++;
+			}
+
+			GTBlameEntry run = {
+				.start = (changed ? runStart : parentLines[runStart]),
+				.count = runEnd - runStart,
+				.finalStart = entries[i].finalStart + (runStart - entries[i].start),
+			};
+
+			[(changed ? keptData : passedData) appendBytes:&run length:sizeof(run)];
+			runStart = runEnd;
+		}
+	}
+
+	free(parentLines);
+}
+
+// Tell the block about lines of the blamed file whose commits are now known.
++ (void)settleLines:(const GTBlameLine *)lines range:(NSRange)range usingBlock:(void (^)(GTBlameHunk *hunk))block {
+	if (block == nil) return;
+
+	for (GTBlameHunk *hunk in [self hunksForLines:lines range:range]) {
+		block(hunk);
+	}
+}
+
++ (NSArray *)hunksForLines:(const GTBlameLine *)lines range:(NSRange)range {
+	NSMutableArray *hunks = [NSMutableArray array];
+
+	NSUInteger start = range.location;
+	while (start < NSMaxRange(range)) {
+		NSUInteger end = start + 1;
+		while (end < NSMaxRange(range) && git_oid_cmp(&lines[end].commit, &lines[start].commit) == 0 && lines[end].originalLine == lines[end - 1].originalLine + 1) {
+			end++;
+		}
+
+		GTOID *commitOID = [GTOID oidWithGitOid:&lines[start].commit];
+		[hunks addObject:[[GTBlameHunk alloc] initWithCommitOID:commitOID lineRange:NSMakeRange(start + 1, end - start) originalStartLineNumber:lines[start].originalLine + 1]];
+
+		start = end;
+	}
+
+	return hunks;
+}
+
+#pragma mark Trees
+
++ (GTOID *)blobOIDAtPath:(NSString *)path inCommit:(GTCommit *)commit error:(NSError **)error {
+	git_tree_entry *entry = NULL;
+	int gitError = git_tree_entry_bypath(&entry, commit.tree.git_tree, path.UTF8String);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to find %@ in commit %@.", path, commit.sha]];
+		return nil;
+	}
+
+	GTOID *oid = nil;
+	if (git_tree_entry_type(entry) == GIT_OBJ_BLOB) oid = [GTOID oidWithGitOid:git_tree_entry_id(entry)];
+	git_tree_entry_free(entry);
+
+	if (oid == nil && error != NULL) *error = [NSError git_errorFor:GIT_ENOTFOUND withAdditionalDescription:[NSString stringWithFormat:@"%@ isn't a file in commit %@.", path, commit.sha]];
+
+	return oid;
+}
+
+@end
@@ -0,0 +1,30 @@
+//
+//  GTBlameHunk.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTOID;
+
+// A run of lines in a blamed file which were last changed by the same commit.
+@interface GTBlameHunk : NSObject
+
+// The commit which last changed the lines.
+@property (nonatomic, readonly, strong) GTOID *commitOID;
+
+// The lines in the blamed file. The location is the number of the first line,
+// counting from 1.
+@property (nonatomic, readonly) NSRange lineRange;
+
+// The number of the first line in the commit's version of the file, counting
+// from 1.
+@property (nonatomic, readonly) NSUInteger originalStartLineNumber;
+
+// Designated initializer.
+- (instancetype)initWithCommitOID:(GTOID *)commitOID lineRange:(NSRange)lineRange originalStartLineNumber:(NSUInteger)originalStartLineNumber;
+
+@end
@@ -0,0 +1,31 @@
+//
+//  GTBlameHunk.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTBlameHunk.h"
+#import "GTOID.h"
+
+@implementation GTBlameHunk
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> commitOID: %@, lineRange: %@, originalStartLineNumber: %lu", NSStringFromClass([self class]), self, self.commitOID, NSStringFromRange(self.lineRange), (unsigned long)self.originalStartLineNumber];
+}
+
+- (instancetype)initWithCommitOID:(GTOID *)commitOID lineRange:(NSRange)lineRange originalStartLineNumber:(NSUInteger)originalStartLineNumber {
+	NSParameterAssert(commitOID != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_commitOID = commitOID;
+	_lineRange = lineRange;
+	_originalStartLineNumber = originalStartLineNumber;
+
+	return self;
+}
+
+@end
@@ -0,0 +1,50 @@
+//
+//  GTBlobSketch.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// The number of MinHash values in a sketch.
+enum {
+	GTBlobSketchHashCount = 64,
+};
+
+// A compact summary of a blob's contents, for finding similar blobs without
+// reading them again.
+//
+// Contents are split into chunks, as git does when scoring renames: each line,
+// or each 64 bytes of a long line. A sketch keeps the hash and size of every
+// distinct chunk, which is enough to compute git's similarity score, and the
+// smallest value of each of `GTBlobSketchHashCount` hash functions over them,
+// a MinHash signature. The fraction of signature values two sketches share
+// estimates how much of their chunks they share.
+@interface GTBlobSketch : NSObject
+
+// The size of the blob, in bytes.
+@property (nonatomic, readonly) NSUInteger size;
+
+// Whether the blob has no chunks at all.
+@property (nonatomic, readonly, getter = isEmpty) BOOL empty;
+
+// The `GTBlobSketchHashCount` MinHash values. Only valid as long as the
+// receiver.
+@property (nonatomic, readonly) const uint32_t *minHashes;
+
+// Roughly how many bytes the receiver takes up, for caching it.
+@property (nonatomic, readonly) NSUInteger cost;
+
+// Sketch some contents.
+//
+// bytes  - The contents. May be NULL if `length` is 0.
+// length - The number of bytes in `bytes`.
+- (id)initWithBytes:(const void *)bytes length:(NSUInteger)length;
+
+// How similar the blobs are, from 0 to 100: the bytes of the chunks they have
+// in common, as a percentage of the size of the larger blob.
+- (NSUInteger)similarityToSketch:(GTBlobSketch *)otherSketch;
+
+@end
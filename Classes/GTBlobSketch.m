@@ -0,0 +1,153 @@
+//
+//  GTBlobSketch.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTBlobSketch.h"
+
+// The longest a chunk gets before it's split, as in git's diffcore-delta.c.
+static const NSUInteger GTBlobSketchMaximumChunkLength = 64;
+
+// A distinct chunk, and how many bytes of the blob are copies of it.
+typedef struct {
+	uint32_t hash;
+	uint32_t byteCount;
+} GTBlobSketchChunk;
+
+static int GTBlobSketchCompareChunks(const void *a, const void *b) {
+	uint32_t hash1 = ((const GTBlobSketchChunk *)a)->hash;
+	uint32_t hash2 = ((const GTBlobSketchChunk *)b)->hash;
+	return (hash1 < hash2 ? -1 : (hash1 > hash2 ? 1 : 0));
+}
+
+// Murmur3's finalizer, which spreads every input bit over the output.
+static inline uint32_t GTBlobSketchMix(uint32_t value) {
+	value ^= value >> 16;
+	value *= 0x85ebca6b;
+	value ^= value >> 13;
+	value *= 0xc2b2ae35;
+	value ^= value >> 16;
+	return value;
+}
+
+@interface GTBlobSketch () {
+	uint32_t _minHashes[GTBlobSketchHashCount];
+}
+
+// The chunks, as GTBlobSketchChunks sorted by hash.
+@property (nonatomic, readonly, strong) NSData *chunks;
+
+@end
+
+@implementation GTBlobSketch
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> size: %lu, chunks: %lu", NSStringFromClass([self class]), self, (unsigned long)self.size, (unsigned long)(self.chunks.length / sizeof(GTBlobSketchChunk))];
+}
+
+#pragma mark Lifecycle
+
+- (id)initWithBytes:(const void *)bytes length:(NSUInteger)length {
+	self = [super init];
+	if (self == nil) return nil;
+
+	_size = length;
+
+	NSUInteger capacity = length / 32 + 16;
+	GTBlobSketchChunk *chunkBytes = malloc(capacity * sizeof(*chunkBytes));
+	NSUInteger chunkCount = 0;
+
+	const uint8_t *content = bytes;
+	NSUInteger offset = 0;
+	while (offset < length) {
+		NSUInteger start = offset;
+		uint32_t hash = 2166136261u;
+		while (offset < length && offset - start < GTBlobSketchMaximumChunkLength) {
+			uint8_t byte = content[offset++];
+			hash = (hash ^ byte) * 16777619u;
+			if (byte == '\n') break;
+		}
+
+		if (chunkCount == capacity) {
+			capacity *= 2;
+			chunkBytes = realloc(chunkBytes, capacity * sizeof(*chunkBytes));
+		}
+
+		chunkBytes[chunkCount++] = (GTBlobSketchChunk){ .hash = hash, .byteCount = (uint32_t)(offset - start) };
+	}
+
+	qsort(chunkBytes, chunkCount, sizeof(*chunkBytes), GTBlobSketchCompareChunks);
+
+	NSUInteger uniqueCount = 0;
+	for (NSUInteger i = 0; i < chunkCount; i++) {
+		if (uniqueCount > 0 && chunkBytes[uniqueCount - 1].hash == chunkBytes[i].hash) {
+			chunkBytes[uniqueCount - 1].byteCount += chunkBytes[i].byteCount;
+		} else {
+			chunkBytes[uniqueCount++] = chunkBytes[i];
+		}
+	}
+
+	_chunks = [NSData dataWithBytes:chunkBytes length:uniqueCount * sizeof(*chunkBytes)];
+	_empty = (uniqueCount == 0);
+
+	for (NSUInteger i = 0; i < GTBlobSketchHashCount; i++) {
+		_minHashes[i] = UINT32_MAX;
+	}
+
+	for (NSUInteger c = 0; c < uniqueCount; c++) {
+		for (NSUInteger i = 0; i < GTBlobSketchHashCount; i++) {
+			uint32_t value = GTBlobSketchMix(chunkBytes[c].hash ^ (uint32_t)((i + 1) * 0x9e3779b9u));
+			if (value < _minHashes[i]) _minHashes[i] = value;
+		}
+	}
+
+	free(chunkBytes);
+
+	return self;
+}
+
+#pragma mark Properties
+
+- (const uint32_t *)minHashes {
+	return _minHashes;
+}
+
+- (NSUInteger)cost {
+	return sizeof(_minHashes) + self.chunks.length;
+}
+
+#pragma mark Similarity
+
+- (NSUInteger)similarityToSketch:(GTBlobSketch *)otherSketch {
+	NSParameterAssert(otherSketch != nil);
+
+	NSUInteger maximumSize = MAX(self.size, otherSketch.size);
+	if (maximumSize == 0) return 100;
+
+	const GTBlobSketchChunk *chunks = self.chunks.bytes;
+	const GTBlobSketchChunk *otherChunks = otherSketch.chunks.bytes;
+	NSUInteger count = self.chunks.length / sizeof(*chunks);
+	NSUInteger otherCount = otherSketch.chunks.length / sizeof(*otherChunks);
+
+	unsigned long long commonBytes = 0;
+	NSUInteger i = 0;
+	NSUInteger j = 0;
+	while (i < count && j < otherCount) {
+		if (chunks[i].hash < otherChunks[j].hash) {
+			i++;
+		} else if (chunks[i].hash > otherChunks[j].hash) {
+			j++;
+		} else {
+			commonBytes += MIN(chunks[i].byteCount, otherChunks[j].byteCount);
+			i++;
+			j++;
+		}
+	}
+
+	return (NSUInteger)(commonBytes * 100 / maximumSize);
+}
+
+@end
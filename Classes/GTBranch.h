@@ -28,6 +28,7 @@
 @class GTCommit;
 @class GTReference;
 @class GTRepository;
+@class GTOID;
 
 typedef enum {
     GTBranchTypeLocal = 1,
@@ -39,6 +40,8 @@ typedef enum {
 @property (nonatomic, readonly) NSString *name;
 @property (nonatomic, readonly) NSString *shortName;
 @property (nonatomic, readonly) NSString *sha;
+// The OID of the commit the branch points at.
+@property (nonatomic, readonly) GTOID *OID;
 @property (nonatomic, readonly) NSString *remoteName;
 @property (nonatomic, readonly) GTBranchType branchType;
 @property (nonatomic, readonly, strong) GTRepository *repository;
@@ -66,6 +69,9 @@ typedef enum {
 
 // Count all commits in this branch
 //
+// Counts are remembered by the repository's `commitCountCache`, so after the
+// first call only commits added since the last one are walked.
+//
 // error(out) - will be filled if an error occurs
 //
 // returns number of commits in the branch or NSNotFound if an error occurred
@@ -76,8 +82,39 @@ typedef enum {
 // returns the matched remote branch or nil if no match was found.
 - (GTBranch *)remoteBranchForRemoteName:(NSString *)remote;
 
+// Find the commits on the receiver which aren't on another branch.
+//
+// otherBranch - The branch to compare against. If nil, an empty array is
+//               returned.
+// error(out)  - will be filled if an error occurs
+//
+// returns the commits in topological order, or nil if an error occurred.
 - (NSArray *)uniqueCommitsRelativeToBranch:(GTBranch *)otherBranch error:(NSError **)error;
 
+// Calculate how far the receiver and another branch have diverged.
+//
+// Each side is found with a single walk which pushes one tip and hides the
+// other, so only the commits which differ are visited and none of them are
+// looked up as GTCommits.
+//
+// otherBranch     - The branch to compare against. Cannot be nil.
+// ahead(out)      - Set to the number of commits on the receiver which aren't
+//                   on `otherBranch`. May be NULL.
+// behind(out)     - Set to the number of commits on `otherBranch` which aren't
+//                   on the receiver. May be NULL.
+// aheadOIDs(out)  - If not NULL, set to the GTOIDs of the commits counted in
+//                   `ahead`, in topological order.
+// behindOIDs(out) - If not NULL, set to the GTOIDs of the commits counted in
+//                   `behind`, in topological order.
+// error(out)      - will be filled if an error occurs
+//
+// returns NO if an error occurred, YES otherwise.
+- (BOOL)aheadBehindRelativeToBranch:(GTBranch *)otherBranch ahead:(NSUInteger *)ahead behind:(NSUInteger *)behind aheadOIDs:(NSArray **)aheadOIDs behindOIDs:(NSArray **)behindOIDs error:(NSError **)error;
+
+// Calls -aheadBehindRelativeToBranch:ahead:behind:aheadOIDs:behindOIDs:error:
+// without asking for the OIDs.
+- (BOOL)aheadBehindRelativeToBranch:(GTBranch *)otherBranch ahead:(NSUInteger *)ahead behind:(NSUInteger *)behind error:(NSError **)error;
+
 // Deletes the local branch and nils out the reference.
 - (BOOL)deleteWithError:(NSError **)error;
 
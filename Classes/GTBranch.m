@@ -29,6 +29,9 @@
 #import "GTRepository.h"
 #import "GTCommit.h"
 #import "NSError+Git.h"
+#import "GTOID.h"
+#import "GTCommitGraph.h"
+#import "GTCommitCountCache.h"
 
 
 @interface GTBranch ()
@@ -46,11 +49,11 @@
 	if (otherBranch == self) return YES;
 	if (![otherBranch isKindOfClass:self.class]) return NO;
 
-	return [self.name isEqual:otherBranch.name] && [self.sha isEqual:otherBranch.sha];
+	return [self.name isEqual:otherBranch.name] && [self.OID isEqual:otherBranch.OID];
 }
 
 - (NSUInteger)hash {
-	return self.name.hash ^ self.sha.hash;
+	return self.name.hash ^ self.OID.hash;
 }
 
 
@@ -116,6 +119,10 @@
 	return self.reference.target;
 }
 
+- (GTOID *)OID {
+	return self.reference.targetOID;
+}
+
 - (NSString *)remoteName {
 	if([self branchType] == GTBranchTypeLocal) {
 		return nil;
@@ -131,16 +138,23 @@
 }
 
 - (GTCommit *)targetCommitAndReturnError:(NSError **)error {
-	if (self.sha == nil) {
+	GTOID *oid = self.OID;
+	if (oid == nil) {
 		if (error != NULL) *error = GTReference.invalidReferenceError;
 		return nil;
 	}
 
-	return (GTCommit *)[self.repository lookupObjectBySha:self.sha objectType:GTObjectTypeCommit error:error];
+	return (GTCommit *)[self.repository lookupObjectByOID:oid objectType:GTObjectTypeCommit error:error];
 }
 
 - (NSUInteger)numberOfCommitsWithError:(NSError **)error {
-	return [self.repository.enumerator countFromSha:self.sha error:error];
+	GTOID *oid = self.OID;
+	if (oid == nil) {
+		if (error != NULL) *error = GTReference.invalidReferenceError;
+		return NSNotFound;
+	}
+
+	return [self.repository.commitCountCache numberOfCommitsFromOID:oid key:self.name error:error];
 }
 
 - (GTBranchType)branchType {
@@ -173,6 +187,21 @@
 + (GTCommit *)mergeBaseOf:(GTBranch *)branch1 andBranch:(GTBranch *)branch2 error:(NSError **)error {
 	NSAssert2([branch1.repository isEqual:branch2.repository], @"Both branches must be in the same repository: %@ vs. %@", branch1.repository, branch2.repository);
 	
+	GTCommitGraph *graph = branch1.repository.commitGraph;
+	if(graph != nil) {
+		GTOID *oid1 = branch1.OID;
+		GTOID *oid2 = branch2.OID;
+		if(oid1 == nil || oid2 == nil) {
+			if(error != NULL) *error = GTReference.invalidReferenceError;
+			return nil;
+		}
+		
+		GTOID *mergeBaseOID = [graph mergeBaseOfOID:oid1 andOID:oid2 error:error];
+		if(mergeBaseOID == nil) return nil;
+		
+		return (GTCommit *)[branch1.repository lookupObjectByOID:mergeBaseOID objectType:GTObjectTypeCommit error:error];
+	}
+	
 	git_oid mergeBase;
 	int errorCode = git_merge_base(&mergeBase, branch1.repository.git_repository, (git_oid *) branch1.reference.oid, (git_oid *) branch2.reference.oid);
 	if(errorCode < GIT_OK) {
@@ -189,34 +218,70 @@
 - (NSArray *)uniqueCommitsRelativeToBranch:(GTBranch *)otherBranch error:(NSError **)error {
 	if(otherBranch == nil) return [NSArray array];
 	
-	GTCommit *mergeBase = [[self class] mergeBaseOf:self andBranch:otherBranch error:error];
-	if(mergeBase == nil) return nil;
+	NSArray *aheadOIDs = nil;
+	BOOL success = [self aheadBehindRelativeToBranch:otherBranch ahead:NULL behind:NULL aheadOIDs:&aheadOIDs behindOIDs:NULL error:error];
+	if(!success) return nil;
 	
-	GTEnumerator *enumerator = self.repository.enumerator;
-	if(enumerator == nil) return nil;
+	return [self.repository lookupObjectsWithOIDs:aheadOIDs objectType:GTObjectTypeCommit error:error];
+}
+
+- (BOOL)aheadBehindRelativeToBranch:(GTBranch *)otherBranch ahead:(NSUInteger *)ahead behind:(NSUInteger *)behind error:(NSError **)error {
+	return [self aheadBehindRelativeToBranch:otherBranch ahead:ahead behind:behind aheadOIDs:NULL behindOIDs:NULL error:error];
+}
+
+- (BOOL)aheadBehindRelativeToBranch:(GTBranch *)otherBranch ahead:(NSUInteger *)ahead behind:(NSUInteger *)behind aheadOIDs:(NSArray **)aheadOIDs behindOIDs:(NSArray **)behindOIDs error:(NSError **)error {
+	NSParameterAssert(otherBranch != nil);
+	NSAssert2([self.repository isEqual:otherBranch.repository], @"Both branches must be in the same repository: %@ vs. %@", self.repository, otherBranch.repository);
 	
-	NSArray * (^allCommitsFromSha)(NSString *, NSError **) = ^NSArray *(NSString *sha, NSError **localError) {
-		[enumerator reset];
-		[enumerator setOptions:GTEnumeratorOptionsTopologicalSort];
-		
-		BOOL success = [enumerator push:sha error:localError];
-		if(!success) return nil;
-		
-		NSMutableArray *commits = [NSMutableArray array];
-		GTCommit *currentCommit = [enumerator nextObjectWithError:localError];
-		while(currentCommit != nil && ![currentCommit.sha isEqualToString:mergeBase.sha]) {
-			[commits addObject:currentCommit];
-			currentCommit = [enumerator nextObjectWithError:localError];
-		}
-		
-		return commits;
-	};
+	GTOID *oid = self.OID;
+	GTOID *otherOID = otherBranch.OID;
+	if(oid == nil || otherOID == nil) {
+		if(error != NULL) *error = GTReference.invalidReferenceError;
+		return NO;
+	}
+	
+	if(ahead != NULL || aheadOIDs != NULL) {
+		NSUInteger count = [self.class countCommitsFromOID:oid hidingOID:otherOID inRepository:self.repository OIDs:aheadOIDs error:error];
+		if(count == NSNotFound) return NO;
+		if(ahead != NULL) *ahead = count;
+	}
+	
+	if(behind != NULL || behindOIDs != NULL) {
+		NSUInteger count = [self.class countCommitsFromOID:otherOID hidingOID:oid inRepository:self.repository OIDs:behindOIDs error:error];
+		if(count == NSNotFound) return NO;
+		if(behind != NULL) *behind = count;
+	}
+	
+	return YES;
+}
+
+// Walk the commits reachable from `oid` but not from `hiddenOID`. If `OIDs`
+// isn't NULL, it's set to their OIDs in topological order. Otherwise they're
+// only counted, and the walk doesn't bother sorting.
++ (NSUInteger)countCommitsFromOID:(GTOID *)oid hidingOID:(GTOID *)hiddenOID inRepository:(GTRepository *)repository OIDs:(NSArray **)OIDs error:(NSError **)error {
+	GTEnumerator *enumerator = [GTEnumerator enumeratorWithRepository:repository error:error];
+	if(enumerator == nil) return NSNotFound;
+	
+	if(OIDs == NULL) return [enumerator countFromOID:oid hidingOIDs:@[ hiddenOID ] error:error];
+	
+	[enumerator setOptions:GTEnumeratorOptionsTopologicalSort];
+	if(![enumerator pushOID:oid error:error]) return NSNotFound;
+	if(![enumerator skipCommitWithOID:hiddenOID error:error]) return NSNotFound;
+	
+	NSMutableArray *walkedOIDs = [NSMutableArray array];
+	NSError *walkError = nil;
+	GTOID *nextOID = nil;
+	while((nextOID = [enumerator nextOIDWithError:&walkError]) != nil) {
+		[walkedOIDs addObject:nextOID];
+	}
+	
+	if(walkError != nil) {
+		if(error != NULL) *error = walkError;
+		return NSNotFound;
+	}
 	
-	NSArray *localCommits = allCommitsFromSha(self.sha, error);
-	NSArray *otherCommits = allCommitsFromSha(otherBranch.sha, error);
-	NSMutableArray *uniqueCommits = [localCommits mutableCopy];
-	[uniqueCommits removeObjectsInArray:otherCommits];
-	return uniqueCommits;
+	*OIDs = walkedOIDs;
+	return walkedOIDs.count;
 }
 
 - (BOOL)deleteWithError:(NSError **)error {
@@ -0,0 +1,22 @@
+//
+//  GTCachedDiffDelta+Private.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCachedDiffDelta.h"
+
+@interface GTCachedDiffDelta ()
+
+// Copies everything out of a delta, so it can outlive its diff.
+//
+// delta        - The delta to copy. Cannot be nil.
+// includePatch - Whether to generate the delta's patch and count its lines.
+// error(out)   - will be filled if an error occurs
+//
+// returns the cached delta, or nil if its patch couldn't be formatted.
+- (id)initWithDiffDelta:(GTDiffDelta *)delta includePatch:(BOOL)includePatch error:(NSError **)error;
+
+@end
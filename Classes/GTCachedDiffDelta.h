@@ -0,0 +1,45 @@
+//
+//  GTCachedDiffDelta.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "GTDiffDelta.h"
+
+@class GTDiffFile;
+
+// A delta of a diff, as kept by a `GTDiffCache`. Unlike a `GTDiffDelta`, it
+// doesn't need the diff it came from, so it holds everything it knows.
+@interface GTCachedDiffDelta : NSObject
+
+// The type of change that this delta represents.
+@property (nonatomic, readonly) GTDiffDeltaType type;
+
+// The file to the "left" of the diff.
+@property (nonatomic, readonly, strong) GTDiffFile *oldFile;
+
+// The file to the "right" of the diff.
+@property (nonatomic, readonly, strong) GTDiffFile *newFile;
+
+// How similar the files are, from 0 to 100, for renames and copies.
+@property (nonatomic, readonly) NSUInteger similarity;
+
+// Whether the file(s) are to be treated as binary.
+@property (nonatomic, readonly, getter = isBinary) BOOL binary;
+
+// The delta's patch, as in `git diff`, or nil if patches weren't cached.
+@property (nonatomic, readonly, copy) NSData *patchData;
+
+// The number of added lines, or 0 if patches weren't cached.
+@property (nonatomic, readonly) NSUInteger addedLinesCount;
+
+// The number of deleted lines, or 0 if patches weren't cached.
+@property (nonatomic, readonly) NSUInteger deletedLinesCount;
+
+// Designated initializer.
+- (id)initWithType:(GTDiffDeltaType)type oldFile:(GTDiffFile *)oldFile newFile:(GTDiffFile *)newFile similarity:(NSUInteger)similarity binary:(BOOL)binary patchData:(NSData *)patchData addedLinesCount:(NSUInteger)addedLinesCount deletedLinesCount:(NSUInteger)deletedLinesCount;
+
+@end
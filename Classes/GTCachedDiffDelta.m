@@ -0,0 +1,69 @@
+//
+//  GTCachedDiffDelta.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCachedDiffDelta+Private.h"
+#import "GTDiffFile.h"
+#import "NSError+Git.h"
+
+@implementation GTCachedDiffDelta
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> type: %d, oldFile: %@, newFile: %@", NSStringFromClass([self class]), self, (int)self.type, self.oldFile.path, self.newFile.path];
+}
+
+- (id)initWithType:(GTDiffDeltaType)type oldFile:(GTDiffFile *)oldFile newFile:(GTDiffFile *)newFile similarity:(NSUInteger)similarity binary:(BOOL)binary patchData:(NSData *)patchData addedLinesCount:(NSUInteger)addedLinesCount deletedLinesCount:(NSUInteger)deletedLinesCount {
+	NSParameterAssert(oldFile != nil);
+	NSParameterAssert(newFile != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_type = type;
+	_oldFile = oldFile;
+	_newFile = newFile;
+	_similarity = similarity;
+	_binary = binary;
+	_patchData = [patchData copy];
+	_addedLinesCount = addedLinesCount;
+	_deletedLinesCount = deletedLinesCount;
+
+	return self;
+}
+
+- (id)initWithDiffDelta:(GTDiffDelta *)delta includePatch:(BOOL)includePatch error:(NSError **)error {
+	NSParameterAssert(delta != nil);
+
+	const git_diff_delta *gitDelta = delta.git_diff_delta;
+
+	NSData *patchData = nil;
+	NSUInteger addedLinesCount = 0;
+	NSUInteger deletedLinesCount = 0;
+	if (includePatch) {
+		char *patchString = NULL;
+		int gitError = git_diff_patch_to_str(&patchString, delta.git_diff_patch);
+		if (gitError != GIT_OK) {
+			if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to format patch."];
+			return nil;
+		}
+
+		patchData = [NSData dataWithBytes:patchString length:strlen(patchString)];
+		free(patchString);
+
+		addedLinesCount = delta.addedLinesCount;
+		deletedLinesCount = delta.deletedLinesCount;
+	}
+
+	// Without a patch, this is only known if the files said so.
+	BOOL binary = (includePatch ? delta.binary : gitDelta->binary == 1);
+
+	GTDiffFile *oldFile = [[GTDiffFile alloc] initWithGitDiffFile:gitDelta->old_file];
+	GTDiffFile *newFile = [[GTDiffFile alloc] initWithGitDiffFile:gitDelta->new_file];
+	return [self initWithType:(GTDiffDeltaType)gitDelta->status oldFile:oldFile newFile:newFile similarity:gitDelta->similarity binary:binary patchData:patchData addedLinesCount:addedLinesCount deletedLinesCount:deletedLinesCount];
+}
+
+@end
@@ -0,0 +1,37 @@
+//
+//  GTChangedPathIndex+Private.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTChangedPathIndex.h"
+#import "git2.h"
+
+// A path, hashed for testing against filters. Hashing a path once and testing
+// the key against many filters is much cheaper than hashing it every time.
+typedef struct {
+	uint32_t hash1;
+	uint32_t hash2;
+} GTChangedPathKey;
+
+GTChangedPathKey GTChangedPathKeyMake(const char *path, size_t length);
+
+typedef enum {
+	// The commit isn't in the index.
+	GTChangedPathFilterResultNotIndexed,
+
+	// The commit didn't change any of the paths.
+	GTChangedPathFilterResultDefinitelyNot,
+
+	// The commit may have changed one of the paths.
+	GTChangedPathFilterResultMaybe,
+} GTChangedPathFilterResult;
+
+@interface GTChangedPathIndex ()
+
+// Test a commit's filter against several keys at once.
+- (GTChangedPathFilterResult)filterResultForGitOid:(const git_oid *)oid keys:(const GTChangedPathKey *)keys count:(NSUInteger)count;
+
+@end
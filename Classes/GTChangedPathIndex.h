@@ -0,0 +1,90 @@
+//
+//  GTChangedPathIndex.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTRepository;
+@class GTOID;
+
+// Returned by -[GTChangedPathIndex initWithRepository:fileURL:error:] when the
+// file isn't a valid index. In GTGitErrorDomain, kept clear of libgit2's codes.
+static const NSInteger GTChangedPathIndexErrorCodeCorruptFile = -1002;
+
+// A persistent index of which paths each commit changed, relative to its first
+// parent (or to nothing, for root commits).
+//
+// Each commit gets a Bloom filter of the paths it changed, including every
+// directory leading to them. Asking whether a commit changed a path is
+// answered without reading any trees: a negative answer is always right, and a
+// positive one is right about 99% of the time. Commits which changed a great
+// many paths are marked as changing everything.
+//
+// Path limited walks (see -[GTRepository enumerateCommitsBeginningAtSha:
+// touchingPaths:error:usingBlock:]) use the repository's index, if it has one,
+// to skip comparing trees for most commits.
+//
+// This class is thread safe.
+@interface GTChangedPathIndex : NSObject
+
+// The repository the index is for.
+@property (nonatomic, readonly, unsafe_unretained) GTRepository *repository;
+
+// The file the index is loaded from and written to.
+@property (nonatomic, readonly, strong) NSURL *fileURL;
+
+// The number of commits in the index.
+@property (nonatomic, readonly) NSUInteger count;
+
+// Whether commits have been added since the index was loaded or written.
+@property (nonatomic, readonly) BOOL hasUnsavedChanges;
+
+// The file URL a repository's index is kept at by default:
+// `objectivegit/changed-paths` in its git directory.
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository;
+
+// Initializes the receiver, loading the index from `fileURL` if the file
+// exists.
+//
+// repository - The repository the index is for. Cannot be nil.
+// fileURL    - The file to load from and write to. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the index, or nil if the file exists but couldn't be read.
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error;
+
+// Add filters for every commit reachable from the given commits which doesn't
+// have one yet. This diffs each of those commits against its first parent, so
+// it can take a while the first time.
+//
+// oids       - An array of GTOIDs of commits. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns NO if an error occurred.
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error;
+
+// Write the index to `fileURL`, atomically.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns NO if an error occurred.
+- (BOOL)writeWithError:(NSError **)error;
+
+// Whether the index has a filter for a commit.
+- (BOOL)containsOID:(GTOID *)oid;
+
+// Whether a commit may have changed a path.
+//
+// oid  - The commit. Cannot be nil.
+// path - A file or directory path, relative to the root of the repository.
+//        Cannot be nil.
+//
+// returns NO only if the commit definitely didn't change the path. Commits
+// which aren't in the index may have changed anything.
+- (BOOL)commitOID:(GTOID *)oid mayHaveChangedPath:(NSString *)path;
+
+@end
@@ -0,0 +1,491 @@
+//
+//  GTChangedPathIndex.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTChangedPathIndex.h"
+#import "GTChangedPathIndex+Private.h"
+#import "GTCommitGraph.h"
+#import "GTCommitGraph+Private.h"
+#import "GTIndexFile.h"
+#import "GTRepository.h"
+#import "GTRepository+Private.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+// The file format (see GTIndexFile.h), all integers big-endian:
+//
+//   "GTCP"                          magic
+//   uint32                          version
+//   uint32                          commit count (N)
+//   N * 20 bytes                    commit oids, sorted
+//   N * uint32                      end offsets of each filter in the filter data
+//   filter data
+//   20 bytes                        SHA1 of everything above
+static const char GTChangedPathIndexMagic[4] = { 'G', 'T', 'C', 'P' };
+static const uint32_t GTChangedPathIndexVersion = 1;
+static const NSUInteger GTChangedPathIndexHeaderLength = 12;
+
+// Filters are sized for this many bits per changed path, and tested with this
+// many hashes, for a false positive rate of about 1%.
+static const NSUInteger GTChangedPathIndexBitsPerPath = 10;
+static const NSUInteger GTChangedPathIndexHashCount = 7;
+
+// Commits which changed more paths than this get a filter which matches
+// everything, rather than a huge one.
+static const NSUInteger GTChangedPathIndexMaximumPathCount = 512;
+
+// The seeds for the two hashes each key is made from.
+static const uint32_t GTChangedPathIndexSeed1 = 0x293ae76f;
+static const uint32_t GTChangedPathIndexSeed2 = 0x7e646e2c;
+
+static uint32_t GTChangedPathMurmur3(const uint8_t *bytes, size_t length, uint32_t seed) {
+	const uint32_t c1 = 0xcc9e2d51;
+	const uint32_t c2 = 0x1b873593;
+	uint32_t hash = seed;
+
+	size_t blockCount = length / 4;
+	for (size_t i = 0; i < blockCount; i++) {
+		uint32_t k = (uint32_t)bytes[4 * i] | ((uint32_t)bytes[4 * i + 1] << 8) | ((uint32_t)bytes[4 * i + 2] << 16) | ((uint32_t)bytes[4 * i + 3] << 24);
+		k *= c1;
+		k = (k << 15) | (k >> 17);
+		k *= c2;
+
+		hash ^= k;
+		hash = (hash << 13) | (hash >> 19);
+		hash = hash * 5 + 0xe6546b64;
+	}
+
+	const uint8_t *tail = bytes + blockCount * 4;
+	uint32_t k = 0;
+	switch (length & 3) {
+		case 3: k ^= (uint32_t)tail[2] << 16;
+		case 2: k ^= (uint32_t)tail[1] << 8;
+		case 1:
+			k ^= tail[0];
+			k *= c1;
+			k = (k << 15) | (k >> 17);
+			k *= c2;
+			hash ^= k;
+	}
+
+	hash ^= (uint32_t)length;
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+GTChangedPathKey GTChangedPathKeyMake(const char *path, size_t length) {
+	return (GTChangedPathKey){
+		.hash1 = GTChangedPathMurmur3((const uint8_t *)path, length, GTChangedPathIndexSeed1),
+		.hash2 = GTChangedPathMurmur3((const uint8_t *)path, length, GTChangedPathIndexSeed2),
+	};
+}
+
+static inline NSUInteger GTChangedPathKeyBit(GTChangedPathKey key, NSUInteger hashIndex, NSUInteger bitCount) {
+	return (key.hash1 + hashIndex * key.hash2) % bitCount;
+}
+
+// An empty filter means the commit changed nothing, and a one byte filter with
+// every bit set means it changed too much to keep track of.
+static BOOL GTChangedPathFilterContainsKey(const uint8_t *filter, NSUInteger length, GTChangedPathKey key) {
+	if (length == 0) return NO;
+
+	NSUInteger bitCount = length * 8;
+	for (NSUInteger i = 0; i < GTChangedPathIndexHashCount; i++) {
+		NSUInteger bit = GTChangedPathKeyBit(key, i, bitCount);
+		if ((filter[bit / 8] & (1 << (bit % 8))) == 0) return NO;
+	}
+
+	return YES;
+}
+
+@interface GTChangedPathIndex () {
+	// The loaded file, and pointers into it.
+	NSData *_loadedData;
+	NSUInteger _loadedCount;
+	const uint8_t *_loadedOids;
+	const uint8_t *_loadedEndOffsets;
+	const uint8_t *_loadedFilters;
+}
+
+// Filters added since loading, keyed by GTOID.
+@property (nonatomic, strong) NSMutableDictionary *addedFilters;
+
+@property (nonatomic, assign) BOOL hasUnsavedChanges;
+
+@end
+
+@implementation GTChangedPathIndex
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> fileURL: %@, count: %lu", NSStringFromClass([self class]), self, self.fileURL, (unsigned long)self.count];
+}
+
+#pragma mark API
+
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository {
+	return GTIndexFileURLForRepository(repository, @"changed-paths", NO);
+}
+
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error {
+	NSParameterAssert(repository != nil);
+	NSParameterAssert(fileURL != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_repository = repository;
+	_fileURL = [fileURL copy];
+	_addedFilters = [NSMutableDictionary dictionary];
+
+	NSData *data = nil;
+	if (!GTIndexFileReadData(fileURL, &data, error)) return nil;
+	if (data != nil && ![self loadData:data error:error]) return nil;
+
+	return self;
+}
+
+- (NSUInteger)count {
+	@synchronized (self) {
+		return _loadedCount + self.addedFilters.count;
+	}
+}
+
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error {
+	NSParameterAssert(oids != nil);
+
+	GTCommitGraph *graph = [self.repository walkableCommitGraphWithError:error];
+	if (graph == nil) return NO;
+
+	// Collect what needs diffing under the graph's lock, and diff outside it.
+	NSMutableData *pendingData = [NSMutableData data];
+	BOOL success = YES;
+
+	[graph lock];
+
+	NSUInteger graphCount = 0;
+	GTCommitGraphPosition *starts = malloc(MAX(oids.count, (NSUInteger)1) * sizeof(*starts));
+	for (NSUInteger i = 0; i < oids.count; i++) {
+		starts[i] = [graph addGitOid:[oids[i] git_oid] error:error];
+		if (starts[i] == GTCommitGraphPositionNotFound) {
+			success = NO;
+			break;
+		}
+	}
+
+	if (success) {
+		graphCount = graph.positionCount;
+		uint8_t *visited = calloc(graphCount, sizeof(*visited));
+		GTCommitGraphPosition *stack = malloc(MAX(graphCount, (NSUInteger)1) * sizeof(*stack));
+		NSUInteger stackCount = 0;
+
+		for (NSUInteger i = 0; i < oids.count; i++) {
+			if (visited[starts[i]]) continue;
+
+			visited[starts[i]] = 1;
+			stack[stackCount++] = starts[i];
+		}
+
+		while (stackCount > 0) {
+			GTCommitGraphPosition position = stack[--stackCount];
+			const git_oid *oid = [graph gitOidAtPosition:position];
+
+			NSUInteger parentCount = 0;
+			const GTCommitGraphPosition *parents = [graph parentPositionsAtPosition:position count:&parentCount];
+
+			if (![self containsGitOid:oid]) {
+				// Each pending commit is its oid, its tree and its first parent's
+				// tree (or zeros).
+				git_oid parentTree;
+				memset(&parentTree, 0, sizeof(parentTree));
+				if (parentCount > 0) git_oid_cpy(&parentTree, [graph treeGitOidAtPosition:parents[0]]);
+
+				[pendingData appendBytes:oid length:sizeof(*oid)];
+				[pendingData appendBytes:[graph treeGitOidAtPosition:position] length:sizeof(git_oid)];
+				[pendingData appendBytes:&parentTree length:sizeof(parentTree)];
+			}
+
+			for (NSUInteger i = 0; i < parentCount; i++) {
+				if (visited[parents[i]]) continue;
+
+				visited[parents[i]] = 1;
+				stack[stackCount++] = parents[i];
+			}
+		}
+
+		free(visited);
+		free(stack);
+	}
+
+	free(starts);
+	[graph unlock];
+
+	if (!success) return NO;
+
+	const git_oid *pending = pendingData.bytes;
+	NSUInteger pendingCount = pendingData.length / (3 * sizeof(git_oid));
+	for (NSUInteger i = 0; i < pendingCount; i++) {
+		@autoreleasepool {
+			const git_oid *oid = &pending[3 * i];
+			const git_oid *parentTree = &pending[3 * i + 2];
+			NSData *filter = [self filterForTreeGitOid:&pending[3 * i + 1] parentTreeGitOid:(git_oid_iszero(parentTree) ? NULL : parentTree) error:error];
+			if (filter == nil) return NO;
+
+			@synchronized (self) {
+				self.addedFilters[[GTOID oidWithGitOid:oid]] = filter;
+				self.hasUnsavedChanges = YES;
+			}
+		}
+	}
+
+	return YES;
+}
+
+- (BOOL)writeWithError:(NSError **)error {
+	NSMutableData *data = nil;
+	@synchronized (self) {
+		data = [self serializedData];
+	}
+
+	if (!GTIndexFileWriteData(data, self.fileURL, error)) return NO;
+
+	@synchronized (self) {
+		self.hasUnsavedChanges = NO;
+	}
+
+	return YES;
+}
+
+- (BOOL)containsOID:(GTOID *)oid {
+	NSParameterAssert(oid != nil);
+
+	return [self containsGitOid:oid.git_oid];
+}
+
+- (BOOL)commitOID:(GTOID *)oid mayHaveChangedPath:(NSString *)path {
+	NSParameterAssert(oid != nil);
+	NSParameterAssert(path != nil);
+
+	NSData *pathData = [path dataUsingEncoding:NSUTF8StringEncoding];
+	GTChangedPathKey key = GTChangedPathKeyMake(pathData.bytes, pathData.length);
+
+	return [self filterResultForGitOid:oid.git_oid keys:&key count:1] != GTChangedPathFilterResultDefinitelyNot;
+}
+
+#pragma mark Filters
+
+- (GTChangedPathFilterResult)filterResultForGitOid:(const git_oid *)oid keys:(const GTChangedPathKey *)keys count:(NSUInteger)count {
+	const uint8_t *filter = NULL;
+	NSUInteger length = 0;
+
+	@synchronized (self) {
+		if (![self getFilter:&filter length:&length forGitOid:oid]) return GTChangedPathFilterResultNotIndexed;
+
+		for (NSUInteger i = 0; i < count; i++) {
+			if (GTChangedPathFilterContainsKey(filter, length, keys[i])) return GTChangedPathFilterResultMaybe;
+		}
+	}
+
+	return GTChangedPathFilterResultDefinitelyNot;
+}
+
+// Must be called while synchronized on the receiver. The filter is only valid
+// until then.
+- (BOOL)getFilter:(const uint8_t **)filter length:(NSUInteger *)length forGitOid:(const git_oid *)oid {
+	NSUInteger low = 0;
+	NSUInteger high = _loadedCount;
+	while (low < high) {
+		NSUInteger middle = low + (high - low) / 2;
+		int comparison = memcmp(_loadedOids + middle * GIT_OID_RAWSZ, oid->id, GIT_OID_RAWSZ);
+		if (comparison == 0) {
+			NSUInteger start = (middle == 0 ? 0 : GTIndexFileReadUInt32(_loadedEndOffsets + (middle - 1) * sizeof(uint32_t)));
+			NSUInteger end = GTIndexFileReadUInt32(_loadedEndOffsets + middle * sizeof(uint32_t));
+			*filter = _loadedFilters + start;
+			*length = end - start;
+			return YES;
+		} else if (comparison < 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	NSData *addedFilter = self.addedFilters[[GTOID oidWithGitOid:oid]];
+	if (addedFilter == nil) return NO;
+
+	*filter = addedFilter.bytes;
+	*length = addedFilter.length;
+	return YES;
+}
+
+- (BOOL)containsGitOid:(const git_oid *)oid {
+	@synchronized (self) {
+		const uint8_t *filter = NULL;
+		NSUInteger length = 0;
+		return [self getFilter:&filter length:&length forGitOid:oid];
+	}
+}
+
+static void GTChangedPathIndexAddPath(NSMutableSet *paths, const char *path) {
+	if (path == NULL) return;
+
+	// Every directory leading to a path changed too.
+	NSString *string = @(path);
+	while (string.length > 0 && ![paths containsObject:string]) {
+		[paths addObject:string];
+		string = [string stringByDeletingLastPathComponent];
+	}
+}
+
+- (NSData *)filterForTreeGitOid:(const git_oid *)treeOid parentTreeGitOid:(const git_oid *)parentTreeOid error:(NSError **)error {
+	git_repository *repository = self.repository.git_repository;
+
+	git_tree *tree = NULL;
+	git_tree *parentTree = NULL;
+	int gitError = git_tree_lookup(&tree, repository, treeOid);
+	if (gitError == GIT_OK && parentTreeOid != NULL) gitError = git_tree_lookup(&parentTree, repository, parentTreeOid);
+
+	git_diff_list *diff = NULL;
+	if (gitError == GIT_OK) gitError = git_diff_tree_to_tree(&diff, repository, parentTree, tree, NULL);
+
+	git_tree_free(tree);
+	git_tree_free(parentTree);
+
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to diff trees."];
+		return nil;
+	}
+
+	NSMutableSet *paths = [NSMutableSet set];
+	size_t deltaCount = git_diff_num_deltas(diff);
+	for (size_t i = 0; i < deltaCount && paths.count <= GTChangedPathIndexMaximumPathCount; i++) {
+		const git_diff_delta *delta = NULL;
+		if (git_diff_get_patch(NULL, &delta, diff, i) < GIT_OK) continue;
+
+		GTChangedPathIndexAddPath(paths, delta->old_file.path);
+		GTChangedPathIndexAddPath(paths, delta->new_file.path);
+	}
+
+	git_diff_list_free(diff);
+
+	if (paths.count > GTChangedPathIndexMaximumPathCount) {
+		uint8_t everything = 0xff;
+		return [NSData dataWithBytes:&everything length:1];
+	}
+
+	NSUInteger length = (paths.count * GTChangedPathIndexBitsPerPath + 7) / 8;
+	NSMutableData *filter = [NSMutableData dataWithLength:length];
+	uint8_t *bytes = filter.mutableBytes;
+	for (NSString *path in paths) {
+		const char *UTF8Path = path.UTF8String;
+		GTChangedPathKey key = GTChangedPathKeyMake(UTF8Path, strlen(UTF8Path));
+		for (NSUInteger i = 0; i < GTChangedPathIndexHashCount; i++) {
+			NSUInteger bit = GTChangedPathKeyBit(key, i, length * 8);
+			bytes[bit / 8] |= 1 << (bit % 8);
+		}
+	}
+
+	return filter;
+}
+
+#pragma mark Serialization
+
+// Must be called while synchronized on the receiver.
+- (NSMutableData *)serializedData {
+	// Merge the loaded entries, which are already sorted, with the added ones.
+	NSArray *addedOIDs = [self.addedFilters.allKeys sortedArrayUsingSelector:@selector(compare:)];
+	NSUInteger count = _loadedCount + addedOIDs.count;
+
+	NSMutableData *oids = [NSMutableData dataWithCapacity:count * GIT_OID_RAWSZ];
+	NSMutableData *endOffsets = [NSMutableData dataWithCapacity:count * sizeof(uint32_t)];
+	NSMutableData *filters = [NSMutableData data];
+
+	NSUInteger loadedIndex = 0;
+	NSUInteger addedIndex = 0;
+	while (loadedIndex < _loadedCount || addedIndex < addedOIDs.count) {
+		const uint8_t *loadedOid = (loadedIndex < _loadedCount ? _loadedOids + loadedIndex * GIT_OID_RAWSZ : NULL);
+		GTOID *addedOID = (addedIndex < addedOIDs.count ? addedOIDs[addedIndex] : nil);
+
+		BOOL takeLoaded = (addedOID == nil || (loadedOid != NULL && memcmp(loadedOid, addedOID.git_oid->id, GIT_OID_RAWSZ) < 0));
+		if (takeLoaded) {
+			NSUInteger start = (loadedIndex == 0 ? 0 : GTIndexFileReadUInt32(_loadedEndOffsets + (loadedIndex - 1) * sizeof(uint32_t)));
+			NSUInteger end = GTIndexFileReadUInt32(_loadedEndOffsets + loadedIndex * sizeof(uint32_t));
+
+			[oids appendBytes:loadedOid length:GIT_OID_RAWSZ];
+			[filters appendBytes:_loadedFilters + start length:end - start];
+			loadedIndex++;
+		} else {
+			[oids appendBytes:addedOID.git_oid->id length:GIT_OID_RAWSZ];
+			[filters appendData:self.addedFilters[addedOID]];
+			addedIndex++;
+		}
+
+		GTIndexFileAppendUInt32(endOffsets, (uint32_t)filters.length);
+	}
+
+	NSMutableData *data = GTIndexFileCreateData(GTChangedPathIndexMagic, GTChangedPathIndexVersion, GTChangedPathIndexHeaderLength + oids.length + endOffsets.length + filters.length + GIT_OID_RAWSZ);
+	GTIndexFileAppendUInt32(data, (uint32_t)count);
+	[data appendData:oids];
+	[data appendData:endOffsets];
+	[data appendData:filters];
+
+	return data;
+}
+
+- (NSError *)corruptFileError {
+	return GTIndexFileCorruptError(GTChangedPathIndexErrorCodeCorruptFile, @"The changed path index", self.fileURL);
+}
+
+// Only called from the initializer, before anyone else can see the receiver.
+- (BOOL)loadData:(NSData *)data error:(NSError **)error {
+	const uint8_t *bytes = data.bytes;
+	NSUInteger length = data.length;
+
+	if (GTIndexFileContentsLength(data, GTChangedPathIndexMagic, GTChangedPathIndexVersion) == 0 || length < GTChangedPathIndexHeaderLength + GIT_OID_RAWSZ) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	NSUInteger count = GTIndexFileReadUInt32(bytes + 8);
+	NSUInteger tableLength = GTChangedPathIndexHeaderLength + count * (GIT_OID_RAWSZ + sizeof(uint32_t));
+	if (length < tableLength + GIT_OID_RAWSZ) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	const uint8_t *endOffsets = bytes + GTChangedPathIndexHeaderLength + count * GIT_OID_RAWSZ;
+	NSUInteger filtersLength = (count == 0 ? 0 : GTIndexFileReadUInt32(endOffsets + (count - 1) * sizeof(uint32_t)));
+	if (length != tableLength + filtersLength + GIT_OID_RAWSZ) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	uint32_t previousEnd = 0;
+	for (NSUInteger i = 0; i < count; i++) {
+		uint32_t end = GTIndexFileReadUInt32(endOffsets + i * sizeof(uint32_t));
+		if (end < previousEnd) {
+			if (error != NULL) *error = self.corruptFileError;
+			return NO;
+		}
+
+		previousEnd = end;
+	}
+
+	_loadedData = data;
+	_loadedCount = count;
+	_loadedOids = bytes + GTChangedPathIndexHeaderLength;
+	_loadedEndOffsets = endOffsets;
+	_loadedFilters = bytes + tableLength;
+
+	return YES;
+}
+
+@end
@@ -37,7 +37,6 @@
 @interface GTCommit ()
 @property (nonatomic, strong) GTSignature *author;
 @property (nonatomic, strong) GTSignature *committer;
-@property (nonatomic, copy) NSArray *parents;
 @end
 
 
@@ -124,50 +123,52 @@
 	return [NSDate dateWithTimeIntervalSince1970:t];
 }
 
+// Cached commits are shared between threads, so the lazy getters are
+// synchronized.
 - (GTSignature *)author {
-	if (_author == nil) {
-		_author = [GTSignature signatureWithSignature:(git_signature *)git_commit_author(self.git_commit)];
+	@synchronized (self) {
+		if (_author == nil) {
+			_author = [GTSignature signatureWithSignature:(git_signature *)git_commit_author(self.git_commit)];
+		}
+		
+		return _author;
 	}
-	
-	return _author;
 }
 
 - (GTSignature *)committer {
-	if (_committer == nil) {
-		_committer = [GTSignature signatureWithSignature:(git_signature *)git_commit_committer(self.git_commit)];
+	@synchronized (self) {
+		if (_committer == nil) {
+			_committer = [GTSignature signatureWithSignature:(git_signature *)git_commit_committer(self.git_commit)];
+		}
+		return _committer;
 	}
-	return _committer;
 }
 
 - (GTTree *)tree {
-	git_tree *tree = NULL;
-	int gitError = git_commit_tree(&tree, self.git_commit);
-	if (gitError < GIT_OK) {
+	NSError *error = nil;
+	GTTree *tree = (GTTree *)[self.repository lookupObjectByOid:git_commit_tree_id(self.git_commit) objectType:GTObjectTypeTree error:&error];
+	if (tree == nil) {
 		// todo: might want to return this error (and change method signature)
-		GTLog("Failed to get tree with error code: %d", gitError);
-		return nil;
+		GTLog("Failed to get tree with error: %@", error);
 	}
-	
-	return (GTTree *)[GTObject objectWithObj:(git_object *)tree inRepository:self.repository];
+
+	return tree;
 }
 
+// The parents aren't kept, or a cached commit would keep its whole ancestry
+// alive. Looking them up again is a hit in the repository's object cache.
 - (NSArray *)parents {
-	if(_parents == nil) {
-		unsigned int numberOfParents = git_commit_parentcount(self.git_commit);
-		NSMutableArray *parents = [NSMutableArray arrayWithCapacity:numberOfParents];
-		
-		for (unsigned int i = 0; i < numberOfParents; i++) {
-			git_commit *parent = NULL;
-			int parentResult = git_commit_parent(&parent, self.git_commit, i);
-			if (parentResult != GIT_OK) continue;
+	unsigned int numberOfParents = git_commit_parentcount(self.git_commit);
+	NSMutableArray *parents = [NSMutableArray arrayWithCapacity:numberOfParents];
+	
+	for (unsigned int i = 0; i < numberOfParents; i++) {
+		GTCommit *parent = (GTCommit *)[self.repository lookupObjectByOid:git_commit_parent_id(self.git_commit, i) objectType:GTObjectTypeCommit error:NULL];
+		if (parent == nil) continue;
 
-			[parents addObject:(GTCommit *)[GTObject objectWithObj:(git_object *)parent inRepository:self.repository]];
-		}
-		
-		_parents = [parents copy];
+		[parents addObject:parent];
 	}
 	
-	return _parents;
+	return [parents copy];
 }
 
 @end
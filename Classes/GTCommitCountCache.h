@@ -0,0 +1,67 @@
+//
+//  GTCommitCountCache.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTRepository;
+@class GTOID;
+
+// A persistent cache of the number of commits reachable from branch tips.
+//
+// The cache remembers the last tip and count it computed for each branch.
+// When a branch's tip moves forward, the new count is the old count plus the
+// commits reachable from the new tip but not from the old one, so only the new
+// commits are walked. When the old tip is no longer an ancestor of the new one
+// (history was rewritten), the count is computed from scratch.
+//
+// Changes are written to disk shortly after they're made, batched together
+// and merged with whatever other processes have written since, so the cache
+// survives between processes without a write for every count. The file is
+// replaced atomically. Each repository has one (see -[GTRepository commitCountCache]),
+// which -[GTBranch numberOfCommitsWithError:] and
+// -[GTRepository numberOfCommitsInCurrentBranch:] go through.
+//
+// This class is thread safe.
+@interface GTCommitCountCache : NSObject
+
+// The repository the counts are for.
+@property (nonatomic, readonly, unsafe_unretained) GTRepository *repository;
+
+// The file the cache is loaded from and written to.
+@property (nonatomic, readonly, strong) NSURL *fileURL;
+
+// The file URL a repository's count cache is kept at by default:
+// `objectivegit/commit-counts.plist` in its git directory.
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository;
+
+// Initializes the receiver, loading the cache from `fileURL` if the file
+// exists. A file which can't be read is ignored, and replaced on the next
+// write.
+//
+// repository - The repository the counts are for. Cannot be nil.
+// fileURL    - The file to load from and write to. Cannot be nil.
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL;
+
+// Count the commits reachable from a branch tip.
+//
+// oid        - The OID of the branch's tip. Cannot be nil.
+// key        - The name the count is remembered under, usually the branch's
+//              reference name. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the number of commits or NSNotFound if an error occurred
+- (NSUInteger)numberOfCommitsFromOID:(GTOID *)oid key:(NSString *)key error:(NSError **)error;
+
+// Write any changes which haven't been written yet, and wait for them to be
+// written.
+- (void)flush;
+
+// Forget every count, and delete the file.
+- (void)removeAllCounts;
+
+@end
@@ -0,0 +1,253 @@
+//
+//  GTCommitCountCache.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCommitCountCache.h"
+#import "GTRepository.h"
+#import "GTEnumerator.h"
+#import "GTCommitGraph.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+// The file is a property list of the form:
+//
+//   { version: 1, branches: { <key>: { tip: <sha>, count: <number> } } }
+static NSString * const GTCommitCountCacheVersionKey = @"version";
+static NSString * const GTCommitCountCacheBranchesKey = @"branches";
+static NSString * const GTCommitCountCacheTipKey = @"tip";
+static NSString * const GTCommitCountCacheCountKey = @"count";
+static const NSInteger GTCommitCountCacheVersion = 1;
+
+// How long changes are held before they're written, so a burst of counts is
+// written once.
+static const NSTimeInterval GTCommitCountCacheFlushDelay = 1;
+
+@interface GTCommitCountCache () {
+	// A serial queue which every read and write of the file goes through.
+	dispatch_queue_t _writeQueue;
+}
+
+// Maps keys to dictionaries holding the tip and count. Only accessed while
+// synchronized on the receiver.
+@property (nonatomic, strong) NSMutableDictionary *branches;
+
+// The keys whose entries changed since the file was last written. Only
+// accessed while synchronized on the receiver.
+@property (nonatomic, strong) NSMutableSet *dirtyKeys;
+
+// Whether a flush has been scheduled on `_writeQueue` and hasn't started yet.
+// Only accessed while synchronized on the receiver.
+@property (nonatomic, assign, getter = isFlushScheduled) BOOL flushScheduled;
+
+@end
+
+@implementation GTCommitCountCache
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> fileURL: %@", NSStringFromClass([self class]), self, self.fileURL];
+}
+
+#pragma mark API
+
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository {
+	return [[repository.gitDirectoryURL URLByAppendingPathComponent:@"objectivegit" isDirectory:YES] URLByAppendingPathComponent:@"commit-counts.plist" isDirectory:NO];
+}
+
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL {
+	NSParameterAssert(repository != nil);
+	NSParameterAssert(fileURL != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_repository = repository;
+	_fileURL = [fileURL copy];
+	_branches = [[self.class branchesInFileAtURL:fileURL] mutableCopy];
+	_dirtyKeys = [NSMutableSet set];
+	_writeQueue = dispatch_queue_create("org.libgit2.objective-git.commit-count-cache", DISPATCH_QUEUE_SERIAL);
+
+	return self;
+}
+
+- (void)dealloc {
+	// Pending flushes retain the receiver, so there's nothing left to write.
+	#if !OS_OBJECT_USE_OBJC
+	dispatch_release(_writeQueue);
+	#endif
+}
+
+- (NSUInteger)numberOfCommitsFromOID:(GTOID *)oid key:(NSString *)key error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+	NSParameterAssert(key != nil);
+
+	NSDictionary *previousEntry = nil;
+	@synchronized (self) {
+		previousEntry = self.branches[key];
+
+		// Another branch may well be at the same tip.
+		if (![previousEntry[GTCommitCountCacheTipKey] isEqualToString:oid.sha]) {
+			for (NSDictionary *entry in self.branches.objectEnumerator) {
+				if ([entry[GTCommitCountCacheTipKey] isEqualToString:oid.sha]) {
+					[self setEntry:entry forKey:key];
+					return [entry[GTCommitCountCacheCountKey] unsignedIntegerValue];
+				}
+			}
+		} else {
+			return [previousEntry[GTCommitCountCacheCountKey] unsignedIntegerValue];
+		}
+	}
+
+	// Count outside the lock, since it can take a while.
+	NSUInteger count = NSNotFound;
+	GTOID *previousTip = (previousEntry != nil ? [GTOID oidWithSha:previousEntry[GTCommitCountCacheTipKey] error:NULL] : nil);
+	if (previousTip != nil) {
+		BOOL success = YES;
+		BOOL fastForward = [self isOID:previousTip ancestorOfOID:oid error:error success:&success];
+		if (!success) return NSNotFound;
+
+		if (fastForward) {
+			GTEnumerator *enumerator = [GTEnumerator enumeratorWithRepository:self.repository error:error];
+			if (enumerator == nil) return NSNotFound;
+
+			NSUInteger newCommitCount = [enumerator countFromOID:oid hidingOIDs:@[ previousTip ] error:error];
+			if (newCommitCount == NSNotFound) return NSNotFound;
+
+			count = [previousEntry[GTCommitCountCacheCountKey] unsignedIntegerValue] + newCommitCount;
+		}
+	}
+
+	if (count == NSNotFound) {
+		GTEnumerator *enumerator = [GTEnumerator enumeratorWithRepository:self.repository error:error];
+		if (enumerator == nil) return NSNotFound;
+
+		count = [enumerator countFromOID:oid error:error];
+		if (count == NSNotFound) return NSNotFound;
+	}
+
+	@synchronized (self) {
+		[self setEntry:@{ GTCommitCountCacheTipKey: oid.sha, GTCommitCountCacheCountKey: @(count) } forKey:key];
+	}
+
+	return count;
+}
+
+- (void)flush {
+	dispatch_sync(_writeQueue, ^{
+		[self writeDirtyBranches];
+	});
+}
+
+- (void)removeAllCounts {
+	dispatch_sync(_writeQueue, ^{
+		@synchronized (self) {
+			[self.branches removeAllObjects];
+			[self.dirtyKeys removeAllObjects];
+		}
+
+		[NSFileManager.defaultManager removeItemAtURL:self.fileURL error:NULL];
+	});
+}
+
+#pragma mark Helpers
+
+- (BOOL)isOID:(GTOID *)ancestorOID ancestorOfOID:(GTOID *)descendantOID error:(NSError **)error success:(BOOL *)success {
+	GTCommitGraph *graph = self.repository.commitGraph;
+	if (graph != nil) return [graph isOID:ancestorOID ancestorOfOID:descendantOID error:error success:success];
+
+	git_oid mergeBase;
+	int gitError = git_merge_base(&mergeBase, self.repository.git_repository, (git_oid *)ancestorOID.git_oid, (git_oid *)descendantOID.git_oid);
+	if (gitError == GIT_ENOTFOUND) {
+		// Unrelated histories.
+		*success = YES;
+		return NO;
+	} else if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to find merge base."];
+		*success = NO;
+		return NO;
+	}
+
+	*success = YES;
+	return git_oid_cmp(&mergeBase, ancestorOID.git_oid) == 0;
+}
+
+// Returns the valid entries in the file at `fileURL`, or an empty dictionary if
+// it doesn't exist or can't be read.
++ (NSDictionary *)branchesInFileAtURL:(NSURL *)fileURL {
+	NSMutableDictionary *branches = [NSMutableDictionary dictionary];
+
+	NSDictionary *plist = [NSDictionary dictionaryWithContentsOfURL:fileURL];
+	if ([plist[GTCommitCountCacheVersionKey] integerValue] == GTCommitCountCacheVersion && [plist[GTCommitCountCacheBranchesKey] isKindOfClass:NSDictionary.class]) {
+		[plist[GTCommitCountCacheBranchesKey] enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSDictionary *entry, BOOL *stop) {
+			if (![entry isKindOfClass:NSDictionary.class]) return;
+			if (![entry[GTCommitCountCacheTipKey] isKindOfClass:NSString.class] || ![entry[GTCommitCountCacheCountKey] isKindOfClass:NSNumber.class]) return;
+
+			branches[key] = entry;
+		}];
+	}
+
+	return branches;
+}
+
+// Remembers an entry, and schedules a flush if there isn't one pending
+// already.
+//
+// Must be called while synchronized on the receiver.
+- (void)setEntry:(NSDictionary *)entry forKey:(NSString *)key {
+	if ([self.branches[key] isEqual:entry]) return;
+
+	self.branches[key] = entry;
+	[self.dirtyKeys addObject:key];
+
+	if (self.flushScheduled) return;
+	self.flushScheduled = YES;
+
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(GTCommitCountCacheFlushDelay * NSEC_PER_SEC)), _writeQueue, ^{
+		[self writeDirtyBranches];
+	});
+}
+
+// Writes the entries which changed since the last write, merged into what's in
+// the file now, so counts written by other processes in the meantime are kept
+// rather than overwritten. Entries from the file which the receiver doesn't
+// know about are picked up.
+//
+// Must be called on `_writeQueue`. The cache is only an optimization, so
+// failing to write it isn't an error.
+- (void)writeDirtyBranches {
+	NSDictionary *dirtyEntries = nil;
+	@synchronized (self) {
+		self.flushScheduled = NO;
+		if (self.dirtyKeys.count == 0) return;
+
+		dirtyEntries = [self.branches dictionaryWithValuesForKeys:self.dirtyKeys.allObjects];
+		[self.dirtyKeys removeAllObjects];
+	}
+
+	NSMutableDictionary *branches = [[self.class branchesInFileAtURL:self.fileURL] mutableCopy];
+	@synchronized (self) {
+		[branches enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSDictionary *entry, BOOL *stop) {
+			if (self.branches[key] == nil) self.branches[key] = entry;
+		}];
+	}
+
+	[branches addEntriesFromDictionary:dirtyEntries];
+
+	NSError *error = nil;
+	NSURL *directoryURL = [self.fileURL URLByDeletingLastPathComponent];
+	if (![NSFileManager.defaultManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:&error]) {
+		GTLog(@"Failed to create %@: %@", directoryURL, error);
+		return;
+	}
+
+	NSDictionary *plist = @{ GTCommitCountCacheVersionKey: @(GTCommitCountCacheVersion), GTCommitCountCacheBranchesKey: branches };
+	NSData *data = [NSPropertyListSerialization dataWithPropertyList:plist format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+	if (data == nil || ![data writeToURL:self.fileURL options:NSDataWritingAtomic error:&error]) {
+		GTLog(@"Failed to write commit counts to %@: %@", self.fileURL, error);
+	}
+}
+
+@end
@@ -0,0 +1,59 @@
+//
+//  GTCommitGraph+Private.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCommitGraph.h"
+
+// The index of a commit in the graph's arrays. Positions never change while
+// the graph is alive, but they aren't stable across loads.
+typedef uint32_t GTCommitGraphPosition;
+
+// Returned for commits which aren't in the graph.
+static const GTCommitGraphPosition GTCommitGraphPositionNotFound = UINT32_MAX;
+
+// Low level access to the graph, for walks which want to work on positions.
+//
+// Every method here must be called between -lock and -unlock, and pointers
+// they return are only valid until -unlock, since adding commits may move the
+// underlying storage.
+@interface GTCommitGraph ()
+
+- (void)lock;
+- (void)unlock;
+
+// The number of commits in the graph. Positions are always less than this.
+- (NSUInteger)positionCount;
+
+// The position of a commit, without reading the object database.
+- (GTCommitGraphPosition)positionOfGitOid:(const git_oid *)oid;
+
+// The position of a commit, reading it and its missing ancestors from the
+// object database if it isn't in the graph yet.
+//
+// returns the position, or GTCommitGraphPositionNotFound if a commit could not
+// be read.
+- (GTCommitGraphPosition)addGitOid:(const git_oid *)oid error:(NSError **)error;
+
+- (const git_oid *)gitOidAtPosition:(GTCommitGraphPosition)position;
+- (const git_oid *)treeGitOidAtPosition:(GTCommitGraphPosition)position;
+- (int64_t)commitTimeAtPosition:(GTCommitGraphPosition)position;
+- (uint32_t)generationAtPosition:(GTCommitGraphPosition)position;
+
+// The positions of a commit's parents, in order.
+- (const GTCommitGraphPosition *)parentPositionsAtPosition:(GTCommitGraphPosition)position count:(NSUInteger *)count;
+
+// Add commits and everything reachable from them to the graph, as
+// -addGitOid:error: does.
+//
+// oids       - An array of GTOIDs of commits. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the positions of every commit reachable from `oids`, packed into
+// data, or nil if a commit could not be read.
+- (NSData *)positionsReachableFromOIDs:(NSArray *)oids error:(NSError **)error;
+
+@end
@@ -0,0 +1,123 @@
+//
+//  GTCommitGraph.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "git2.h"
+
+@class GTRepository;
+@class GTOID;
+
+// Error codes in GTGitErrorDomain, kept clear of libgit2's.
+typedef enum {
+	GTCommitGraphErrorCodeCorruptFile = -1001,
+} GTCommitGraphErrorCode;
+
+// A compact index of the commit history of a repository.
+//
+// For every commit it knows about, the graph keeps the commit's OID, its
+// parents, its commit time, its root tree OID and its generation number (1
+// for a root commit, otherwise one more than the largest generation of its
+// parents). Counting, merge-base and ancestry queries then only touch these
+// integer arrays instead of inflating and parsing commits.
+//
+// The graph can be saved to a sidecar file under the repository's git
+// directory. Commits which aren't in the graph yet are read from the object
+// database the first time a query reaches them, so a graph never gives wrong
+// answers, it just gets slower the further behind it falls.
+//
+// When the file at +defaultFileURLForRepository: exists, the repository loads
+// it automatically (see -[GTRepository commitGraph]) and uses it to count
+// commits and find merge bases.
+//
+// This class is thread safe.
+@interface GTCommitGraph : NSObject
+
+// The repository the graph indexes.
+@property (nonatomic, readonly, unsafe_unretained) GTRepository *repository;
+
+// The file the graph is loaded from and written to.
+@property (nonatomic, readonly, strong) NSURL *fileURL;
+
+// The number of commits in the graph.
+@property (nonatomic, readonly) NSUInteger count;
+
+// Whether commits have been added since the graph was loaded or written.
+@property (nonatomic, readonly) BOOL hasUnsavedChanges;
+
+// The file URL a repository's commit graph is kept at by default:
+// `objectivegit/commit-graph` in its git directory.
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository;
+
+// Initializes the receiver, loading the graph from `fileURL` if the file
+// exists.
+//
+// repository - The repository to index. Cannot be nil.
+// fileURL    - The file to load from and write to. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the graph, or nil if the file exists but could not be read.
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error;
+
+// Add the given commits and all of their ancestors to the graph.
+//
+// oids       - An array of the GTOIDs of commits. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns NO if a commit could not be read, YES otherwise.
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error;
+
+// Add every commit reachable from a reference to the graph.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns NO if the references or commits could not be read, YES otherwise.
+- (BOOL)addCommitsReachableFromReferencesWithError:(NSError **)error;
+
+// Write the graph to `fileURL`, replacing it atomically.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns YES if the graph was written.
+- (BOOL)writeWithError:(NSError **)error;
+
+// Whether the commit is already in the graph. This never reads the object
+// database.
+- (BOOL)containsOID:(GTOID *)oid;
+
+// The generation number of a commit.
+//
+// returns the generation, or NSNotFound if the commit could not be read.
+- (NSUInteger)generationOfOID:(GTOID *)oid error:(NSError **)error;
+
+// The OIDs of a commit's parents, in order.
+//
+// returns the parents, or nil if the commit could not be read.
+- (NSArray *)parentOIDsOfOID:(GTOID *)oid error:(NSError **)error;
+
+// The number of commits reachable from a commit, including itself.
+//
+// returns the count, or NSNotFound if a commit could not be read.
+- (NSUInteger)countFromOID:(GTOID *)oid error:(NSError **)error;
+
+// Find a best common ancestor of two commits: one which isn't an ancestor of
+// any other common ancestor.
+//
+// returns the merge base, or nil if the commits have no common ancestor or a
+// commit could not be read.
+- (GTOID *)mergeBaseOfOID:(GTOID *)oid1 andOID:(GTOID *)oid2 error:(NSError **)error;
+
+// Whether one commit is an ancestor of (or the same as) another.
+//
+// ancestorOID   - The possible ancestor. Cannot be nil.
+// descendantOID - The possible descendant. Cannot be nil.
+// error(out)    - will be filled if an error occurs
+// success(out)  - set to NO if a commit could not be read, YES otherwise
+//
+// returns whether `ancestorOID` is reachable from `descendantOID`.
+- (BOOL)isOID:(GTOID *)ancestorOID ancestorOfOID:(GTOID *)descendantOID error:(NSError **)error success:(BOOL *)success;
+
+@end
@@ -0,0 +1,787 @@
+//
+//  GTCommitGraph.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCommitGraph.h"
+#import "GTCommitGraph+Private.h"
+#import "GTIndexFile.h"
+#import "GTRepository.h"
+#import "GTRepository+Private.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+#import <pthread.h>
+
+// The file format (see GTIndexFile.h), all integers big-endian:
+//
+//   "GTCG"                          magic
+//   uint32                          version
+//   uint32                          commit count (N)
+//   uint32                          parent edge count (E)
+//   N * 20 bytes                    commit oids, sorted
+//   N * 20 bytes                    root tree oids
+//   N * int64                       commit times, in seconds since the epoch
+//   N * uint32                      generation numbers
+//   (N + 1) * uint32                offsets into the parent positions
+//   E * uint32                      parent positions
+//   20 bytes                        SHA1 of everything above
+static const char GTCommitGraphMagic[4] = { 'G', 'T', 'C', 'G' };
+static const uint32_t GTCommitGraphVersion = 1;
+static const NSUInteger GTCommitGraphHeaderLength = 16;
+
+// A commit being read from the object database, waiting on its parents.
+typedef struct {
+	git_oid oid;
+	git_oid tree;
+	int64_t time;
+	unsigned int parentCount;
+	unsigned int nextParent;
+	git_oid *parents;
+} GTCommitGraphPendingCommit;
+
+// A binary max-heap of positions, ordered by generation.
+
+static void GTCommitGraphHeapPush(GTCommitGraphPosition *heap, NSUInteger *count, const uint32_t *generations, GTCommitGraphPosition position) {
+	NSUInteger i = (*count)++;
+	while (i > 0) {
+		NSUInteger parent = (i - 1) / 2;
+		if (generations[heap[parent]] >= generations[position]) break;
+
+		heap[i] = heap[parent];
+		i = parent;
+	}
+
+	heap[i] = position;
+}
+
+static GTCommitGraphPosition GTCommitGraphHeapPop(GTCommitGraphPosition *heap, NSUInteger *count, const uint32_t *generations) {
+	GTCommitGraphPosition top = heap[0];
+	GTCommitGraphPosition last = heap[--(*count)];
+
+	NSUInteger i = 0;
+	while (YES) {
+		NSUInteger child = 2 * i + 1;
+		if (child >= *count) break;
+		if (child + 1 < *count && generations[heap[child + 1]] > generations[heap[child]]) child++;
+		if (generations[last] >= generations[heap[child]]) break;
+
+		heap[i] = heap[child];
+		i = child;
+	}
+
+	if (*count > 0) heap[i] = last;
+
+	return top;
+}
+
+@interface GTCommitGraph () {
+	pthread_mutex_t _lock;
+
+	NSUInteger _count;
+	NSUInteger _capacity;
+	git_oid *_oids;
+	git_oid *_trees;
+	int64_t *_times;
+	uint32_t *_generations;
+
+	// The parents of the commit at position `p` are at
+	// `_parents[_parentStarts[p]]` up to `_parents[_parentStarts[p + 1]]`.
+	uint32_t *_parentStarts;
+	GTCommitGraphPosition *_parents;
+	NSUInteger _parentCount;
+	NSUInteger _parentCapacity;
+
+	// An open addressing hash table of positions, keyed by oid.
+	GTCommitGraphPosition *_table;
+	NSUInteger _tableCapacity;
+
+	BOOL _hasUnsavedChanges;
+}
+
+@end
+
+@implementation GTCommitGraph
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> fileURL: %@, count: %lu", NSStringFromClass([self class]), self, self.fileURL, (unsigned long)self.count];
+}
+
+- (void)dealloc {
+	free(_oids);
+	free(_trees);
+	free(_times);
+	free(_generations);
+	free(_parentStarts);
+	free(_parents);
+	free(_table);
+	pthread_mutex_destroy(&_lock);
+}
+
+#pragma mark API
+
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository {
+	return GTIndexFileURLForRepository(repository, @"commit-graph", NO);
+}
+
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error {
+	NSParameterAssert(repository != nil);
+	NSParameterAssert(fileURL != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	pthread_mutex_init(&_lock, NULL);
+	_repository = repository;
+	_fileURL = [fileURL copy];
+
+	_parentStarts = calloc(1, sizeof(*_parentStarts));
+
+	NSData *data = nil;
+	if (!GTIndexFileReadData(fileURL, &data, error)) return nil;
+	if (data != nil && ![self loadData:data error:error]) return nil;
+
+	return self;
+}
+
+- (NSUInteger)count {
+	[self lock];
+	NSUInteger count = _count;
+	[self unlock];
+	return count;
+}
+
+- (BOOL)hasUnsavedChanges {
+	[self lock];
+	BOOL hasUnsavedChanges = _hasUnsavedChanges;
+	[self unlock];
+	return hasUnsavedChanges;
+}
+
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error {
+	NSParameterAssert(oids != nil);
+
+	[self lock];
+
+	BOOL success = YES;
+	for (GTOID *oid in oids) {
+		if ([self addGitOid:oid.git_oid error:error] == GTCommitGraphPositionNotFound) {
+			success = NO;
+			break;
+		}
+	}
+
+	[self unlock];
+
+	return success;
+}
+
+- (BOOL)addCommitsReachableFromReferencesWithError:(NSError **)error {
+	NSArray *oids = [self.repository referencedCommitOIDsWithError:error];
+	if (oids == nil) return NO;
+
+	return [self addCommitsReachableFromOIDs:oids error:error];
+}
+
+- (BOOL)writeWithError:(NSError **)error {
+	[self lock];
+	NSMutableData *data = [self serializedData];
+	[self unlock];
+
+	if (!GTIndexFileWriteData(data, self.fileURL, error)) return NO;
+
+	[self lock];
+	_hasUnsavedChanges = NO;
+	[self unlock];
+
+	return YES;
+}
+
+- (BOOL)containsOID:(GTOID *)oid {
+	NSParameterAssert(oid != nil);
+
+	[self lock];
+	BOOL contains = [self positionOfGitOid:oid.git_oid] != GTCommitGraphPositionNotFound;
+	[self unlock];
+
+	return contains;
+}
+
+- (NSUInteger)generationOfOID:(GTOID *)oid error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+
+	[self lock];
+
+	NSUInteger generation = NSNotFound;
+	GTCommitGraphPosition position = [self addGitOid:oid.git_oid error:error];
+	if (position != GTCommitGraphPositionNotFound) generation = _generations[position];
+
+	[self unlock];
+
+	return generation;
+}
+
+- (NSArray *)parentOIDsOfOID:(GTOID *)oid error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+
+	[self lock];
+
+	NSMutableArray *parentOIDs = nil;
+	GTCommitGraphPosition position = [self addGitOid:oid.git_oid error:error];
+	if (position != GTCommitGraphPositionNotFound) {
+		NSUInteger parentCount = 0;
+		const GTCommitGraphPosition *parents = [self parentPositionsAtPosition:position count:&parentCount];
+
+		parentOIDs = [NSMutableArray arrayWithCapacity:parentCount];
+		for (NSUInteger i = 0; i < parentCount; i++) {
+			[parentOIDs addObject:[GTOID oidWithGitOid:&_oids[parents[i]]]];
+		}
+	}
+
+	[self unlock];
+
+	return parentOIDs;
+}
+
+- (NSUInteger)countFromOID:(GTOID *)oid error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+
+	[self lock];
+
+	NSUInteger count = NSNotFound;
+	GTCommitGraphPosition start = [self addGitOid:oid.git_oid error:error];
+	if (start != GTCommitGraphPositionNotFound) {
+		uint8_t *visited = calloc(_count, sizeof(*visited));
+		GTCommitGraphPosition *stack = malloc(_count * sizeof(*stack));
+		NSUInteger stackCount = 0;
+
+		visited[start] = 1;
+		stack[stackCount++] = start;
+		count = 0;
+
+		while (stackCount > 0) {
+			GTCommitGraphPosition position = stack[--stackCount];
+			count++;
+
+			for (uint32_t i = _parentStarts[position]; i < _parentStarts[position + 1]; i++) {
+				GTCommitGraphPosition parent = _parents[i];
+				if (visited[parent]) continue;
+
+				visited[parent] = 1;
+				stack[stackCount++] = parent;
+			}
+		}
+
+		free(visited);
+		free(stack);
+	}
+
+	[self unlock];
+
+	return count;
+}
+
+- (GTOID *)mergeBaseOfOID:(GTOID *)oid1 andOID:(GTOID *)oid2 error:(NSError **)error {
+	NSParameterAssert(oid1 != nil);
+	NSParameterAssert(oid2 != nil);
+
+	[self lock];
+
+	GTOID *mergeBase = nil;
+	GTCommitGraphPosition position1 = [self addGitOid:oid1.git_oid error:error];
+	GTCommitGraphPosition position2 = (position1 != GTCommitGraphPositionNotFound ? [self addGitOid:oid2.git_oid error:error] : GTCommitGraphPositionNotFound);
+	if (position2 != GTCommitGraphPositionNotFound) {
+		GTCommitGraphPosition position = [self mergeBaseOfPosition:position1 andPosition:position2];
+		if (position != GTCommitGraphPositionNotFound) {
+			mergeBase = [GTOID oidWithGitOid:&_oids[position]];
+		} else if (error != NULL) {
+			*error = [NSError git_errorFor:GIT_ENOTFOUND withAdditionalDescription:[NSString stringWithFormat:@"No merge base found between %@ and %@.", oid1.sha, oid2.sha]];
+		}
+	}
+
+	[self unlock];
+
+	return mergeBase;
+}
+
+- (BOOL)isOID:(GTOID *)ancestorOID ancestorOfOID:(GTOID *)descendantOID error:(NSError **)error success:(BOOL *)success {
+	NSParameterAssert(ancestorOID != nil);
+	NSParameterAssert(descendantOID != nil);
+
+	[self lock];
+
+	BOOL isAncestor = NO;
+	GTCommitGraphPosition ancestor = [self addGitOid:ancestorOID.git_oid error:error];
+	GTCommitGraphPosition descendant = (ancestor != GTCommitGraphPositionNotFound ? [self addGitOid:descendantOID.git_oid error:error] : GTCommitGraphPositionNotFound);
+	if (descendant != GTCommitGraphPositionNotFound) {
+		isAncestor = [self isPosition:ancestor ancestorOfPosition:descendant];
+	}
+
+	if (success != NULL) *success = (descendant != GTCommitGraphPositionNotFound);
+
+	[self unlock];
+
+	return isAncestor;
+}
+
+#pragma mark Queries
+
+// Paints the ancestors of both commits, visiting commits in order of
+// decreasing generation. A commit can only be visited after all of its
+// descendants have been, so the first commit found painted by both sides is
+// the common ancestor with the highest generation, which can't be an ancestor
+// of any other common ancestor.
+- (GTCommitGraphPosition)mergeBaseOfPosition:(GTCommitGraphPosition)position1 andPosition:(GTCommitGraphPosition)position2 {
+	if (position1 == position2) return position1;
+
+	enum {
+		GTPaintedFromFirst = 1 << 0,
+		GTPaintedFromSecond = 1 << 1,
+		GTPaintedFromBoth = GTPaintedFromFirst | GTPaintedFromSecond,
+	};
+
+	uint8_t *paint = calloc(_count, sizeof(*paint));
+	GTCommitGraphPosition *heap = malloc(_count * sizeof(*heap));
+	NSUInteger heapCount = 0;
+
+	paint[position1] = GTPaintedFromFirst;
+	paint[position2] = GTPaintedFromSecond;
+	GTCommitGraphHeapPush(heap, &heapCount, _generations, position1);
+	GTCommitGraphHeapPush(heap, &heapCount, _generations, position2);
+
+	GTCommitGraphPosition mergeBase = GTCommitGraphPositionNotFound;
+	while (heapCount > 0) {
+		GTCommitGraphPosition position = GTCommitGraphHeapPop(heap, &heapCount, _generations);
+		uint8_t flags = paint[position];
+		if (flags == GTPaintedFromBoth) {
+			mergeBase = position;
+			break;
+		}
+
+		for (uint32_t i = _parentStarts[position]; i < _parentStarts[position + 1]; i++) {
+			GTCommitGraphPosition parent = _parents[i];
+			if ((paint[parent] | flags) == paint[parent]) continue;
+
+			BOOL queued = (paint[parent] != 0);
+			paint[parent] |= flags;
+			if (!queued) GTCommitGraphHeapPush(heap, &heapCount, _generations, parent);
+		}
+	}
+
+	free(paint);
+	free(heap);
+
+	return mergeBase;
+}
+
+// Ancestors always have a lower generation than their descendants, so the
+// walk never needs to look past the ancestor's generation.
+- (BOOL)isPosition:(GTCommitGraphPosition)ancestor ancestorOfPosition:(GTCommitGraphPosition)descendant {
+	if (ancestor == descendant) return YES;
+
+	uint32_t ancestorGeneration = _generations[ancestor];
+	if (_generations[descendant] <= ancestorGeneration) return NO;
+
+	uint8_t *visited = calloc(_count, sizeof(*visited));
+	GTCommitGraphPosition *stack = malloc(_count * sizeof(*stack));
+	NSUInteger stackCount = 0;
+
+	visited[descendant] = 1;
+	stack[stackCount++] = descendant;
+
+	BOOL found = NO;
+	while (stackCount > 0 && !found) {
+		GTCommitGraphPosition position = stack[--stackCount];
+
+		for (uint32_t i = _parentStarts[position]; i < _parentStarts[position + 1]; i++) {
+			GTCommitGraphPosition parent = _parents[i];
+			if (parent == ancestor) {
+				found = YES;
+				break;
+			}
+
+			if (visited[parent] || _generations[parent] <= ancestorGeneration) continue;
+
+			visited[parent] = 1;
+			stack[stackCount++] = parent;
+		}
+	}
+
+	free(visited);
+	free(stack);
+
+	return found;
+}
+
+- (NSData *)positionsReachableFromOIDs:(NSArray *)oids error:(NSError **)error {
+	NSParameterAssert(oids != nil);
+
+	NSMutableData *startData = [NSMutableData dataWithLength:oids.count * sizeof(GTCommitGraphPosition)];
+	GTCommitGraphPosition *starts = startData.mutableBytes;
+	for (NSUInteger i = 0; i < oids.count; i++) {
+		starts[i] = [self addGitOid:[oids[i] git_oid] error:error];
+		if (starts[i] == GTCommitGraphPositionNotFound) return nil;
+	}
+
+	uint8_t *visited = calloc(_count, sizeof(*visited));
+	NSMutableData *positionData = [NSMutableData dataWithLength:_count * sizeof(GTCommitGraphPosition)];
+	GTCommitGraphPosition *positions = positionData.mutableBytes;
+	NSUInteger positionCount = 0;
+
+	// Positions double as the stack: everything before `next` has been
+	// visited, everything after it is waiting.
+	for (NSUInteger i = 0; i < oids.count; i++) {
+		if (visited[starts[i]]) continue;
+
+		visited[starts[i]] = 1;
+		positions[positionCount++] = starts[i];
+	}
+
+	for (NSUInteger next = 0; next < positionCount; next++) {
+		GTCommitGraphPosition position = positions[next];
+
+		for (uint32_t i = _parentStarts[position]; i < _parentStarts[position + 1]; i++) {
+			GTCommitGraphPosition parent = _parents[i];
+			if (visited[parent]) continue;
+
+			visited[parent] = 1;
+			positions[positionCount++] = parent;
+		}
+	}
+
+	free(visited);
+
+	positionData.length = positionCount * sizeof(GTCommitGraphPosition);
+	return positionData;
+}
+
+#pragma mark Storage
+
+- (void)lock {
+	pthread_mutex_lock(&_lock);
+}
+
+- (void)unlock {
+	pthread_mutex_unlock(&_lock);
+}
+
+- (NSUInteger)positionCount {
+	return _count;
+}
+
+static inline NSUInteger GTCommitGraphHash(const git_oid *oid) {
+	// The oid is already a cryptographic hash, so its leading bytes are as good
+	// a hash as any.
+	uint32_t hash;
+	memcpy(&hash, oid->id, sizeof(hash));
+	return hash;
+}
+
+- (GTCommitGraphPosition)positionOfGitOid:(const git_oid *)oid {
+	if (_tableCapacity == 0) return GTCommitGraphPositionNotFound;
+
+	NSUInteger mask = _tableCapacity - 1;
+	for (NSUInteger i = GTCommitGraphHash(oid) & mask; ; i = (i + 1) & mask) {
+		GTCommitGraphPosition position = _table[i];
+		if (position == GTCommitGraphPositionNotFound) return GTCommitGraphPositionNotFound;
+		if (git_oid_cmp(&_oids[position], oid) == 0) return position;
+	}
+}
+
+- (const git_oid *)gitOidAtPosition:(GTCommitGraphPosition)position {
+	return &_oids[position];
+}
+
+- (const git_oid *)treeGitOidAtPosition:(GTCommitGraphPosition)position {
+	return &_trees[position];
+}
+
+- (int64_t)commitTimeAtPosition:(GTCommitGraphPosition)position {
+	return _times[position];
+}
+
+- (uint32_t)generationAtPosition:(GTCommitGraphPosition)position {
+	return _generations[position];
+}
+
+- (const GTCommitGraphPosition *)parentPositionsAtPosition:(GTCommitGraphPosition)position count:(NSUInteger *)count {
+	if (count != NULL) *count = _parentStarts[position + 1] - _parentStarts[position];
+	return &_parents[_parentStarts[position]];
+}
+
+- (void)insertPositionIntoTable:(GTCommitGraphPosition)position {
+	NSUInteger mask = _tableCapacity - 1;
+	NSUInteger i = GTCommitGraphHash(&_oids[position]) & mask;
+	while (_table[i] != GTCommitGraphPositionNotFound) {
+		i = (i + 1) & mask;
+	}
+
+	_table[i] = position;
+}
+
+// Keeps the table at most half full.
+- (void)ensureTableCapacityForCount:(NSUInteger)count {
+	if (count * 2 <= _tableCapacity) return;
+
+	NSUInteger capacity = MAX(_tableCapacity, (NSUInteger)1024);
+	while (count * 2 > capacity) capacity *= 2;
+
+	free(_table);
+	_tableCapacity = capacity;
+	_table = malloc(capacity * sizeof(*_table));
+	memset(_table, 0xff, capacity * sizeof(*_table));
+
+	for (GTCommitGraphPosition position = 0; position < _count; position++) {
+		[self insertPositionIntoTable:position];
+	}
+}
+
+- (void)ensureCapacityForCount:(NSUInteger)count parentCount:(NSUInteger)parentCount {
+	if (count > _capacity) {
+		NSUInteger capacity = MAX(_capacity * 2, MAX(count, (NSUInteger)1024));
+		_oids = realloc(_oids, capacity * sizeof(*_oids));
+		_trees = realloc(_trees, capacity * sizeof(*_trees));
+		_times = realloc(_times, capacity * sizeof(*_times));
+		_generations = realloc(_generations, capacity * sizeof(*_generations));
+		_parentStarts = realloc(_parentStarts, (capacity + 1) * sizeof(*_parentStarts));
+		_capacity = capacity;
+	}
+
+	if (parentCount > _parentCapacity) {
+		NSUInteger capacity = MAX(_parentCapacity * 2, MAX(parentCount, (NSUInteger)1024));
+		_parents = realloc(_parents, capacity * sizeof(*_parents));
+		_parentCapacity = capacity;
+	}
+
+	[self ensureTableCapacityForCount:count];
+}
+
+// All of the commit's parents must already be in the graph.
+- (GTCommitGraphPosition)appendPendingCommit:(const GTCommitGraphPendingCommit *)commit {
+	[self ensureCapacityForCount:_count + 1 parentCount:_parentCount + commit->parentCount];
+
+	GTCommitGraphPosition position = (GTCommitGraphPosition)_count;
+	uint32_t generation = 0;
+	for (unsigned int i = 0; i < commit->parentCount; i++) {
+		GTCommitGraphPosition parent = [self positionOfGitOid:&commit->parents[i]];
+		NSAssert(parent != GTCommitGraphPositionNotFound, @"Parent %u of commit %lu was not in the graph", i, (unsigned long)position);
+
+		_parents[_parentCount++] = parent;
+		generation = MAX(generation, _generations[parent]);
+	}
+
+	git_oid_cpy(&_oids[position], &commit->oid);
+	git_oid_cpy(&_trees[position], &commit->tree);
+	_times[position] = commit->time;
+	_generations[position] = generation + 1;
+	_parentStarts[position + 1] = (uint32_t)_parentCount;
+	_count++;
+
+	[self insertPositionIntoTable:position];
+	_hasUnsavedChanges = YES;
+
+	return position;
+}
+
+- (BOOL)readPendingCommit:(GTCommitGraphPendingCommit *)pendingCommit oid:(const git_oid *)oid error:(NSError **)error {
+	git_commit *commit = NULL;
+	int gitError = git_commit_lookup(&commit, self.repository.git_repository, oid);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to read commit %@ for the commit graph.", [GTOID oidWithGitOid:oid].sha]];
+		return NO;
+	}
+
+	git_oid_cpy(&pendingCommit->oid, oid);
+	git_oid_cpy(&pendingCommit->tree, git_commit_tree_id(commit));
+	pendingCommit->time = git_commit_time(commit);
+	pendingCommit->parentCount = git_commit_parentcount(commit);
+	pendingCommit->nextParent = 0;
+	pendingCommit->parents = malloc(MAX(pendingCommit->parentCount, 1U) * sizeof(*pendingCommit->parents));
+	for (unsigned int i = 0; i < pendingCommit->parentCount; i++) {
+		git_oid_cpy(&pendingCommit->parents[i], git_commit_parent_id(commit, i));
+	}
+
+	git_commit_free(commit);
+
+	return YES;
+}
+
+// Reads commits depth first, so that a commit is only appended once all of
+// its parents have been.
+- (GTCommitGraphPosition)addGitOid:(const git_oid *)oid error:(NSError **)error {
+	GTCommitGraphPosition position = [self positionOfGitOid:oid];
+	if (position != GTCommitGraphPositionNotFound) return position;
+
+	NSUInteger stackCapacity = 64;
+	NSUInteger stackCount = 0;
+	GTCommitGraphPendingCommit *stack = malloc(stackCapacity * sizeof(*stack));
+
+	if (![self readPendingCommit:&stack[stackCount] oid:oid error:error]) {
+		free(stack);
+		return GTCommitGraphPositionNotFound;
+	}
+	stackCount++;
+
+	while (stackCount > 0) {
+		GTCommitGraphPendingCommit *top = &stack[stackCount - 1];
+		while (top->nextParent < top->parentCount && [self positionOfGitOid:&top->parents[top->nextParent]] != GTCommitGraphPositionNotFound) {
+			top->nextParent++;
+		}
+
+		if (top->nextParent < top->parentCount) {
+			if (stackCount == stackCapacity) {
+				stackCapacity *= 2;
+				stack = realloc(stack, stackCapacity * sizeof(*stack));
+				top = &stack[stackCount - 1];
+			}
+
+			if (![self readPendingCommit:&stack[stackCount] oid:&top->parents[top->nextParent] error:error]) {
+				for (NSUInteger i = 0; i < stackCount; i++) {
+					free(stack[i].parents);
+				}
+				free(stack);
+				return GTCommitGraphPositionNotFound;
+			}
+
+			stackCount++;
+			continue;
+		}
+
+		position = [self appendPendingCommit:top];
+		free(top->parents);
+		stackCount--;
+	}
+
+	free(stack);
+
+	return position;
+}
+
+#pragma mark Serialization
+
+// Must be called with the lock held.
+- (NSMutableData *)serializedData {
+	// The file keeps commits sorted by oid, so positions have to be remapped.
+	GTCommitGraphPosition *order = malloc(MAX(_count, (NSUInteger)1) * sizeof(*order));
+	GTCommitGraphPosition *newPositions = malloc(MAX(_count, (NSUInteger)1) * sizeof(*newPositions));
+	for (NSUInteger i = 0; i < _count; i++) {
+		order[i] = (GTCommitGraphPosition)i;
+	}
+
+	git_oid *oids = _oids;
+	qsort_b(order, _count, sizeof(*order), ^int(const void *a, const void *b) {
+		return git_oid_cmp(&oids[*(const GTCommitGraphPosition *)a], &oids[*(const GTCommitGraphPosition *)b]);
+	});
+
+	for (NSUInteger i = 0; i < _count; i++) {
+		newPositions[order[i]] = (GTCommitGraphPosition)i;
+	}
+
+	NSUInteger length = GTCommitGraphHeaderLength + _count * (2 * GIT_OID_RAWSZ + sizeof(int64_t) + 2 * sizeof(uint32_t)) + sizeof(uint32_t) + _parentCount * sizeof(uint32_t) + GIT_OID_RAWSZ;
+	NSMutableData *data = GTIndexFileCreateData(GTCommitGraphMagic, GTCommitGraphVersion, length);
+	GTIndexFileAppendUInt32(data, (uint32_t)_count);
+	GTIndexFileAppendUInt32(data, (uint32_t)_parentCount);
+
+	for (NSUInteger i = 0; i < _count; i++) {
+		[data appendBytes:_oids[order[i]].id length:GIT_OID_RAWSZ];
+	}
+
+	for (NSUInteger i = 0; i < _count; i++) {
+		[data appendBytes:_trees[order[i]].id length:GIT_OID_RAWSZ];
+	}
+
+	for (NSUInteger i = 0; i < _count; i++) {
+		GTIndexFileAppendInt64(data, _times[order[i]]);
+	}
+
+	for (NSUInteger i = 0; i < _count; i++) {
+		GTIndexFileAppendUInt32(data, _generations[order[i]]);
+	}
+
+	uint32_t parentOffset = 0;
+	GTIndexFileAppendUInt32(data, 0);
+	for (NSUInteger i = 0; i < _count; i++) {
+		parentOffset += _parentStarts[order[i] + 1] - _parentStarts[order[i]];
+		GTIndexFileAppendUInt32(data, parentOffset);
+	}
+
+	for (NSUInteger i = 0; i < _count; i++) {
+		for (uint32_t j = _parentStarts[order[i]]; j < _parentStarts[order[i] + 1]; j++) {
+			GTIndexFileAppendUInt32(data, newPositions[_parents[j]]);
+		}
+	}
+
+	free(order);
+	free(newPositions);
+
+	return data;
+}
+
+- (NSError *)corruptFileError {
+	return GTIndexFileCorruptError(GTCommitGraphErrorCodeCorruptFile, @"The commit graph", self.fileURL);
+}
+
+// Only called from the initializer, before anyone else can see the receiver.
+- (BOOL)loadData:(NSData *)data error:(NSError **)error {
+	const uint8_t *bytes = data.bytes;
+	NSUInteger length = data.length;
+
+	if (GTIndexFileContentsLength(data, GTCommitGraphMagic, GTCommitGraphVersion) == 0 || length < GTCommitGraphHeaderLength + sizeof(uint32_t) + GIT_OID_RAWSZ) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	NSUInteger count = GTIndexFileReadUInt32(bytes + 8);
+	NSUInteger parentCount = GTIndexFileReadUInt32(bytes + 12);
+	NSUInteger expectedLength = GTCommitGraphHeaderLength + count * (2 * GIT_OID_RAWSZ + sizeof(int64_t) + 2 * sizeof(uint32_t)) + sizeof(uint32_t) + parentCount * sizeof(uint32_t) + GIT_OID_RAWSZ;
+	if (length != expectedLength) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	[self ensureCapacityForCount:count parentCount:parentCount];
+
+	const uint8_t *oids = bytes + GTCommitGraphHeaderLength;
+	const uint8_t *trees = oids + count * GIT_OID_RAWSZ;
+	const uint8_t *times = trees + count * GIT_OID_RAWSZ;
+	const uint8_t *generations = times + count * sizeof(int64_t);
+	const uint8_t *parentStarts = generations + count * sizeof(uint32_t);
+	const uint8_t *parents = parentStarts + (count + 1) * sizeof(uint32_t);
+
+	for (NSUInteger i = 0; i < count; i++) {
+		git_oid_fromraw(&_oids[i], oids + i * GIT_OID_RAWSZ);
+		git_oid_fromraw(&_trees[i], trees + i * GIT_OID_RAWSZ);
+		_times[i] = GTIndexFileReadInt64(times + i * sizeof(int64_t));
+		_generations[i] = GTIndexFileReadUInt32(generations + i * sizeof(uint32_t));
+	}
+
+	for (NSUInteger i = 0; i <= count; i++) {
+		_parentStarts[i] = GTIndexFileReadUInt32(parentStarts + i * sizeof(uint32_t));
+		if ((i == 0 && _parentStarts[i] != 0) || (i > 0 && _parentStarts[i] < _parentStarts[i - 1]) || _parentStarts[i] > parentCount) {
+			if (error != NULL) *error = self.corruptFileError;
+			return NO;
+		}
+	}
+
+	for (NSUInteger i = 0; i < parentCount; i++) {
+		_parents[i] = GTIndexFileReadUInt32(parents + i * sizeof(uint32_t));
+		if (_parents[i] >= count) {
+			if (error != NULL) *error = self.corruptFileError;
+			return NO;
+		}
+	}
+
+	_count = count;
+	_parentCount = parentCount;
+	[self ensureTableCapacityForCount:count];
+	for (GTCommitGraphPosition position = 0; position < count; position++) {
+		[self insertPositionIntoTable:position];
+	}
+
+	return YES;
+}
+
+@end
@@ -0,0 +1,113 @@
+//
+//  GTCommitMessageIndex.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTRepository;
+@class GTOID;
+
+// Returned by -[GTCommitMessageIndex initWithRepository:fileURL:error:] when
+// the file isn't a valid index. In GTGitErrorDomain, kept clear of libgit2's
+// codes.
+static const NSInteger GTCommitMessageIndexErrorCodeCorruptFile = -1004;
+
+// A persistent trigram index of commit messages, for searching history
+// without reading every commit.
+//
+// Every run of three bytes in each message's UTF-8 (with ASCII letters
+// lowercased, and messages in other encodings read as Latin-1) is a trigram,
+// and each trigram has a compressed list of the commits whose messages
+// contain it. A query looks up the trigrams of the text it needs and
+// intersects their lists, leaving a short list of candidates. Candidates may
+// still not match (the trigrams can be in the wrong order, or the case can
+// differ), so they need checking against the real messages, which
+// -OIDsOfCommitsWithMessagesMatchingRegularExpression:error: does.
+//
+// Adding commits only reads the ones which aren't in the index yet, so keeping
+// it up to date as refs move is cheap.
+//
+// This class is thread safe.
+@interface GTCommitMessageIndex : NSObject
+
+// The repository the index is for.
+@property (nonatomic, readonly, unsafe_unretained) GTRepository *repository;
+
+// The file the index is loaded from and written to.
+@property (nonatomic, readonly, strong) NSURL *fileURL;
+
+// The number of commits in the index.
+@property (nonatomic, readonly) NSUInteger count;
+
+// Whether commits have been added since the index was loaded or written.
+@property (nonatomic, readonly) BOOL hasUnsavedChanges;
+
+// The file URL a repository's index is kept at by default:
+// `objectivegit/messages` in its git directory.
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository;
+
+// Initializes the receiver, loading the index from `fileURL` if the file
+// exists.
+//
+// repository - The repository the index is for. Cannot be nil.
+// fileURL    - The file to load from and write to. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the index, or nil if the file exists but couldn't be read.
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error;
+
+// Add every commit reachable from the given commits which isn't in the index
+// yet.
+//
+// oids       - An array of GTOIDs of commits. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns NO if an error occurred.
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error;
+
+// Write the index to `fileURL`, atomically.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns NO if an error occurred.
+- (BOOL)writeWithError:(NSError **)error;
+
+// Whether the index has a commit.
+- (BOOL)containsOID:(GTOID *)oid;
+
+// Find the commits whose messages may contain a string, ignoring the case of
+// ASCII letters.
+//
+// string - The text to look for. Cannot be nil.
+//
+// returns an array of GTOIDs, in the order they were indexed, or nil if the
+// string is too short to narrow anything down (less than three bytes), in
+// which case every commit is a candidate.
+- (NSArray *)candidateOIDsForSubstring:(NSString *)string;
+
+// Find the commits whose messages may match a regular expression.
+//
+// The literal text every match must contain is pulled out of the pattern and
+// looked up as with -candidateOIDsForSubstring:. Patterns with alternation at
+// the top level, inline flags, or without three literal characters in a row,
+// can't be narrowed down.
+//
+// regularExpression - The expression to match. Cannot be nil.
+//
+// returns an array of GTOIDs, or nil if every commit is a candidate.
+- (NSArray *)candidateOIDsForRegularExpression:(NSRegularExpression *)regularExpression;
+
+// Find the indexed commits whose messages match a regular expression, checking
+// each candidate against its real message.
+//
+// regularExpression - The expression to match. Cannot be nil.
+// error(out)        - will be filled if an error occurs
+//
+// returns an array of GTOIDs, or nil if an error occurred.
+- (NSArray *)OIDsOfCommitsWithMessagesMatchingRegularExpression:(NSRegularExpression *)regularExpression error:(NSError **)error;
+
+@end
@@ -0,0 +1,719 @@
+//
+//  GTCommitMessageIndex.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCommitMessageIndex.h"
+#import "GTCommitGraph.h"
+#import "GTCommitGraph+Private.h"
+#import "GTCommitRecord.h"
+#import "GTCommitRecord+Private.h"
+#import "GTIndexFile.h"
+#import "GTRepository.h"
+#import "GTRepository+Private.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+// The file format (see GTIndexFile.h), all integers big-endian:
+//
+//   "GTCM"                          magic
+//   uint32                          version
+//   uint32                          commit count (N)
+//   uint32                          trigram count (T)
+//   N * 20 bytes                    commit oids, by commit number
+//   T * trigram, sorted:
+//     uint32                        trigram
+//     uint32                        commit count
+//     uint32                        last commit number
+//     uint32                        end offset of its list in the list data
+//   list data
+//   20 bytes                        SHA1 of everything above
+//
+// Each list is its commit numbers in ascending order, each written as a
+// varint of the gap from the one before (or from 0, for the first).
+//
+// Version 1 took the trigrams of messages which aren't UTF-8 from their raw
+// bytes.
+static const char GTCommitMessageIndexMagic[4] = { 'G', 'T', 'C', 'M' };
+static const uint32_t GTCommitMessageIndexVersion = 2;
+static const NSUInteger GTCommitMessageIndexTrigramEntryLength = 16;
+
+static void GTCommitMessageIndexAppendVarint(NSMutableData *data, uint32_t value) {
+	uint8_t bytes[5];
+	NSUInteger length = 0;
+	do {
+		bytes[length] = value & 0x7f;
+		value >>= 7;
+		if (value != 0) bytes[length] |= 0x80;
+		length++;
+	} while (value != 0);
+
+	[data appendBytes:bytes length:length];
+}
+
+static inline uint8_t GTCommitMessageIndexFoldByte(uint8_t byte) {
+	return (byte >= 'A' && byte <= 'Z' ? byte + ('a' - 'A') : byte);
+}
+
+static int GTCommitMessageIndexCompareUInt32(const void *a, const void *b) {
+	uint32_t value1 = *(const uint32_t *)a;
+	uint32_t value2 = *(const uint32_t *)b;
+	return (value1 < value2 ? -1 : (value1 > value2 ? 1 : 0));
+}
+
+// Fills `trigrams` with the distinct trigrams of some text, sorted, and
+// returns how many there are. `trigrams` must have room for `length` of them.
+static NSUInteger GTCommitMessageIndexGetTrigrams(const uint8_t *bytes, NSUInteger length, uint32_t *trigrams) {
+	if (length < 3) return 0;
+
+	NSUInteger count = 0;
+	for (NSUInteger i = 0; i + 2 < length; i++) {
+		trigrams[count++] = ((uint32_t)GTCommitMessageIndexFoldByte(bytes[i]) << 16) | ((uint32_t)GTCommitMessageIndexFoldByte(bytes[i + 1]) << 8) | GTCommitMessageIndexFoldByte(bytes[i + 2]);
+	}
+
+	qsort(trigrams, count, sizeof(*trigrams), GTCommitMessageIndexCompareUInt32);
+
+	NSUInteger uniqueCount = 1;
+	for (NSUInteger i = 1; i < count; i++) {
+		if (trigrams[i] != trigrams[uniqueCount - 1]) trigrams[uniqueCount++] = trigrams[i];
+	}
+
+	return uniqueCount;
+}
+
+// The text to take a message's trigrams from: the UTF-8 of the message as
+// GTCommitRecordString() reads it, which is what regular expressions are
+// checked against. That's the message's own bytes if they're UTF-8, but a
+// message in another encoding is read as Latin-1, and so is indexed as the
+// UTF-8 of that.
+static NSData *GTCommitMessageIndexMessageData(const char *buffer, NSRange range) {
+	const uint8_t *bytes = (const uint8_t *)buffer + range.location;
+	for (NSUInteger i = 0; i < range.length; i++) {
+		if (bytes[i] >= 0x80) return [GTCommitRecordString(buffer, range) dataUsingEncoding:NSUTF8StringEncoding];
+	}
+
+	return [NSData dataWithBytesNoCopy:(void *)bytes length:range.length freeWhenDone:NO];
+}
+
+// The literal runs which every match of a pattern must contain, or nil if the
+// pattern is beyond this simple reading of it.
+static NSArray *GTCommitMessageIndexRequiredLiterals(NSString *pattern, NSRegularExpressionOptions options) {
+	if ((options & NSRegularExpressionIgnoreMetacharacters) != 0) return @[ pattern ];
+	if ((options & NSRegularExpressionAllowCommentsAndWhitespace) != 0) return nil;
+
+	NSMutableArray *literals = [NSMutableArray array];
+	NSMutableString *run = [NSMutableString string];
+	BOOL lastWasLiteral = NO;
+
+	void (^flush)(void) = ^{
+		if (run.length > 0) [literals addObject:[run copy]];
+		[run setString:@""];
+	};
+
+	NSUInteger length = pattern.length;
+	NSUInteger i = 0;
+	while (i < length) {
+		unichar c = [pattern characterAtIndex:i++];
+
+		if (c == '|') return nil;
+
+		if (c == '*' || c == '?' || c == '+' || c == '{') {
+			BOOL optional = (c == '*' || c == '?');
+			if (c == '{') {
+				NSUInteger close = [pattern rangeOfString:@"}" options:0 range:NSMakeRange(i, length - i)].location;
+				if (close == NSNotFound) return nil;
+
+				optional = ([pattern characterAtIndex:i] == '0' || [pattern characterAtIndex:i] == ',');
+				i = close + 1;
+			}
+
+			// The quantified character may not be there, or be there many times.
+			if (lastWasLiteral && run.length > 0) {
+				NSRange quantifiedRange = [run rangeOfComposedCharacterSequenceAtIndex:run.length - 1];
+				NSString *quantified = [run substringWithRange:quantifiedRange];
+				[run deleteCharactersInRange:quantifiedRange];
+				flush();
+				if (!optional) [literals addObject:quantified];
+			} else {
+				flush();
+			}
+
+			// Lazy and possessive quantifiers.
+			if (i < length && ([pattern characterAtIndex:i] == '?' || [pattern characterAtIndex:i] == '+')) i++;
+
+			lastWasLiteral = NO;
+			continue;
+		}
+
+		if (c == '(' || c == '[') {
+			// Inline flags, like (?i) or (?x:…), change how the rest of the
+			// pattern reads.
+			if (c == '(' && i + 1 < length && [pattern characterAtIndex:i] == '?') {
+				unichar flag = [pattern characterAtIndex:i + 1];
+				if (flag == '-' || [NSCharacterSet.letterCharacterSet characterIsMember:flag]) return nil;
+			}
+
+			// Skip the group or set, since it may be optional or have
+			// alternatives.
+			flush();
+
+			unichar close = (c == '(' ? ')' : ']');
+			NSUInteger depth = 1;
+			while (i < length && depth > 0) {
+				unichar d = [pattern characterAtIndex:i++];
+				if (d == '\\') {
+					i++;
+				} else if (d == c) {
+					depth++;
+				} else if (d == close) {
+					depth--;
+				}
+			}
+
+			if (depth > 0) return nil;
+
+			lastWasLiteral = NO;
+			continue;
+		}
+
+		if (c == '.' || c == '^' || c == '$') {
+			flush();
+			lastWasLiteral = NO;
+			continue;
+		}
+
+		if (c == '\\') {
+			if (i >= length) return nil;
+
+			unichar escaped = [pattern characterAtIndex:i++];
+			if (escaped == 'Q') {
+				NSUInteger end = [pattern rangeOfString:@"\\E" options:0 range:NSMakeRange(i, length - i)].location;
+				if (end == NSNotFound) end = length;
+
+				// A quantifier after the \E applies to the last quoted
+				// character alone.
+				if (end > i) {
+					[run appendString:[pattern substringWithRange:NSMakeRange(i, end - i)]];
+					lastWasLiteral = YES;
+				}
+
+				i = MIN(end + 2, length);
+				continue;
+			}
+
+			if (escaped == 't' || escaped == 'n') {
+				[run appendString:(escaped == 't' ? @"\t" : @"\n")];
+				lastWasLiteral = YES;
+				continue;
+			}
+
+			if ([NSCharacterSet.alphanumericCharacterSet characterIsMember:escaped]) {
+				// Character classes and anchors match no particular text. Other
+				// escapes could mean anything, so give up on them.
+				if ([@"wWdDsSbBAzZG" rangeOfString:[NSString stringWithCharacters:&escaped length:1]].location == NSNotFound) return nil;
+
+				flush();
+				lastWasLiteral = NO;
+				continue;
+			}
+
+			c = escaped;
+		}
+
+		[run appendString:[NSString stringWithCharacters:&c length:1]];
+		lastWasLiteral = YES;
+	}
+
+	flush();
+
+	if ((options & NSRegularExpressionCaseInsensitive) != 0) {
+		// Only ASCII letters are folded in the index.
+		NSCharacterSet *nonASCII = [[NSCharacterSet characterSetWithRange:NSMakeRange(0, 128)] invertedSet];
+		NSIndexSet *indexes = [literals indexesOfObjectsPassingTest:^(NSString *literal, NSUInteger idx, BOOL *stop) {
+			return (BOOL)([literal rangeOfCharacterFromSet:nonASCII].location == NSNotFound);
+		}];
+
+		return [literals objectsAtIndexes:indexes];
+	}
+
+	return literals;
+}
+
+// A trigram's list of commits.
+@interface GTCommitMessagePostingList : NSObject
+
+@property (nonatomic, strong) NSMutableData *data;
+@property (nonatomic, assign) uint32_t count;
+@property (nonatomic, assign) uint32_t lastNumber;
+
+@end
+
+@implementation GTCommitMessagePostingList
+
+- (void)addNumber:(uint32_t)number {
+	GTCommitMessageIndexAppendVarint(self.data, number - self.lastNumber);
+	self.lastNumber = number;
+	self.count++;
+}
+
+// Decodes the list into `numbers`, which must have room for `count` of them.
+- (void)getNumbers:(uint32_t *)numbers {
+	const uint8_t *bytes = self.data.bytes;
+	NSUInteger length = self.data.length;
+	NSUInteger offset = 0;
+	uint32_t number = 0;
+
+	for (uint32_t i = 0; i < self.count && offset < length; i++) {
+		uint32_t gap = 0;
+		NSUInteger shift = 0;
+		uint8_t byte;
+		do {
+			byte = bytes[offset++];
+			gap |= (uint32_t)(byte & 0x7f) << shift;
+			shift += 7;
+		} while ((byte & 0x80) != 0 && offset < length);
+
+		number += gap;
+		numbers[i] = number;
+	}
+}
+
+@end
+
+@interface GTCommitMessageIndex () {
+	// The loaded file, and pointers into it.
+	NSData *_loadedData;
+	NSUInteger _loadedCount;
+	const uint8_t *_loadedOids;
+
+	// Loaded commit numbers, sorted by oid.
+	uint32_t *_loadedNumbersByOid;
+}
+
+// The GTOIDs of commits added since loading, by commit number.
+@property (nonatomic, strong) NSMutableArray *addedOIDs;
+@property (nonatomic, strong) NSMutableSet *addedOIDSet;
+
+// GTCommitMessagePostingLists keyed by NSNumber trigrams.
+@property (nonatomic, strong) NSMutableDictionary *postingLists;
+
+@property (nonatomic, assign) BOOL hasUnsavedChanges;
+
+@end
+
+@implementation GTCommitMessageIndex
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> fileURL: %@, count: %lu", NSStringFromClass([self class]), self, self.fileURL, (unsigned long)self.count];
+}
+
+- (void)dealloc {
+	free(_loadedNumbersByOid);
+}
+
+#pragma mark API
+
++ (NSURL *)defaultFileURLForRepository:(GTRepository *)repository {
+	return GTIndexFileURLForRepository(repository, @"messages", NO);
+}
+
+- (id)initWithRepository:(GTRepository *)repository fileURL:(NSURL *)fileURL error:(NSError **)error {
+	NSParameterAssert(repository != nil);
+	NSParameterAssert(fileURL != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_repository = repository;
+	_fileURL = [fileURL copy];
+	_addedOIDs = [NSMutableArray array];
+	_addedOIDSet = [NSMutableSet set];
+	_postingLists = [NSMutableDictionary dictionary];
+
+	NSData *data = nil;
+	if (!GTIndexFileReadData(fileURL, &data, error)) return nil;
+	if (data != nil && ![self loadData:data error:error]) return nil;
+
+	return self;
+}
+
+- (NSUInteger)count {
+	@synchronized (self) {
+		return _loadedCount + self.addedOIDs.count;
+	}
+}
+
+- (BOOL)containsOID:(GTOID *)oid {
+	NSParameterAssert(oid != nil);
+
+	@synchronized (self) {
+		return [self containsGitOid:oid.git_oid];
+	}
+}
+
+- (BOOL)addCommitsReachableFromOIDs:(NSArray *)oids error:(NSError **)error {
+	NSParameterAssert(oids != nil);
+
+	GTCommitGraph *graph = [self.repository walkableCommitGraphWithError:error];
+	if (graph == nil) return NO;
+
+	NSMutableData *pendingData = [NSMutableData data];
+
+	[graph lock];
+
+	NSData *positionData = [graph positionsReachableFromOIDs:oids error:error];
+	const GTCommitGraphPosition *positions = positionData.bytes;
+	NSUInteger positionCount = positionData.length / sizeof(*positions);
+
+	// Oldest first, so commit numbers roughly follow history.
+	@synchronized (self) {
+		for (NSUInteger i = positionCount; i > 0; i--) {
+			const git_oid *oid = [graph gitOidAtPosition:positions[i - 1]];
+			if (![self containsGitOid:oid]) [pendingData appendBytes:oid length:sizeof(*oid)];
+		}
+	}
+
+	[graph unlock];
+
+	if (positionData == nil) return NO;
+
+	return [self enumerateRecordsForGitOids:pendingData.bytes count:pendingData.length / sizeof(git_oid) error:error usingBlock:^(const GTCommitRecord *records, NSUInteger count, const char *buffer, BOOL *stop) {
+		[self addRecords:records count:count buffer:buffer];
+	}];
+}
+
+- (BOOL)writeWithError:(NSError **)error {
+	NSMutableData *data = nil;
+	@synchronized (self) {
+		data = [self serializedData];
+	}
+
+	if (!GTIndexFileWriteData(data, self.fileURL, error)) return NO;
+
+	@synchronized (self) {
+		self.hasUnsavedChanges = NO;
+	}
+
+	return YES;
+}
+
+- (NSArray *)candidateOIDsForSubstring:(NSString *)string {
+	NSParameterAssert(string != nil);
+
+	return [self candidateOIDsForLiterals:@[ string ]];
+}
+
+- (NSArray *)candidateOIDsForRegularExpression:(NSRegularExpression *)regularExpression {
+	NSParameterAssert(regularExpression != nil);
+
+	NSArray *literals = GTCommitMessageIndexRequiredLiterals(regularExpression.pattern, regularExpression.options);
+	if (literals == nil) return nil;
+
+	return [self candidateOIDsForLiterals:literals];
+}
+
+- (NSArray *)OIDsOfCommitsWithMessagesMatchingRegularExpression:(NSRegularExpression *)regularExpression error:(NSError **)error {
+	NSParameterAssert(regularExpression != nil);
+
+	NSArray *candidates = [self candidateOIDsForRegularExpression:regularExpression];
+	if (candidates == nil) {
+		@synchronized (self) {
+			NSMutableArray *allOIDs = [NSMutableArray arrayWithCapacity:_loadedCount + self.addedOIDs.count];
+			for (NSUInteger i = 0; i < _loadedCount; i++) {
+				[allOIDs addObject:[GTOID oidWithGitOid:(const git_oid *)(_loadedOids + i * GIT_OID_RAWSZ)]];
+			}
+
+			[allOIDs addObjectsFromArray:self.addedOIDs];
+			candidates = allOIDs;
+		}
+	}
+
+	NSMutableData *candidateData = [NSMutableData dataWithCapacity:candidates.count * sizeof(git_oid)];
+	for (GTOID *oid in candidates) {
+		[candidateData appendBytes:oid.git_oid length:sizeof(git_oid)];
+	}
+
+	NSMutableArray *matches = [NSMutableArray array];
+	BOOL success = [self enumerateRecordsForGitOids:candidateData.bytes count:candidates.count error:error usingBlock:^(const GTCommitRecord *records, NSUInteger count, const char *buffer, BOOL *stop) {
+		for (NSUInteger i = 0; i < count; i++) {
+			NSString *message = GTCommitRecordString(buffer, records[i].message);
+			if ([regularExpression firstMatchInString:message options:0 range:NSMakeRange(0, message.length)] == nil) continue;
+
+			[matches addObject:[GTOID oidWithGitOid:&records[i].oid]];
+		}
+	}];
+
+	return (success ? matches : nil);
+}
+
+#pragma mark Indexing
+
+// Must be called while synchronized on the receiver.
+- (BOOL)containsGitOid:(const git_oid *)oid {
+	NSUInteger low = 0;
+	NSUInteger high = _loadedCount;
+	while (low < high) {
+		NSUInteger middle = low + (high - low) / 2;
+		int comparison = memcmp(_loadedOids + _loadedNumbersByOid[middle] * GIT_OID_RAWSZ, oid->id, GIT_OID_RAWSZ);
+		if (comparison == 0) return YES;
+
+		if (comparison < 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return [self.addedOIDSet containsObject:[GTOID oidWithGitOid:oid]];
+}
+
+// Reads commits from the object database, a batch at a time.
+- (BOOL)enumerateRecordsForGitOids:(const git_oid *)oids count:(NSUInteger)count error:(NSError **)error usingBlock:(GTCommitRecordBlock)block {
+	git_odb *odb = NULL;
+	int gitError = git_repository_odb(&odb, self.repository.git_repository);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to open object database."];
+		return NO;
+	}
+
+	GTCommitRecordBatch batch;
+	GTCommitRecordBatchInit(&batch, GTCommitRecordDefaultBatchSize);
+
+	BOOL success = YES;
+	BOOL stop = NO;
+	for (NSUInteger start = 0; start < count && success && !stop; start += batch.capacity) {
+		@autoreleasepool {
+			GTCommitRecordBatchReset(&batch);
+
+			NSUInteger end = MIN(start + batch.capacity, count);
+			for (NSUInteger i = start; i < end && success; i++) {
+				success = GTCommitRecordBatchAppendFromOdb(&batch, odb, &oids[i], error);
+			}
+
+			if (success) {
+				GTCommitRecordBatchFinish(&batch);
+				block(batch.records, batch.count, batch.buffer, &stop);
+			}
+		}
+	}
+
+	GTCommitRecordBatchFree(&batch);
+	git_odb_free(odb);
+
+	return success;
+}
+
+- (void)addRecords:(const GTCommitRecord *)records count:(NSUInteger)count buffer:(const char *)buffer {
+	// Reading a message as Latin-1 at most doubles its length in UTF-8.
+	NSUInteger trigramCapacity = 0;
+	for (NSUInteger i = 0; i < count; i++) {
+		trigramCapacity = MAX(trigramCapacity, 2 * records[i].message.length);
+	}
+
+	uint32_t *trigrams = malloc(MAX(trigramCapacity, (NSUInteger)1) * sizeof(*trigrams));
+
+	@synchronized (self) {
+		for (NSUInteger i = 0; i < count; i++) {
+			const GTCommitRecord *record = &records[i];
+			GTOID *oid = [GTOID oidWithGitOid:&record->oid];
+			if ([self containsGitOid:oid.git_oid]) continue;
+
+			uint32_t number = (uint32_t)(_loadedCount + self.addedOIDs.count);
+			[self.addedOIDs addObject:oid];
+			[self.addedOIDSet addObject:oid];
+
+			NSData *messageData = GTCommitMessageIndexMessageData(buffer, record->message);
+			NSUInteger trigramCount = GTCommitMessageIndexGetTrigrams(messageData.bytes, messageData.length, trigrams);
+			for (NSUInteger j = 0; j < trigramCount; j++) {
+				NSNumber *key = @(trigrams[j]);
+				GTCommitMessagePostingList *list = self.postingLists[key];
+				if (list == nil) {
+					list = [[GTCommitMessagePostingList alloc] init];
+					list.data = [NSMutableData data];
+					self.postingLists[key] = list;
+				}
+
+				[list addNumber:number];
+			}
+
+			self.hasUnsavedChanges = YES;
+		}
+	}
+
+	free(trigrams);
+}
+
+#pragma mark Queries
+
+// Intersects the lists of every trigram in the literals, or returns nil if
+// there are no trigrams to go on.
+- (NSArray *)candidateOIDsForLiterals:(NSArray *)literals {
+	NSMutableData *trigramData = [NSMutableData data];
+	for (NSString *literal in literals) {
+		NSData *bytes = [literal dataUsingEncoding:NSUTF8StringEncoding];
+		if (bytes.length < 3) continue;
+
+		NSUInteger offset = trigramData.length;
+		trigramData.length += bytes.length * sizeof(uint32_t);
+		NSUInteger count = GTCommitMessageIndexGetTrigrams(bytes.bytes, bytes.length, (uint32_t *)((uint8_t *)trigramData.mutableBytes + offset));
+		trigramData.length = offset + count * sizeof(uint32_t);
+	}
+
+	const uint32_t *trigrams = trigramData.bytes;
+	NSUInteger trigramCount = trigramData.length / sizeof(uint32_t);
+	if (trigramCount == 0) return nil;
+
+	@synchronized (self) {
+		// Start with the shortest list, so every step is as cheap as it can be.
+		NSMutableArray *lists = [NSMutableArray arrayWithCapacity:trigramCount];
+		for (NSUInteger i = 0; i < trigramCount; i++) {
+			GTCommitMessagePostingList *list = self.postingLists[@(trigrams[i])];
+			if (list == nil) return @[];
+			if (![lists containsObject:list]) [lists addObject:list];
+		}
+
+		[lists sortUsingComparator:^(GTCommitMessagePostingList *list1, GTCommitMessagePostingList *list2) {
+			return [@(list1.count) compare:@(list2.count)];
+		}];
+
+		GTCommitMessagePostingList *shortest = lists[0];
+		uint32_t *numbers = malloc(MAX(shortest.count, (uint32_t)1) * sizeof(*numbers));
+		NSUInteger numberCount = shortest.count;
+		[shortest getNumbers:numbers];
+
+		for (NSUInteger i = 1; i < lists.count && numberCount > 0; i++) {
+			GTCommitMessagePostingList *list = lists[i];
+			uint32_t *otherNumbers = malloc(list.count * sizeof(*otherNumbers));
+			[list getNumbers:otherNumbers];
+
+			NSUInteger kept = 0;
+			NSUInteger j = 0;
+			for (NSUInteger k = 0; k < numberCount; k++) {
+				while (j < list.count && otherNumbers[j] < numbers[k]) j++;
+				if (j < list.count && otherNumbers[j] == numbers[k]) numbers[kept++] = numbers[k];
+			}
+
+			numberCount = kept;
+			free(otherNumbers);
+		}
+
+		NSMutableArray *oids = [NSMutableArray arrayWithCapacity:numberCount];
+		for (NSUInteger i = 0; i < numberCount; i++) {
+			[oids addObject:[self OIDForNumber:numbers[i]]];
+		}
+
+		free(numbers);
+
+		return oids;
+	}
+}
+
+// Must be called while synchronized on the receiver.
+- (GTOID *)OIDForNumber:(uint32_t)number {
+	if (number < _loadedCount) return [GTOID oidWithGitOid:(const git_oid *)(_loadedOids + number * GIT_OID_RAWSZ)];
+
+	return self.addedOIDs[number - _loadedCount];
+}
+
+#pragma mark Serialization
+
+// Must be called while synchronized on the receiver.
+- (NSMutableData *)serializedData {
+	NSMutableData *data = GTIndexFileCreateData(GTCommitMessageIndexMagic, GTCommitMessageIndexVersion, 0);
+	GTIndexFileAppendUInt32(data, (uint32_t)(_loadedCount + self.addedOIDs.count));
+	GTIndexFileAppendUInt32(data, (uint32_t)self.postingLists.count);
+
+	if (_loadedCount > 0) [data appendBytes:_loadedOids length:_loadedCount * GIT_OID_RAWSZ];
+	for (GTOID *oid in self.addedOIDs) {
+		[data appendBytes:oid.git_oid->id length:GIT_OID_RAWSZ];
+	}
+
+	NSArray *trigrams = [self.postingLists.allKeys sortedArrayUsingSelector:@selector(compare:)];
+	NSMutableData *listData = [NSMutableData data];
+	for (NSNumber *trigram in trigrams) {
+		GTCommitMessagePostingList *list = self.postingLists[trigram];
+		[listData appendData:list.data];
+
+		GTIndexFileAppendUInt32(data, trigram.unsignedIntValue);
+		GTIndexFileAppendUInt32(data, list.count);
+		GTIndexFileAppendUInt32(data, list.lastNumber);
+		GTIndexFileAppendUInt32(data, (uint32_t)listData.length);
+	}
+
+	[data appendData:listData];
+
+	return data;
+}
+
+- (NSError *)corruptFileError {
+	return GTIndexFileCorruptError(GTCommitMessageIndexErrorCodeCorruptFile, @"The commit message index", self.fileURL);
+}
+
+// Only called from the initializer, before anyone else can see the receiver.
+- (BOOL)loadData:(NSData *)data error:(NSError **)error {
+	NSUInteger contentsLength = GTIndexFileContentsLength(data, GTCommitMessageIndexMagic, GTCommitMessageIndexVersion);
+	if (contentsLength == 0) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	GTIndexFileReader reader = GTIndexFileReaderMake(data, contentsLength);
+	uint32_t count = 0;
+	uint32_t trigramCount = 0;
+	const uint8_t *oids = NULL;
+	const uint8_t *entries = NULL;
+	if (!GTIndexFileReaderReadUInt32(&reader, &count) || !GTIndexFileReaderReadUInt32(&reader, &trigramCount) || !GTIndexFileReaderReadArray(&reader, count, GIT_OID_RAWSZ, &oids) || !GTIndexFileReaderReadArray(&reader, trigramCount, GTCommitMessageIndexTrigramEntryLength, &entries)) {
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	// The rest is list data.
+	NSUInteger listLength = reader.length - reader.offset;
+	const uint8_t *listBytes = NULL;
+	GTIndexFileReaderReadBytes(&reader, listLength, &listBytes);
+
+	NSUInteger previousEnd = 0;
+	for (NSUInteger i = 0; i < trigramCount; i++) {
+		const uint8_t *entry = entries + i * GTCommitMessageIndexTrigramEntryLength;
+		NSUInteger end = GTIndexFileReadUInt32(entry + 12);
+		if (end < previousEnd || end > listLength) {
+			[self.postingLists removeAllObjects];
+			if (error != NULL) *error = self.corruptFileError;
+			return NO;
+		}
+
+		GTCommitMessagePostingList *list = [[GTCommitMessagePostingList alloc] init];
+		list.data = [NSMutableData dataWithBytes:listBytes + previousEnd length:end - previousEnd];
+		list.count = GTIndexFileReadUInt32(entry + 4);
+		list.lastNumber = GTIndexFileReadUInt32(entry + 8);
+		self.postingLists[@(GTIndexFileReadUInt32(entry))] = list;
+
+		previousEnd = end;
+	}
+
+	if (previousEnd != listLength) {
+		[self.postingLists removeAllObjects];
+		if (error != NULL) *error = self.corruptFileError;
+		return NO;
+	}
+
+	_loadedData = data;
+	_loadedCount = count;
+	_loadedOids = oids;
+
+	_loadedNumbersByOid = malloc(MAX(count, (NSUInteger)1) * sizeof(*_loadedNumbersByOid));
+	for (NSUInteger i = 0; i < count; i++) {
+		_loadedNumbersByOid[i] = (uint32_t)i;
+	}
+
+	qsort_b(_loadedNumbersByOid, count, sizeof(*_loadedNumbersByOid), ^(const void *a, const void *b) {
+		return memcmp(oids + *(const uint32_t *)a * GIT_OID_RAWSZ, oids + *(const uint32_t *)b * GIT_OID_RAWSZ, GIT_OID_RAWSZ);
+	});
+
+	return YES;
+}
+
+@end
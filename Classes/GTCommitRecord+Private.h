@@ -0,0 +1,45 @@
+//
+//  GTCommitRecord+Private.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCommitRecord.h"
+
+// A batch of records and the buffer they point into, reused from one batch to
+// the next so a scan doesn't allocate per commit.
+typedef struct {
+	GTCommitRecord *records;
+	NSUInteger count;
+	NSUInteger capacity;
+
+	char *buffer;
+	NSUInteger bufferLength;
+	NSUInteger bufferCapacity;
+
+	// Where each record's parents start in `buffer`. The buffer may move while
+	// the batch fills, so `parents` is only set by GTCommitRecordBatchFinish().
+	NSUInteger *parentOffsets;
+} GTCommitRecordBatch;
+
+void GTCommitRecordBatchInit(GTCommitRecordBatch *batch, NSUInteger capacity);
+void GTCommitRecordBatchFree(GTCommitRecordBatch *batch);
+
+// Empty the batch, keeping its storage.
+void GTCommitRecordBatchReset(GTCommitRecordBatch *batch);
+
+// Copy a raw commit into the batch and parse it into the next record. The
+// batch must not be full.
+//
+// returns NO if the commit is malformed, in which case the batch is unchanged.
+BOOL GTCommitRecordBatchAppend(GTCommitRecordBatch *batch, const git_oid *oid, const char *data, size_t length);
+
+// Point every record's `parents` into the buffer, once the batch is full.
+void GTCommitRecordBatchFinish(GTCommitRecordBatch *batch);
+
+// Read a commit from the object database and append it to the batch.
+//
+// returns NO and fills `error` if the commit couldn't be read or parsed.
+BOOL GTCommitRecordBatchAppendFromOdb(GTCommitRecordBatch *batch, git_odb *odb, const git_oid *oid, NSError **error);
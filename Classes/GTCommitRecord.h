@@ -0,0 +1,63 @@
+//
+//  GTCommitRecord.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "git2.h"
+
+// The number of records handed to a GTCommitRecordBlock at a time by default.
+static const NSUInteger GTCommitRecordDefaultBatchSize = 1024;
+
+// A commit, read straight out of the object database without creating a
+// GTCommit, a git_commit or any strings.
+//
+// The text fields are ranges of bytes in the buffer the record was handed out
+// with, and `parents` points into that buffer too, so a record is only valid
+// for as long as its buffer is. Use GTCommitRecordString() to turn a range
+// into a string when it's actually needed.
+typedef struct {
+	git_oid oid;
+	git_oid tree;
+
+	// The commit's parents, in order.
+	const git_oid *parents;
+	NSUInteger parentCount;
+
+	// Times are in seconds since the epoch, and offsets are the time zone in
+	// minutes east of UTC.
+	git_time_t authorTime;
+	int authorOffset;
+	git_time_t commitTime;
+	int commitOffset;
+
+	NSRange authorName;
+	NSRange authorEmail;
+	NSRange committerName;
+	NSRange committerEmail;
+
+	// The raw message, including the summary line and trailing newline.
+	NSRange message;
+} GTCommitRecord;
+
+// Handles a batch of commit records.
+//
+// records - The records. Only valid until the block returns.
+// count   - The number of records.
+// buffer  - The bytes the records' ranges refer to. Only valid until the block
+//           returns.
+// stop    - Set to YES to stop the enumeration after this batch.
+typedef void (^GTCommitRecordBlock)(const GTCommitRecord *records, NSUInteger count, const char *buffer, BOOL *stop);
+
+// Create a string from a range of a record buffer.
+//
+// The bytes are expected to be UTF-8. Commits in other encodings are decoded
+// as Latin-1 rather than failing.
+//
+// buffer - The buffer the record was handed out with. Cannot be NULL.
+// range  - One of the record's ranges.
+//
+// returns the string.
+extern NSString *GTCommitRecordString(const char *buffer, NSRange range);
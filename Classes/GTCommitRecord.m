@@ -0,0 +1,183 @@
+//
+//  GTCommitRecord.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTCommitRecord.h"
+#import "GTCommitRecord+Private.h"
+#import "NSError+Git.h"
+
+// A `parent <sha>\n` line, which bounds how many parents a commit of a given
+// size can have.
+static const size_t GTCommitRecordParentLineLength = 48;
+
+NSString *GTCommitRecordString(const char *buffer, NSRange range) {
+	NSCParameterAssert(buffer != NULL);
+
+	NSString *string = [[NSString alloc] initWithBytes:buffer + range.location length:range.length encoding:NSUTF8StringEncoding];
+	if (string == nil) string = [[NSString alloc] initWithBytes:buffer + range.location length:range.length encoding:NSISOLatin1StringEncoding];
+
+	return string;
+}
+
+static inline BOOL GTCommitRecordLineHasPrefix(const char *line, const char *lineEnd, const char *prefix, size_t prefixLength) {
+	return (size_t)(lineEnd - line) >= prefixLength && memcmp(line, prefix, prefixLength) == 0;
+}
+
+// Parses `Name <email> 1234567890 +0100`. Ranges are relative to `base`.
+static BOOL GTCommitRecordParseSignature(const char *base, const char *start, const char *end, NSRange *name, NSRange *email, git_time_t *time, int *offset) {
+	const char *emailStart = memchr(start, '<', end - start);
+	if (emailStart == NULL) return NO;
+
+	const char *emailEnd = memchr(emailStart, '>', end - emailStart);
+	if (emailEnd == NULL) return NO;
+
+	const char *nameEnd = emailStart;
+	while (nameEnd > start && nameEnd[-1] == ' ') nameEnd--;
+
+	*name = NSMakeRange(start - base, nameEnd - start);
+	*email = NSMakeRange(emailStart + 1 - base, emailEnd - emailStart - 1);
+
+	const char *p = emailEnd + 1;
+	while (p < end && *p == ' ') p++;
+
+	git_time_t seconds = 0;
+	while (p < end && *p >= '0' && *p <= '9') seconds = seconds * 10 + (*p++ - '0');
+	*time = seconds;
+
+	while (p < end && *p == ' ') p++;
+
+	*offset = 0;
+	if (end - p >= 5 && (*p == '+' || *p == '-')) {
+		int hours = (p[1] - '0') * 10 + (p[2] - '0');
+		int minutes = (p[3] - '0') * 10 + (p[4] - '0');
+		*offset = (*p == '-' ? -1 : 1) * (hours * 60 + minutes);
+	}
+
+	return YES;
+}
+
+// Parses the commit at `start`, writing its parents to `parents`. Ranges are
+// relative to `base`.
+static BOOL GTCommitRecordParse(GTCommitRecord *record, const char *base, const char *start, size_t length, git_oid *parents) {
+	const char *end = start + length;
+	const char *p = start;
+	BOOL hasTree = NO;
+	BOOL hasAuthor = NO;
+	BOOL hasCommitter = NO;
+
+	record->parentCount = 0;
+
+	while (p < end && *p != '\n') {
+		const char *lineEnd = memchr(p, '\n', end - p);
+		if (lineEnd == NULL) lineEnd = end;
+
+		if (!hasTree && GTCommitRecordLineHasPrefix(p, lineEnd, "tree ", 5)) {
+			if (lineEnd - p < 5 + GIT_OID_HEXSZ || git_oid_fromstrn(&record->tree, p + 5, GIT_OID_HEXSZ) < GIT_OK) return NO;
+			hasTree = YES;
+		} else if (GTCommitRecordLineHasPrefix(p, lineEnd, "parent ", 7)) {
+			if (lineEnd - p < 7 + GIT_OID_HEXSZ || git_oid_fromstrn(&parents[record->parentCount], p + 7, GIT_OID_HEXSZ) < GIT_OK) return NO;
+			record->parentCount++;
+		} else if (!hasAuthor && GTCommitRecordLineHasPrefix(p, lineEnd, "author ", 7)) {
+			if (!GTCommitRecordParseSignature(base, p + 7, lineEnd, &record->authorName, &record->authorEmail, &record->authorTime, &record->authorOffset)) return NO;
+			hasAuthor = YES;
+		} else if (!hasCommitter && GTCommitRecordLineHasPrefix(p, lineEnd, "committer ", 10)) {
+			if (!GTCommitRecordParseSignature(base, p + 10, lineEnd, &record->committerName, &record->committerEmail, &record->commitTime, &record->commitOffset)) return NO;
+			hasCommitter = YES;
+		}
+
+		// Anything else is a header we don't care about (like `encoding` or
+		// `gpgsig`), or a continuation line of one.
+		p = lineEnd + 1;
+	}
+
+	if (!hasTree || !hasAuthor || !hasCommitter) return NO;
+
+	const char *messageStart = MIN(p + 1, end);
+	record->message = NSMakeRange(messageStart - base, end - messageStart);
+
+	return YES;
+}
+
+#pragma mark Batches
+
+void GTCommitRecordBatchInit(GTCommitRecordBatch *batch, NSUInteger capacity) {
+	NSCParameterAssert(capacity > 0);
+
+	memset(batch, 0, sizeof(*batch));
+	batch->capacity = capacity;
+	batch->records = malloc(capacity * sizeof(*batch->records));
+	batch->parentOffsets = malloc(capacity * sizeof(*batch->parentOffsets));
+}
+
+void GTCommitRecordBatchFree(GTCommitRecordBatch *batch) {
+	free(batch->records);
+	free(batch->parentOffsets);
+	free(batch->buffer);
+	memset(batch, 0, sizeof(*batch));
+}
+
+void GTCommitRecordBatchReset(GTCommitRecordBatch *batch) {
+	batch->count = 0;
+	batch->bufferLength = 0;
+}
+
+BOOL GTCommitRecordBatchAppend(GTCommitRecordBatch *batch, const git_oid *oid, const char *data, size_t length) {
+	NSCParameterAssert(batch->count < batch->capacity);
+
+	// Room for the raw commit, followed by as many parents as it could have.
+	NSUInteger maximumParentCount = length / GTCommitRecordParentLineLength;
+	NSUInteger required = batch->bufferLength + length + maximumParentCount * sizeof(git_oid);
+	if (required > batch->bufferCapacity) {
+		batch->bufferCapacity = MAX(required, batch->bufferCapacity * 2);
+		batch->buffer = realloc(batch->buffer, batch->bufferCapacity);
+	}
+
+	char *start = batch->buffer + batch->bufferLength;
+	memcpy(start, data, length);
+
+	GTCommitRecord *record = &batch->records[batch->count];
+	git_oid *parents = (git_oid *)(start + length);
+	if (!GTCommitRecordParse(record, batch->buffer, start, length, parents)) return NO;
+
+	git_oid_cpy(&record->oid, oid);
+	record->parents = NULL;
+	batch->parentOffsets[batch->count] = (char *)parents - batch->buffer;
+	batch->bufferLength += length + record->parentCount * sizeof(git_oid);
+	batch->count++;
+
+	return YES;
+}
+
+void GTCommitRecordBatchFinish(GTCommitRecordBatch *batch) {
+	for (NSUInteger i = 0; i < batch->count; i++) {
+		batch->records[i].parents = (const git_oid *)(batch->buffer + batch->parentOffsets[i]);
+	}
+}
+
+BOOL GTCommitRecordBatchAppendFromOdb(GTCommitRecordBatch *batch, git_odb *odb, const git_oid *oid, NSError **error) {
+	git_odb_object *object = NULL;
+	int gitError = git_odb_read(&object, odb, oid);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to read commit."];
+		return NO;
+	}
+
+	BOOL success = NO;
+	if (git_odb_object_type(object) == GIT_OBJ_COMMIT) {
+		success = GTCommitRecordBatchAppend(batch, oid, git_odb_object_data(object), git_odb_object_size(object));
+	}
+
+	git_odb_object_free(object);
+
+	if (!success && error != NULL) {
+		char sha[GIT_OID_HEXSZ + 1];
+		git_oid_tostr(sha, sizeof(sha), oid);
+		*error = [NSError git_errorFor:GIT_ERROR withAdditionalDescription:[NSString stringWithFormat:@"%s is not a valid commit.", sha]];
+	}
+
+	return success;
+}
@@ -11,6 +11,7 @@
 #import "GTDiffDelta.h"
 
 @class GTDiffDelta;
+@class GTDiffOptions;
 @class GTRepository;
 @class GTTree;
 
@@ -144,6 +145,40 @@ typedef enum : git_diff_find_t {
 	GTDiffFindOptionsFlagsFindAndBreakRewrites = GIT_DIFF_FIND_AND_BREAK_REWRITES,
 } GTDiffFindOptionsFlags;
 
+// Line counts for one delta, from -deltaStatsWithOptions:totals:error:.
+//
+// addedLinesCount   - The number of lines added.
+// deletedLinesCount - The number of lines deleted.
+// binary            - Whether the files are binary, in which case there are no
+//                     line counts.
+typedef struct {
+	NSUInteger addedLinesCount;
+	NSUInteger deletedLinesCount;
+	BOOL binary;
+} GTDiffDeltaStats;
+
+// Totals over a whole diff, as in `git diff --shortstat`.
+//
+// filesChanged       - The number of deltas.
+// addedLinesCount    - The number of lines added across all deltas.
+// deletedLinesCount  - The number of lines deleted across all deltas.
+// binaryFilesChanged - How many of the deltas are binary.
+typedef struct {
+	NSUInteger filesChanged;
+	NSUInteger addedLinesCount;
+	NSUInteger deletedLinesCount;
+	NSUInteger binaryFilesChanged;
+} GTDiffStats;
+
+// Options for -deltaStatsWithOptions:totals:error:.
+// These options may be bitwise-OR'd together
+enum {
+	GTDiffStatsOptionsNone = 0,
+	GTDiffStatsOptionsConcurrent = 1 << 0, // generate patches on a pool of workers
+};
+
+typedef unsigned int GTDiffStatsOptions;
+
 // A class representing a single "diff".
 //
 // Analagous to `git_diff_list` in libgit2, this object represents a list of
@@ -170,6 +205,14 @@ typedef enum : git_diff_find_t {
 // Returns a newly created `GTDiff` object or nil on error.
 + (GTDiff *)diffOldTree:(GTTree *)oldTree withNewTree:(GTTree *)newTree options:(NSDictionary *)options error:(NSError **)error;
 
+// Create a diff between 2 `GTTree`s, with prepared options.
+//
+// This is the same as +diffOldTree:withNewTree:options:error:, but without
+// parsing the options again.
+//
+// options - The options to diff with, or nil to use the defaults.
++ (GTDiff *)diffOldTree:(GTTree *)oldTree withNewTree:(GTTree *)newTree diffOptions:(GTDiffOptions *)options error:(NSError **)error;
+
 // Create a diff between a repository's current index.
 //
 // This is equivalent to `git diff --cached <treeish>` or if you pass the HEAD
@@ -188,6 +231,15 @@ typedef enum : git_diff_find_t {
 // Returns a newly created `GTDiff` object or nil on error.
 + (GTDiff *)diffIndexFromTree:(GTTree *)tree options:(NSDictionary *)options error:(NSError **)error;
 
+// Create a diff between a tree and its repository's index, with prepared
+// options.
+//
+// This is the same as +diffIndexFromTree:options:error:, but without parsing
+// the options again.
+//
+// options - The options to diff with, or nil to use the defaults.
++ (GTDiff *)diffIndexFromTree:(GTTree *)tree diffOptions:(GTDiffOptions *)options error:(NSError **)error;
+
 // Create a diff between the index and working directory in a given repository.
 //
 // This matches the `git diff` command.
@@ -201,6 +253,15 @@ typedef enum : git_diff_find_t {
 // Returns a newly created `GTDiff` object or nil on error.
 + (GTDiff *)diffIndexToWorkingDirectoryInRepository:(GTRepository *)repository options:(NSDictionary *)options error:(NSError **)error;
 
+// Create a diff between the index and working directory in a given
+// repository, with prepared options.
+//
+// This is the same as +diffIndexToWorkingDirectoryInRepository:options:error:,
+// but without parsing the options again.
+//
+// options - The options to diff with, or nil to use the defaults.
++ (GTDiff *)diffIndexToWorkingDirectoryInRepository:(GTRepository *)repository diffOptions:(GTDiffOptions *)options error:(NSError **)error;
+
 // Create a diff between a repository's working directory and a tree.
 //
 // tree    - The tree to be diffed. The tree will be the left side of the diff.
@@ -212,6 +273,15 @@ typedef enum : git_diff_find_t {
 // Returns a newly created `GTDiff` object or nil on error.
 + (GTDiff *)diffWorkingDirectoryFromTree:(GTTree *)tree options:(NSDictionary *)options error:(NSError **)error;
 
+// Create a diff between a repository's working directory and a tree, with
+// prepared options.
+//
+// This is the same as +diffWorkingDirectoryFromTree:options:error:, but
+// without parsing the options again.
+//
+// options - The options to diff with, or nil to use the defaults.
++ (GTDiff *)diffWorkingDirectoryFromTree:(GTTree *)tree diffOptions:(GTDiffOptions *)options error:(NSError **)error;
+
 // Designated initialiser.
 - (instancetype)initWithGitDiffList:(git_diff_list *)diffList;
 
@@ -220,10 +290,11 @@ typedef enum : git_diff_find_t {
 
 // Enumerate the deltas in a diff.
 //
-// It is worth noting that the `git_diff_patch` objects backing each delta
-// contain the entire contents in memory. It is therefore recommended you
-// do not store the `delta` object given here, but instead perform any work
-// necessary within the provided block.
+// Deltas are cheap until their hunks or line counts are asked for, at which
+// point their `git_diff_patch` is generated, which loads the entire contents
+// of both files into memory. It is therefore recommended you do not store the
+// `delta` object given here, but instead perform any work necessary within
+// the provided block.
 //
 // Also note that this method blocks during the enumeration.
 //
@@ -231,10 +302,105 @@ typedef enum : git_diff_find_t {
 //         immediately stops the enumeration.
 - (void)enumerateDeltasUsingBlock:(void (^)(GTDiffDelta *delta, BOOL *stop))block;
 
+// Enumerate the deltas in a diff with their patches, generating the patches on
+// a pool of workers.
+//
+// Each worker reads blobs through its own handle on the repository, so patches
+// for many deltas are generated at once. The block is still called serially,
+// in delta order, and only a bounded number of patches are held waiting for
+// it, so memory use doesn't grow with the size of the diff. Deltas whose
+// contents aren't all in the object database (like working directory files),
+// or whose paths have a `diff` attribute (like files marked `binary`), have
+// their patches generated on the calling thread instead, so the patches are
+// the same as -enumerateDeltasUsingBlock: would give.
+//
+// error(out) - will be filled if an error occurs
+// block      - A block to be executed for each delta. Setting `stop` to `YES`
+//              stops the enumeration.
+//
+// Returns NO if an error occurred.
+- (BOOL)enumerateDeltasConcurrentlyWithError:(NSError **)error usingBlock:(void (^)(GTDiffDelta *delta, BOOL *stop))block;
+
+// Count the added and deleted lines of every delta, as in `git diff --numstat`.
+//
+// Each patch is generated, counted and freed in turn, without creating any
+// `GTDiffDelta`s, so this is much cheaper than asking every delta for its
+// line counts.
+//
+// options    - With `GTDiffStatsOptionsConcurrent`, patches are generated on a
+//              pool of workers, as in
+//              -enumerateDeltasConcurrentlyWithError:usingBlock:.
+// totals     - If not NULL, filled in with the totals over the whole diff.
+// error(out) - will be filled if an error occurs
+//
+// Returns an `NSData` containing a `GTDiffDeltaStats` for each delta, in delta
+// order, or nil if an error occurred.
+- (NSData *)deltaStatsWithOptions:(GTDiffStatsOptions)options totals:(GTDiffStats *)totals error:(NSError **)error;
+
+// Write the whole diff as a unified patch, as in `git diff`, to a file
+// descriptor.
+//
+// File headers use the prefixes given by `GTDiffOptionsOldPrefixKey` and
+// `GTDiffOptionsNewPrefixKey`, and binary files are marked as such rather than
+// printed. Patches are generated one delta at a time and written through a
+// fixed-size buffer, without creating any objects along the way, so memory use
+// doesn't grow with the size of the diff.
+//
+// fileDescriptor - The file descriptor to write to. It isn't closed.
+// error(out)     - will be filled if an error occurs
+//
+// Returns NO if an error occurred, in which case some of the patch may already
+// have been written.
+- (BOOL)writePatchToFileDescriptor:(int)fileDescriptor error:(NSError **)error;
+
+// Write the whole diff as a unified patch to a stream, as with
+// -writePatchToFileDescriptor:error:.
+//
+// stream     - The stream to write to. It must already be open, and is left
+//              open. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// Returns NO if an error occurred.
+- (BOOL)writePatchToOutputStream:(NSOutputStream *)stream error:(NSError **)error;
+
 // Modify the diff list to combine similar changes using the given options.
 //
 // options - A dictionary containing any of the above find options key constants
 //           or nil to use the defaults.
 - (void)findSimilarWithOptions:(NSDictionary *)options;
 
+// Modify the diff list to combine similar changes using prepared options.
+//
+// options - The options containing any of the above find options key
+//           constants, or nil to use the defaults.
+- (void)findSimilarWithDiffOptions:(GTDiffOptions *)options;
+
+// Find renames and copies without comparing every pair of files.
+//
+// Unlike -findSimilarWithOptions:, which compares every added file against
+// every deleted one up to `GTDiffFindOptionsTargetLimitKey`, this sketches
+// each blob with a MinHash signature of its lines, and only compares files
+// whose signatures share a band of values (locality-sensitive hashing), which
+// copes with diffs adding and deleting thousands of files. Candidates are then
+// scored exactly, with git's similarity index.
+//
+// Sketches are cached by the repository, keyed by blob OID, so diffs touching
+// the same blobs again barely read them.
+//
+// Only files whose contents are in the object database are considered, and
+// the diff itself isn't changed.
+//
+// options    - A dictionary containing `GTDiffFindOptionsFlagsKey`,
+//              `GTDiffFindOptionsRenameThresholdKey` and
+//              `GTDiffFindOptionsCopyThresholdKey`, or nil to use the
+//              defaults. Copies are only looked for with
+//              `GTDiffFindOptionsFlagsFindCopies`, from modified files, and
+//              also from unmodified files (if the diff includes them) with
+//              `GTDiffFindOptionsFlagsFindCopiesFromUnmodified`.
+// error(out) - will be filled if an error occurs
+//
+// Returns an array of `GTDiffRename`s, ordered by the index of their new
+// file's delta, or nil if an error occurred.
+- (NSArray *)detectRenamesUsingSketchesWithOptions:(NSDictionary *)options error:(NSError **)error;
+
 @end
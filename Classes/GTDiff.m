@@ -8,8 +8,16 @@
 
 #import "GTDiff.h"
 
+#import "GTBlobSketch.h"
 #import "GTDiffDelta.h"
+#import "GTDiffDelta+Private.h"
+#import "GTDiffFile.h"
+#import "GTDiffOptions.h"
+#import "GTDiffRename.h"
+#import "GTOID.h"
+#import "GTPipeline.h"
 #import "GTRepository.h"
+#import "GTRepository+Private.h"
 #import "GTTree.h"
 
 #import "NSError+Git.h"
@@ -29,118 +37,336 @@ NSString *const GTDiffFindOptionsCopyThresholdKey = @"GTDiffFindOptionsCopyThres
 NSString *const GTDiffFindOptionsBreakRewriteThresholdKey = @"GTDiffFindOptionsBreakRewriteThresholdKey";
 NSString *const GTDiffFindOptionsTargetLimitKey = @"GTDiffFindOptionsTargetLimitKey";
 
-@implementation GTDiff
+// How many deltas each worker may have generated patches for in
+// -enumerateDeltasConcurrentlyWithError:usingBlock: before it waits for the
+// block to catch up.
+static const NSUInteger GTDiffPendingPatchesPerWorker = 16;
 
-+ (git_diff_options *)optionsStructFromDictionary:(NSDictionary *)dictionary {
-	if (dictionary == nil || dictionary.count < 1) return nil;
-	
-	git_diff_options newOptions = GIT_DIFF_OPTIONS_INIT;
-	
-	NSNumber *flagsNumber = dictionary[GTDiffOptionsFlagsKey];
-	if (flagsNumber != nil) newOptions.flags = (uint32_t)flagsNumber.unsignedIntegerValue;
+// Whether one side of a delta is nothing, or a blob in the object database,
+// so that it can be read through any handle on the repository.
+static BOOL GTDiffFileIsInObjectDatabase(const git_diff_file *file, git_odb *odb) {
+	if (git_oid_iszero(&file->oid)) return (file->mode == 0);
+	if (!S_ISREG(file->mode) && !S_ISLNK(file->mode)) return NO;
 	
-	NSNumber *contextLinesNumber = dictionary[GTDiffOptionsContextLinesKey];
-	if (contextLinesNumber != nil) newOptions.context_lines = (uint16_t)contextLinesNumber.unsignedIntegerValue;
+	return git_odb_exists(odb, &file->oid) != 0;
+}
+
+// Whether either side of a delta has the "diff" attribute, set directly or
+// through a macro like "binary". git_diff_patch_from_blobs() doesn't know the
+// delta's paths, so can't honour it as git_diff_get_patch() does.
+static BOOL GTDiffDeltaHasDiffAttribute(const git_diff_delta *delta, git_repository *repository) {
+	const char *paths[] = { delta->old_file.path, delta->new_file.path };
+	for (NSUInteger i = 0; i < sizeof(paths) / sizeof(*paths); i++) {
+		if (paths[i] == NULL) continue;
+		
+		// If the attributes can't be read, leave it to libgit2.
+		const char *value = NULL;
+		if (git_attr_get(&value, repository, GIT_ATTR_CHECK_FILE_THEN_INDEX, paths[i], "diff") != GIT_OK) return YES;
+		if (!GIT_ATTR_UNSPECIFIED(value)) return YES;
+	}
 	
-	NSNumber *interHunkLinesNumber = dictionary[GTDiffOptionsInterHunkLinesKey];
-	if (interHunkLinesNumber != nil) newOptions.interhunk_lines = (uint16_t)interHunkLinesNumber.unsignedIntegerValue;
+	return NO;
+}
+
+// Look up one side of a delta, or NULL if there's nothing on that side.
+static int GTDiffLookUpBlob(git_blob **blob, const git_diff_file *file, git_repository *repository) {
+	*blob = NULL;
+	if (git_oid_iszero(&file->oid)) return GIT_OK;
 	
-	// We cast to char* below to work around a current bug in libgit2, which is
-	// fixed in https://github.com/libgit2/libgit2/pull/1118
+	return git_blob_lookup(blob, repository, &file->oid);
+}
+
+static GTDiffDeltaStats GTDiffDeltaStatsFromPatch(git_diff_patch *patch) {
+	GTDiffDeltaStats stats = { 0 };
+	stats.binary = (git_diff_patch_delta(patch)->binary == 1);
+	if (stats.binary) return stats;
 	
-	NSString *oldPrefix = dictionary[GTDiffOptionsOldPrefixKey];
-	if (oldPrefix != nil) newOptions.old_prefix = (char *)oldPrefix.UTF8String;
+	size_t adds = 0;
+	size_t deletes = 0;
+	git_diff_patch_line_stats(NULL, &adds, &deletes, patch);
+	stats.addedLinesCount = adds;
+	stats.deletedLinesCount = deletes;
 	
-	NSString *newPrefix = dictionary[GTDiffOptionsNewPrefixKey];
-	if (newPrefix != nil) newOptions.new_prefix = (char *)newPrefix.UTF8String;
+	return stats;
+}
+
+// The size of the buffer patches are written through.
+static const size_t GTDiffPatchWriterBufferSize = 64 * 1024;
+
+// Where -writePatchToFileDescriptor:error: and
+// -writePatchToOutputStream:error: send their output. Exactly one of
+// `fileDescriptor` (if not -1) and `stream` is used.
+typedef struct {
+	int fileDescriptor;
+	__unsafe_unretained NSOutputStream *stream;
 	
-	NSNumber *maxSizeNumber = dictionary[GTDiffOptionsMaxSizeKey];
-	if (maxSizeNumber != nil) newOptions.max_size = (uint16_t)maxSizeNumber.unsignedIntegerValue;
+	char *buffer;
+	size_t length;
 	
-	NSArray *pathSpec = dictionary[GTDiffOptionsPathSpecArrayKey];
-	if (pathSpec != nil) {
-		char **cStrings = malloc(sizeof(*cStrings) * pathSpec.count);
-		for (NSUInteger idx = 0; idx < pathSpec.count; idx ++) {
-			cStrings[idx] = (char *)[pathSpec[idx] cStringUsingEncoding:NSUTF8StringEncoding];
+	// The errno of a failed write to the file descriptor, or 0.
+	int writeErrno;
+} GTDiffPatchWriter;
+
+static BOOL GTDiffPatchWriterWriteBytes(GTDiffPatchWriter *writer, const char *bytes, size_t length) {
+	while (length > 0) {
+		if (writer->stream != nil) {
+			NSInteger written = [writer->stream write:(const uint8_t *)bytes maxLength:length];
+			if (written <= 0) return NO;
+			
+			bytes += written;
+			length -= (size_t)written;
+		} else {
+			ssize_t written = write(writer->fileDescriptor, bytes, length);
+			if (written < 0) {
+				if (errno == EINTR) continue;
+				
+				writer->writeErrno = errno;
+				return NO;
+			}
+			
+			bytes += written;
+			length -= (size_t)written;
 		}
+	}
+	
+	return YES;
+}
+
+static BOOL GTDiffPatchWriterFlush(GTDiffPatchWriter *writer) {
+	BOOL success = GTDiffPatchWriterWriteBytes(writer, writer->buffer, writer->length);
+	writer->length = 0;
+	return success;
+}
+
+static BOOL GTDiffPatchWriterAppend(GTDiffPatchWriter *writer, const char *bytes, size_t length) {
+	if (writer->length + length > GTDiffPatchWriterBufferSize) {
+		if (!GTDiffPatchWriterFlush(writer)) return NO;
 		
-		git_strarray optionsPathSpec = {.strings = cStrings, .count = pathSpec.count};
-		newOptions.pathspec = optionsPathSpec;
+		// Too big to be worth copying.
+		if (length > GTDiffPatchWriterBufferSize) return GTDiffPatchWriterWriteBytes(writer, bytes, length);
 	}
 	
-	git_diff_options *returnOptions = malloc(sizeof(*returnOptions));
-	memcpy(returnOptions, &newOptions, sizeof(*returnOptions));
+	memcpy(writer->buffer + writer->length, bytes, length);
+	writer->length += length;
+	return YES;
+}
+
+static int GTDiffPatchWriterCallback(const git_diff_delta *delta, const git_diff_range *range, char lineOrigin, const char *content, size_t contentLength, void *payload) {
+	GTDiffPatchWriter *writer = payload;
+	
+	// libgit2 has already formatted every line, origin included.
+	if (!GTDiffPatchWriterAppend(writer, content, contentLength)) return -1;
 	
-	return returnOptions;
+	return 0;
+}
+
+// How -detectRenamesUsingSketchesWithOptions:error: splits MinHash signatures
+// into bands. Files become candidates when every value in any one band
+// matches, so with 32 bands of 2, files sharing a third of their lines are
+// compared about 97% of the time, and ones sharing a tenth about 27%.
+//
+// Together they must cover the `GTBlobSketchHashCount` values.
+static const NSUInteger GTDiffSketchBandCount = 32;
+static const NSUInteger GTDiffSketchRowsPerBand = 2;
+
+// The similarity thresholds used when none are given.
+static const NSUInteger GTDiffDefaultSimilarityThreshold = 50;
+
+// One band of a source file's signature.
+typedef struct {
+	uint64_t key;
+	NSUInteger sourceIndex;
+} GTDiffSketchBucket;
+
+// One side of a delta which may have been renamed or copied.
+typedef struct {
+	NSUInteger deltaIndex;
+	const git_diff_delta *gitDelta;
+	const git_diff_file *file;
+} GTDiffSketchFile;
+
+// A pair of files worth reporting.
+typedef struct {
+	NSUInteger similarity;
+	NSUInteger sourceIndex;
+	NSUInteger targetIndex;
+} GTDiffSketchMatch;
+
+static int GTDiffCompareSketchBuckets(const void *a, const void *b) {
+	uint64_t key1 = ((const GTDiffSketchBucket *)a)->key;
+	uint64_t key2 = ((const GTDiffSketchBucket *)b)->key;
+	return (key1 < key2 ? -1 : (key1 > key2 ? 1 : 0));
 }
 
-+ (void)freeOptionsStruct:(git_diff_options *)options {
-	if (options == NULL) return;
-	free(options->pathspec.strings);
-	free(options);
+// Best matches first, then in delta order, so the results are stable.
+static int GTDiffCompareSketchMatches(const void *a, const void *b) {
+	const GTDiffSketchMatch *match1 = a;
+	const GTDiffSketchMatch *match2 = b;
+	if (match1->similarity != match2->similarity) return (match1->similarity > match2->similarity ? -1 : 1);
+	if (match1->targetIndex != match2->targetIndex) return (match1->targetIndex < match2->targetIndex ? -1 : 1);
+	if (match1->sourceIndex != match2->sourceIndex) return (match1->sourceIndex < match2->sourceIndex ? -1 : 1);
+	return 0;
 }
 
+static uint64_t GTDiffSketchBandKey(GTBlobSketch *sketch, NSUInteger band) {
+	const uint32_t *values = sketch.minHashes + band * GTDiffSketchRowsPerBand;
+	uint64_t key = band * 0x9e3779b97f4a7c15ull;
+	for (NSUInteger row = 0; row < GTDiffSketchRowsPerBand; row++) {
+		key = (key ^ values[row]) * 0x100000001b3ull;
+	}
+	
+	return key;
+}
+
+static NSUInteger GTDiffSimilarityThreshold(NSNumber *number) {
+	NSUInteger threshold = number.unsignedIntegerValue;
+	return (threshold == 0 || threshold > 100 ? GTDiffDefaultSimilarityThreshold : threshold);
+}
+
+// Whether one side of a delta can be sketched, from its blob.
+static BOOL GTDiffFileCanBeSketched(const git_diff_file *file, git_odb *odb) {
+	if (!S_ISREG(file->mode) || git_oid_iszero(&file->oid)) return NO;
+	
+	return git_odb_exists(odb, &file->oid) != 0;
+}
+
+// A delta on its way through -generatePatchesOrdered:error:worker:consumer:.
+@interface GTDiffPatchJob : NSObject
+
+@property (nonatomic, assign) NSUInteger index;
+@property (nonatomic, assign) const git_diff_delta *gitDelta;
+
+// The delta's patch, once it's been generated. It's freed along with the job,
+// unless it's been taken.
+@property (nonatomic, assign) git_diff_patch *patch;
+
+// The blobs a worker generated the patch from, or NULL. The patch's hunks and
+// lines point into them, so they're freed after it, unless they've been taken.
+@property (nonatomic, assign) git_blob *oldBlob;
+@property (nonatomic, assign) git_blob *newBlob;
+
+// Take ownership of the patch.
+- (git_diff_patch *)takePatch;
+
+// Take ownership of the patch and the blobs it points into.
+- (git_diff_patch *)takePatchWithOldBlob:(git_blob **)oldBlob newBlob:(git_blob **)newBlob;
+
+@end
+
+@implementation GTDiffPatchJob
+
+- (void)dealloc {
+	if (_patch != NULL) git_diff_patch_free(_patch);
+	git_blob_free(_oldBlob);
+	git_blob_free(_newBlob);
+}
+
+- (git_diff_patch *)takePatch {
+	git_diff_patch *patch = self.patch;
+	self.patch = NULL;
+	return patch;
+}
+
+- (git_diff_patch *)takePatchWithOldBlob:(git_blob **)oldBlob newBlob:(git_blob **)newBlob {
+	*oldBlob = self.oldBlob;
+	*newBlob = self.newBlob;
+	self.oldBlob = NULL;
+	self.newBlob = NULL;
+	return [self takePatch];
+}
+
+@end
+
+@interface GTDiff ()
+
+// The repository the diff was made in, or nil if it was made from a
+// `git_diff_list` directly.
+@property (nonatomic, unsafe_unretained) GTRepository *repository;
+
+// The options the diff was made with, for generating patches the same way.
+@property (nonatomic, strong) GTDiffOptions *diffOptions;
+
+@end
+
+@implementation GTDiff
+
 + (GTDiff *)diffOldTree:(GTTree *)oldTree withNewTree:(GTTree *)newTree options:(NSDictionary *)options error:(NSError **)error {
+	return [self diffOldTree:oldTree withNewTree:newTree diffOptions:[GTDiffOptions optionsWithDictionary:options] error:error];
+}
+
++ (GTDiff *)diffOldTree:(GTTree *)oldTree withNewTree:(GTTree *)newTree diffOptions:(GTDiffOptions *)options error:(NSError **)error {
 	NSParameterAssert([oldTree.repository isEqual:newTree.repository]);
 	
-	git_diff_options *optionsStruct = [self optionsStructFromDictionary:options];
 	git_diff_list *diffList;
-	int returnValue = git_diff_tree_to_tree(&diffList, oldTree.repository.git_repository, oldTree.git_tree, newTree.git_tree, optionsStruct);
-	[self freeOptionsStruct:optionsStruct];
+	int returnValue = git_diff_tree_to_tree(&diffList, oldTree.repository.git_repository, oldTree.git_tree, newTree.git_tree, options.git_diff_options);
 	if (returnValue != GIT_OK) {
 		if (error != NULL) *error = [NSError git_errorFor:returnValue withAdditionalDescription:@"Failed to create diff."];
 		return nil;
 	}
 	
 	GTDiff *newDiff = [[GTDiff alloc] initWithGitDiffList:diffList];
+	newDiff.repository = oldTree.repository;
+	newDiff.diffOptions = options;
 	return newDiff;
 }
 
 + (GTDiff *)diffIndexFromTree:(GTTree *)tree options:(NSDictionary *)options error:(NSError **)error {
+	return [self diffIndexFromTree:tree diffOptions:[GTDiffOptions optionsWithDictionary:options] error:error];
+}
+
++ (GTDiff *)diffIndexFromTree:(GTTree *)tree diffOptions:(GTDiffOptions *)options error:(NSError **)error {
 	NSParameterAssert(tree != nil);
 	
-	git_diff_options *optionsStruct = [self optionsStructFromDictionary:options];
 	git_diff_list *diffList;
-	int returnValue = git_diff_tree_to_index(&diffList, tree.repository.git_repository, tree.git_tree, NULL, optionsStruct);
-	[self freeOptionsStruct:optionsStruct];
+	int returnValue = git_diff_tree_to_index(&diffList, tree.repository.git_repository, tree.git_tree, NULL, options.git_diff_options);
 	if (returnValue != GIT_OK) {
 		if (error != NULL) *error = [NSError git_errorFor:returnValue withAdditionalDescription:@"Failed to create diff."];
 		return nil;
 	}
 	
 	GTDiff *newDiff = [[GTDiff alloc] initWithGitDiffList:diffList];
+	newDiff.repository = tree.repository;
+	newDiff.diffOptions = options;
 	return newDiff;
 }
 
 + (GTDiff *)diffIndexToWorkingDirectoryInRepository:(GTRepository *)repository options:(NSDictionary *)options error:(NSError **)error {
+	return [self diffIndexToWorkingDirectoryInRepository:repository diffOptions:[GTDiffOptions optionsWithDictionary:options] error:error];
+}
+
++ (GTDiff *)diffIndexToWorkingDirectoryInRepository:(GTRepository *)repository diffOptions:(GTDiffOptions *)options error:(NSError **)error {
 	NSParameterAssert(repository != nil);
 	
-	git_diff_options *optionsStruct = [self optionsStructFromDictionary:options];
 	git_diff_list *diffList;
-	int returnValue = git_diff_index_to_workdir(&diffList, repository.git_repository, NULL, optionsStruct);
-	[self freeOptionsStruct:optionsStruct];
+	int returnValue = git_diff_index_to_workdir(&diffList, repository.git_repository, NULL, options.git_diff_options);
 	if (returnValue != GIT_OK) {
 		if (error != NULL) *error = [NSError git_errorFor:returnValue withAdditionalDescription:@"Failed to create diff."];
 		return nil;
 	}
 	
 	GTDiff *newDiff = [[GTDiff alloc] initWithGitDiffList:diffList];
+	newDiff.repository = repository;
+	newDiff.diffOptions = options;
 	return newDiff;
 }
 
 + (GTDiff *)diffWorkingDirectoryFromTree:(GTTree *)tree options:(NSDictionary *)options error:(NSError **)error {
+	return [self diffWorkingDirectoryFromTree:tree diffOptions:[GTDiffOptions optionsWithDictionary:options] error:error];
+}
+
++ (GTDiff *)diffWorkingDirectoryFromTree:(GTTree *)tree diffOptions:(GTDiffOptions *)options error:(NSError **)error {
 	NSParameterAssert(tree != nil);
 	
-	git_diff_options *optionsStruct = [self optionsStructFromDictionary:options];
 	git_diff_list *diffList;
-	int returnValue = git_diff_tree_to_workdir(&diffList, tree.repository.git_repository, tree.git_tree, optionsStruct);
-	[self freeOptionsStruct:optionsStruct];
+	int returnValue = git_diff_tree_to_workdir(&diffList, tree.repository.git_repository, tree.git_tree, options.git_diff_options);
 	if (returnValue != GIT_OK) {
 		if (error != NULL) *error = [NSError git_errorFor:returnValue withAdditionalDescription:@"Failed to create diff."];
 		return nil;
 	}
 	
 	GTDiff *newDiff = [[GTDiff alloc] initWithGitDiffList:diffList];
+	newDiff.repository = tree.repository;
+	newDiff.diffOptions = options;
 	return newDiff;
 }
 
@@ -163,16 +389,209 @@ NSString *const GTDiffFindOptionsTargetLimitKey = @"GTDiffFindOptionsTargetLimit
 	NSParameterAssert(block != nil);
 	
 	for (NSUInteger idx = 0; idx < self.deltaCount; idx ++) {
-		git_diff_patch *patch;
-		int result = git_diff_get_patch(&patch, NULL, self.git_diff_list, idx);
-		if (result != GIT_OK) continue;
-		GTDiffDelta *delta = [[GTDiffDelta alloc] initWithGitPatch:patch];
+		GTDiffDelta *delta = [[GTDiffDelta alloc] initWithDiff:self deltaIndex:idx];
+		if (delta == nil) continue;
 		BOOL stop = NO;
 		block(delta, &stop);
 		if (stop) return;
 	}
 }
 
+- (BOOL)enumerateDeltasConcurrentlyWithError:(NSError **)error usingBlock:(void (^)(GTDiffDelta *delta, BOOL *stop))block {
+	NSParameterAssert(block != nil);
+	
+	if (self.repository == nil) {
+		[self enumerateDeltasUsingBlock:block];
+		return YES;
+	}
+	
+	return [self generatePatchesOrdered:YES error:error worker:^ id (GTDiffPatchJob *job, NSError **workerError) {
+		GTDiffDelta *delta = [[GTDiffDelta alloc] initWithDiff:self deltaIndex:job.index gitDelta:job.gitDelta];
+		git_blob *oldBlob = NULL;
+		git_blob *newBlob = NULL;
+		git_diff_patch *patch = [job takePatchWithOldBlob:&oldBlob newBlob:&newBlob];
+		[delta adoptGitPatch:patch oldBlob:oldBlob newBlob:newBlob];
+		return delta;
+	} consumer:^(GTDiffDelta *delta, BOOL *stop) {
+		block(delta, stop);
+	}];
+}
+
+- (NSData *)deltaStatsWithOptions:(GTDiffStatsOptions)options totals:(GTDiffStats *)totals error:(NSError **)error {
+	NSUInteger deltaCount = self.deltaCount;
+	NSMutableData *statsData = [NSMutableData dataWithLength:deltaCount * sizeof(GTDiffDeltaStats)];
+	GTDiffDeltaStats *stats = statsData.mutableBytes;
+	
+	if ((options & GTDiffStatsOptionsConcurrent) != 0 && self.repository != nil) {
+		// Each result only needs a home, so there's no need to deliver them in
+		// order. Every index is written by exactly one worker.
+		BOOL success = [self generatePatchesOrdered:NO error:error worker:^ id (GTDiffPatchJob *job, NSError **workerError) {
+			git_diff_patch *patch = [job takePatch];
+			stats[job.index] = GTDiffDeltaStatsFromPatch(patch);
+			git_diff_patch_free(patch);
+			return job;
+		} consumer:^(id result, BOOL *stop) {
+		}];
+		
+		if (!success) return nil;
+	} else {
+		for (NSUInteger idx = 0; idx < deltaCount; idx ++) {
+			git_diff_patch *patch = NULL;
+			int gitError = git_diff_get_patch(&patch, NULL, self.git_diff_list, idx);
+			if (gitError != GIT_OK) {
+				if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to generate patch."];
+				return nil;
+			}
+			
+			stats[idx] = GTDiffDeltaStatsFromPatch(patch);
+			git_diff_patch_free(patch);
+		}
+	}
+	
+	if (totals != NULL) {
+		GTDiffStats total = { 0 };
+		for (NSUInteger idx = 0; idx < deltaCount; idx ++) {
+			total.filesChanged++;
+			total.addedLinesCount += stats[idx].addedLinesCount;
+			total.deletedLinesCount += stats[idx].deletedLinesCount;
+			if (stats[idx].binary) total.binaryFilesChanged++;
+		}
+		
+		*totals = total;
+	}
+	
+	return statsData;
+}
+
+- (BOOL)writePatchToFileDescriptor:(int)fileDescriptor error:(NSError **)error {
+	GTDiffPatchWriter writer = { .fileDescriptor = fileDescriptor, .stream = nil };
+	return [self writePatchWithWriter:&writer error:error];
+}
+
+- (BOOL)writePatchToOutputStream:(NSOutputStream *)stream error:(NSError **)error {
+	NSParameterAssert(stream != nil);
+	
+	GTDiffPatchWriter writer = { .fileDescriptor = -1, .stream = stream };
+	return [self writePatchWithWriter:&writer error:error];
+}
+
+- (BOOL)writePatchWithWriter:(GTDiffPatchWriter *)writer error:(NSError **)error {
+	writer->buffer = malloc(GTDiffPatchWriterBufferSize);
+	writer->length = 0;
+	
+	int gitError = git_diff_print_patch(self.git_diff_list, GTDiffPatchWriterCallback, writer);
+	BOOL success = (gitError == GIT_OK && GTDiffPatchWriterFlush(writer));
+	free(writer->buffer);
+	
+	if (success) return YES;
+	
+	if (error != NULL) {
+		if (gitError != GIT_OK && gitError != GIT_EUSER) {
+			*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to generate patch."];
+		} else if (writer->stream != nil && writer->stream.streamError != nil) {
+			*error = writer->stream.streamError;
+		} else {
+			int code = (writer->writeErrno != 0 ? writer->writeErrno : EIO);
+			*error = [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:@{ NSLocalizedDescriptionKey: @"Failed to write patch.", NSLocalizedFailureReasonErrorKey: @(strerror(code)) }];
+		}
+	}
+	
+	return NO;
+}
+
+#pragma mark Patch Generation
+
+// Generate the patch of every delta, on a pool of workers where possible.
+//
+// Only the calling thread may use the diff list, since it reads through the
+// diff's own repository handle. So the calling thread looks up each delta, and
+// generates the patch itself if either side isn't a blob in the object
+// database (like a working directory file), or has attributes changing how
+// it's diffed. Otherwise a worker reads the blobs
+// through its own handle from the reader pool and generates the patch from
+// them. Without a reader pool, everything happens on the calling thread.
+//
+// ordered    - Whether to call `consumer` serially, in delta order.
+// error(out) - will be filled if an error occurs
+// worker     - Called on a worker with each job, once its patch has been
+//              generated. Returns a result for the consumer, or nil and fills
+//              `error` to fail.
+// consumer   - Called with each result, on a worker.
+//
+// Returns NO if an error occurred.
+- (BOOL)generatePatchesOrdered:(BOOL)ordered error:(NSError **)error worker:(id (^)(GTDiffPatchJob *job, NSError **error))worker consumer:(void (^)(id result, BOOL *stop))consumer {
+	git_odb *odb = NULL;
+	int gitError = git_repository_odb(&odb, self.repository.git_repository);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to open object database."];
+		return NO;
+	}
+	
+	GTPipeline *pipeline = [self.repository readerPipelineWithPendingCountPerWorker:GTDiffPendingPatchesPerWorker ordered:ordered];
+	
+	const git_diff_options *optionsStruct = self.diffOptions.git_diff_options;
+	NSUInteger deltaCount = self.deltaCount;
+	__block NSUInteger nextIndex = 0;
+	
+	BOOL success = [pipeline runWithProducer:^ id (NSError **producerError) {
+		if (nextIndex >= deltaCount) return nil;
+		
+		GTDiffPatchJob *job = [[GTDiffPatchJob alloc] init];
+		job.index = nextIndex++;
+		
+		const git_diff_delta *delta = NULL;
+		int gitError = git_diff_get_patch(NULL, &delta, self.git_diff_list, job.index);
+		if (gitError == GIT_OK) {
+			job.gitDelta = delta;
+			if (GTDiffFileIsInObjectDatabase(&delta->old_file, odb) && GTDiffFileIsInObjectDatabase(&delta->new_file, odb) && !GTDiffDeltaHasDiffAttribute(delta, self.repository.git_repository)) return job;
+			
+			git_diff_patch *patch = NULL;
+			gitError = git_diff_get_patch(&patch, NULL, self.git_diff_list, job.index);
+			job.patch = patch;
+		}
+		
+		if (gitError != GIT_OK) {
+			*producerError = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to generate patch."];
+			return nil;
+		}
+		
+		return job;
+	} worker:^ id (GTDiffPatchJob *job, GTRepository *workerRepository, NSError **workerError) {
+		if (job.patch == NULL) {
+			git_blob *oldBlob = NULL;
+			git_blob *newBlob = NULL;
+			int gitError = GTDiffLookUpBlob(&oldBlob, &job.gitDelta->old_file, workerRepository.git_repository);
+			if (gitError == GIT_OK) gitError = GTDiffLookUpBlob(&newBlob, &job.gitDelta->new_file, workerRepository.git_repository);
+			
+			git_diff_patch *patch = NULL;
+			if (gitError == GIT_OK) gitError = git_diff_patch_from_blobs(&patch, oldBlob, newBlob, optionsStruct);
+			
+			// The patch points into the blobs' contents, so they go with it.
+			// Releasing them later only drops a reference count, without
+			// touching this worker's handle.
+			job.oldBlob = oldBlob;
+			job.newBlob = newBlob;
+			
+			if (gitError != GIT_OK) {
+				// libgit2's error messages are per-thread, so build the error here.
+				const char *path = (job.gitDelta->new_file.path ?: job.gitDelta->old_file.path);
+				*workerError = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to generate patch for %s.", path]];
+				return nil;
+			}
+			
+			job.patch = patch;
+		}
+		
+		return worker(job, workerError);
+	} consumer:^(id result, NSUInteger index, BOOL *stop) {
+		consumer(result, stop);
+	} error:error];
+	
+	git_odb_free(odb);
+	
+	return success;
+}
+
 - (NSUInteger)deltaCount {
 	return git_diff_num_deltas(self.git_diff_list);
 }
@@ -181,34 +600,246 @@ NSString *const GTDiffFindOptionsTargetLimitKey = @"GTDiffFindOptionsTargetLimit
 	return git_diff_num_deltas_of_type(self.git_diff_list, (git_delta_t)deltaType);
 }
 
-- (BOOL)findOptionsStructWithDictionary:(NSDictionary *)dictionary optionsStruct:(git_diff_find_options *)newOptions {
-	if (dictionary == nil || dictionary.count < 1) return NO;
+- (void)findSimilarWithOptions:(NSDictionary *)options {
+	[self findSimilarWithDiffOptions:[GTDiffOptions optionsWithDictionary:options]];
+}
+
+- (void)findSimilarWithDiffOptions:(GTDiffOptions *)options {
+	// libgit2 wants to be able to write to the options, and they're shared.
+	const git_diff_find_options *preparedOptions = options.git_diff_find_options;
+	git_diff_find_options findOptions = GIT_DIFF_FIND_OPTIONS_INIT;
+	if (preparedOptions != NULL) findOptions = *preparedOptions;
+	git_diff_find_similar(self.git_diff_list, (preparedOptions != NULL ? &findOptions : NULL));
+}
+
+#pragma mark Sketches
+
+- (NSArray *)detectRenamesUsingSketchesWithOptions:(NSDictionary *)options error:(NSError **)error {
+	if (self.repository == nil) {
+		if (error != NULL) *error = [NSError git_errorFor:GIT_ERROR withAdditionalDescription:@"Sketching files needs the repository the diff was made in."];
+		return nil;
+	}
+	
+	NSNumber *flagsNumber = options[GTDiffFindOptionsFlagsKey];
+	GTDiffFindOptionsFlags flags = (flagsNumber != nil ? (GTDiffFindOptionsFlags)flagsNumber.unsignedIntValue : GTDiffFindOptionsFlagsFindRenames);
+	BOOL findCopiesFromUnmodified = (flags & GTDiffFindOptionsFlagsFindCopiesFromUnmodified) != 0;
+	BOOL findCopies = findCopiesFromUnmodified || (flags & GTDiffFindOptionsFlagsFindCopies) != 0;
+	NSUInteger renameThreshold = GTDiffSimilarityThreshold(options[GTDiffFindOptionsRenameThresholdKey]);
+	NSUInteger copyThreshold = GTDiffSimilarityThreshold(options[GTDiffFindOptionsCopyThresholdKey]);
+	
+	git_odb *odb = NULL;
+	int gitError = git_repository_odb(&odb, self.repository.git_repository);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to open object database."];
+		return nil;
+	}
+	
+	NSUInteger deltaCount = self.deltaCount;
+	NSMutableData *sourceData = [NSMutableData dataWithLength:deltaCount * sizeof(GTDiffSketchFile)];
+	NSMutableData *targetData = [NSMutableData dataWithLength:deltaCount * sizeof(GTDiffSketchFile)];
+	GTDiffSketchFile *sources = sourceData.mutableBytes;
+	GTDiffSketchFile *targets = targetData.mutableBytes;
+	NSUInteger sourceCount = 0;
+	NSUInteger targetCount = 0;
+	NSMutableArray *sourceOIDs = [NSMutableArray array];
+	NSMutableArray *targetOIDs = [NSMutableArray array];
+	
+	for (NSUInteger idx = 0; idx < deltaCount; idx ++) {
+		const git_diff_delta *delta = NULL;
+		gitError = git_diff_get_patch(NULL, &delta, self.git_diff_list, idx);
+		if (gitError != GIT_OK) {
+			git_odb_free(odb);
+			if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to look up delta."];
+			return nil;
+		}
+		
+		BOOL isSource = (delta->status == GIT_DELTA_DELETED || (delta->status == GIT_DELTA_MODIFIED && findCopies) || (delta->status == GIT_DELTA_UNMODIFIED && findCopiesFromUnmodified));
+		BOOL isTarget = (delta->status == GIT_DELTA_ADDED);
+		const git_diff_file *file = (isSource ? &delta->old_file : &delta->new_file);
+		if (!(isSource || isTarget) || !GTDiffFileCanBeSketched(file, odb)) continue;
 		
-	NSNumber *flagsNumber = dictionary[GTDiffFindOptionsFlagsKey];
-	if (flagsNumber != nil) newOptions->flags = (uint32_t)flagsNumber.unsignedIntegerValue;
+		GTDiffSketchFile sketchFile = { .deltaIndex = idx, .gitDelta = delta, .file = file };
+		if (isSource) {
+			sources[sourceCount++] = sketchFile;
+			[sourceOIDs addObject:[[GTOID alloc] initWithGitOid:&file->oid]];
+		} else {
+			targets[targetCount++] = sketchFile;
+			[targetOIDs addObject:[[GTOID alloc] initWithGitOid:&file->oid]];
+		}
+	}
 	
-	NSNumber *renameThresholdNumber = dictionary[GTDiffFindOptionsRenameThresholdKey];
-	if (renameThresholdNumber != nil) newOptions->rename_threshold = renameThresholdNumber.unsignedIntValue;
+	git_odb_free(odb);
 	
-	NSNumber *renameFromRewriteThresholdNumber = dictionary[GTDiffFindOptionsRenameFromRewriteThresholdKey];
-	if (renameFromRewriteThresholdNumber != nil) newOptions->rename_from_rewrite_threshold = renameFromRewriteThresholdNumber.unsignedIntValue;
+	if (sourceCount == 0 || targetCount == 0) return @[];
 	
-	NSNumber *copyThresholdNumber = dictionary[GTDiffFindOptionsCopyThresholdKey];
-	if (copyThresholdNumber != nil) newOptions->copy_threshold = copyThresholdNumber.unsignedIntValue;
+	NSDictionary *sketches = [self sketchesForBlobOIDs:[sourceOIDs arrayByAddingObjectsFromArray:targetOIDs] error:error];
+	if (sketches == nil) return nil;
 	
-	NSNumber *breakRewriteThresholdNumber = dictionary[GTDiffFindOptionsBreakRewriteThresholdKey];
-	if (renameThresholdNumber != nil) newOptions->break_rewrite_threshold = breakRewriteThresholdNumber.unsignedIntValue;
+	// Identical blobs need no sketch to be found.
+	NSMutableDictionary *sourceIndexesByOID = [NSMutableDictionary dictionaryWithCapacity:sourceCount];
+	for (NSUInteger idx = 0; idx < sourceCount; idx ++) {
+		if (sourceIndexesByOID[sourceOIDs[idx]] == nil) sourceIndexesByOID[sourceOIDs[idx]] = @(idx);
+	}
 	
-	NSNumber *targetLimitNumber = dictionary[GTDiffFindOptionsTargetLimitKey];
-	if (targetLimitNumber != nil) newOptions->target_limit = targetLimitNumber.unsignedIntValue;
+	NSMutableData *bucketData = [NSMutableData dataWithLength:sourceCount * GTDiffSketchBandCount * sizeof(GTDiffSketchBucket)];
+	GTDiffSketchBucket *buckets = bucketData.mutableBytes;
+	NSUInteger bucketCount = 0;
+	for (NSUInteger idx = 0; idx < sourceCount; idx ++) {
+		GTBlobSketch *sketch = sketches[sourceOIDs[idx]];
+		if (sketch.empty) continue;
+		
+		for (NSUInteger band = 0; band < GTDiffSketchBandCount; band ++) {
+			buckets[bucketCount++] = (GTDiffSketchBucket){ .key = GTDiffSketchBandKey(sketch, band), .sourceIndex = idx };
+		}
+	}
 	
-	return YES;
+	qsort(buckets, bucketCount, sizeof(*buckets), GTDiffCompareSketchBuckets);
+	
+	// The lowest threshold any source could be reported at.
+	NSUInteger deletedSourceThreshold = (findCopies ? MIN(renameThreshold, copyThreshold) : renameThreshold);
+	
+	NSMutableData *matchData = [NSMutableData data];
+	NSMutableData *visitedData = [NSMutableData dataWithLength:sourceCount * sizeof(NSUInteger)];
+	NSUInteger *lastVisitingTarget = visitedData.mutableBytes;
+	for (NSUInteger targetIndex = 0; targetIndex < targetCount; targetIndex ++) {
+		GTBlobSketch *targetSketch = sketches[targetOIDs[targetIndex]];
+		if (targetSketch.size == 0) continue;
+		
+		NSNumber *exactSourceIndex = sourceIndexesByOID[targetOIDs[targetIndex]];
+		if (exactSourceIndex != nil) {
+			GTDiffSketchMatch match = { .similarity = 100, .sourceIndex = exactSourceIndex.unsignedIntegerValue, .targetIndex = targetIndex };
+			[matchData appendBytes:&match length:sizeof(match)];
+			lastVisitingTarget[match.sourceIndex] = targetIndex + 1;
+		}
+		
+		if (targetSketch.empty) continue;
+		
+		for (NSUInteger band = 0; band < GTDiffSketchBandCount; band ++) {
+			uint64_t key = GTDiffSketchBandKey(targetSketch, band);
+			
+			NSUInteger low = 0;
+			NSUInteger high = bucketCount;
+			while (low < high) {
+				NSUInteger middle = low + (high - low) / 2;
+				if (buckets[middle].key < key) {
+					low = middle + 1;
+				} else {
+					high = middle;
+				}
+			}
+			
+			for (NSUInteger bucketIndex = low; bucketIndex < bucketCount && buckets[bucketIndex].key == key; bucketIndex ++) {
+				NSUInteger sourceIndex = buckets[bucketIndex].sourceIndex;
+				if (lastVisitingTarget[sourceIndex] == targetIndex + 1) continue;
+				lastVisitingTarget[sourceIndex] = targetIndex + 1;
+				
+				GTBlobSketch *sourceSketch = sketches[sourceOIDs[sourceIndex]];
+				NSUInteger threshold = (sources[sourceIndex].gitDelta->status == GIT_DELTA_DELETED ? deletedSourceThreshold : copyThreshold);
+				
+				// Files of very different sizes can't be similar enough.
+				NSUInteger smallerSize = MIN(sourceSketch.size, targetSketch.size);
+				NSUInteger largerSize = MAX(sourceSketch.size, targetSketch.size);
+				if ((unsigned long long)smallerSize * 100 < (unsigned long long)threshold * largerSize) continue;
+				
+				NSUInteger similarity = [sourceSketch similarityToSketch:targetSketch];
+				if (similarity < threshold) continue;
+				
+				GTDiffSketchMatch match = { .similarity = similarity, .sourceIndex = sourceIndex, .targetIndex = targetIndex };
+				[matchData appendBytes:&match length:sizeof(match)];
+			}
+		}
+	}
+	
+	GTDiffSketchMatch *matches = matchData.mutableBytes;
+	NSUInteger matchCount = matchData.length / sizeof(*matches);
+	qsort(matches, matchCount, sizeof(*matches), GTDiffCompareSketchMatches);
+	
+	// Hand out the best matches first. A deleted file can only be renamed
+	// once, but anything can be copied any number of times.
+	NSMutableData *targetMatchedData = [NSMutableData dataWithLength:targetCount * sizeof(BOOL)];
+	NSMutableData *sourceRenamedData = [NSMutableData dataWithLength:sourceCount * sizeof(BOOL)];
+	BOOL *targetMatched = targetMatchedData.mutableBytes;
+	BOOL *sourceRenamed = sourceRenamedData.mutableBytes;
+	NSMutableArray *renames = [NSMutableArray array];
+	for (NSUInteger idx = 0; idx < matchCount; idx ++) {
+		GTDiffSketchMatch match = matches[idx];
+		if (targetMatched[match.targetIndex]) continue;
+		
+		GTDiffSketchFile source = sources[match.sourceIndex];
+		GTDiffSketchFile target = targets[match.targetIndex];
+		GTDiffDeltaType type;
+		if (source.gitDelta->status == GIT_DELTA_DELETED && !sourceRenamed[match.sourceIndex] && match.similarity >= renameThreshold) {
+			type = GTDiffFileDeltaRenamed;
+			sourceRenamed[match.sourceIndex] = YES;
+		} else if (findCopies && match.similarity >= copyThreshold) {
+			type = GTDiffFileDeltaCopied;
+		} else {
+			continue;
+		}
+		
+		targetMatched[match.targetIndex] = YES;
+		
+		GTDiffFile *oldFile = [[GTDiffFile alloc] initWithGitDiffFile:*source.file];
+		GTDiffFile *newFile = [[GTDiffFile alloc] initWithGitDiffFile:*target.file];
+		[renames addObject:[[GTDiffRename alloc] initWithType:type oldFile:oldFile newFile:newFile similarity:match.similarity oldDeltaIndex:source.deltaIndex newDeltaIndex:target.deltaIndex]];
+	}
+	
+	[renames sortUsingComparator:^(GTDiffRename *rename1, GTDiffRename *rename2) {
+		return [@(rename1.newDeltaIndex) compare:@(rename2.newDeltaIndex)];
+	}];
+	
+	return renames;
 }
 
-- (void)findSimilarWithOptions:(NSDictionary *)options {
-	git_diff_find_options findOptions = GIT_DIFF_FIND_OPTIONS_INIT;
-	BOOL findOptionsCreated = [self findOptionsStructWithDictionary:options optionsStruct:&findOptions];
-	git_diff_find_similar(self.git_diff_list, (findOptionsCreated ? &findOptions : NULL));
+// Sketch blobs, using and filling the repository's cache.
+//
+// Blobs which aren't cached are read on a pool of workers, each through its own
+// handle on the repository.
+//
+// Returns a dictionary of `GTBlobSketch`s keyed by `GTOID`, or nil if an error
+// occurred.
+- (NSDictionary *)sketchesForBlobOIDs:(NSArray *)oids error:(NSError **)error {
+	NSCache *cache = self.repository.blobSketchCache;
+	NSMutableDictionary *sketches = [NSMutableDictionary dictionaryWithCapacity:oids.count];
+	NSMutableOrderedSet *missingOIDs = [NSMutableOrderedSet orderedSet];
+	for (GTOID *oid in oids) {
+		if (sketches[oid] != nil) continue;
+		
+		GTBlobSketch *sketch = [cache objectForKey:oid];
+		if (sketch != nil) {
+			sketches[oid] = sketch;
+		} else {
+			[missingOIDs addObject:oid];
+		}
+	}
+	
+	if (missingOIDs.count == 0) return sketches;
+	
+	GTPipeline *pipeline = [self.repository readerPipelineWithPendingCountPerWorker:GTDiffPendingPatchesPerWorker ordered:NO];
+	
+	NSEnumerator *missingEnumerator = missingOIDs.objectEnumerator;
+	BOOL success = [pipeline runWithProducer:^ id (NSError **producerError) {
+		return [missingEnumerator nextObject];
+	} worker:^ id (GTOID *oid, GTRepository *workerRepository, NSError **workerError) {
+		git_blob *blob = NULL;
+		int gitError = git_blob_lookup(&blob, workerRepository.git_repository, oid.git_oid);
+		if (gitError != GIT_OK) {
+			*workerError = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to look up blob %@.", oid.sha]];
+			return nil;
+		}
+		
+		GTBlobSketch *sketch = [[GTBlobSketch alloc] initWithBytes:git_blob_rawcontent(blob) length:(NSUInteger)git_blob_rawsize(blob)];
+		git_blob_free(blob);
+		
+		[cache setObject:sketch forKey:oid cost:sketch.cost];
+		return @[ oid, sketch ];
+	} consumer:^(NSArray *result, NSUInteger index, BOOL *stop) {
+		@synchronized (sketches) {
+			sketches[result[0]] = result[1];
+		}
+	} error:error];
+	
+	return (success ? sketches : nil);
 }
 
 @end
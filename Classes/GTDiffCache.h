@@ -0,0 +1,96 @@
+//
+//  GTDiffCache.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTDiffOptions;
+@class GTRepository;
+@class GTTree;
+
+// The size a repository's diff cache is kept under by default: 64MB.
+static const unsigned long long GTDiffCacheDefaultMaximumSize = 64 * 1024 * 1024;
+
+// A persistent cache of tree-to-tree diffs.
+//
+// Trees never change, so a diff between two trees with the same options is
+// always the same. Each one is kept as a compact binary file of its deltas
+// (see `GTCachedDiffDelta`), after rename detection and, if asked for, with
+// their patches, so asking again costs a file read instead of a tree walk,
+// rename detection and patch generation.
+//
+// Files are named after a hash of both trees' OIDs and the normalized options.
+// Reading a diff marks its file as recently used, and once the files add up to
+// more than `maximumSize`, the least recently used ones are deleted until the
+// rest fit in three quarters of it.
+//
+// This class is thread safe.
+@interface GTDiffCache : NSObject
+
+// The repository the diffs are in.
+@property (nonatomic, readonly, unsafe_unretained) GTRepository *repository;
+
+// The directory the diffs are kept in.
+@property (nonatomic, readonly, strong) NSURL *directoryURL;
+
+// The most bytes the cached diffs may add up to.
+@property (nonatomic, readonly) unsigned long long maximumSize;
+
+// The number of diffs which have been found in the cache, since the receiver
+// was created.
+@property (nonatomic, readonly) NSUInteger hitCount;
+
+// The number of diffs which had to be computed, since the receiver was created.
+@property (nonatomic, readonly) NSUInteger missCount;
+
+// The proportion of diffs which were found in the cache, from 0 to 1.
+@property (nonatomic, readonly) double hitRate;
+
+// The directory a repository's diff cache is kept in by default:
+// `objectivegit/diffs` in its git directory.
++ (NSURL *)defaultDirectoryURLForRepository:(GTRepository *)repository;
+
+// Initializes the receiver.
+//
+// repository   - The repository the diffs are in. Cannot be nil.
+// directoryURL - The directory to keep diffs in. Cannot be nil.
+// maximumSize  - The most bytes the cached diffs may add up to.
+- (id)initWithRepository:(GTRepository *)repository directoryURL:(NSURL *)directoryURL maximumSize:(unsigned long long)maximumSize;
+
+// Diff two trees, using the cache if possible.
+//
+// oldTree        - The "left" side of the diff. Cannot be nil.
+// newTree        - The "right" side of the diff. Cannot be nil.
+// options        - The options to diff with, as for
+//                  +[GTDiff diffOldTree:withNewTree:options:error:], or nil.
+// findOptions    - The options to detect renames with, as for
+//                  -[GTDiff findSimilarWithOptions:], or nil to not look for
+//                  renames.
+// includePatches - Whether the deltas need their patches and line counts. A
+//                  diff cached without them is computed again.
+// error(out)     - will be filled if an error occurs
+//
+// returns an array of `GTCachedDiffDelta`s, in delta order, or nil if an error
+// occurred.
+- (NSArray *)deltasForOldTree:(GTTree *)oldTree newTree:(GTTree *)newTree options:(NSDictionary *)options findOptions:(NSDictionary *)findOptions includePatches:(BOOL)includePatches error:(NSError **)error;
+
+// Diff two trees with prepared options, using the cache if possible.
+//
+// This is the same as
+// -deltasForOldTree:newTree:options:findOptions:includePatches:error:, but
+// without parsing the options again. Diffs are cached by the options'
+// dictionaries, so they're shared with that method.
+//
+// options     - The options to diff with, or nil to use the defaults.
+// findOptions - The options to detect renames with, or nil to not look for
+//               renames.
+- (NSArray *)deltasForOldTree:(GTTree *)oldTree newTree:(GTTree *)newTree diffOptions:(GTDiffOptions *)options findOptions:(GTDiffOptions *)findOptions includePatches:(BOOL)includePatches error:(NSError **)error;
+
+// Delete every cached diff.
+- (void)removeAllDiffs;
+
+@end
@@ -0,0 +1,446 @@
+//
+//  GTDiffCache.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTDiffCache.h"
+#import "GTCachedDiffDelta+Private.h"
+#import "GTDiff.h"
+#import "GTDiffDelta.h"
+#import "GTDiffFile.h"
+#import "GTDiffOptions.h"
+#import "GTIndexFile.h"
+#import "GTRepository.h"
+#import "GTTree.h"
+#import "GTOID.h"
+
+// Each diff is a file (see GTIndexFile.h), all integers big-endian:
+//
+//   "GTDC"                          magic
+//   uint32                          version
+//   uint32                          flags (see GTDiffCacheFlag)
+//   uint32                          delta count
+//   each delta:
+//     uint8                         status (a git_delta_t)
+//     uint8                         whether it's binary
+//     uint16                        unused
+//     uint32                        similarity
+//     uint32                        added lines
+//     uint32                        deleted lines
+//     old file, then new file:
+//       20 bytes                    oid
+//       uint32                      mode
+//       uint32                      flags
+//       uint64                      size
+//       uint32                      path length (P)
+//       P bytes                     path, in UTF-8
+//     if GTDiffCacheFlagPatches is set:
+//       uint32                      patch length (L)
+//       L bytes                     patch
+//   20 bytes                        SHA1 of everything above
+static const char GTDiffCacheMagic[4] = { 'G', 'T', 'D', 'C' };
+static const uint32_t GTDiffCacheVersion = 1;
+
+// Once the cache is too big, it's trimmed to this percentage of `maximumSize`,
+// so the next eviction is a good many writes away.
+static const unsigned long long GTDiffCacheEvictionTargetPercent = 75;
+
+typedef enum {
+	// The deltas have their patches and line counts.
+	GTDiffCacheFlagPatches = 1 << 0,
+} GTDiffCacheFlag;
+
+static void GTDiffCacheAppendFile(NSMutableData *data, const git_diff_file *file) {
+	[data appendBytes:file->oid.id length:GIT_OID_RAWSZ];
+	GTIndexFileAppendUInt32(data, file->mode);
+	GTIndexFileAppendUInt32(data, file->flags);
+	GTIndexFileAppendUInt64(data, (uint64_t)file->size);
+
+	size_t pathLength = (file->path != NULL ? strlen(file->path) : 0);
+	GTIndexFileAppendUInt32(data, (uint32_t)pathLength);
+	if (pathLength > 0) [data appendBytes:file->path length:pathLength];
+}
+
+static GTDiffFile *GTDiffCacheReadFile(GTIndexFileReader *reader) {
+	const uint8_t *oidBytes = NULL;
+	uint32_t mode = 0;
+	uint32_t flags = 0;
+	uint64_t size = 0;
+	uint32_t pathLength = 0;
+	const uint8_t *pathBytes = NULL;
+
+	if (!GTIndexFileReaderReadBytes(reader, GIT_OID_RAWSZ, &oidBytes)) return nil;
+	if (!GTIndexFileReaderReadUInt32(reader, &mode)) return nil;
+	if (!GTIndexFileReaderReadUInt32(reader, &flags)) return nil;
+	if (!GTIndexFileReaderReadUInt64(reader, &size)) return nil;
+	if (!GTIndexFileReaderReadUInt32(reader, &pathLength)) return nil;
+	if (!GTIndexFileReaderReadBytes(reader, pathLength, &pathBytes)) return nil;
+
+	NSString *path = [[NSString alloc] initWithBytes:pathBytes length:pathLength encoding:NSUTF8StringEncoding];
+	if (path == nil) return nil;
+
+	git_diff_file file;
+	memset(&file, 0, sizeof(file));
+	git_oid_fromraw(&file.oid, oidBytes);
+	file.path = path.UTF8String;
+	file.size = (git_off_t)size;
+	file.flags = flags;
+	file.mode = (uint16_t)mode;
+
+	return [[GTDiffFile alloc] initWithGitDiffFile:file];
+}
+
+// Writes a property list value such that equal values always come out the
+// same, whatever order their dictionaries were built in.
+static void GTDiffCacheAppendNormalizedValue(NSMutableString *string, id value) {
+	if ([value isKindOfClass:NSDictionary.class]) {
+		[string appendString:@"{"];
+		for (id key in [[value allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+			GTDiffCacheAppendNormalizedValue(string, key);
+			[string appendString:@"="];
+			GTDiffCacheAppendNormalizedValue(string, value[key]);
+			[string appendString:@";"];
+		}
+		[string appendString:@"}"];
+	} else if ([value isKindOfClass:NSArray.class]) {
+		// Pathspecs match the same files in any order.
+		NSMutableArray *items = [NSMutableArray arrayWithCapacity:[value count]];
+		for (id item in value) {
+			NSMutableString *itemString = [NSMutableString string];
+			GTDiffCacheAppendNormalizedValue(itemString, item);
+			[items addObject:itemString];
+		}
+
+		[string appendFormat:@"(%@)", [[items sortedArrayUsingSelector:@selector(compare:)] componentsJoinedByString:@","]];
+	} else if ([value isKindOfClass:NSString.class]) {
+		[string appendFormat:@"\"%@\"", [[value stringByReplacingOccurrencesOfString:@"\\" withString:@"\\\\"] stringByReplacingOccurrencesOfString:@"\"" withString:@"\\\""]];
+	} else {
+		[string appendString:[value description]];
+	}
+}
+
+@interface GTDiffCache ()
+
+@property (nonatomic, assign) NSUInteger hitCount;
+@property (nonatomic, assign) NSUInteger missCount;
+
+// The total size of the cached diffs, as of the last time the directory was
+// scanned, plus what's been written since. Only valid once `sizeKnown` is set.
+// Only accessed while synchronized on the receiver.
+@property (nonatomic, assign) unsigned long long size;
+@property (nonatomic, assign, getter = isSizeKnown) BOOL sizeKnown;
+
+@end
+
+@implementation GTDiffCache
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> directoryURL: %@, hitCount: %lu, missCount: %lu", NSStringFromClass([self class]), self, self.directoryURL, (unsigned long)self.hitCount, (unsigned long)self.missCount];
+}
+
+#pragma mark API
+
++ (NSURL *)defaultDirectoryURLForRepository:(GTRepository *)repository {
+	return GTIndexFileURLForRepository(repository, @"diffs", YES);
+}
+
+- (id)initWithRepository:(GTRepository *)repository directoryURL:(NSURL *)directoryURL maximumSize:(unsigned long long)maximumSize {
+	NSParameterAssert(repository != nil);
+	NSParameterAssert(directoryURL != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_repository = repository;
+	_directoryURL = [directoryURL copy];
+	_maximumSize = maximumSize;
+
+	return self;
+}
+
+- (NSUInteger)hitCount {
+	@synchronized (self) {
+		return _hitCount;
+	}
+}
+
+- (NSUInteger)missCount {
+	@synchronized (self) {
+		return _missCount;
+	}
+}
+
+- (double)hitRate {
+	@synchronized (self) {
+		NSUInteger total = _hitCount + _missCount;
+		return (total > 0 ? (double)_hitCount / total : 0);
+	}
+}
+
+- (NSArray *)deltasForOldTree:(GTTree *)oldTree newTree:(GTTree *)newTree options:(NSDictionary *)options findOptions:(NSDictionary *)findOptions includePatches:(BOOL)includePatches error:(NSError **)error {
+	GTDiffOptions *diffOptions = [GTDiffOptions optionsWithDictionary:options];
+	GTDiffOptions *findDiffOptions = (findOptions != nil ? [GTDiffOptions optionsWithDictionary:findOptions] : nil);
+	return [self deltasForOldTree:oldTree newTree:newTree diffOptions:diffOptions findOptions:findDiffOptions includePatches:includePatches error:error];
+}
+
+- (NSArray *)deltasForOldTree:(GTTree *)oldTree newTree:(GTTree *)newTree diffOptions:(GTDiffOptions *)options findOptions:(GTDiffOptions *)findOptions includePatches:(BOOL)includePatches error:(NSError **)error {
+	NSParameterAssert(oldTree != nil);
+	NSParameterAssert(newTree != nil);
+
+	NSURL *fileURL = [self fileURLForOldTree:oldTree newTree:newTree options:options findOptions:findOptions];
+
+	NSData *data = nil;
+	GTIndexFileReadData(fileURL, &data, NULL);
+	unsigned long long replacedSize = data.length;
+	if (data != nil) {
+		BOOL hasPatches = NO;
+		NSArray *deltas = [self deltasFromData:data hasPatches:&hasPatches];
+		if (deltas == nil) {
+			// Don't trip over a bad file again.
+			[NSFileManager.defaultManager removeItemAtURL:fileURL error:NULL];
+		} else if (hasPatches || !includePatches) {
+			// Mark it as recently used.
+			[NSFileManager.defaultManager setAttributes:@{ NSFileModificationDate: [NSDate date] } ofItemAtPath:fileURL.path error:NULL];
+
+			@synchronized (self) {
+				_hitCount++;
+			}
+
+			return deltas;
+		}
+	}
+
+	@synchronized (self) {
+		_missCount++;
+	}
+
+	GTDiff *diff = [GTDiff diffOldTree:oldTree withNewTree:newTree diffOptions:options error:error];
+	if (diff == nil) return nil;
+
+	if (findOptions != nil) [diff findSimilarWithDiffOptions:findOptions];
+
+	NSMutableArray *deltas = [NSMutableArray arrayWithCapacity:diff.deltaCount];
+	NSMutableData *diffData = [self dataForDiff:diff includePatches:includePatches deltas:deltas error:error];
+	if (diffData == nil) return nil;
+
+	// The diff was worth computing even if it can't be kept.
+	NSError *writeError = nil;
+	if (GTIndexFileWriteData(diffData, fileURL, &writeError)) {
+		[self didWriteDiffOfSize:diffData.length replacingSize:replacedSize];
+	} else {
+		GTLog(@"Failed to write the diff to %@: %@", fileURL.path, writeError);
+	}
+
+	return deltas;
+}
+
+- (void)removeAllDiffs {
+	@synchronized (self) {
+		[NSFileManager.defaultManager removeItemAtURL:self.directoryURL error:NULL];
+		self.size = 0;
+		self.sizeKnown = YES;
+	}
+}
+
+#pragma mark Keys
+
+// Keyed off the options' dictionaries, so prepared options find the same diffs
+// as the dictionaries they were made from.
+- (NSURL *)fileURLForOldTree:(GTTree *)oldTree newTree:(GTTree *)newTree options:(GTDiffOptions *)options findOptions:(GTDiffOptions *)findOptions {
+	NSMutableString *key = [NSMutableString stringWithFormat:@"%@\n%@\n", oldTree.sha, newTree.sha];
+	GTDiffCacheAppendNormalizedValue(key, options.dictionary ?: @{});
+	[key appendString:@"\n"];
+	if (findOptions != nil) GTDiffCacheAppendNormalizedValue(key, findOptions.dictionary);
+
+	NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+	git_oid hash;
+	git_odb_hash(&hash, keyData.bytes, keyData.length, GIT_OBJ_BLOB);
+	NSString *sha = [GTOID oidWithGitOid:&hash].sha;
+
+	// Fan out like the object database, so no directory gets too big.
+	NSURL *fanOutURL = [self.directoryURL URLByAppendingPathComponent:[sha substringToIndex:2] isDirectory:YES];
+	return [fanOutURL URLByAppendingPathComponent:[sha substringFromIndex:2] isDirectory:NO];
+}
+
+#pragma mark Serialization
+
+// Serializes a diff, less its checksum, and fills `deltas` with what it
+// serialized.
+- (NSMutableData *)dataForDiff:(GTDiff *)diff includePatches:(BOOL)includePatches deltas:(NSMutableArray *)deltas error:(NSError **)error {
+	NSMutableData *data = GTIndexFileCreateData(GTDiffCacheMagic, GTDiffCacheVersion, 0);
+	GTIndexFileAppendUInt32(data, (includePatches ? GTDiffCacheFlagPatches : 0));
+	GTIndexFileAppendUInt32(data, (uint32_t)diff.deltaCount);
+
+	__block NSError *patchError = nil;
+	void (^appendDelta)(GTDiffDelta *, BOOL *) = ^(GTDiffDelta *delta, BOOL *stop) {
+		const git_diff_delta *gitDelta = delta.git_diff_delta;
+
+		NSError *deltaError = nil;
+		GTCachedDiffDelta *cachedDelta = [[GTCachedDiffDelta alloc] initWithDiffDelta:delta includePatch:includePatches error:&deltaError];
+		if (cachedDelta == nil) {
+			patchError = deltaError;
+			*stop = YES;
+			return;
+		}
+
+		NSData *patchData = cachedDelta.patchData;
+
+		GTIndexFileAppendUInt8(data, (uint8_t)gitDelta->status);
+		GTIndexFileAppendUInt8(data, (cachedDelta.binary ? 1 : 0));
+		GTIndexFileAppendUInt16(data, 0);
+		GTIndexFileAppendUInt32(data, gitDelta->similarity);
+		GTIndexFileAppendUInt32(data, (uint32_t)cachedDelta.addedLinesCount);
+		GTIndexFileAppendUInt32(data, (uint32_t)cachedDelta.deletedLinesCount);
+		GTDiffCacheAppendFile(data, &gitDelta->old_file);
+		GTDiffCacheAppendFile(data, &gitDelta->new_file);
+		if (includePatches) {
+			GTIndexFileAppendUInt32(data, (uint32_t)patchData.length);
+			[data appendData:patchData];
+		}
+
+		[deltas addObject:cachedDelta];
+	};
+
+	if (includePatches) {
+		if (![diff enumerateDeltasConcurrentlyWithError:error usingBlock:appendDelta]) return nil;
+	} else {
+		[diff enumerateDeltasUsingBlock:appendDelta];
+	}
+
+	if (patchError != nil) {
+		if (error != NULL) *error = patchError;
+		return nil;
+	}
+
+	return data;
+}
+
+// Returns the deltas in a cache file, or nil if it's corrupt.
+- (NSArray *)deltasFromData:(NSData *)data hasPatches:(BOOL *)hasPatches {
+	NSUInteger contentsLength = GTIndexFileContentsLength(data, GTDiffCacheMagic, GTDiffCacheVersion);
+	if (contentsLength == 0) return nil;
+
+	GTIndexFileReader reader = GTIndexFileReaderMake(data, contentsLength);
+	uint32_t flags = 0;
+	uint32_t count = 0;
+	if (!GTIndexFileReaderReadUInt32(&reader, &flags)) return nil;
+	if (!GTIndexFileReaderReadUInt32(&reader, &count)) return nil;
+
+	BOOL patches = (flags & GTDiffCacheFlagPatches) != 0;
+
+	// Every delta takes at least this much, so a bad count can't make us
+	// allocate a huge array.
+	static const NSUInteger minimumDeltaLength = 16 + 2 * (GIT_OID_RAWSZ + 20);
+	if (count > (reader.length - reader.offset) / minimumDeltaLength) return nil;
+
+	NSMutableArray *deltas = [NSMutableArray arrayWithCapacity:count];
+	for (uint32_t i = 0; i < count; i++) {
+		uint8_t status = 0;
+		uint8_t binary = 0;
+		uint16_t unused = 0;
+		uint32_t similarity = 0;
+		uint32_t addedLinesCount = 0;
+		uint32_t deletedLinesCount = 0;
+		if (!GTIndexFileReaderReadUInt8(&reader, &status)) return nil;
+		if (!GTIndexFileReaderReadUInt8(&reader, &binary)) return nil;
+		if (!GTIndexFileReaderReadUInt16(&reader, &unused)) return nil;
+		if (!GTIndexFileReaderReadUInt32(&reader, &similarity)) return nil;
+		if (!GTIndexFileReaderReadUInt32(&reader, &addedLinesCount)) return nil;
+		if (!GTIndexFileReaderReadUInt32(&reader, &deletedLinesCount)) return nil;
+
+		GTDiffFile *oldFile = GTDiffCacheReadFile(&reader);
+		if (oldFile == nil) return nil;
+
+		GTDiffFile *newFile = GTDiffCacheReadFile(&reader);
+		if (newFile == nil) return nil;
+
+		NSData *patchData = nil;
+		if (patches) {
+			uint32_t patchLength = 0;
+			const uint8_t *patchBytes = NULL;
+			if (!GTIndexFileReaderReadUInt32(&reader, &patchLength)) return nil;
+			if (!GTIndexFileReaderReadBytes(&reader, patchLength, &patchBytes)) return nil;
+
+			patchData = [NSData dataWithBytes:patchBytes length:patchLength];
+		}
+
+		[deltas addObject:[[GTCachedDiffDelta alloc] initWithType:(GTDiffDeltaType)status oldFile:oldFile newFile:newFile similarity:similarity binary:(binary != 0) patchData:patchData addedLinesCount:addedLinesCount deletedLinesCount:deletedLinesCount]];
+	}
+
+	if (!GTIndexFileReaderIsAtEnd(&reader)) return nil;
+
+	*hasPatches = patches;
+	return deltas;
+}
+
+#pragma mark Eviction
+
+// Account for a diff which has been written, evicting others if the cache has
+// grown too big.
+//
+// The directory is only scanned the first time, and when evicting, so writing
+// a diff doesn't cost a walk over every other one. Writes by other processes
+// are only noticed when evicting.
+- (void)didWriteDiffOfSize:(unsigned long long)writtenSize replacingSize:(unsigned long long)replacedSize {
+	@synchronized (self) {
+		if (self.sizeKnown) {
+			self.size = self.size - MIN(self.size, replacedSize) + writtenSize;
+		} else {
+			self.size = [self scanDiffs:NULL];
+			self.sizeKnown = YES;
+		}
+
+		if (self.size > self.maximumSize) [self evictDiffs];
+	}
+}
+
+// Returns the total size of the cached diffs, and if `files` isn't NULL, fills
+// it with an array of the URL, modification date and size of each one.
+- (unsigned long long)scanDiffs:(NSMutableArray **)files {
+	NSArray *keys = @[ NSURLIsRegularFileKey, NSURLFileSizeKey, NSURLContentModificationDateKey ];
+	NSDirectoryEnumerator *enumerator = [NSFileManager.defaultManager enumeratorAtURL:self.directoryURL includingPropertiesForKeys:keys options:NSDirectoryEnumerationSkipsHiddenFiles errorHandler:nil];
+
+	if (files != NULL) *files = [NSMutableArray array];
+
+	unsigned long long totalSize = 0;
+	for (NSURL *fileURL in enumerator) {
+		NSDictionary *values = [fileURL resourceValuesForKeys:keys error:NULL];
+		if (![values[NSURLIsRegularFileKey] boolValue]) continue;
+
+		totalSize += [values[NSURLFileSizeKey] unsignedLongLongValue];
+		if (files != NULL) [*files addObject:@[ fileURL, values[NSURLContentModificationDateKey] ?: NSDate.distantPast, values[NSURLFileSizeKey] ?: @0 ]];
+	}
+
+	return totalSize;
+}
+
+// Delete the least recently used diffs until the rest fit comfortably in
+// `maximumSize`.
+- (void)evictDiffs {
+	@synchronized (self) {
+		NSMutableArray *files = nil;
+		unsigned long long totalSize = [self scanDiffs:&files];
+
+		unsigned long long targetSize = self.maximumSize / 100 * GTDiffCacheEvictionTargetPercent;
+		if (totalSize > self.maximumSize) {
+			[files sortUsingComparator:^(NSArray *file1, NSArray *file2) {
+				return [file1[1] compare:file2[1]];
+			}];
+
+			for (NSArray *file in files) {
+				if (totalSize <= targetSize) break;
+				if (![NSFileManager.defaultManager removeItemAtURL:file[0] error:NULL]) continue;
+
+				totalSize -= [file[2] unsignedLongLongValue];
+			}
+		}
+
+		self.size = totalSize;
+		self.sizeKnown = YES;
+	}
+}
+
+@end
@@ -0,0 +1,26 @@
+//
+//  GTDiffDelta+Private.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTDiffDelta.h"
+
+@interface GTDiffDelta ()
+
+// Whether `git_diff_patch` has been generated, or tried to be.
+@property (nonatomic, assign) BOOL patchLoaded;
+
+// Initialises the receiver with a delta which has already been looked up in
+// the diff list, without touching the list again. Safe to call on any thread.
+- (instancetype)initWithDiff:(GTDiff *)diff deltaIndex:(NSUInteger)deltaIndex gitDelta:(const git_diff_delta *)gitDelta;
+
+// Hand the receiver a patch generated elsewhere, which it takes ownership of,
+// along with the blobs the patch was generated from, since its hunks and lines
+// point into them. Either blob may be NULL. Must only be called before the
+// receiver has loaded its own patch.
+- (void)adoptGitPatch:(git_diff_patch *)patch oldBlob:(git_blob *)oldBlob newBlob:(git_blob *)newBlob;
+
+@end
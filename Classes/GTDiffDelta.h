@@ -8,6 +8,7 @@
 
 #import "git2.h"
 
+@class GTDiff;
 @class GTDiffFile;
 @class GTDiffHunk;
 
@@ -41,16 +42,24 @@ typedef enum : git_delta_t {
 // The change may not be simply a change of text within a given file, it could
 // be that the file was renamed, or added to the index. See `GTDiffDeltaType`
 // for the types of change represented.
+//
+// Deltas from a diff only load their patch (both blobs, and the text diff
+// between them) when something needs it: the hunks or the line counts. Status
+// and file information come straight from the diff list.
 @interface GTDiffDelta : NSObject
 
 // A convenience accessor to fetch the `git_diff_delta` represented by the
 // object.
 @property (nonatomic, readonly) const git_diff_delta *git_diff_delta;
 
-// The backing libgit2 `git_diff_patch` object.
+// The backing libgit2 `git_diff_patch` object, generated the first time it's
+// asked for. This is NULL if the patch couldn't be generated.
 @property (nonatomic, readonly) git_diff_patch *git_diff_patch;
 
 // Whether the file(s) are to be treated as binary.
+//
+// If libgit2 hasn't looked at the files' contents yet, this generates the
+// patch.
 @property (nonatomic, readonly, getter = isBinary) BOOL binary;
 
 // The file to the "left" of the diff.
@@ -82,9 +91,19 @@ typedef enum : git_delta_t {
 // Undefined if this delta is binary.
 @property (nonatomic, readonly) NSUInteger contextLinesCount;
 
-// Designated initialiser.
+// Initialises the receiver with a patch which has already been generated.
 - (instancetype)initWithGitPatch:(git_diff_patch *)patch;
 
+// Initialises the receiver with a delta in a diff, without generating its
+// patch.
+//
+// diff       - The diff the delta is in. It's retained by the receiver, since
+//              the delta lives in its diff list. Cannot be nil.
+// deltaIndex - The index of the delta in the diff.
+//
+// Returns the delta, or nil if there's no delta at that index.
+- (instancetype)initWithDiff:(GTDiff *)diff deltaIndex:(NSUInteger)deltaIndex;
+
 // Enumerate the hunks contained in the delta.
 //
 // Blocks during enumeration.
@@ -7,12 +7,34 @@
 //
 
 #import "GTDiffDelta.h"
+#import "GTDiffDelta+Private.h"
 
+#import "GTDiff.h"
 #import "GTDiffFile.h"
 #import "GTDiffHunk.h"
 
+@interface GTDiffDelta () {
+	git_diff_patch *_git_diff_patch;
+	
+	// The blobs an adopted patch was generated from, which it points into.
+	git_blob *_oldBlob;
+	git_blob *_newBlob;
+}
+
+// The diff the delta was looked up in, or nil if the receiver was created with
+// a patch.
+@property (nonatomic, strong, readonly) GTDiff *diff;
+@property (nonatomic, readonly) NSUInteger deltaIndex;
+
+@end
+
 @implementation GTDiffDelta
 
+@synthesize git_diff_delta = _git_diff_delta;
+@synthesize addedLinesCount = _addedLinesCount;
+@synthesize deletedLinesCount = _deletedLinesCount;
+@synthesize contextLinesCount = _contextLinesCount;
+
 - (instancetype)initWithGitPatch:(git_diff_patch *)patch {
 	NSParameterAssert(patch != NULL);
 	
@@ -20,31 +42,94 @@
 	if (self == nil) return nil;
 	
 	_git_diff_patch = patch;
+	_git_diff_delta = git_diff_patch_delta(patch);
+	_patchLoaded = YES;
+	[self loadLineStats];
+	
+	return self;
+}
+
+- (instancetype)initWithDiff:(GTDiff *)diff deltaIndex:(NSUInteger)deltaIndex {
+	NSParameterAssert(diff != nil);
+	
+	// Asking for the delta alone doesn't generate the patch.
+	const git_diff_delta *gitDelta = NULL;
+	int result = git_diff_get_patch(NULL, &gitDelta, diff.git_diff_list, deltaIndex);
+	if (result != GIT_OK) return nil;
 	
+	return [self initWithDiff:diff deltaIndex:deltaIndex gitDelta:gitDelta];
+}
+
+- (instancetype)initWithDiff:(GTDiff *)diff deltaIndex:(NSUInteger)deltaIndex gitDelta:(const git_diff_delta *)gitDelta {
+	NSParameterAssert(diff != nil);
+	NSParameterAssert(gitDelta != NULL);
+	
+	self = [super init];
+	if (self == nil) return nil;
+	
+	_diff = diff;
+	_deltaIndex = deltaIndex;
+	_git_diff_delta = gitDelta;
+	
+	return self;
+}
+
+- (void)dealloc {
+	if (_git_diff_patch != NULL) git_diff_patch_free(_git_diff_patch);
+	git_blob_free(_oldBlob);
+	git_blob_free(_newBlob);
+}
+
+#pragma mark - Patch
+
+- (void)loadLineStats {
 	size_t adds = 0;
 	size_t deletes = 0;
 	size_t contexts = 0;
-	git_diff_patch_line_stats(&contexts, &adds, &deletes, patch);
+	if (_git_diff_patch != NULL) git_diff_patch_line_stats(&contexts, &adds, &deletes, _git_diff_patch);
 	
 	_addedLinesCount = adds;
 	_deletedLinesCount = deletes;
 	_contextLinesCount = contexts;
+}
+
+- (git_diff_patch *)git_diff_patch {
+	if (!self.patchLoaded) {
+		self.patchLoaded = YES;
+		
+		git_diff_patch *patch = NULL;
+		int result = git_diff_get_patch(&patch, NULL, self.diff.git_diff_list, self.deltaIndex);
+		if (result == GIT_OK) _git_diff_patch = patch;
+		
+		[self loadLineStats];
+	}
 	
-	return self;
+	return _git_diff_patch;
 }
 
-- (void)dealloc {
-	git_diff_patch_free(self.git_diff_patch);
+- (void)adoptGitPatch:(git_diff_patch *)patch oldBlob:(git_blob *)oldBlob newBlob:(git_blob *)newBlob {
+	NSParameterAssert(patch != NULL);
+	NSAssert(!self.patchLoaded, @"%@ already has a patch", self);
+	
+	_git_diff_patch = patch;
+	_oldBlob = oldBlob;
+	_newBlob = newBlob;
+	self.patchLoaded = YES;
+	[self loadLineStats];
 }
 
 #pragma mark - Properties
 
-- (const git_diff_delta *)git_diff_delta {
-	return git_diff_patch_delta(self.git_diff_patch);
-}
-
 - (BOOL)isBinary {
-	return (BOOL)self.git_diff_delta->binary;
+	// The list's delta is only updated when the list generates the patch
+	// itself, so once there is a patch, it knows best.
+	const git_diff_delta *delta = self.git_diff_delta;
+	if (delta->binary == -1 || self.patchLoaded) {
+		git_diff_patch *patch = self.git_diff_patch;
+		if (patch != NULL) delta = git_diff_patch_delta(patch);
+	}
+	
+	return delta->binary == 1;
 }
 
 - (GTDiffFile *)oldFile {
@@ -60,13 +145,32 @@
 }
 
 - (NSUInteger)hunkCount {
-	return git_diff_patch_num_hunks(self.git_diff_patch);
+	git_diff_patch *patch = self.git_diff_patch;
+	if (patch == NULL) return 0;
+	
+	return git_diff_patch_num_hunks(patch);
+}
+
+- (NSUInteger)addedLinesCount {
+	[self git_diff_patch];
+	return _addedLinesCount;
+}
+
+- (NSUInteger)deletedLinesCount {
+	[self git_diff_patch];
+	return _deletedLinesCount;
+}
+
+- (NSUInteger)contextLinesCount {
+	[self git_diff_patch];
+	return _contextLinesCount;
 }
 
 - (void)enumerateHunksWithBlock:(void (^)(GTDiffHunk *hunk, BOOL *stop))block {
 	NSParameterAssert(block != nil);
 	
-	for (NSUInteger idx = 0; idx < self.hunkCount; idx ++) {
+	NSUInteger hunkCount = self.hunkCount;
+	for (NSUInteger idx = 0; idx < hunkCount; idx ++) {
 		GTDiffHunk *hunk = [[GTDiffHunk alloc] initWithDelta:self hunkIndex:idx];
 		if (hunk == nil) return;
 		BOOL shouldStop = NO;
@@ -8,6 +8,8 @@
 
 #import "git2.h"
 
+@class GTOID;
+
 // Flags which may be set on the file.
 //
 // See diff.h for individual documentation.
@@ -36,6 +38,11 @@ typedef enum : git_diff_file_flag_t {
 // The mode of the file.
 @property (nonatomic, readonly) mode_t mode;
 
+// The OID of the file's contents. It's all zeros when there's no file on this
+// side, and may be for working directory files which haven't been hashed (see
+// `GTDiffFileFlagValidOID`).
+@property (nonatomic, readonly, strong) GTOID *OID;
+
 // Designated initialiser.
 - (instancetype)initWithGitDiffFile:(git_diff_file)file;
 
@@ -8,6 +8,8 @@
 
 #import "GTDiffFile.h"
 
+#import "GTOID.h"
+
 @implementation GTDiffFile
 
 - (instancetype)initWithGitDiffFile:(git_diff_file)file {
@@ -18,6 +20,7 @@
 	_flags = (GTDiffFileFlag)file.flags;
 	_mode = file.mode;
 	_path = [NSString stringWithUTF8String:file.path];
+	_OID = [[GTOID alloc] initWithGitOid:&file.oid];
 	
 	return self;
 }
@@ -7,6 +7,8 @@
 //
 
 #import "git2.h"
+#import "GTDiffLine.h"
+#import "GTDiffLineChange.h"
 
 @class GTDiffDelta;
 @class GTDiffLine;
@@ -14,12 +16,27 @@
 // A class representing a hunk within a diff delta.
 @interface GTDiffHunk : NSObject
 
-// The header of the hunk.
+// The header of the hunk, decoded the first time it's asked for.
 @property (nonatomic, readonly, copy) NSString *header;
 
+// The bytes of the header, including its newline, pointing into the delta's
+// patch. They aren't NUL terminated, and are valid as long as the delta.
+@property (nonatomic, readonly) const char *headerBytes;
+
+// The number of bytes in `headerBytes`.
+@property (nonatomic, readonly) NSUInteger headerLength;
+
 // The number of lines represented in the hunk.
 @property (nonatomic, readonly) NSUInteger lineCount;
 
+// The lines of the old file covered by the hunk. The location is the number
+// of the first line, counting from 1, or of the line before the hunk if the
+// range is empty.
+@property (nonatomic, readonly) NSRange oldLineRange;
+
+// The lines of the new file covered by the hunk, as with `oldLineRange`.
+@property (nonatomic, readonly) NSRange newLineRange;
+
 // Designated initialiser.
 //
 // The contents of a hunk are lazily loaded, therefore we initialise the object
@@ -34,4 +51,31 @@
 //         immediately stop the enumeration and return from the method.
 - (void)enumerateLinesInHunkUsingBlock:(void (^)(GTDiffLine *line, BOOL *stop))block;
 
+// Perfoms the given block on each line in the hunk, without allocating
+// anything per line.
+//
+// The line, and the bytes it points to, must not be used after the delta has
+// been deallocated. The line struct itself is only valid during the block.
+//
+// Note that this method blocks during the enumeration.
+//
+// block - A block to execute on each line. Setting `stop` to `YES` will
+//         immediately stop the enumeration and return from the method.
+- (void)enumerateRawLinesInHunkUsingBlock:(void (^)(const GTDiffRawLine *line, BOOL *stop))block;
+
+// Perfoms the given block on each changed line in the hunk, paired with the
+// line which replaced it, and broken down into the parts which changed.
+//
+// Each run of deleted lines followed by added lines is paired up in order, the
+// first deletion with the first addition and so on. Lines left over when one
+// side of a run is longer aren't included, as they're changed through and
+// through.
+//
+// Note that this method blocks during the enumeration.
+//
+// granularity - How finely to compare the lines.
+// block       - A block to execute on each pair. Setting `stop` to `YES` will
+//               immediately stop the enumeration and return from the method.
+- (void)enumerateLineChangesWithGranularity:(GTDiffLineChangeGranularity)granularity usingBlock:(void (^)(GTDiffLineChange *change, BOOL *stop))block;
+
 @end
@@ -10,8 +10,12 @@
 
 #import "GTDiffDelta.h"
 #import "GTDiffLine.h"
+#import "GTDiffLine+Private.h"
+#import "GTDiffLineChange+Private.h"
 
-@interface GTDiffHunk ()
+@interface GTDiffHunk () {
+	NSString *_header;
+}
 
 @property (nonatomic, strong, readonly) GTDiffDelta *delta;
 @property (nonatomic, readonly) NSUInteger hunkIndex;
@@ -27,34 +31,100 @@
 	_delta = delta;
 	_hunkIndex = hunkIndex;
 	
+	const git_diff_range *range;
 	const char *headerCString;
 	size_t headerLength;
 	size_t lineCount;
-	int result = git_diff_patch_get_hunk(NULL, &headerCString, &headerLength, &lineCount, delta.git_diff_patch, hunkIndex);
+	int result = git_diff_patch_get_hunk(&range, &headerCString, &headerLength, &lineCount, delta.git_diff_patch, hunkIndex);
 	if (result != GIT_OK) return nil;
 	
-	_header = [[[NSString alloc] initWithBytes:headerCString length:headerLength encoding:NSUTF8StringEncoding] stringByTrimmingCharactersInSet:NSCharacterSet.newlineCharacterSet];
+	_headerBytes = headerCString;
+	_headerLength = headerLength;
 	_lineCount = lineCount;
+	_oldLineRange = NSMakeRange((NSUInteger)range->old_start, (NSUInteger)range->old_lines);
+	_newLineRange = NSMakeRange((NSUInteger)range->new_start, (NSUInteger)range->new_lines);
 
 	return self;
 }
 
+- (NSString *)header {
+	if (_header == nil) {
+		_header = [[[NSString alloc] initWithBytes:self.headerBytes length:self.headerLength encoding:NSUTF8StringEncoding] stringByTrimmingCharactersInSet:NSCharacterSet.newlineCharacterSet];
+	}
+	
+	return _header;
+}
+
 - (void)enumerateLinesInHunkUsingBlock:(void (^)(GTDiffLine *line, BOOL *stop))block {
 	NSParameterAssert(block != nil);
 	
+	[self enumerateRawLinesInHunkUsingBlock:^(const GTDiffRawLine *rawLine, BOOL *stop) {
+		GTDiffLine *line = [[GTDiffLine alloc] initWithRawLine:rawLine owner:self.delta];
+		block(line, stop);
+	}];
+}
+
+- (void)enumerateLineChangesWithGranularity:(GTDiffLineChangeGranularity)granularity usingBlock:(void (^)(GTDiffLineChange *change, BOOL *stop))block {
+	NSParameterAssert(block != nil);
+	
+	// The lines of the current run. The structs are copied, but they point
+	// into the patch, which the delta keeps alive.
+	NSMutableData *deletions = [NSMutableData data];
+	NSMutableData *additions = [NSMutableData data];
+	__block BOOL stopped = NO;
+	
+	void (^pairRun)(void) = ^{
+		NSUInteger count = MIN(deletions.length, additions.length) / sizeof(GTDiffRawLine);
+		const GTDiffRawLine *oldLines = deletions.bytes;
+		const GTDiffRawLine *newLines = additions.bytes;
+		for (NSUInteger idx = 0; idx < count && !stopped; idx ++) {
+			GTDiffLineChange *change = [[GTDiffLineChange alloc] initWithOldRawLine:&oldLines[idx] newRawLine:&newLines[idx] owner:self.delta granularity:granularity];
+			block(change, &stopped);
+		}
+		
+		deletions.length = 0;
+		additions.length = 0;
+	};
+	
+	[self enumerateRawLinesInHunkUsingBlock:^(const GTDiffRawLine *line, BOOL *stop) {
+		if (line->origin == GTDiffLineOriginDeletion) {
+			if (additions.length > 0) pairRun();
+			[deletions appendBytes:line length:sizeof(*line)];
+		} else if (line->origin == GTDiffLineOriginAddition) {
+			[additions appendBytes:line length:sizeof(*line)];
+		} else if (line->origin == GTDiffLineOriginContext) {
+			pairRun();
+		}
+		
+		*stop = stopped;
+	}];
+	
+	if (!stopped) pairRun();
+}
+
+- (void)enumerateRawLinesInHunkUsingBlock:(void (^)(const GTDiffRawLine *line, BOOL *stop))block {
+	NSParameterAssert(block != nil);
+	
+	git_diff_patch *patch = self.delta.git_diff_patch;
 	for (NSUInteger idx = 0; idx < self.lineCount; idx ++) {
 		char lineOrigin;
 		const char *content;
 		size_t contentLength;
 		int oldLineNumber;
 		int newLineNumber;
-		int result = git_diff_patch_get_line_in_hunk(&lineOrigin, &content, &contentLength, &oldLineNumber, &newLineNumber, self.delta.git_diff_patch, self.hunkIndex, idx);
+		int result = git_diff_patch_get_line_in_hunk(&lineOrigin, &content, &contentLength, &oldLineNumber, &newLineNumber, patch, self.hunkIndex, idx);
 		if (result != GIT_OK) continue;
 		
-		NSString *lineString = [[[NSString alloc] initWithBytes:content length:contentLength encoding:NSUTF8StringEncoding] stringByTrimmingCharactersInSet:NSCharacterSet.newlineCharacterSet];
-		GTDiffLine *line = [[GTDiffLine alloc] initWithContent:lineString oldLineNumber:oldLineNumber newLineNumber:newLineNumber origin:lineOrigin];
+		GTDiffRawLine line = {
+			.origin = (GTDiffLineOrigin)lineOrigin,
+			.oldLineNumber = oldLineNumber,
+			.newLineNumber = newLineNumber,
+			.content = content,
+			.contentLength = contentLength,
+		};
+		
 		BOOL stop = NO;
-		block(line, &stop);
+		block(&line, &stop);
 		if (stop) return;
 	}
 }
@@ -0,0 +1,20 @@
+//
+//  GTDiffLine+Private.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTDiffLine.h"
+
+@interface GTDiffLine ()
+
+// Initializes the receiver with a raw line, decoding its content lazily.
+//
+// line  - The line. Cannot be NULL.
+// owner - The object which keeps the line's bytes alive, usually its
+//         `GTDiffDelta`. It's retained until the content has been decoded.
+- (instancetype)initWithRawLine:(const GTDiffRawLine *)line owner:(id)owner;
+
+@end
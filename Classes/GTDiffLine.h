@@ -19,10 +19,33 @@ typedef enum : git_diff_line_t {
 	GTDiffLineOriginDeleteEOFNewLine = GIT_DIFF_LINE_DEL_EOFNL,
 } GTDiffLineOrigin;
 
+// A line in a diff hunk, pointing into its delta's patch instead of copying
+// anything out of it.
+//
+// origin        - The origin of the line.
+// oldLineNumber - The line number in the left side of the diff, or -1 if the
+//                 line is an addition.
+// newLineNumber - The line number in the right side of the diff, or -1 if the
+//                 line is a deletion.
+// content       - The bytes of the line, including its newline if it has one.
+//                 They aren't NUL terminated, aren't necessarily UTF-8, and
+//                 are only valid as long as the `GTDiffDelta` they came from.
+// contentLength - The number of bytes in `content`.
+typedef struct {
+	GTDiffLineOrigin origin;
+	NSInteger oldLineNumber;
+	NSInteger newLineNumber;
+	const char *content;
+	NSUInteger contentLength;
+} GTDiffRawLine;
+
 // Represents an individual line in a diff hunk.
 @interface GTDiffLine : NSObject
 
-// The content string of the line.
+// The content string of the line, without its newline.
+//
+// Lines from a hunk are decoded the first time this is asked for, as UTF-8,
+// or as ISO Latin 1 if they aren't valid UTF-8.
 @property (nonatomic, readonly, copy) NSString *content;
 
 // The line number of this line in the left side of the diff.
@@ -7,6 +7,19 @@
 //
 
 #import "GTDiffLine.h"
+#import "GTDiffLine+Private.h"
+
+@interface GTDiffLine () {
+	NSString *_content;
+	
+	// The undecoded content, and what keeps it alive, until `content` is
+	// asked for.
+	const char *_contentBytes;
+	NSUInteger _contentLength;
+	id _contentOwner;
+}
+
+@end
 
 @implementation GTDiffLine
 
@@ -22,4 +35,35 @@
 	return self;
 }
 
+- (instancetype)initWithRawLine:(const GTDiffRawLine *)line owner:(id)owner {
+	NSParameterAssert(line != NULL);
+	
+	self = [super init];
+	if (self == nil) return nil;
+	
+	_oldLineNumber = line->oldLineNumber;
+	_newLineNumber = line->newLineNumber;
+	_origin = line->origin;
+	_contentBytes = line->content;
+	_contentLength = line->contentLength;
+	_contentOwner = owner;
+	
+	return self;
+}
+
+- (NSString *)content {
+	if (_contentOwner != nil) {
+		NSUInteger length = _contentLength;
+		while (length > 0 && (_contentBytes[length - 1] == '\n' || _contentBytes[length - 1] == '\r')) length--;
+		
+		_content = [[NSString alloc] initWithBytes:_contentBytes length:length encoding:NSUTF8StringEncoding];
+		if (_content == nil) _content = [[NSString alloc] initWithBytes:_contentBytes length:length encoding:NSISOLatin1StringEncoding];
+		
+		_contentBytes = NULL;
+		_contentOwner = nil;
+	}
+	
+	return _content;
+}
+
 @end
@@ -0,0 +1,23 @@
+//
+//  GTDiffLineChange+Private.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTDiffLineChange.h"
+#import "GTDiffLine.h"
+
+@interface GTDiffLineChange ()
+
+// Compares a deleted line with the added line which replaced it.
+//
+// oldLine     - The deleted line. Cannot be NULL.
+// newLine     - The added line. Cannot be NULL.
+// owner       - The object which keeps the lines' bytes alive, usually their
+//               `GTDiffDelta`.
+// granularity - How finely to compare the lines.
+- (id)initWithOldRawLine:(const GTDiffRawLine *)oldLine newRawLine:(const GTDiffRawLine *)newLine owner:(id)owner granularity:(GTDiffLineChangeGranularity)granularity;
+
+@end
@@ -0,0 +1,72 @@
+//
+//  GTDiffLineChange.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTDiffLine;
+
+// How finely a line change is broken down.
+//
+// GTDiffLineChangeGranularityWord      - Lines are compared as runs of letters,
+//                                        digits and underscores, runs of
+//                                        whitespace, and single punctuation
+//                                        characters.
+// GTDiffLineChangeGranularityCharacter - Lines are compared character by
+//                                        character (UTF-8 sequences are kept
+//                                        whole).
+typedef enum {
+	GTDiffLineChangeGranularityWord,
+	GTDiffLineChangeGranularityCharacter,
+} GTDiffLineChangeGranularity;
+
+// A deleted line and the added line which replaced it, with the parts of each
+// which actually changed.
+//
+// The lines are compared with Myers' diff algorithm, in linear space. Lines
+// which would take too long to compare (because they're very long and very
+// different) aren't compared beyond their common beginning and end, and
+// everything in between is marked as changed.
+@interface GTDiffLineChange : NSObject
+
+// The deleted line.
+@property (nonatomic, readonly, strong) GTDiffLine *oldLine;
+
+// The added line.
+@property (nonatomic, readonly, strong) GTDiffLine *newLine;
+
+// How finely the lines were compared.
+@property (nonatomic, readonly) GTDiffLineChangeGranularity granularity;
+
+// Whether the lines were compared in full. If not, the changed ranges cover
+// everything between the lines' common beginning and end.
+@property (nonatomic, readonly, getter = isRefined) BOOL refined;
+
+// The byte offsets of the changed parts of the old line's content, without its
+// newline. The content is as it is in the patch, which is usually, but not
+// always, UTF-8.
+@property (nonatomic, readonly, copy) NSIndexSet *oldChangedByteRanges;
+
+// The byte offsets of the changed parts of the new line's content.
+@property (nonatomic, readonly, copy) NSIndexSet *newChangedByteRanges;
+
+// Find the changed parts of two pieces of text.
+//
+// oldBytes         - The old text. A trailing newline is ignored.
+// oldLength        - The number of bytes in `oldBytes`.
+// newBytes         - The new text. A trailing newline is ignored.
+// newLength        - The number of bytes in `newBytes`.
+// granularity      - How finely to compare the texts.
+// oldChangedRanges - If not NULL, set to the byte offsets of the changed parts
+//                    of the old text.
+// newChangedRanges - If not NULL, set to the byte offsets of the changed parts
+//                    of the new text.
+//
+// Returns whether the texts were compared in full (see `refined`).
++ (BOOL)compareOldBytes:(const char *)oldBytes length:(NSUInteger)oldLength newBytes:(const char *)newBytes length:(NSUInteger)newLength granularity:(GTDiffLineChangeGranularity)granularity oldChangedRanges:(NSIndexSet **)oldChangedRanges newChangedRanges:(NSIndexSet **)newChangedRanges;
+
+@end
@@ -0,0 +1,358 @@
+//
+//  GTDiffLineChange.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTDiffLineChange.h"
+#import "GTDiffLineChange+Private.h"
+#import "GTDiffLine.h"
+#import "GTDiffLine+Private.h"
+
+// Lines with more tokens than this, between their common beginning and end,
+// aren't compared.
+static const NSUInteger GTDiffLineChangeMaximumTokenCount = 100000;
+
+// The most diagonals the comparison of two lines may explore before giving
+// up. Ordinary lines need a few hundred at most.
+static const NSUInteger GTDiffLineChangeMaximumCost = 1000000;
+
+typedef enum {
+	GTDiffByteClassWord,
+	GTDiffByteClassSpace,
+	GTDiffByteClassPunctuation,
+} GTDiffByteClass;
+
+// What each byte is, for splitting lines into words. Bytes of multibyte UTF-8
+// characters count as letters, so those characters are never split.
+static uint8_t GTDiffByteClasses[256];
+
+static void GTDiffInitializeByteClasses(void) {
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		for (NSUInteger byte = 0; byte < 256; byte++) {
+			if (byte >= 0x80 || isalnum((int)byte) || byte == '_') {
+				GTDiffByteClasses[byte] = GTDiffByteClassWord;
+			} else if (byte == ' ' || byte == '\t' || byte == '\r' || byte == '\n' || byte == '\v' || byte == '\f') {
+				GTDiffByteClasses[byte] = GTDiffByteClassSpace;
+			} else {
+				GTDiffByteClasses[byte] = GTDiffByteClassPunctuation;
+			}
+		}
+	});
+}
+
+// A word or character of a line.
+typedef struct {
+	uint32_t offset;
+	uint32_t length;
+	uint32_t hash;
+} GTDiffToken;
+
+// The length of a line without its newline.
+static NSUInteger GTDiffLineChangeContentLength(const char *bytes, NSUInteger length) {
+	if (length > 0 && bytes[length - 1] == '\n') length--;
+	if (length > 0 && bytes[length - 1] == '\r') length--;
+	return length;
+}
+
+// Splits a line into tokens, which must have room for `length` of them, and
+// returns how many there are.
+static NSUInteger GTDiffTokenize(const char *bytes, NSUInteger length, GTDiffLineChangeGranularity granularity, GTDiffToken *tokens) {
+	const uint8_t *unsignedBytes = (const uint8_t *)bytes;
+	NSUInteger count = 0;
+	NSUInteger offset = 0;
+	while (offset < length) {
+		NSUInteger end = offset + 1;
+		if (granularity == GTDiffLineChangeGranularityCharacter) {
+			while (end < length && (unsignedBytes[end] & 0xc0) == 0x80) end++;
+		} else {
+			uint8_t class = GTDiffByteClasses[unsignedBytes[offset]];
+			if (class != GTDiffByteClassPunctuation) {
+				while (end < length && GTDiffByteClasses[unsignedBytes[end]] == class) end++;
+			}
+		}
+
+		// FNV-1a.
+		uint32_t hash = 2166136261u;
+		for (NSUInteger i = offset; i < end; i++) {
+			hash = (hash ^ unsignedBytes[i]) * 16777619u;
+		}
+
+		tokens[count++] = (GTDiffToken){ .offset = (uint32_t)offset, .length = (uint32_t)(end - offset), .hash = hash };
+		offset = end;
+	}
+
+	return count;
+}
+
+typedef struct {
+	const char *oldBytes;
+	const GTDiffToken *oldTokens;
+	const char *newBytes;
+	const GTDiffToken *newTokens;
+
+	// The furthest reaching paths on each diagonal, going forward from the
+	// start and backward from the end.
+	NSInteger *forward;
+	NSInteger *backward;
+
+	// Which tokens have changed.
+	uint8_t *oldChanged;
+	uint8_t *newChanged;
+
+	// How many more diagonals may be explored.
+	NSUInteger budget;
+} GTDiffMyersContext;
+
+static inline BOOL GTDiffTokensEqual(const GTDiffMyersContext *context, NSInteger oldIndex, NSInteger newIndex) {
+	const GTDiffToken *oldToken = &context->oldTokens[oldIndex];
+	const GTDiffToken *newToken = &context->newTokens[newIndex];
+	return oldToken->hash == newToken->hash && oldToken->length == newToken->length && memcmp(context->oldBytes + oldToken->offset, context->newBytes + newToken->offset, oldToken->length) == 0;
+}
+
+// Find the middle of an optimal path from (oldStart, newStart) to (oldEnd,
+// newEnd), by searching from both ends at once until the searches meet.
+//
+// Returns NO if the budget ran out. Otherwise `found` says whether a middle
+// was found, which it only isn't if the ranges have nothing in common.
+static BOOL GTDiffMyersBisect(GTDiffMyersContext *context, NSInteger oldStart, NSInteger oldEnd, NSInteger newStart, NSInteger newEnd, NSInteger *splitOld, NSInteger *splitNew, BOOL *found) {
+	NSInteger oldLength = oldEnd - oldStart;
+	NSInteger newLength = newEnd - newStart;
+	NSInteger maxD = (oldLength + newLength + 1) / 2;
+	NSInteger vOffset = maxD;
+	NSInteger vLength = 2 * maxD + 2;
+
+	NSInteger *v1 = context->forward;
+	NSInteger *v2 = context->backward;
+	for (NSInteger i = 0; i < vLength; i++) {
+		v1[i] = -1;
+		v2[i] = -1;
+	}
+	v1[vOffset + 1] = 0;
+	v2[vOffset + 1] = 0;
+
+	// If the difference in lengths is odd, the forward search finds where the
+	// searches overlap, otherwise the backward search does.
+	NSInteger delta = oldLength - newLength;
+	BOOL front = (delta % 2 != 0);
+
+	// Diagonals which have run off the edge don't need exploring again.
+	NSInteger k1Start = 0, k1End = 0, k2Start = 0, k2End = 0;
+
+	*found = NO;
+	for (NSInteger d = 0; d < maxD; d++) {
+		for (NSInteger k1 = -d + k1Start; k1 <= d - k1End; k1 += 2) {
+			if (context->budget == 0) return NO;
+			context->budget--;
+
+			NSInteger k1Offset = vOffset + k1;
+			NSInteger x1 = 0;
+			if (k1 == -d || (k1 != d && v1[k1Offset - 1] < v1[k1Offset + 1])) {
+				x1 = v1[k1Offset + 1];
+			} else {
+				x1 = v1[k1Offset - 1] + 1;
+			}
+
+			NSInteger y1 = x1 - k1;
+			while (x1 < oldLength && y1 < newLength && GTDiffTokensEqual(context, oldStart + x1, newStart + y1)) {
+				x1++;
+				y1++;
+			}
+
+			v1[k1Offset] = x1;
+			if (x1 > oldLength) {
+				k1End += 2;
+			} else if (y1 > newLength) {
+				k1Start += 2;
+			} else if (front) {
+				NSInteger k2Offset = vOffset + delta - k1;
+				if (k2Offset >= 0 && k2Offset < vLength && v2[k2Offset] != -1 && x1 >= oldLength - v2[k2Offset]) {
+					*splitOld = oldStart + x1;
+					*splitNew = newStart + y1;
+					*found = YES;
+					return YES;
+				}
+			}
+		}
+
+		for (NSInteger k2 = -d + k2Start; k2 <= d - k2End; k2 += 2) {
+			if (context->budget == 0) return NO;
+			context->budget--;
+
+			NSInteger k2Offset = vOffset + k2;
+			NSInteger x2 = 0;
+			if (k2 == -d || (k2 != d && v2[k2Offset - 1] < v2[k2Offset + 1])) {
+				x2 = v2[k2Offset + 1];
+			} else {
+				x2 = v2[k2Offset - 1] + 1;
+			}
+
+			NSInteger y2 = x2 - k2;
+			while (x2 < oldLength && y2 < newLength && GTDiffTokensEqual(context, oldEnd - x2 - 1, newEnd - y2 - 1)) {
+				x2++;
+				y2++;
+			}
+
+			v2[k2Offset] = x2;
+			if (x2 > oldLength) {
+				k2End += 2;
+			} else if (y2 > newLength) {
+				k2Start += 2;
+			} else if (!front) {
+				NSInteger k1Offset = vOffset + delta - k2;
+				if (k1Offset >= 0 && k1Offset < vLength && v1[k1Offset] != -1) {
+					NSInteger x1 = v1[k1Offset];
+					NSInteger y1 = vOffset + x1 - k1Offset;
+					if (x1 >= oldLength - x2) {
+						*splitOld = oldStart + x1;
+						*splitNew = newStart + y1;
+						*found = YES;
+						return YES;
+					}
+				}
+			}
+		}
+	}
+
+	return YES;
+}
+
+// Mark the tokens which aren't on an optimal path from (oldStart, newStart)
+// to (oldEnd, newEnd) as changed.
+//
+// Returns NO if the budget ran out.
+static BOOL GTDiffMyersCompare(GTDiffMyersContext *context, NSInteger oldStart, NSInteger oldEnd, NSInteger newStart, NSInteger newEnd) {
+	while (oldStart < oldEnd && newStart < newEnd && GTDiffTokensEqual(context, oldStart, newStart)) {
+		oldStart++;
+		newStart++;
+	}
+
+	while (oldStart < oldEnd && newStart < newEnd && GTDiffTokensEqual(context, oldEnd - 1, newEnd - 1)) {
+		oldEnd--;
+		newEnd--;
+	}
+
+	if (oldStart == oldEnd || newStart == newEnd) {
+		memset(context->oldChanged + oldStart, 1, (size_t)(oldEnd - oldStart));
+		memset(context->newChanged + newStart, 1, (size_t)(newEnd - newStart));
+		return YES;
+	}
+
+	NSInteger splitOld = 0;
+	NSInteger splitNew = 0;
+	BOOL found = NO;
+	if (!GTDiffMyersBisect(context, oldStart, oldEnd, newStart, newEnd, &splitOld, &splitNew, &found)) return NO;
+
+	if (!found) {
+		memset(context->oldChanged + oldStart, 1, (size_t)(oldEnd - oldStart));
+		memset(context->newChanged + newStart, 1, (size_t)(newEnd - newStart));
+		return YES;
+	}
+
+	return GTDiffMyersCompare(context, oldStart, splitOld, newStart, splitNew) && GTDiffMyersCompare(context, splitOld, oldEnd, splitNew, newEnd);
+}
+
+static void GTDiffAddChangedTokens(NSMutableIndexSet *ranges, const GTDiffToken *tokens, const uint8_t *changed, NSUInteger start, NSUInteger end) {
+	for (NSUInteger i = start; i < end; i++) {
+		if (changed == NULL || changed[i]) [ranges addIndexesInRange:NSMakeRange(tokens[i].offset, tokens[i].length)];
+	}
+}
+
+@implementation GTDiffLineChange
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> oldLine: %@, newLine: %@, oldChangedByteRanges: %@, newChangedByteRanges: %@", NSStringFromClass([self class]), self, self.oldLine.content, self.newLine.content, self.oldChangedByteRanges, self.newChangedByteRanges];
+}
+
+#pragma mark API
+
++ (BOOL)compareOldBytes:(const char *)oldBytes length:(NSUInteger)oldLength newBytes:(const char *)newBytes length:(NSUInteger)newLength granularity:(GTDiffLineChangeGranularity)granularity oldChangedRanges:(NSIndexSet **)oldChangedRanges newChangedRanges:(NSIndexSet **)newChangedRanges {
+	GTDiffInitializeByteClasses();
+
+	oldLength = GTDiffLineChangeContentLength(oldBytes, oldLength);
+	newLength = GTDiffLineChangeContentLength(newBytes, newLength);
+
+	GTDiffToken *oldTokens = malloc(MAX(oldLength, 1) * sizeof(*oldTokens));
+	GTDiffToken *newTokens = malloc(MAX(newLength, 1) * sizeof(*newTokens));
+	NSUInteger oldCount = GTDiffTokenize(oldBytes, oldLength, granularity, oldTokens);
+	NSUInteger newCount = GTDiffTokenize(newBytes, newLength, granularity, newTokens);
+
+	GTDiffMyersContext context = {
+		.oldBytes = oldBytes,
+		.oldTokens = oldTokens,
+		.newBytes = newBytes,
+		.newTokens = newTokens,
+		.budget = GTDiffLineChangeMaximumCost,
+	};
+
+	// The common beginning and end are cheap to find, and all that's left to
+	// go on if the lines are too different to compare.
+	NSUInteger prefixCount = 0;
+	while (prefixCount < oldCount && prefixCount < newCount && GTDiffTokensEqual(&context, prefixCount, prefixCount)) prefixCount++;
+
+	NSUInteger suffixCount = 0;
+	while (suffixCount < oldCount - prefixCount && suffixCount < newCount - prefixCount && GTDiffTokensEqual(&context, oldCount - suffixCount - 1, newCount - suffixCount - 1)) suffixCount++;
+
+	NSUInteger oldEnd = oldCount - suffixCount;
+	NSUInteger newEnd = newCount - suffixCount;
+	NSMutableIndexSet *oldRanges = [NSMutableIndexSet indexSet];
+	NSMutableIndexSet *newRanges = [NSMutableIndexSet indexSet];
+
+	BOOL refined = NO;
+	if ((oldEnd - prefixCount) + (newEnd - prefixCount) <= GTDiffLineChangeMaximumTokenCount) {
+		NSUInteger vLength = (oldEnd - prefixCount) + (newEnd - prefixCount) + 3;
+		context.forward = malloc(vLength * sizeof(*context.forward));
+		context.backward = malloc(vLength * sizeof(*context.backward));
+		context.oldChanged = calloc(MAX(oldCount, 1), sizeof(*context.oldChanged));
+		context.newChanged = calloc(MAX(newCount, 1), sizeof(*context.newChanged));
+
+		refined = GTDiffMyersCompare(&context, prefixCount, oldEnd, prefixCount, newEnd);
+		if (refined) {
+			GTDiffAddChangedTokens(oldRanges, oldTokens, context.oldChanged, prefixCount, oldEnd);
+			GTDiffAddChangedTokens(newRanges, newTokens, context.newChanged, prefixCount, newEnd);
+		}
+
+		free(context.forward);
+		free(context.backward);
+		free(context.oldChanged);
+		free(context.newChanged);
+	}
+
+	if (!refined) {
+		GTDiffAddChangedTokens(oldRanges, oldTokens, NULL, prefixCount, oldEnd);
+		GTDiffAddChangedTokens(newRanges, newTokens, NULL, prefixCount, newEnd);
+	}
+
+	free(oldTokens);
+	free(newTokens);
+
+	if (oldChangedRanges != NULL) *oldChangedRanges = oldRanges;
+	if (newChangedRanges != NULL) *newChangedRanges = newRanges;
+
+	return refined;
+}
+
+- (id)initWithOldRawLine:(const GTDiffRawLine *)oldLine newRawLine:(const GTDiffRawLine *)newLine owner:(id)owner granularity:(GTDiffLineChangeGranularity)granularity {
+	NSParameterAssert(oldLine != NULL);
+	NSParameterAssert(newLine != NULL);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_oldLine = [[GTDiffLine alloc] initWithRawLine:oldLine owner:owner];
+	_newLine = [[GTDiffLine alloc] initWithRawLine:newLine owner:owner];
+	_granularity = granularity;
+
+	NSIndexSet *oldChangedByteRanges = nil;
+	NSIndexSet *newChangedByteRanges = nil;
+	_refined = [self.class compareOldBytes:oldLine->content length:oldLine->contentLength newBytes:newLine->content length:newLine->contentLength granularity:granularity oldChangedRanges:&oldChangedByteRanges newChangedRanges:&newChangedByteRanges];
+	_oldChangedByteRanges = oldChangedByteRanges;
+	_newChangedByteRanges = newChangedByteRanges;
+
+	return self;
+}
+
+@end
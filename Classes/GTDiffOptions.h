@@ -0,0 +1,68 @@
+//
+//  GTDiffOptions.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "git2.h"
+
+// Options for making diffs and finding renames in them, prepared once so they
+// can be used for any number of diffs.
+//
+// Passing a dictionary to GTDiff parses it into libgit2's structs again, and
+// copies its strings, for every diff. A `GTDiffOptions` does that when it's
+// created, and keeps the structs and the strings they point to for as long as
+// it lives. The first time a path is tested against it, it also compiles the
+// pathspec into a matcher which tests paths the way libgit2 does, without
+// going through libgit2.
+//
+// Instances are immutable, so they may be shared between threads.
+@interface GTDiffOptions : NSObject <NSCopying>
+
+// The dictionary the receiver was created from. Never nil.
+@property (nonatomic, readonly, copy) NSDictionary *dictionary;
+
+// The options to make diffs with, or NULL if the dictionary contains none of
+// the `GTDiffOptions…Key`s, in which case libgit2's defaults should be used.
+//
+// It's only valid for as long as the receiver.
+@property (nonatomic, readonly) const git_diff_options *git_diff_options;
+
+// The options to find renames with, or NULL if the dictionary contains none of
+// the `GTDiffFindOptions…Key`s, in which case libgit2's defaults should be
+// used.
+//
+// It's only valid for as long as the receiver.
+@property (nonatomic, readonly) const git_diff_find_options *git_diff_find_options;
+
+// Creates options from a dictionary.
++ (instancetype)optionsWithDictionary:(NSDictionary *)dictionary;
+
+// Designated initializer.
+//
+// dictionary - A dictionary containing any of the `GTDiffOptions…Key` and
+//              `GTDiffFindOptions…Key` constants from GTDiff.h, or nil to use
+//              the defaults.
+- (id)initWithDictionary:(NSDictionary *)dictionary;
+
+// Whether a path is included by `GTDiffOptionsPathSpecArrayKey`.
+//
+// As in libgit2, the patterns are tried in order and the first one to match
+// decides: patterns starting with `!` exclude, the rest include. Patterns
+// match the path exactly or as globs, and patterns without wildcards also
+// match everything in the directory they name. When there is no pathspec,
+// every path is included.
+//
+// path - The path, relative to the root of the repository. Cannot be nil.
+- (BOOL)matchesPath:(NSString *)path;
+
+// Like -matchesPath:, for a path as it's found in a `git_diff_file`.
+//
+// bytes  - The path, in UTF-8. Need not be NUL terminated.
+// length - The number of bytes in `bytes`.
+- (BOOL)matchesPathBytes:(const char *)bytes length:(NSUInteger)length;
+
+@end
@@ -0,0 +1,542 @@
+//
+//  GTDiffOptions.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTDiffOptions.h"
+#import "GTDiff.h"
+
+// A node in the trie of pathspec patterns without wildcards.
+typedef struct {
+	NSUInteger firstChild;
+	NSUInteger nextSibling;
+
+	// The first pattern matching a path which ends at this node, or NSNotFound.
+	NSUInteger exactPattern;
+
+	// The first pattern matching a path which continues past this node with a
+	// `/`, or NSNotFound.
+	NSUInteger directoryPattern;
+
+	uint8_t byte;
+} GTDiffPathspecNode;
+
+typedef enum {
+	GTDiffPathspecOpByte,
+	GTDiffPathspecOpAnyByte,
+	GTDiffPathspecOpStar,
+	GTDiffPathspecOpClass,
+} GTDiffPathspecOpKind;
+
+// One step of a compiled glob.
+typedef struct {
+	uint8_t kind;
+	uint8_t byte;
+	uint32_t classIndex;
+} GTDiffPathspecOp;
+
+// The bytes a `[…]` matches, one bit each.
+typedef struct {
+	uint8_t bits[32];
+} GTDiffPathspecClass;
+
+// A pattern with wildcards, as a run of `GTDiffPathspecOp`s.
+typedef struct {
+	NSUInteger pattern;
+	NSUInteger firstOp;
+	NSUInteger opCount;
+} GTDiffPathspecGlob;
+
+static inline uint8_t GTDiffPathspecFoldByte(uint8_t byte, BOOL caseFold) {
+	return (caseFold && byte >= 'A' && byte <= 'Z' ? byte + ('a' - 'A') : byte);
+}
+
+static inline BOOL GTDiffPathspecClassContains(const GTDiffPathspecClass *class, uint8_t byte) {
+	return (class->bits[byte >> 3] & (1 << (byte & 7))) != 0;
+}
+
+static inline void GTDiffPathspecClassAdd(GTDiffPathspecClass *class, uint8_t byte) {
+	class->bits[byte >> 3] |= (uint8_t)(1 << (byte & 7));
+}
+
+static BOOL GTDiffPathspecPatternHasWildcards(const char *pattern, size_t length) {
+	for (size_t idx = 0; idx < length; idx++) {
+		char character = pattern[idx];
+		if (character == '*' || character == '?' || character == '[' || character == '\\') return YES;
+	}
+
+	return NO;
+}
+
+// Parse a `[…]` starting at `pattern[start]`, as fnmatch() does.
+//
+// Returns the index just past the closing `]`, or 0 if there isn't one, in
+// which case the `[` is just a `[`.
+static size_t GTDiffPathspecParseClass(const char *pattern, size_t length, size_t start, BOOL caseFold, GTDiffPathspecClass *class) {
+	memset(class, 0, sizeof(*class));
+
+	size_t idx = start + 1;
+	BOOL negated = NO;
+	if (idx < length && (pattern[idx] == '!' || pattern[idx] == '^')) {
+		negated = YES;
+		idx++;
+	}
+
+	BOOL first = YES;
+	while (idx < length && (pattern[idx] != ']' || first)) {
+		first = NO;
+
+		uint8_t low = (uint8_t)pattern[idx];
+		if (low == '\\' && idx + 1 < length) low = (uint8_t)pattern[++idx];
+		idx++;
+
+		uint8_t high = low;
+		if (idx + 1 < length && pattern[idx] == '-' && pattern[idx + 1] != ']') {
+			idx++;
+			high = (uint8_t)pattern[idx];
+			if (high == '\\' && idx + 1 < length) high = (uint8_t)pattern[++idx];
+			idx++;
+		}
+
+		for (NSUInteger byte = low; byte <= high; byte++) {
+			GTDiffPathspecClassAdd(class, (uint8_t)byte);
+		}
+	}
+
+	if (idx >= length) return 0;
+
+	if (caseFold) {
+		for (uint8_t byte = 'a'; byte <= 'z'; byte++) {
+			uint8_t upper = byte - ('a' - 'A');
+			if (GTDiffPathspecClassContains(class, byte) || GTDiffPathspecClassContains(class, upper)) {
+				GTDiffPathspecClassAdd(class, byte);
+				GTDiffPathspecClassAdd(class, upper);
+			}
+		}
+	}
+
+	if (negated) {
+		for (NSUInteger byteIndex = 0; byteIndex < sizeof(class->bits); byteIndex++) {
+			class->bits[byteIndex] = (uint8_t)~class->bits[byteIndex];
+		}
+	}
+
+	return idx + 1;
+}
+
+static inline BOOL GTDiffPathspecOpMatches(const GTDiffPathspecOp *op, const GTDiffPathspecClass *classes, uint8_t byte) {
+	switch (op->kind) {
+		case GTDiffPathspecOpByte:
+			return op->byte == byte;
+		case GTDiffPathspecOpAnyByte:
+			return YES;
+		case GTDiffPathspecOpClass:
+			return GTDiffPathspecClassContains(&classes[op->classIndex], byte);
+		default:
+			return NO;
+	}
+}
+
+// Match a glob against a whole path, as fnmatch() does without FNM_PATHNAME,
+// so `*` matches `/` too.
+//
+// Only the last `*` is ever backtracked to, which keeps this linear in the
+// length of the path for most patterns.
+static BOOL GTDiffPathspecGlobMatches(const GTDiffPathspecOp *ops, NSUInteger opCount, const GTDiffPathspecClass *classes, const uint8_t *path, NSUInteger length, BOOL caseFold) {
+	NSUInteger opIndex = 0;
+	NSUInteger pathIndex = 0;
+	NSUInteger starOpIndex = NSNotFound;
+	NSUInteger starPathIndex = 0;
+
+	while (pathIndex < length) {
+		if (opIndex < opCount && ops[opIndex].kind == GTDiffPathspecOpStar) {
+			starOpIndex = opIndex++;
+			starPathIndex = pathIndex;
+			continue;
+		}
+
+		uint8_t byte = GTDiffPathspecFoldByte(path[pathIndex], caseFold);
+		if (opIndex < opCount && GTDiffPathspecOpMatches(&ops[opIndex], classes, byte)) {
+			opIndex++;
+			pathIndex++;
+			continue;
+		}
+
+		if (starOpIndex == NSNotFound) return NO;
+
+		opIndex = starOpIndex + 1;
+		pathIndex = ++starPathIndex;
+	}
+
+	while (opIndex < opCount && ops[opIndex].kind == GTDiffPathspecOpStar) {
+		opIndex++;
+	}
+
+	return opIndex == opCount;
+}
+
+@interface GTDiffOptions () {
+	git_diff_options _gitDiffOptions;
+	git_diff_find_options _gitDiffFindOptions;
+	BOOL _hasDiffOptions;
+	BOOL _hasFindOptions;
+
+	// The strings `_gitDiffOptions` points to.
+	char *_oldPrefix;
+	char *_newPrefix;
+	char **_pathspecStrings;
+	NSUInteger _pathspecCount;
+
+	// Whether -compilePathspec has been run. Only accessed while synchronized
+	// on the receiver.
+	BOOL _pathspecCompiled;
+}
+
+// Whether the pathspec matcher ignores case. This and the rest of the
+// matcher's properties are only set once -compilePathspecIfNeeded has run.
+@property (nonatomic, readonly) BOOL caseFold;
+
+// The number of patterns in the pathspec matcher, not counting empty ones.
+@property (nonatomic, readonly) NSUInteger patternCount;
+
+// One BOOL per pattern: whether it excludes the paths it matches.
+@property (nonatomic, readonly, strong) NSData *negatedPatterns;
+
+// The trie of patterns without wildcards, as `GTDiffPathspecNode`s. The first
+// one is the root.
+@property (nonatomic, readonly, strong) NSData *nodes;
+
+// The patterns with wildcards, as `GTDiffPathspecGlob`s in pattern order,
+// along with the `GTDiffPathspecOp`s and `GTDiffPathspecClass`es they use.
+@property (nonatomic, readonly, strong) NSData *globs;
+@property (nonatomic, readonly, strong) NSData *ops;
+@property (nonatomic, readonly, strong) NSData *classes;
+
+@end
+
+@implementation GTDiffOptions
+
+#pragma mark Lifecycle
+
++ (instancetype)optionsWithDictionary:(NSDictionary *)dictionary {
+	return [[self alloc] initWithDictionary:dictionary];
+}
+
+- (id)init {
+	return [self initWithDictionary:nil];
+}
+
+- (id)initWithDictionary:(NSDictionary *)dictionary {
+	self = [super init];
+	if (self == nil) return nil;
+
+	_dictionary = [dictionary copy] ?: @{};
+
+	[self setUpDiffOptions];
+	[self setUpFindOptions];
+
+	return self;
+}
+
+- (void)setUpDiffOptions {
+	git_diff_options options = GIT_DIFF_OPTIONS_INIT;
+	_gitDiffOptions = options;
+
+	NSNumber *flagsNumber = self.dictionary[GTDiffOptionsFlagsKey];
+	if (flagsNumber != nil) _gitDiffOptions.flags = (uint32_t)flagsNumber.unsignedIntegerValue;
+
+	NSNumber *contextLinesNumber = self.dictionary[GTDiffOptionsContextLinesKey];
+	if (contextLinesNumber != nil) _gitDiffOptions.context_lines = (uint16_t)contextLinesNumber.unsignedIntegerValue;
+
+	NSNumber *interHunkLinesNumber = self.dictionary[GTDiffOptionsInterHunkLinesKey];
+	if (interHunkLinesNumber != nil) _gitDiffOptions.interhunk_lines = (uint16_t)interHunkLinesNumber.unsignedIntegerValue;
+
+	NSString *oldPrefix = self.dictionary[GTDiffOptionsOldPrefixKey];
+	if (oldPrefix != nil) {
+		_oldPrefix = strdup(oldPrefix.UTF8String);
+		_gitDiffOptions.old_prefix = _oldPrefix;
+	}
+
+	NSString *newPrefix = self.dictionary[GTDiffOptionsNewPrefixKey];
+	if (newPrefix != nil) {
+		_newPrefix = strdup(newPrefix.UTF8String);
+		_gitDiffOptions.new_prefix = _newPrefix;
+	}
+
+	NSNumber *maxSizeNumber = self.dictionary[GTDiffOptionsMaxSizeKey];
+	if (maxSizeNumber != nil) _gitDiffOptions.max_size = (git_off_t)maxSizeNumber.longLongValue;
+
+	NSArray *pathSpec = self.dictionary[GTDiffOptionsPathSpecArrayKey];
+	if (pathSpec != nil) {
+		_pathspecCount = pathSpec.count;
+		_pathspecStrings = calloc(MAX(_pathspecCount, 1), sizeof(*_pathspecStrings));
+		for (NSUInteger idx = 0; idx < _pathspecCount; idx++) {
+			_pathspecStrings[idx] = strdup([pathSpec[idx] UTF8String]);
+		}
+
+		_gitDiffOptions.pathspec = (git_strarray){ .strings = _pathspecStrings, .count = _pathspecCount };
+	}
+
+	_hasDiffOptions = (flagsNumber != nil || contextLinesNumber != nil || interHunkLinesNumber != nil || oldPrefix != nil || newPrefix != nil || maxSizeNumber != nil || pathSpec != nil);
+}
+
+- (void)setUpFindOptions {
+	git_diff_find_options options = GIT_DIFF_FIND_OPTIONS_INIT;
+	_gitDiffFindOptions = options;
+
+	NSNumber *flagsNumber = self.dictionary[GTDiffFindOptionsFlagsKey];
+	if (flagsNumber != nil) _gitDiffFindOptions.flags = (uint32_t)flagsNumber.unsignedIntegerValue;
+
+	NSNumber *renameThresholdNumber = self.dictionary[GTDiffFindOptionsRenameThresholdKey];
+	if (renameThresholdNumber != nil) _gitDiffFindOptions.rename_threshold = renameThresholdNumber.unsignedIntValue;
+
+	NSNumber *renameFromRewriteThresholdNumber = self.dictionary[GTDiffFindOptionsRenameFromRewriteThresholdKey];
+	if (renameFromRewriteThresholdNumber != nil) _gitDiffFindOptions.rename_from_rewrite_threshold = renameFromRewriteThresholdNumber.unsignedIntValue;
+
+	NSNumber *copyThresholdNumber = self.dictionary[GTDiffFindOptionsCopyThresholdKey];
+	if (copyThresholdNumber != nil) _gitDiffFindOptions.copy_threshold = copyThresholdNumber.unsignedIntValue;
+
+	NSNumber *breakRewriteThresholdNumber = self.dictionary[GTDiffFindOptionsBreakRewriteThresholdKey];
+	if (breakRewriteThresholdNumber != nil) _gitDiffFindOptions.break_rewrite_threshold = breakRewriteThresholdNumber.unsignedIntValue;
+
+	NSNumber *targetLimitNumber = self.dictionary[GTDiffFindOptionsTargetLimitKey];
+	if (targetLimitNumber != nil) _gitDiffFindOptions.target_limit = targetLimitNumber.unsignedIntValue;
+
+	_hasFindOptions = (flagsNumber != nil || renameThresholdNumber != nil || renameFromRewriteThresholdNumber != nil || copyThresholdNumber != nil || breakRewriteThresholdNumber != nil || targetLimitNumber != nil);
+}
+
+// Build the trie and globs -matchesPathBytes:length: uses, the first time
+// it's called. Most options are only ever handed to libgit2, so they never
+// pay for it.
+- (void)compilePathspecIfNeeded {
+	@synchronized (self) {
+		if (_pathspecCompiled) return;
+
+		[self compilePathspec];
+		_pathspecCompiled = YES;
+	}
+}
+
+// Patterns are parsed as libgit2 parses pathspecs: leading whitespace is
+// skipped, a leading `!` negates and a trailing `/` is dropped. Like libgit2,
+// patterns with wildcards are also compared to the whole path, so they're in
+// the trie as well as the globs.
+- (void)compilePathspec {
+	uint32_t flags = _gitDiffOptions.flags;
+	BOOL caseFold = (flags & GTDiffOptionsFlagsDeltasAreICase) != 0;
+	BOOL literalOnly = (flags & GTDiffOptionsFlagsDisablePathspecMatch) != 0;
+
+	NSMutableData *negatedPatterns = [NSMutableData data];
+	NSMutableData *nodes = [NSMutableData data];
+	NSMutableData *globs = [NSMutableData data];
+	NSMutableData *ops = [NSMutableData data];
+	NSMutableData *classes = [NSMutableData data];
+
+	GTDiffPathspecNode root = { .firstChild = NSNotFound, .nextSibling = NSNotFound, .exactPattern = NSNotFound, .directoryPattern = NSNotFound };
+	[nodes appendBytes:&root length:sizeof(root)];
+
+	NSUInteger patternCount = 0;
+	for (NSUInteger idx = 0; idx < _pathspecCount; idx++) {
+		const char *pattern = _pathspecStrings[idx];
+		if (pattern == NULL) continue;
+
+		while (isspace((unsigned char)*pattern)) pattern++;
+
+		BOOL negated = (*pattern == '!');
+		if (negated) pattern++;
+
+		size_t length = strlen(pattern);
+		if (length > 0 && pattern[length - 1] == '/') length--;
+		if (length == 0) continue;
+
+		NSUInteger patternIndex = patternCount++;
+		[negatedPatterns appendBytes:&negated length:sizeof(negated)];
+
+		BOOL hasWildcards = GTDiffPathspecPatternHasWildcards(pattern, length);
+		[self insertPattern:pattern length:length index:patternIndex matchesDirectory:!hasWildcards caseFold:caseFold nodes:nodes];
+		if (hasWildcards && !literalOnly) [self appendGlobForPattern:pattern length:length index:patternIndex caseFold:caseFold globs:globs ops:ops classes:classes];
+	}
+
+	_caseFold = caseFold;
+	_patternCount = patternCount;
+	_negatedPatterns = negatedPatterns;
+	_nodes = nodes;
+	_globs = globs;
+	_ops = ops;
+	_classes = classes;
+}
+
+- (void)insertPattern:(const char *)pattern length:(size_t)length index:(NSUInteger)patternIndex matchesDirectory:(BOOL)matchesDirectory caseFold:(BOOL)caseFold nodes:(NSMutableData *)nodes {
+	NSUInteger nodeIndex = 0;
+	for (size_t idx = 0; idx < length; idx++) {
+		uint8_t byte = GTDiffPathspecFoldByte((uint8_t)pattern[idx], caseFold);
+
+		GTDiffPathspecNode *allNodes = nodes.mutableBytes;
+		NSUInteger childIndex = allNodes[nodeIndex].firstChild;
+		while (childIndex != NSNotFound && allNodes[childIndex].byte != byte) {
+			childIndex = allNodes[childIndex].nextSibling;
+		}
+
+		if (childIndex == NSNotFound) {
+			GTDiffPathspecNode child = { .firstChild = NSNotFound, .nextSibling = allNodes[nodeIndex].firstChild, .exactPattern = NSNotFound, .directoryPattern = NSNotFound, .byte = byte };
+			childIndex = nodes.length / sizeof(child);
+			allNodes[nodeIndex].firstChild = childIndex;
+			[nodes appendBytes:&child length:sizeof(child)];
+		}
+
+		nodeIndex = childIndex;
+	}
+
+	// Earlier patterns win, and they're inserted first.
+	GTDiffPathspecNode *node = (GTDiffPathspecNode *)nodes.mutableBytes + nodeIndex;
+	if (node->exactPattern == NSNotFound) node->exactPattern = patternIndex;
+	if (matchesDirectory && node->directoryPattern == NSNotFound) node->directoryPattern = patternIndex;
+}
+
+- (void)appendGlobForPattern:(const char *)pattern length:(size_t)length index:(NSUInteger)patternIndex caseFold:(BOOL)caseFold globs:(NSMutableData *)globs ops:(NSMutableData *)ops classes:(NSMutableData *)classes {
+	GTDiffPathspecGlob glob = { .pattern = patternIndex, .firstOp = ops.length / sizeof(GTDiffPathspecOp), .opCount = 0 };
+
+	size_t idx = 0;
+	while (idx < length) {
+		GTDiffPathspecOp op = { .kind = GTDiffPathspecOpByte, .byte = 0, .classIndex = 0 };
+		char character = pattern[idx];
+		if (character == '*') {
+			while (idx < length && pattern[idx] == '*') idx++;
+			op.kind = GTDiffPathspecOpStar;
+		} else if (character == '?') {
+			idx++;
+			op.kind = GTDiffPathspecOpAnyByte;
+		} else if (character == '[') {
+			GTDiffPathspecClass class;
+			size_t end = GTDiffPathspecParseClass(pattern, length, idx, caseFold, &class);
+			if (end > 0) {
+				op.kind = GTDiffPathspecOpClass;
+				op.classIndex = (uint32_t)(classes.length / sizeof(class));
+				[classes appendBytes:&class length:sizeof(class)];
+				idx = end;
+			} else {
+				op.byte = '[';
+				idx++;
+			}
+		} else if (character == '\\' && idx + 1 < length) {
+			op.byte = GTDiffPathspecFoldByte((uint8_t)pattern[idx + 1], caseFold);
+			idx += 2;
+		} else {
+			op.byte = GTDiffPathspecFoldByte((uint8_t)character, caseFold);
+			idx++;
+		}
+
+		[ops appendBytes:&op length:sizeof(op)];
+		glob.opCount++;
+	}
+
+	[globs appendBytes:&glob length:sizeof(glob)];
+}
+
+- (void)dealloc {
+	free(_oldPrefix);
+	free(_newPrefix);
+
+	for (NSUInteger idx = 0; idx < _pathspecCount; idx++) {
+		free(_pathspecStrings[idx]);
+	}
+
+	free(_pathspecStrings);
+}
+
+#pragma mark Properties
+
+- (const git_diff_options *)git_diff_options {
+	return (_hasDiffOptions ? &_gitDiffOptions : NULL);
+}
+
+- (const git_diff_find_options *)git_diff_find_options {
+	return (_hasFindOptions ? &_gitDiffFindOptions : NULL);
+}
+
+#pragma mark Pathspec
+
+- (BOOL)matchesPath:(NSString *)path {
+	NSParameterAssert(path != nil);
+
+	const char *bytes = path.UTF8String;
+	return [self matchesPathBytes:bytes length:strlen(bytes)];
+}
+
+- (BOOL)matchesPathBytes:(const char *)bytes length:(NSUInteger)length {
+	[self compilePathspecIfNeeded];
+	if (self.patternCount == 0) return YES;
+
+	BOOL caseFold = self.caseFold;
+	const uint8_t *path = (const uint8_t *)bytes;
+	NSUInteger firstMatch = NSNotFound;
+
+	// Walk the trie as far as the path goes, noting patterns naming the path
+	// itself, or a directory it's in.
+	const GTDiffPathspecNode *nodes = self.nodes.bytes;
+	NSUInteger nodeIndex = 0;
+	for (NSUInteger idx = 0; ; idx++) {
+		const GTDiffPathspecNode *node = &nodes[nodeIndex];
+		if (idx == length) {
+			firstMatch = MIN(firstMatch, MIN(node->exactPattern, node->directoryPattern));
+			break;
+		}
+
+		if (path[idx] == '/') firstMatch = MIN(firstMatch, node->directoryPattern);
+
+		uint8_t byte = GTDiffPathspecFoldByte(path[idx], caseFold);
+		NSUInteger childIndex = node->firstChild;
+		while (childIndex != NSNotFound && nodes[childIndex].byte != byte) {
+			childIndex = nodes[childIndex].nextSibling;
+		}
+
+		if (childIndex == NSNotFound) break;
+		nodeIndex = childIndex;
+	}
+
+	// Only globs which come before the first match so far can change the
+	// outcome.
+	const GTDiffPathspecGlob *globs = self.globs.bytes;
+	const GTDiffPathspecOp *ops = self.ops.bytes;
+	const GTDiffPathspecClass *classes = self.classes.bytes;
+	NSUInteger globCount = self.globs.length / sizeof(*globs);
+	for (NSUInteger idx = 0; idx < globCount && globs[idx].pattern < firstMatch; idx++) {
+		if (GTDiffPathspecGlobMatches(ops + globs[idx].firstOp, globs[idx].opCount, classes, path, length, caseFold)) {
+			firstMatch = globs[idx].pattern;
+			break;
+		}
+	}
+
+	if (firstMatch == NSNotFound) return NO;
+
+	const BOOL *negatedPatterns = self.negatedPatterns.bytes;
+	return !negatedPatterns[firstMatch];
+}
+
+#pragma mark NSObject
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> dictionary: %@", NSStringFromClass([self class]), self, self.dictionary];
+}
+
+- (BOOL)isEqual:(GTDiffOptions *)options {
+	if (self == options) return YES;
+	if (![options isKindOfClass:GTDiffOptions.class]) return NO;
+
+	return [self.dictionary isEqual:options.dictionary];
+}
+
+- (NSUInteger)hash {
+	return self.dictionary.hash;
+}
+
+#pragma mark NSCopying
+
+- (id)copyWithZone:(NSZone *)zone {
+	return self;
+}
+
+@end
@@ -0,0 +1,39 @@
+//
+//  GTDiffRename.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "GTDiffDelta.h"
+
+@class GTDiffFile;
+
+// A file found to have been renamed or copied, by
+// -[GTDiff detectRenamesUsingSketchesWithOptions:error:].
+@interface GTDiffRename : NSObject
+
+// Either `GTDiffFileDeltaRenamed` or `GTDiffFileDeltaCopied`.
+@property (nonatomic, readonly) GTDiffDeltaType type;
+
+// The file which was renamed or copied.
+@property (nonatomic, readonly, strong) GTDiffFile *oldFile;
+
+// The file it was renamed or copied to.
+@property (nonatomic, readonly, strong) GTDiffFile *newFile;
+
+// How similar the files are, from 0 to 100.
+@property (nonatomic, readonly) NSUInteger similarity;
+
+// The index of the delta `oldFile` came from in the diff.
+@property (nonatomic, readonly) NSUInteger oldDeltaIndex;
+
+// The index of the delta `newFile` came from in the diff.
+@property (nonatomic, readonly) NSUInteger newDeltaIndex;
+
+// Designated initializer.
+- (id)initWithType:(GTDiffDeltaType)type oldFile:(GTDiffFile *)oldFile newFile:(GTDiffFile *)newFile similarity:(NSUInteger)similarity oldDeltaIndex:(NSUInteger)oldDeltaIndex newDeltaIndex:(NSUInteger)newDeltaIndex;
+
+@end
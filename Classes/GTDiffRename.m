@@ -0,0 +1,35 @@
+//
+//  GTDiffRename.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTDiffRename.h"
+#import "GTDiffFile.h"
+
+@implementation GTDiffRename
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> type: %d, oldFile: %@, newFile: %@, similarity: %lu", NSStringFromClass([self class]), self, (int)self.type, self.oldFile.path, self.newFile.path, (unsigned long)self.similarity];
+}
+
+- (id)initWithType:(GTDiffDeltaType)type oldFile:(GTDiffFile *)oldFile newFile:(GTDiffFile *)newFile similarity:(NSUInteger)similarity oldDeltaIndex:(NSUInteger)oldDeltaIndex newDeltaIndex:(NSUInteger)newDeltaIndex {
+	NSParameterAssert(oldFile != nil);
+	NSParameterAssert(newFile != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_type = type;
+	_oldFile = oldFile;
+	_newFile = newFile;
+	_similarity = similarity;
+	_oldDeltaIndex = oldDeltaIndex;
+	_newDeltaIndex = newDeltaIndex;
+
+	return self;
+}
+
+@end
@@ -28,6 +28,7 @@
 //
 
 #import "GTObject.h"
+#import "GTCommitRecord.h"
 
 // Options to specify enumeration order when enumerating through a repository.
 // These options may be bitwise-OR'd together
@@ -40,8 +41,34 @@ enum {
 
 typedef unsigned int GTEnumeratorOptions;
 
+// Options for -enumerateCommitsConcurrentlyWithOptions:error:usingBlock:.
+// These options may be bitwise-OR'd together
+enum {
+	GTEnumeratorConcurrencyOptionsNone = 0,
+	GTEnumeratorConcurrencyOptionsOrdered = 1 << 0, // call the block serially, in walk order
+	GTEnumeratorConcurrencyOptionsUnbounded = 1 << 1, // never make the walk wait for the block to catch up
+};
+
+typedef unsigned int GTEnumeratorConcurrencyOptions;
+
+// Options for -enumerateFirstParentDiffsWithOptions:diffOptions:error:usingBlock:.
+// These options may be bitwise-OR'd together
+enum {
+	GTEnumeratorDiffOptionsNone = 0,
+	GTEnumeratorDiffOptionsOrdered = 1 << 0, // call the block serially, in walk order
+	GTEnumeratorDiffOptionsIncludePatches = 1 << 1, // generate each delta's patch and line counts
+};
+
+typedef unsigned int GTEnumeratorDiffOptions;
+
+// The default `clockSkewTolerance`: a day.
+static const NSTimeInterval GTEnumeratorDefaultClockSkewTolerance = 24 * 60 * 60;
+
 @class GTRepository;
 @class GTCommit;
+@class GTDiffOptions;
+@class GTOID;
+@class GTEnumeratorCursor;
 @protocol GTObject;
 
 // This object is usually used from within a repository. You generally don't 
@@ -52,18 +79,154 @@ typedef unsigned int GTEnumeratorOptions;
 @property (nonatomic, unsafe_unretained) GTRepository *repository;
 @property (nonatomic, assign) GTEnumeratorOptions options;
 
+// Only enumerate commits made at or after this date. Defaults to nil, for no
+// limit.
+//
+// When sorting by time alone (without GTEnumeratorOptionsTopologicalSort or
+// GTEnumeratorOptionsReverse), commits come out newest first, so once the
+// walk reaches a commit older than this by more than `clockSkewTolerance`,
+// every commit still pending is older too and the walk ends there instead of
+// going through the rest of the history.
+@property (nonatomic, copy) NSDate *sinceDate;
+
+// Only enumerate commits made at or before this date. Defaults to nil, for no
+// limit.
+@property (nonatomic, copy) NSDate *untilDate;
+
+// How much older than `sinceDate` commits may get before a time sorted walk
+// gives up. A commit whose clock was behind can be older than its parents, so
+// stopping at the first commit older than `sinceDate` could miss newer
+// commits behind it. Defaults to GTEnumeratorDefaultClockSkewTolerance.
+@property (nonatomic, assign) NSTimeInterval clockSkewTolerance;
+
+// How many commits within the dates to pass over before enumerating any.
+// Defaults to 0.
+@property (nonatomic, assign) NSUInteger skipCount;
+
+// The most commits to enumerate after each push, or 0 for no limit. Defaults
+// to 0.
+@property (nonatomic, assign) NSUInteger maximumCount;
+
+// Where the walk is up to, for picking it up again later with
+// -resumeFromCursor:error:.
+//
+// Cursors are only kept for walks sorted by time alone with a
+// `maximumCount`, since they're for handing out history a page at a time.
+// This is nil for other walks, and once the walk is over.
+@property (nonatomic, readonly, strong) GTEnumeratorCursor *cursor;
+
 - (id)initWithRepository:(GTRepository *)theRepo error:(NSError **)error;
 + (id)enumeratorWithRepository:(GTRepository *)theRepo error:(NSError **)error;
 
 - (BOOL)push:(NSString *)sha error:(NSError **)error;
 
+// Like -push:error:, but takes an OID so no SHA has to be parsed.
+- (BOOL)pushOID:(GTOID *)oid error:(NSError **)error;
+
 // suppress the enumeration of the specified commit and all of its ancestors
 - (BOOL)skipCommitWithHash:(NSString *)sha error:(NSError **)error;
 
+// Like -skipCommitWithHash:error:, but takes an OID.
+- (BOOL)skipCommitWithOID:(GTOID *)oid error:(NSError **)error;
+
+// Reset the walk and pick it up where a cursor left off. Resuming a time
+// sorted walk enumerates the same commits the original walk would have gone
+// on to enumerate, as long as no commit is dated before one of its parents.
+//
+// cursor     - The cursor to resume from. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns NO if an error occurred.
+- (BOOL)resumeFromCursor:(GTEnumeratorCursor *)cursor error:(NSError **)error;
+
 - (void)reset;
 - (NSUInteger)countFromSha:(NSString *)sha error:(NSError **)error;
 
+// Like -countFromSha:error:, but takes an OID.
+- (NSUInteger)countFromOID:(GTOID *)oid error:(NSError **)error;
+
+// Count the commits reachable from a commit but not from any of the hidden
+// commits, without looking any of them up.
+//
+// oid        - The OID of the commit to count from. Cannot be nil.
+// hiddenOIDs - An array of GTOIDs whose ancestors shouldn't be counted. Cannot
+//              be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the number of commits or NSNotFound if an error occurred
+- (NSUInteger)countFromOID:(GTOID *)oid hidingOIDs:(NSArray *)hiddenOIDs error:(NSError **)error;
+
 - (NSArray *)allObjectsWithError:(NSError **)error;
 - (id)nextObjectWithError:(NSError **)error;
 
+// Get the OID of the next commit without looking the commit up.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns the OID, or nil if the walk is over or an error occurred.
+- (GTOID *)nextOIDWithError:(NSError **)error;
+
+// Enumerate the remaining commits as GTCommitRecords, read straight from the
+// object database, rather than as GTCommits.
+//
+// Nothing is allocated per commit, so this runs at close to the speed of the
+// object database. The block is called once per batch.
+//
+// batchSize  - The most records to hand the block at once. Must be greater
+//              than 0. GTCommitRecordDefaultBatchSize is a good choice.
+// error(out) - will be filled if an error occurs
+// block      - The block to call with each batch. Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateCommitRecordsWithBatchSize:(NSUInteger)batchSize error:(NSError **)error usingBlock:(GTCommitRecordBlock)block;
+
+// Enumerate the remaining commits, looking them up and calling the block on a
+// pool of worker threads while this thread keeps walking.
+//
+// Without GTEnumeratorConcurrencyOptionsOrdered, the block is called
+// concurrently, in whatever order commits are ready. With it, commits are held
+// until the ones before them have been handed out, and the block is called
+// serially (though not necessarily on the same thread).
+//
+// Unless GTEnumeratorConcurrencyOptionsUnbounded is given, the walk waits
+// whenever too many commits are waiting for the block, so a slow block doesn't
+// pile them up in memory.
+//
+// The workers hold the repository's reader handles while the block runs, so
+// the repository's other concurrent methods, if called from the block, run
+// serially on the block's thread. Commits looked up on a reader handle aren't
+// added to the repository's object cache.
+//
+// options    - How to deliver commits.
+// error(out) - will be filled if an error occurs
+// block      - The block to call with each commit and its position in the
+//              walk. Setting `stop` stops the walk, and no more commits are
+//              handed out. Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateCommitsConcurrentlyWithOptions:(GTEnumeratorConcurrencyOptions)options error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, NSUInteger index, BOOL *stop))block;
+
+// Diff each remaining commit against its first parent, on a pool of worker
+// threads while this thread keeps walking. Root commits are diffed against an
+// empty tree.
+//
+// Neighbouring commits share trees, so each worker is handed a run of
+// consecutive commits, and reuses the trees they have in common.
+// Deltas are handed out as `GTCachedDiffDelta`s, which don't need the diff
+// they came from.
+//
+// options     - How to diff and deliver the commits. Patches are only
+//               generated with GTEnumeratorDiffOptionsIncludePatches.
+// diffOptions - The options to diff with, or nil to use the defaults. Renames
+//               are found if it has any find options.
+// error(out)  - will be filled if an error occurs
+// block       - The block to call with each commit's OID, its deltas and its
+//               position in the walk. Setting `stop` stops the walk. The block
+//               is called as for
+//               -enumerateCommitsConcurrentlyWithOptions:error:usingBlock:.
+//               Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateFirstParentDiffsWithOptions:(GTEnumeratorDiffOptions)options diffOptions:(GTDiffOptions *)diffOptions error:(NSError **)error usingBlock:(void (^)(GTOID *commitOID, NSArray *deltas, NSUInteger index, BOOL *stop))block;
+
 @end
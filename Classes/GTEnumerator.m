@@ -33,14 +33,106 @@
 #import "NSString+Git.h"
 #import "GTRepository.h"
 #import "GTRepository+Private.h"
+#import "GTOID.h"
+#import "GTCommitGraph.h"
+#import "GTCommitRecord+Private.h"
+#import "GTObjectCache.h"
+#import "GTPipeline.h"
+#import "GTEnumeratorCursor.h"
+#import "GTCachedDiffDelta+Private.h"
+#import "GTDiff.h"
+#import "GTDiffOptions.h"
+
+// How many commits per worker may wait to be handed to the block in
+// -enumerateCommitsConcurrentlyWithOptions:error:usingBlock: before the walk
+// waits for them.
+static const NSUInteger GTEnumeratorPendingCommitsPerWorker = 64;
+
+// How many consecutive commits
+// -enumerateFirstParentDiffsWithOptions:diffOptions:error:usingBlock: hands a
+// worker at once. A commit's tree is usually the parent tree of the commit
+// before it, so a worker diffing a run of them reads most trees only once.
+static const NSUInteger GTEnumeratorCommitsPerDiffRun = 16;
+
+// A run of consecutive commits for one worker to diff against their first
+// parents, and once it's been diffed, the results.
+@interface GTEnumeratorDiffRun : NSObject
+
+// The position of the first commit in the walk.
+@property (nonatomic, assign) NSUInteger firstIndex;
+
+// The GTOIDs of the commits, in walk order.
+@property (nonatomic, strong) NSMutableArray *commitOIDs;
+
+// An array of GTCachedDiffDeltas per commit.
+@property (nonatomic, strong) NSMutableArray *deltaLists;
+
+@end
+
+@implementation GTEnumeratorDiffRun
+
+@end
 
 @interface GTEnumerator()
 @property (nonatomic, assign) git_revwalk *walk;
 
+// How many commits have been skipped and enumerated since the last push.
+@property (nonatomic, assign) NSUInteger skippedCount;
+@property (nonatomic, assign) NSUInteger enumeratedCount;
+
+// Whether the walk ended early because of `sinceDate`.
+@property (nonatomic, assign) BOOL reachedSinceDate;
+
+// The GTOIDs of the commits hidden since the last push.
+@property (nonatomic, strong) NSMutableArray *hiddenOIDs;
+
+// The GTOIDs of the commits the walk will look at next, or nil if they haven't
+// been kept track of.
+@property (nonatomic, strong) NSMutableSet *pendingOIDs;
+
+// Whether commits come out newest first.
+@property (nonatomic, readonly, getter = isSortedByTime) BOOL sortedByTime;
+
 - (void)cleanup;
+- (BOOL)pushGitOid:(const git_oid *)oid error:(NSError **)error;
+- (BOOL)hideGitOid:(const git_oid *)oid error:(NSError **)error;
+- (NSUInteger)countFromGitOid:(const git_oid *)oid error:(NSError **)error;
+- (int)nextGitOid:(git_oid *)oid error:(NSError **)error;
 @end
 
 
+// Reads the tree of a commit, and swaps the tree of its first parent into
+// `parentTree`, or NULL for a root commit. If `parentTree` is already the
+// commit's tree, it's reused rather than read again.
+//
+// Both trees must be freed by the caller, even on failure.
+static int GTEnumeratorLookUpTrees(git_repository *repository, const git_oid *commitOid, git_tree **parentTree, git_tree **tree) {
+	git_commit *commit = NULL;
+	int gitError = git_commit_lookup(&commit, repository, commitOid);
+	if(gitError < GIT_OK) return gitError;
+	
+	const git_oid *treeOid = git_commit_tree_id(commit);
+	if(*parentTree != NULL && git_oid_cmp(git_tree_id(*parentTree), treeOid) == 0) {
+		*tree = *parentTree;
+		*parentTree = NULL;
+	} else {
+		gitError = git_tree_lookup(tree, repository, treeOid);
+	}
+	
+	git_tree_free(*parentTree);
+	*parentTree = NULL;
+	
+	if(gitError == GIT_OK && git_commit_parentcount(commit) > 0) {
+		git_commit *parent = NULL;
+		gitError = git_commit_parent(&parent, commit, 0);
+		if(gitError == GIT_OK) gitError = git_tree_lookup(parentTree, repository, git_commit_tree_id(parent));
+		git_commit_free(parent);
+	}
+	
+	git_commit_free(commit);
+	return gitError;
+}
+
 @implementation GTEnumerator
 
 - (NSString *)description {
@@ -57,6 +149,11 @@
 @synthesize repository;
 @synthesize walk;
 @synthesize options;
+@synthesize sinceDate;
+@synthesize untilDate;
+@synthesize clockSkewTolerance;
+@synthesize skipCount;
+@synthesize maximumCount;
 
 - (id)initWithRepository:(GTRepository *)theRepo error:(NSError **)error {
 	if((self = [super init])) {
@@ -69,6 +166,8 @@
 			return nil;
 		}
 		self.walk = w;
+		self.clockSkewTolerance = GTEnumeratorDefaultClockSkewTolerance;
+		self.hiddenOIDs = [NSMutableArray array];
 	}
 	return self;
 }
@@ -92,15 +191,49 @@
 	BOOL success = [sha git_getOid:&oid error:error];
 	if(!success) return NO;
 	
+	return [self pushGitOid:&oid error:error];
+}
+
+- (BOOL)pushOID:(GTOID *)oid error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+	
+	return [self pushGitOid:oid.git_oid error:error];
+}
+
+- (BOOL)pushGitOid:(const git_oid *)oid error:(NSError **)error {
 	[self reset];
 	
-	int gitError = git_revwalk_push(self.walk, &oid);
+	int gitError = git_revwalk_push(self.walk, oid);
 	if(gitError < GIT_OK) {
 		if (error != NULL)
 			*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to push sha onto rev walker."];
 		return NO;
 	}
 	
+	self.pendingOIDs = [NSMutableSet setWithObject:[GTOID oidWithGitOid:oid]];
+	return YES;
+}
+
+- (BOOL)resumeFromCursor:(GTEnumeratorCursor *)cursor error:(NSError **)error {
+	NSParameterAssert(cursor != nil);
+	
+	[self reset];
+	
+	for(GTOID *oid in cursor.pendingOIDs) {
+		int gitError = git_revwalk_push(self.walk, oid.git_oid);
+		if(gitError < GIT_OK) {
+			if (error != NULL)
+				*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to push sha onto rev walker."];
+			return NO;
+		}
+	}
+	
+	for(GTOID *oid in cursor.hiddenOIDs) {
+		BOOL success = [self hideGitOid:oid.git_oid error:error];
+		if(!success) return NO;
+	}
+	
+	self.pendingOIDs = [NSMutableSet setWithArray:cursor.pendingOIDs];
 	return YES;
 }
 
@@ -109,17 +242,115 @@
 	BOOL success = [sha git_getOid:&oid error:error];
 	if(!success) return NO;
 	
-	int gitError = git_revwalk_hide(self.walk, &oid);
+	return [self hideGitOid:&oid error:error];
+}
+
+- (BOOL)skipCommitWithOID:(GTOID *)oid error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+	
+	return [self hideGitOid:oid.git_oid error:error];
+}
+
+- (BOOL)hideGitOid:(const git_oid *)oid error:(NSError **)error {
+	int gitError = git_revwalk_hide(self.walk, oid);
 	if(gitError < GIT_OK) {
 		if (error != NULL)
 			*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to hide sha on rev walker."];
 		return NO;
 	}
+	
+	[self.hiddenOIDs addObject:[GTOID oidWithGitOid:oid]];
 	return YES;
 }
 
 - (void)reset {
 	git_revwalk_reset(self.walk);
+	
+	self.skippedCount = 0;
+	self.enumeratedCount = 0;
+	self.reachedSinceDate = NO;
+	self.pendingOIDs = nil;
+	[self.hiddenOIDs removeAllObjects];
+}
+
+- (BOOL)isSortedByTime {
+	return (self.options & GTEnumeratorOptionsTimeSort) != 0 && (self.options & (GTEnumeratorOptionsTopologicalSort | GTEnumeratorOptionsReverse)) == 0;
+}
+
+- (GTEnumeratorCursor *)cursor {
+	if(self.pendingOIDs.count == 0 || self.reachedSinceDate) return nil;
+	
+	NSArray *pendingOIDs = [self.pendingOIDs.allObjects sortedArrayUsingSelector:@selector(compare:)];
+	return [[GTEnumeratorCursor alloc] initWithPendingOIDs:pendingOIDs hiddenOIDs:self.hiddenOIDs];
+}
+
+// Gets the next commit within the limits.
+//
+// Returns GIT_ITEROVER once there are no more, or another error code if an
+// error occurred, in which case `error` is filled.
+- (int)nextGitOid:(git_oid *)oid error:(NSError **)error {
+	if(self.reachedSinceDate) return GIT_ITEROVER;
+	if(self.maximumCount > 0 && self.enumeratedCount >= self.maximumCount) return GIT_ITEROVER;
+	
+	BOOL sortedByTime = self.sortedByTime;
+	BOOL tracksPendingOIDs = sortedByTime && self.maximumCount > 0;
+	BOOL checksDates = self.sinceDate != nil || self.untilDate != nil;
+	git_time_t since = (git_time_t)floor(self.sinceDate.timeIntervalSince1970);
+	git_time_t until = (git_time_t)ceil(self.untilDate.timeIntervalSince1970);
+	git_time_t giveUpTime = (git_time_t)floor(self.sinceDate.timeIntervalSince1970 - self.clockSkewTolerance);
+	
+	while(YES) {
+		int gitError = git_revwalk_next(oid, self.walk);
+		if(gitError == GIT_ITEROVER) {
+			self.pendingOIDs = nil;
+			return gitError;
+		}
+		
+		if(gitError < GIT_OK) {
+			if (error != NULL)
+				*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to get next sha from rev walker."];
+			return gitError;
+		}
+		
+		if(!tracksPendingOIDs) self.pendingOIDs = nil;
+		
+		if(tracksPendingOIDs || checksDates) {
+			git_commit *commit = NULL;
+			gitError = git_commit_lookup(&commit, self.repository.git_repository, oid);
+			if(gitError < GIT_OK) {
+				if (error != NULL)
+					*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to lookup commit."];
+				return gitError;
+			}
+			
+			git_time_t time = git_commit_time(commit);
+			if(tracksPendingOIDs) {
+				[self.pendingOIDs removeObject:[GTOID oidWithGitOid:oid]];
+				for(unsigned int i = 0; i < git_commit_parentcount(commit); i++) {
+					[self.pendingOIDs addObject:[GTOID oidWithGitOid:git_commit_parent_id(commit, i)]];
+				}
+			}
+			git_commit_free(commit);
+			
+			if(self.untilDate != nil && time > until) continue;
+			
+			if(self.sinceDate != nil && time < since) {
+				if(sortedByTime && time < giveUpTime) {
+					self.reachedSinceDate = YES;
+					return GIT_ITEROVER;
+				}
+				continue;
+			}
+		}
+		
+		if(self.skippedCount < self.skipCount) {
+			self.skippedCount++;
+			continue;
+		}
+		
+		self.enumeratedCount++;
+		return GIT_OK;
+	}
 }
 
 - (void)setOptions:(GTEnumeratorOptions)newOptions {
@@ -133,12 +364,195 @@
 
 - (id)nextObjectWithError:(NSError **)error {
 	git_oid oid;
-	int gitError = git_revwalk_next(&oid, self.walk);
-	if(gitError == GIT_ITEROVER)
+	int gitError = [self nextGitOid:&oid error:error];
+	if(gitError < GIT_OK)
 		return nil;
 	
 	// ignore error if we can't lookup object and just return nil
-	return [self.repository lookupObjectBySha:[NSString git_stringWithOid:&oid] objectType:GTObjectTypeCommit error:error];
+	return [self.repository lookupObjectByOid:&oid objectType:GTObjectTypeCommit error:error];
+}
+
+- (GTOID *)nextOIDWithError:(NSError **)error {
+	git_oid oid;
+	int gitError = [self nextGitOid:&oid error:error];
+	if(gitError < GIT_OK)
+		return nil;
+	
+	return [GTOID oidWithGitOid:&oid];
+}
+
+- (BOOL)enumerateCommitRecordsWithBatchSize:(NSUInteger)batchSize error:(NSError **)error usingBlock:(GTCommitRecordBlock)block {
+	NSParameterAssert(batchSize > 0);
+	NSParameterAssert(block != nil);
+	
+	git_odb *odb = NULL;
+	int gitError = git_repository_odb(&odb, self.repository.git_repository);
+	if(gitError < GIT_OK) {
+		if (error != NULL)
+			*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to open object database."];
+		return NO;
+	}
+	
+	GTCommitRecordBatch batch;
+	GTCommitRecordBatchInit(&batch, batchSize);
+	
+	BOOL success = YES;
+	BOOL stop = NO;
+	git_oid oid;
+	while(success && !stop) {
+		GTCommitRecordBatchReset(&batch);
+		
+		while(batch.count < batch.capacity) {
+			gitError = [self nextGitOid:&oid error:error];
+			if(gitError == GIT_ITEROVER) break;
+			
+			if(gitError < GIT_OK) {
+				success = NO;
+				break;
+			}
+			
+			success = GTCommitRecordBatchAppendFromOdb(&batch, odb, &oid, error);
+			if(!success) break;
+		}
+		
+		if(!success || batch.count == 0) break;
+		
+		GTCommitRecordBatchFinish(&batch);
+		block(batch.records, batch.count, batch.buffer, &stop);
+		
+		if(batch.count < batch.capacity) break;
+	}
+	
+	GTCommitRecordBatchFree(&batch);
+	git_odb_free(odb);
+	
+	return success;
+}
+
+- (BOOL)enumerateCommitsConcurrentlyWithOptions:(GTEnumeratorConcurrencyOptions)concurrencyOptions error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, NSUInteger index, BOOL *stop))block {
+	NSParameterAssert(block != nil);
+	
+	GTRepository *repo = self.repository;
+	BOOL ordered = (concurrencyOptions & GTEnumeratorConcurrencyOptionsOrdered) != 0;
+	BOOL unbounded = (concurrencyOptions & GTEnumeratorConcurrencyOptionsUnbounded) != 0;
+	
+	GTPipeline *pipeline = [repo readerPipelineWithPendingCountPerWorker:(unbounded ? 0 : GTEnumeratorPendingCommitsPerWorker) ordered:ordered];
+	
+	return [pipeline runWithProducer:^ id (NSError **producerError) {
+		git_oid oid;
+		int gitError = [self nextGitOid:&oid error:producerError];
+		if(gitError < GIT_OK) return nil;
+		
+		return [GTOID oidWithGitOid:&oid];
+	} worker:^ id (GTOID *oid, GTRepository *worker, NSError **workerError) {
+		GTObject *cachedObject = [repo.objectCache objectForOid:oid.git_oid];
+		if ([cachedObject isKindOfClass:GTCommit.class]) return cachedObject;
+		
+		git_object *object = NULL;
+		int gitError = git_object_lookup(&object, worker.git_repository, oid.git_oid, GIT_OBJ_COMMIT);
+		if(gitError < GIT_OK) {
+			// libgit2's error messages are per-thread, so build the error here.
+			*workerError = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to lookup commit %@.", oid.sha]];
+			return nil;
+		}
+		
+		// A parsed commit never goes back to the handle it was read on, so it
+		// can outlive the worker's checkout. Only commits read through the
+		// repository's own handle are cached, though, so that the cache never
+		// holds on to pool handles' objects.
+		GTObject *commit = [GTObject objectWithObj:object inRepository:repo];
+		if (worker == repo) [repo.objectCache addObject:commit];
+		return commit;
+	} consumer:^(GTCommit *commit, NSUInteger index, BOOL *stop) {
+		block(commit, index, stop);
+	} error:error];
+}
+
+- (BOOL)enumerateFirstParentDiffsWithOptions:(GTEnumeratorDiffOptions)options diffOptions:(GTDiffOptions *)diffOptions error:(NSError **)error usingBlock:(void (^)(GTOID *commitOID, NSArray *deltas, NSUInteger index, BOOL *stop))block {
+	NSParameterAssert(block != nil);
+	
+	BOOL ordered = (options & GTEnumeratorDiffOptionsOrdered) != 0;
+	BOOL includePatches = (options & GTEnumeratorDiffOptionsIncludePatches) != 0;
+	
+	GTPipeline *pipeline = [self.repository readerPipelineWithPendingCountPerWorker:MAX(GTEnumeratorPendingCommitsPerWorker / GTEnumeratorCommitsPerDiffRun, (NSUInteger)1) ordered:ordered];
+	
+	__block NSUInteger producedCount = 0;
+	return [pipeline runWithProducer:^ id (NSError **producerError) {
+		GTEnumeratorDiffRun *run = [[GTEnumeratorDiffRun alloc] init];
+		run.firstIndex = producedCount;
+		run.commitOIDs = [NSMutableArray arrayWithCapacity:GTEnumeratorCommitsPerDiffRun];
+		
+		while (run.commitOIDs.count < GTEnumeratorCommitsPerDiffRun) {
+			git_oid oid;
+			int gitError = [self nextGitOid:&oid error:producerError];
+			if(gitError == GIT_ITEROVER) break;
+			if(gitError < GIT_OK) return nil;
+			
+			[run.commitOIDs addObject:[GTOID oidWithGitOid:&oid]];
+		}
+		
+		if (run.commitOIDs.count == 0) return nil;
+		
+		producedCount += run.commitOIDs.count;
+		return run;
+	} worker:^ id (GTEnumeratorDiffRun *run, GTRepository *worker, NSError **workerError) {
+		// Trees are read on, and only used with, this worker's handle. The
+		// last parent tree is kept for the next commit, whose tree it usually
+		// is.
+		git_tree *parentTree = NULL;
+		
+		run.deltaLists = [NSMutableArray arrayWithCapacity:run.commitOIDs.count];
+		for (GTOID *oid in run.commitOIDs) {
+			git_tree *tree = NULL;
+			int gitError = GTEnumeratorLookUpTrees(worker.git_repository, oid.git_oid, &parentTree, &tree);
+			if(gitError < GIT_OK) {
+				// libgit2's error messages are per-thread, so build the error here.
+				*workerError = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to read the trees of commit %@.", oid.sha]];
+				git_tree_free(parentTree);
+				return nil;
+			}
+			
+			// Diff on the worker's handle, which the diff's blobs are read through.
+			git_diff_list *diffList = NULL;
+			gitError = git_diff_tree_to_tree(&diffList, worker.git_repository, parentTree, tree, diffOptions.git_diff_options);
+			git_tree_free(tree);
+			if(gitError < GIT_OK) {
+				*workerError = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to diff commit %@.", oid.sha]];
+				git_tree_free(parentTree);
+				return nil;
+			}
+			
+			GTDiff *diff = [[GTDiff alloc] initWithGitDiffList:diffList];
+			if (diffOptions.git_diff_find_options != NULL) [diff findSimilarWithDiffOptions:diffOptions];
+			
+			NSMutableArray *deltas = [NSMutableArray arrayWithCapacity:diff.deltaCount];
+			__block NSError *deltaError = nil;
+			[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+				GTCachedDiffDelta *cachedDelta = [[GTCachedDiffDelta alloc] initWithDiffDelta:delta includePatch:includePatches error:&deltaError];
+				if (cachedDelta == nil) {
+					*stop = YES;
+					return;
+				}
+				
+				[deltas addObject:cachedDelta];
+			}];
+			
+			if (deltaError != nil) {
+				*workerError = deltaError;
+				git_tree_free(parentTree);
+				return nil;
+			}
+			
+			[run.deltaLists addObject:deltas];
+		}
+		
+		git_tree_free(parentTree);
+		return run;
+	} consumer:^(GTEnumeratorDiffRun *run, NSUInteger index, BOOL *stop) {
+		for (NSUInteger i = 0; i < run.commitOIDs.count && !*stop; i++) {
+			block(run.commitOIDs[i], run.deltaLists[i], run.firstIndex + i, stop);
+		}
+	} error:error];
 }
 
 - (NSArray *)allObjects {
@@ -155,9 +569,51 @@
 }
 
 - (NSUInteger)countFromSha:(NSString *)sha error:(NSError **)error {
+	git_oid oid;
+	BOOL success = [sha git_getOid:&oid error:error];
+	if(!success) return NSNotFound;
+	
+	return [self countFromGitOid:&oid error:error];
+}
+
+- (NSUInteger)countFromOID:(GTOID *)oid error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+	
+	return [self countFromGitOid:oid.git_oid error:error];
+}
+
+- (NSUInteger)countFromOID:(GTOID *)oid hidingOIDs:(NSArray *)hiddenOIDs error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+	NSParameterAssert(hiddenOIDs != nil);
+	
+	[self setOptions:GTEnumeratorOptionsNone];
+	
+	BOOL success = [self pushOID:oid error:error];
+	if(!success) return NSNotFound;
+	
+	for(GTOID *hiddenOID in hiddenOIDs) {
+		success = [self skipCommitWithOID:hiddenOID error:error];
+		if(!success) return NSNotFound;
+	}
+	
+	git_oid nextOid;
+	NSUInteger count = 0;
+	while(git_revwalk_next(&nextOid, self.walk) == GIT_OK) {
+		count++;
+	}
+	self.pendingOIDs = nil;
+	return count;
+}
+
+- (NSUInteger)countFromGitOid:(const git_oid *)startOid error:(NSError **)error {
+	// Pushing resets the walker, so the count never depends on any hidden
+	// commits and the graph can answer it without walking.
+	GTCommitGraph *graph = self.repository.commitGraph;
+	if (graph != nil) return [graph countFromOID:[GTOID oidWithGitOid:startOid] error:error];
+	
 	[self setOptions:GTEnumeratorOptionsNone];
 	
-	BOOL success = [self push:sha error:error];
+	BOOL success = [self pushGitOid:startOid error:error];
 	if(!success) return NSNotFound;
 	
 	git_oid oid;
@@ -165,6 +621,7 @@
 	while(git_revwalk_next(&oid, self.walk) == GIT_OK) {
 		count++;
 	}
+	self.pendingOIDs = nil;
 	return count;
 }
 
@@ -0,0 +1,49 @@
+//
+//  GTEnumeratorCursor.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Returned by +[GTEnumeratorCursor cursorWithString:error:] when the string
+// isn't a valid cursor. In GTGitErrorDomain, kept clear of libgit2's codes.
+static const NSInteger GTEnumeratorCursorErrorCodeInvalidString = -1005;
+
+// Where a time sorted walk left off, so it can be picked up again later (see
+// -[GTEnumerator resumeFromCursor:error:]) without walking everything before
+// it again.
+//
+// A cursor is the walk's frontier: the commits it would have looked at next,
+// plus the commits it was told to hide. Its string form is suitable for
+// handing to API clients as a page token.
+@interface GTEnumeratorCursor : NSObject <NSCopying>
+
+// The GTOIDs of the commits the walk would have looked at next.
+@property (nonatomic, readonly, copy) NSArray *pendingOIDs;
+
+// The GTOIDs of the commits the walk was told to hide.
+@property (nonatomic, readonly, copy) NSArray *hiddenOIDs;
+
+// The cursor as a string: the pending SHAs followed by the hidden SHAs, each
+// hidden one prefixed with `^`, separated by spaces.
+@property (nonatomic, readonly, copy) NSString *stringValue;
+
+// Parse a cursor from its `stringValue`.
+//
+// string     - The string to parse. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the cursor, or nil if the string isn't a valid cursor.
++ (id)cursorWithString:(NSString *)string error:(NSError **)error;
+
+// Designated initializer.
+//
+// pendingOIDs - The GTOIDs of the commits to resume at. Cannot be nil or
+//               empty.
+// hiddenOIDs  - The GTOIDs of the commits to hide. Cannot be nil.
+- (id)initWithPendingOIDs:(NSArray *)pendingOIDs hiddenOIDs:(NSArray *)hiddenOIDs;
+
+@end
@@ -0,0 +1,95 @@
+//
+//  GTEnumeratorCursor.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTEnumeratorCursor.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+@implementation GTEnumeratorCursor
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> %@", NSStringFromClass([self class]), self, self.stringValue];
+}
+
+- (BOOL)isEqual:(id)otherObject {
+	if (![otherObject isKindOfClass:GTEnumeratorCursor.class]) return NO;
+
+	GTEnumeratorCursor *otherCursor = otherObject;
+	return [self.pendingOIDs isEqualToArray:otherCursor.pendingOIDs] && [self.hiddenOIDs isEqualToArray:otherCursor.hiddenOIDs];
+}
+
+- (NSUInteger)hash {
+	return [self.pendingOIDs.lastObject hash];
+}
+
+#pragma mark Lifecycle
+
++ (id)cursorWithString:(NSString *)string error:(NSError **)error {
+	NSParameterAssert(string != nil);
+
+	NSMutableArray *pendingOIDs = [NSMutableArray array];
+	NSMutableArray *hiddenOIDs = [NSMutableArray array];
+
+	for (NSString *component in [string componentsSeparatedByString:@" "]) {
+		if (component.length == 0) continue;
+
+		BOOL hidden = [component hasPrefix:@"^"];
+		GTOID *oid = [GTOID oidWithSha:(hidden ? [component substringFromIndex:1] : component) error:NULL];
+
+		// Pending commits come first.
+		if (oid == nil || (!hidden && hiddenOIDs.count > 0)) {
+			pendingOIDs = nil;
+			break;
+		}
+
+		[(hidden ? hiddenOIDs : pendingOIDs) addObject:oid];
+	}
+
+	if (pendingOIDs.count == 0) {
+		if (error != NULL) *error = [NSError errorWithDomain:GTGitErrorDomain code:GTEnumeratorCursorErrorCodeInvalidString userInfo:@{ NSLocalizedDescriptionKey: [NSString stringWithFormat:@"\"%@\" is not a valid cursor.", string] }];
+		return nil;
+	}
+
+	return [[self alloc] initWithPendingOIDs:pendingOIDs hiddenOIDs:hiddenOIDs];
+}
+
+- (id)initWithPendingOIDs:(NSArray *)pendingOIDs hiddenOIDs:(NSArray *)hiddenOIDs {
+	NSParameterAssert(pendingOIDs.count > 0);
+	NSParameterAssert(hiddenOIDs != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_pendingOIDs = [pendingOIDs copy];
+	_hiddenOIDs = [hiddenOIDs copy];
+
+	return self;
+}
+
+#pragma mark Properties
+
+- (NSString *)stringValue {
+	NSMutableArray *components = [NSMutableArray arrayWithCapacity:self.pendingOIDs.count + self.hiddenOIDs.count];
+	for (GTOID *oid in self.pendingOIDs) {
+		[components addObject:oid.sha];
+	}
+
+	for (GTOID *oid in self.hiddenOIDs) {
+		[components addObject:[@"^" stringByAppendingString:oid.sha]];
+	}
+
+	return [components componentsJoinedByString:@" "];
+}
+
+#pragma mark NSCopying
+
+- (id)copyWithZone:(NSZone *)zone {
+	return self;
+}
+
+@end
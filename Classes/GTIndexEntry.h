@@ -30,6 +30,8 @@
 #include "git2.h"
 #import "GTObject.h"
 
+@class GTOID;
+
 typedef enum {
 	GTIndexEntryStatusUpdated = 0,
 	GTIndexEntryStatusRemoved,
@@ -63,4 +65,8 @@ typedef enum {
 - (NSString *)sha;
 - (BOOL)setSha:(NSString *)theSha error:(NSError **)error;
 
+// The OID of the entry's blob.
+- (GTOID *)OID;
+- (void)setOID:(GTOID *)theOID;
+
 @end
@@ -30,6 +30,7 @@
 #import "GTIndexEntry.h"
 #import "NSError+Git.h"
 #import "NSString+Git.h"
+#import "GTOID.h"
 
 
 @implementation GTIndexEntry
@@ -111,6 +112,16 @@
 	return YES;
 }
 
+- (GTOID *)OID {
+	return [GTOID oidWithGitOid:&git_index_entry->oid];
+}
+
+- (void)setOID:(GTOID *)theOID {
+	NSParameterAssert(theOID != nil);
+	
+	git_oid_cpy(&git_index_entry->oid, theOID.git_oid);
+}
+
 - (NSDate *)modificationDate {	
 	double time = self.git_index_entry->mtime.seconds + (self.git_index_entry->mtime.nanoseconds/1000);
 	return [NSDate dateWithTimeIntervalSince1970:time];
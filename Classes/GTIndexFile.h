@@ -0,0 +1,129 @@
+//
+//  GTIndexFile.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "git2.h"
+
+@class GTRepository;
+
+// Reading and writing the files the framework keeps alongside a repository,
+// like the commit graph and the diff cache. They share a layout, with every
+// integer big-endian:
+//
+//   4 bytes                         magic
+//   uint32                          version
+//   ...                             the file's contents
+//   20 bytes                        SHA1 of everything above
+
+// The length of the magic and version.
+static const NSUInteger GTIndexFileHeaderLength = 8;
+
+static inline void GTIndexFileAppendUInt8(NSMutableData *data, uint8_t value) {
+	[data appendBytes:&value length:sizeof(value)];
+}
+
+static inline void GTIndexFileAppendUInt16(NSMutableData *data, uint16_t value) {
+	uint16_t bigEndian = CFSwapInt16HostToBig(value);
+	[data appendBytes:&bigEndian length:sizeof(bigEndian)];
+}
+
+static inline void GTIndexFileAppendUInt32(NSMutableData *data, uint32_t value) {
+	uint32_t bigEndian = CFSwapInt32HostToBig(value);
+	[data appendBytes:&bigEndian length:sizeof(bigEndian)];
+}
+
+static inline void GTIndexFileAppendUInt64(NSMutableData *data, uint64_t value) {
+	uint64_t bigEndian = CFSwapInt64HostToBig(value);
+	[data appendBytes:&bigEndian length:sizeof(bigEndian)];
+}
+
+static inline void GTIndexFileAppendInt64(NSMutableData *data, int64_t value) {
+	GTIndexFileAppendUInt64(data, (uint64_t)value);
+}
+
+static inline uint16_t GTIndexFileReadUInt16(const uint8_t *bytes) {
+	uint16_t bigEndian;
+	memcpy(&bigEndian, bytes, sizeof(bigEndian));
+	return CFSwapInt16BigToHost(bigEndian);
+}
+
+static inline uint32_t GTIndexFileReadUInt32(const uint8_t *bytes) {
+	uint32_t bigEndian;
+	memcpy(&bigEndian, bytes, sizeof(bigEndian));
+	return CFSwapInt32BigToHost(bigEndian);
+}
+
+static inline uint64_t GTIndexFileReadUInt64(const uint8_t *bytes) {
+	uint64_t bigEndian;
+	memcpy(&bigEndian, bytes, sizeof(bigEndian));
+	return CFSwapInt64BigToHost(bigEndian);
+}
+
+static inline int64_t GTIndexFileReadInt64(const uint8_t *bytes) {
+	return (int64_t)GTIndexFileReadUInt64(bytes);
+}
+
+// Reads from a file's contents, failing instead of running off the end of
+// them. For files whose layout isn't known until they're read.
+typedef struct {
+	const uint8_t *bytes;
+	NSUInteger length;
+	NSUInteger offset;
+} GTIndexFileReader;
+
+// A reader of the contents of `data`, starting after the header. `data` must
+// have been checked with GTIndexFileContentsLength().
+GTIndexFileReader GTIndexFileReaderMake(NSData *data, NSUInteger contentsLength);
+
+BOOL GTIndexFileReaderReadBytes(GTIndexFileReader *reader, NSUInteger length, const uint8_t **bytes);
+
+// Read `count` elements of `elementLength` bytes each, without the length
+// overflowing however big a count the file claims.
+BOOL GTIndexFileReaderReadArray(GTIndexFileReader *reader, NSUInteger count, NSUInteger elementLength, const uint8_t **bytes);
+
+BOOL GTIndexFileReaderReadUInt8(GTIndexFileReader *reader, uint8_t *value);
+BOOL GTIndexFileReaderReadUInt16(GTIndexFileReader *reader, uint16_t *value);
+BOOL GTIndexFileReaderReadUInt32(GTIndexFileReader *reader, uint32_t *value);
+BOOL GTIndexFileReaderReadUInt64(GTIndexFileReader *reader, uint64_t *value);
+
+// Whether the reader has read everything.
+BOOL GTIndexFileReaderIsAtEnd(const GTIndexFileReader *reader);
+
+// The file or directory named `name` in the `objectivegit` directory of the
+// repository's git directory.
+NSURL *GTIndexFileURLForRepository(GTRepository *repository, NSString *name, BOOL isDirectory);
+
+// Start a file with its magic and version.
+//
+// capacity - How long the whole file is expected to be.
+NSMutableData *GTIndexFileCreateData(const char magic[4], uint32_t version, NSUInteger capacity);
+
+// Append the checksum to a file started with GTIndexFileCreateData().
+void GTIndexFileFinishData(NSMutableData *data);
+
+// Finish a file, and write it atomically, creating its directory if need be.
+BOOL GTIndexFileWriteData(NSMutableData *data, NSURL *fileURL, NSError **error);
+
+// Read a file, mapping it if possible.
+//
+// data(out) - Set to the file's contents, or nil if there's no file.
+//
+// returns NO and fills `error` if the file exists but can't be read.
+BOOL GTIndexFileReadData(NSURL *fileURL, NSData **data, NSError **error);
+
+// Check a file's magic, version and checksum.
+//
+// returns the length of the file less its checksum, or 0 if it isn't a valid
+// file with that magic and version.
+NSUInteger GTIndexFileContentsLength(NSData *data, const char magic[4], uint32_t version);
+
+// The error to fail with when a file is corrupt.
+//
+// code        - The owning class's error code for corrupt files.
+// description - What the file is, like "The commit graph".
+NSError *GTIndexFileCorruptError(NSInteger code, NSString *description, NSURL *fileURL);
@@ -0,0 +1,124 @@
+//
+//  GTIndexFile.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTIndexFile.h"
+#import "GTRepository.h"
+#import "NSError+Git.h"
+
+static const NSUInteger GTIndexFileMagicLength = 4;
+
+GTIndexFileReader GTIndexFileReaderMake(NSData *data, NSUInteger contentsLength) {
+	NSCParameterAssert(contentsLength >= GTIndexFileHeaderLength && contentsLength <= data.length);
+
+	GTIndexFileReader reader = { .bytes = data.bytes, .length = contentsLength, .offset = GTIndexFileHeaderLength };
+	return reader;
+}
+
+BOOL GTIndexFileReaderReadBytes(GTIndexFileReader *reader, NSUInteger length, const uint8_t **bytes) {
+	if (reader->length - reader->offset < length) return NO;
+
+	*bytes = reader->bytes + reader->offset;
+	reader->offset += length;
+	return YES;
+}
+
+BOOL GTIndexFileReaderReadArray(GTIndexFileReader *reader, NSUInteger count, NSUInteger elementLength, const uint8_t **bytes) {
+	if (elementLength > 0 && count > (reader->length - reader->offset) / elementLength) return NO;
+
+	return GTIndexFileReaderReadBytes(reader, count * elementLength, bytes);
+}
+
+BOOL GTIndexFileReaderReadUInt8(GTIndexFileReader *reader, uint8_t *value) {
+	const uint8_t *bytes = NULL;
+	if (!GTIndexFileReaderReadBytes(reader, sizeof(*value), &bytes)) return NO;
+
+	*value = *bytes;
+	return YES;
+}
+
+BOOL GTIndexFileReaderReadUInt16(GTIndexFileReader *reader, uint16_t *value) {
+	const uint8_t *bytes = NULL;
+	if (!GTIndexFileReaderReadBytes(reader, sizeof(*value), &bytes)) return NO;
+
+	*value = GTIndexFileReadUInt16(bytes);
+	return YES;
+}
+
+BOOL GTIndexFileReaderReadUInt32(GTIndexFileReader *reader, uint32_t *value) {
+	const uint8_t *bytes = NULL;
+	if (!GTIndexFileReaderReadBytes(reader, sizeof(*value), &bytes)) return NO;
+
+	*value = GTIndexFileReadUInt32(bytes);
+	return YES;
+}
+
+BOOL GTIndexFileReaderReadUInt64(GTIndexFileReader *reader, uint64_t *value) {
+	const uint8_t *bytes = NULL;
+	if (!GTIndexFileReaderReadBytes(reader, sizeof(*value), &bytes)) return NO;
+
+	*value = GTIndexFileReadUInt64(bytes);
+	return YES;
+}
+
+BOOL GTIndexFileReaderIsAtEnd(const GTIndexFileReader *reader) {
+	return reader->offset == reader->length;
+}
+
+NSURL *GTIndexFileURLForRepository(GTRepository *repository, NSString *name, BOOL isDirectory) {
+	return [[repository.gitDirectoryURL URLByAppendingPathComponent:@"objectivegit" isDirectory:YES] URLByAppendingPathComponent:name isDirectory:isDirectory];
+}
+
+NSMutableData *GTIndexFileCreateData(const char magic[4], uint32_t version, NSUInteger capacity) {
+	NSMutableData *data = [NSMutableData dataWithCapacity:capacity];
+	[data appendBytes:magic length:GTIndexFileMagicLength];
+	GTIndexFileAppendUInt32(data, version);
+
+	return data;
+}
+
+void GTIndexFileFinishData(NSMutableData *data) {
+	git_oid checksum;
+	git_odb_hash(&checksum, data.bytes, data.length, GIT_OBJ_BLOB);
+	[data appendBytes:checksum.id length:GIT_OID_RAWSZ];
+}
+
+BOOL GTIndexFileWriteData(NSMutableData *data, NSURL *fileURL, NSError **error) {
+	GTIndexFileFinishData(data);
+
+	NSURL *directoryURL = fileURL.URLByDeletingLastPathComponent;
+	if (![NSFileManager.defaultManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:error]) return NO;
+
+	return [data writeToURL:fileURL options:NSDataWritingAtomic error:error];
+}
+
+BOOL GTIndexFileReadData(NSURL *fileURL, NSData **data, NSError **error) {
+	*data = nil;
+	if (![NSFileManager.defaultManager fileExistsAtPath:fileURL.path]) return YES;
+
+	*data = [NSData dataWithContentsOfURL:fileURL options:NSDataReadingMappedIfSafe error:error];
+	return *data != nil;
+}
+
+NSUInteger GTIndexFileContentsLength(NSData *data, const char magic[4], uint32_t version) {
+	const uint8_t *bytes = data.bytes;
+	NSUInteger length = data.length;
+	if (length < GTIndexFileHeaderLength + GIT_OID_RAWSZ) return 0;
+	if (memcmp(bytes, magic, GTIndexFileMagicLength) != 0 || GTIndexFileReadUInt32(bytes + GTIndexFileMagicLength) != version) return 0;
+
+	NSUInteger contentsLength = length - GIT_OID_RAWSZ;
+	git_oid checksum;
+	git_odb_hash(&checksum, bytes, contentsLength, GIT_OBJ_BLOB);
+	if (memcmp(checksum.id, bytes + contentsLength, GIT_OID_RAWSZ) != 0) return 0;
+
+	return contentsLength;
+}
+
+NSError *GTIndexFileCorruptError(NSInteger code, NSString *description, NSURL *fileURL) {
+	NSString *message = [NSString stringWithFormat:@"%@ at %@ is corrupt.", description, fileURL.path];
+	return [NSError errorWithDomain:GTGitErrorDomain code:code userInfo:@{ NSLocalizedDescriptionKey: message }];
+}
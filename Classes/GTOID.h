@@ -0,0 +1,45 @@
+//
+//  GTOID.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "git2.h"
+
+// An immutable object ID.
+//
+// The 20 raw bytes are stored inline, so comparing and hashing OIDs never
+// touches a string. The hex representation is only formatted when `sha` is
+// first asked for.
+@interface GTOID : NSObject <NSCopying>
+
+// The underlying libgit2 oid. Valid for the lifetime of the receiver.
+@property (nonatomic, readonly) const git_oid *git_oid;
+
+// The 40 character hex SHA of the receiver.
+@property (nonatomic, readonly, copy) NSString *sha;
+
+// Create an OID from a libgit2 oid. The oid is copied.
+//
+// git_oid - The oid to copy. Cannot be NULL.
++ (id)oidWithGitOid:(const git_oid *)git_oid;
+- (id)initWithGitOid:(const git_oid *)git_oid;
+
+// Create an OID from a full 40 character hex SHA.
+//
+// sha   - The SHA to parse. Cannot be nil.
+// error - Will be filled if the SHA could not be parsed.
+//
+// Returns the OID, or nil if an error occurred.
++ (id)oidWithSha:(NSString *)sha error:(NSError **)error;
+- (id)initWithSha:(NSString *)sha error:(NSError **)error;
+
+// Whether the receiver and the given OID point at the same object.
+- (BOOL)isEqualToOID:(GTOID *)otherOID;
+
+// Compare the raw bytes of the receiver and the given OID.
+- (NSComparisonResult)compare:(GTOID *)otherOID;
+
+@end
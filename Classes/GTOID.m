@@ -0,0 +1,114 @@
+//
+//  GTOID.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTOID.h"
+#import "NSError+Git.h"
+#import "NSString+Git.h"
+
+@interface GTOID () {
+	git_oid _git_oid;
+}
+
+// The lazily formatted SHA. Atomic so that concurrent readers of an OID
+// shared between threads don't race on it.
+@property (atomic, copy) NSString *formattedSha;
+
+@end
+
+@implementation GTOID
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> %@", NSStringFromClass([self class]), self, self.sha];
+}
+
+- (NSUInteger)hash {
+	// The oid is already a cryptographic hash, so its leading bytes are as good
+	// a hash as any.
+	NSUInteger hash;
+	memcpy(&hash, _git_oid.id, sizeof(hash));
+	return hash;
+}
+
+- (BOOL)isEqual:(id)otherObject {
+	if (otherObject == self) return YES;
+	if (![otherObject isKindOfClass:GTOID.class]) return NO;
+
+	return [self isEqualToOID:otherObject];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+	// We're immutable.
+	return self;
+}
+
+#pragma mark API
+
++ (id)oidWithGitOid:(const git_oid *)git_oid {
+	return [[self alloc] initWithGitOid:git_oid];
+}
+
+- (id)initWithGitOid:(const git_oid *)git_oid {
+	NSParameterAssert(git_oid != NULL);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	git_oid_cpy(&_git_oid, git_oid);
+
+	return self;
+}
+
++ (id)oidWithSha:(NSString *)sha error:(NSError **)error {
+	return [[self alloc] initWithSha:sha error:error];
+}
+
+- (id)initWithSha:(NSString *)sha error:(NSError **)error {
+	NSParameterAssert(sha != nil);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	int gitError = git_oid_fromstr(&_git_oid, sha.UTF8String);
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorForMkStr:gitError];
+		return nil;
+	}
+
+	self.formattedSha = [sha lowercaseString];
+
+	return self;
+}
+
+- (const git_oid *)git_oid {
+	return &_git_oid;
+}
+
+- (NSString *)sha {
+	NSString *sha = self.formattedSha;
+	if (sha == nil) {
+		sha = [NSString git_stringWithOid:&_git_oid];
+		self.formattedSha = sha;
+	}
+
+	return sha;
+}
+
+- (BOOL)isEqualToOID:(GTOID *)otherOID {
+	if (otherOID == nil) return NO;
+
+	return git_oid_cmp(&_git_oid, otherOID.git_oid) == 0;
+}
+
+- (NSComparisonResult)compare:(GTOID *)otherOID {
+	int result = git_oid_cmp(&_git_oid, otherOID.git_oid);
+	if (result < 0) return NSOrderedAscending;
+	if (result > 0) return NSOrderedDescending;
+	return NSOrderedSame;
+}
+
+@end
@@ -44,6 +44,7 @@ typedef enum {
 
 @class GTRepository;
 @class GTOdbObject;
+@class GTOID;
 
 @protocol GTObject <NSObject>
 
@@ -58,6 +59,10 @@ typedef enum {
 @property (nonatomic, readonly) NSString *type;
 @property (nonatomic, readonly) NSString *sha;
 @property (nonatomic, readonly) NSString *shortSha;
+
+// The object ID of the receiver.
+@property (nonatomic, readonly) GTOID *OID;
+
 @property (nonatomic, unsafe_unretained) GTRepository *repository;
 
 // Convenience initializers
@@ -36,6 +36,7 @@
 #import "GTTree.h"
 #import "GTBlob.h"
 #import "GTTag.h"
+#import "GTOID.h"
 
 @interface GTObject ()
 @property (nonatomic, assign) git_object *git_object;
@@ -54,7 +55,10 @@
 }
 
 - (NSUInteger)hash {
-	return [self.sha hash];
+	// Hash the raw oid rather than formatting the SHA.
+	NSUInteger hash;
+	memcpy(&hash, git_object_id(self.git_object)->id, sizeof(hash));
+	return hash;
 }
 
 - (BOOL)isEqual:(id)otherObject {
@@ -109,6 +113,10 @@
 	return [NSString git_stringWithOid:git_object_id(self.git_object)];
 }
 
+- (GTOID *)OID {
+	return [GTOID oidWithGitOid:git_object_id(self.git_object)];
+}
+
 - (NSString *)shortSha {
 	return [self.sha git_shortUniqueShaString];
 }
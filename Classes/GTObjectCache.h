@@ -0,0 +1,86 @@
+//
+//  GTObjectCache.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "git2.h"
+
+@class GTObject;
+
+// A bounded, least-recently-used cache of objects keyed by their raw 20 byte
+// `git_oid`.
+//
+// Every `GTRepository` owns one of these (see `-[GTRepository objectCache]`),
+// which it consults before asking libgit2 to look an object up, so that hot
+// commits and trees are wrapped only once.
+//
+// This class is thread safe.
+@interface GTObjectCache : NSObject
+
+// The maximum number of objects the cache will hold before evicting the least
+// recently used ones. A limit of 0 means there is no limit.
+//
+// Defaults to 4096.
+@property (nonatomic, assign) NSUInteger countLimit;
+
+// The maximum total cost the cache will hold before evicting the least
+// recently used objects. For `GTObject`s the cost is an estimate of the memory
+// used by the object, in bytes. A limit of 0 means there is no limit.
+//
+// Defaults to 32MB.
+@property (nonatomic, assign) NSUInteger totalCostLimit;
+
+// The number of objects currently in the cache.
+@property (nonatomic, readonly) NSUInteger count;
+
+// The total cost of the objects currently in the cache.
+@property (nonatomic, readonly) NSUInteger totalCost;
+
+// The number of lookups which found an object in the cache.
+@property (nonatomic, readonly) NSUInteger hitCount;
+
+// The number of lookups which did not find an object in the cache.
+@property (nonatomic, readonly) NSUInteger missCount;
+
+// The number of objects which have been evicted to stay within the limits.
+@property (nonatomic, readonly) NSUInteger evictionCount;
+
+// Designated initializer.
+//
+// countLimit     - The maximum number of objects, or 0 for no limit.
+// totalCostLimit - The maximum total cost, or 0 for no limit.
+- (id)initWithCountLimit:(NSUInteger)countLimit totalCostLimit:(NSUInteger)totalCostLimit;
+
+// Look up the object cached for the given oid, marking it as most recently
+// used.
+//
+// oid - The oid of the object. Cannot be NULL.
+//
+// returns the cached object, or nil if the cache doesn't contain the oid.
+- (id)objectForOid:(const git_oid *)oid;
+
+// Add an object to the cache, replacing any object already cached for the oid
+// and evicting least recently used objects if a limit is exceeded.
+//
+// object - The object to cache. Cannot be nil.
+// oid    - The oid to cache the object under. Cannot be NULL.
+// cost   - The cost of the object.
+- (void)setObject:(id)object forOid:(const git_oid *)oid cost:(NSUInteger)cost;
+
+// Add a `GTObject` to the cache under its own oid, estimating its cost from
+// the size of the underlying libgit2 object.
+- (void)addObject:(GTObject *)object;
+
+// Remove the object cached for the given oid, if any.
+- (void)removeObjectForOid:(const git_oid *)oid;
+
+// Remove every object from the cache. This does not reset the statistics.
+- (void)removeAllObjects;
+
+// Reset the hit, miss and eviction counters to 0.
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,301 @@
+//
+//  GTObjectCache.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTObjectCache.h"
+#import "GTObject.h"
+
+#import <pthread.h>
+
+static const NSUInteger GTObjectCacheDefaultCountLimit = 4096;
+static const NSUInteger GTObjectCacheDefaultTotalCostLimit = 32 * 1024 * 1024;
+
+// An entry in the cache. Entries form a doubly linked list ordered from most
+// to least recently used, and are indexed by a dictionary whose keys point at
+// the entry's own `oid`, so a lookup never needs to allocate a key.
+typedef struct GTObjectCacheEntry {
+	git_oid oid;
+	CFTypeRef object;
+	NSUInteger cost;
+	struct GTObjectCacheEntry *newer;
+	struct GTObjectCacheEntry *older;
+} GTObjectCacheEntry;
+
+static CFHashCode GTObjectCacheOidHash(const void *value) {
+	// The oid is already a cryptographic hash, so its leading bytes are as good
+	// a hash as any.
+	CFHashCode hash;
+	memcpy(&hash, ((const git_oid *)value)->id, sizeof(hash));
+	return hash;
+}
+
+static Boolean GTObjectCacheOidEqual(const void *value1, const void *value2) {
+	return git_oid_cmp(value1, value2) == 0;
+}
+
+@interface GTObjectCache () {
+	pthread_mutex_t _lock;
+	CFMutableDictionaryRef _entries;
+	GTObjectCacheEntry *_newest;
+	GTObjectCacheEntry *_oldest;
+
+	NSUInteger _countLimit;
+	NSUInteger _totalCostLimit;
+	NSUInteger _totalCost;
+	NSUInteger _hitCount;
+	NSUInteger _missCount;
+	NSUInteger _evictionCount;
+}
+
+@end
+
+@implementation GTObjectCache
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> count: %lu, totalCost: %lu, hits: %lu, misses: %lu, evictions: %lu", NSStringFromClass([self class]), self, (unsigned long)self.count, (unsigned long)self.totalCost, (unsigned long)self.hitCount, (unsigned long)self.missCount, (unsigned long)self.evictionCount];
+}
+
+- (void)dealloc {
+	[self removeAllObjects];
+	CFRelease(_entries);
+	pthread_mutex_destroy(&_lock);
+}
+
+#pragma mark API
+
+- (id)init {
+	return [self initWithCountLimit:GTObjectCacheDefaultCountLimit totalCostLimit:GTObjectCacheDefaultTotalCostLimit];
+}
+
+- (id)initWithCountLimit:(NSUInteger)countLimit totalCostLimit:(NSUInteger)totalCostLimit {
+	self = [super init];
+	if (self == nil) return nil;
+
+	CFDictionaryKeyCallBacks keyCallBacks = { 0, NULL, NULL, NULL, GTObjectCacheOidEqual, GTObjectCacheOidHash };
+	_entries = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &keyCallBacks, NULL);
+	pthread_mutex_init(&_lock, NULL);
+
+	_countLimit = countLimit;
+	_totalCostLimit = totalCostLimit;
+
+	return self;
+}
+
+- (NSUInteger)countLimit {
+	pthread_mutex_lock(&_lock);
+	NSUInteger limit = _countLimit;
+	pthread_mutex_unlock(&_lock);
+	return limit;
+}
+
+- (void)setCountLimit:(NSUInteger)countLimit {
+	pthread_mutex_lock(&_lock);
+	_countLimit = countLimit;
+	[self evictEntriesToFitLimits];
+	pthread_mutex_unlock(&_lock);
+}
+
+- (NSUInteger)totalCostLimit {
+	pthread_mutex_lock(&_lock);
+	NSUInteger limit = _totalCostLimit;
+	pthread_mutex_unlock(&_lock);
+	return limit;
+}
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit {
+	pthread_mutex_lock(&_lock);
+	_totalCostLimit = totalCostLimit;
+	[self evictEntriesToFitLimits];
+	pthread_mutex_unlock(&_lock);
+}
+
+- (NSUInteger)count {
+	pthread_mutex_lock(&_lock);
+	NSUInteger count = (NSUInteger)CFDictionaryGetCount(_entries);
+	pthread_mutex_unlock(&_lock);
+	return count;
+}
+
+- (NSUInteger)totalCost {
+	pthread_mutex_lock(&_lock);
+	NSUInteger cost = _totalCost;
+	pthread_mutex_unlock(&_lock);
+	return cost;
+}
+
+- (NSUInteger)hitCount {
+	pthread_mutex_lock(&_lock);
+	NSUInteger hits = _hitCount;
+	pthread_mutex_unlock(&_lock);
+	return hits;
+}
+
+- (NSUInteger)missCount {
+	pthread_mutex_lock(&_lock);
+	NSUInteger misses = _missCount;
+	pthread_mutex_unlock(&_lock);
+	return misses;
+}
+
+- (NSUInteger)evictionCount {
+	pthread_mutex_lock(&_lock);
+	NSUInteger evictions = _evictionCount;
+	pthread_mutex_unlock(&_lock);
+	return evictions;
+}
+
+- (id)objectForOid:(const git_oid *)oid {
+	NSParameterAssert(oid != NULL);
+
+	pthread_mutex_lock(&_lock);
+
+	id object = nil;
+	GTObjectCacheEntry *entry = (GTObjectCacheEntry *)CFDictionaryGetValue(_entries, oid);
+	if (entry != NULL) {
+		[self unlinkEntry:entry];
+		[self linkEntryAsNewest:entry];
+		object = (__bridge id)entry->object;
+		_hitCount++;
+	} else {
+		_missCount++;
+	}
+
+	pthread_mutex_unlock(&_lock);
+
+	return object;
+}
+
+- (void)setObject:(id)object forOid:(const git_oid *)oid cost:(NSUInteger)cost {
+	NSParameterAssert(object != nil);
+	NSParameterAssert(oid != NULL);
+
+	pthread_mutex_lock(&_lock);
+
+	GTObjectCacheEntry *entry = (GTObjectCacheEntry *)CFDictionaryGetValue(_entries, oid);
+	if (entry != NULL) {
+		[self removeEntry:entry];
+	}
+
+	entry = calloc(1, sizeof(*entry));
+	git_oid_cpy(&entry->oid, oid);
+	entry->object = CFBridgingRetain(object);
+	entry->cost = cost;
+
+	CFDictionarySetValue(_entries, &entry->oid, entry);
+	[self linkEntryAsNewest:entry];
+	_totalCost += cost;
+
+	[self evictEntriesToFitLimits];
+
+	pthread_mutex_unlock(&_lock);
+}
+
+- (void)addObject:(GTObject *)object {
+	NSParameterAssert(object != nil);
+
+	[self setObject:object forOid:git_object_id(object.git_object) cost:[self.class costOfGitObject:object.git_object]];
+}
+
+- (void)removeObjectForOid:(const git_oid *)oid {
+	NSParameterAssert(oid != NULL);
+
+	pthread_mutex_lock(&_lock);
+	GTObjectCacheEntry *entry = (GTObjectCacheEntry *)CFDictionaryGetValue(_entries, oid);
+	if (entry != NULL) [self removeEntry:entry];
+	pthread_mutex_unlock(&_lock);
+}
+
+- (void)removeAllObjects {
+	pthread_mutex_lock(&_lock);
+	while (_oldest != NULL) {
+		[self removeEntry:_oldest];
+	}
+	pthread_mutex_unlock(&_lock);
+}
+
+- (void)resetStatistics {
+	pthread_mutex_lock(&_lock);
+	_hitCount = 0;
+	_missCount = 0;
+	_evictionCount = 0;
+	pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark Cost
+
++ (NSUInteger)costOfGitObject:(git_object *)object {
+	// A rough estimate of the memory held by the parsed object and its wrapper.
+	static const NSUInteger baseCost = 128;
+
+	switch (git_object_type(object)) {
+		case GIT_OBJ_COMMIT: {
+			const char *message = git_commit_message((git_commit *)object);
+			return baseCost + 256 + (message != NULL ? strlen(message) : 0);
+		}
+		case GIT_OBJ_TREE:
+			return baseCost + git_tree_entrycount((git_tree *)object) * 64;
+		case GIT_OBJ_BLOB:
+			return baseCost + (NSUInteger)git_blob_rawsize((git_blob *)object);
+		case GIT_OBJ_TAG: {
+			const char *message = git_tag_message((git_tag *)object);
+			return baseCost + 256 + (message != NULL ? strlen(message) : 0);
+		}
+		default:
+			return baseCost;
+	}
+}
+
+#pragma mark Entries
+
+// All of the following must be called with the lock held.
+
+- (void)linkEntryAsNewest:(GTObjectCacheEntry *)entry {
+	entry->older = _newest;
+	entry->newer = NULL;
+	if (_newest != NULL) _newest->newer = entry;
+	_newest = entry;
+	if (_oldest == NULL) _oldest = entry;
+}
+
+- (void)unlinkEntry:(GTObjectCacheEntry *)entry {
+	if (entry->newer != NULL) {
+		entry->newer->older = entry->older;
+	} else {
+		_newest = entry->older;
+	}
+
+	if (entry->older != NULL) {
+		entry->older->newer = entry->newer;
+	} else {
+		_oldest = entry->newer;
+	}
+
+	entry->newer = NULL;
+	entry->older = NULL;
+}
+
+- (void)removeEntry:(GTObjectCacheEntry *)entry {
+	[self unlinkEntry:entry];
+	CFDictionaryRemoveValue(_entries, &entry->oid);
+	_totalCost -= entry->cost;
+
+	CFRelease(entry->object);
+	free(entry);
+}
+
+- (void)evictEntriesToFitLimits {
+	while (_oldest != NULL && _oldest != _newest) {
+		BOOL overCount = (_countLimit > 0 && (NSUInteger)CFDictionaryGetCount(_entries) > _countLimit);
+		BOOL overCost = (_totalCostLimit > 0 && _totalCost > _totalCostLimit);
+		if (!overCount && !overCost) break;
+
+		[self removeEntry:_oldest];
+		_evictionCount++;
+	}
+}
+
+@end
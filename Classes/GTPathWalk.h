@@ -0,0 +1,54 @@
+//
+//  GTPathWalk.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTRepository;
+@class GTCommit;
+@class GTOID;
+
+// A walk of the commits which changed a set of paths, with git's default
+// history simplification. See -[GTRepository enumerateCommitsBeginningAtSha:
+// touchingPaths:error:usingBlock:].
+//
+// Commits are walked newest first over the commit graph, so no commit is read
+// just to find its parents. Whether a commit changed the paths relative to its
+// first parent is answered by the changed path index when it can be, and by
+// comparing the entries at the paths in both trees otherwise.
+@interface GTPathWalk : NSObject
+
+// The repository to walk.
+@property (nonatomic, readonly, strong) GTRepository *repository;
+
+// The paths to limit the walk to, without leading or trailing slashes.
+@property (nonatomic, readonly, copy) NSArray *paths;
+
+// The number of times the last walk compared trees.
+@property (nonatomic, readonly) NSUInteger treeComparisonCount;
+
+// The number of times the last walk skipped comparing trees because the
+// changed path index said nothing changed.
+@property (nonatomic, readonly) NSUInteger filterRejectionCount;
+
+// Designated initializer.
+//
+// repository - The repository to walk. Cannot be nil.
+// paths      - The paths to limit the walk to. Cannot be nil or empty.
+- (id)initWithRepository:(GTRepository *)repository paths:(NSArray *)paths;
+
+// Walk from a commit.
+//
+// oid        - The commit to start at. Cannot be nil.
+// error(out) - will be filled if an error occurs
+// block      - The block to call with each commit which changed the paths.
+//              Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateCommitsFromOID:(GTOID *)oid error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, BOOL *stop))block;
+
+@end
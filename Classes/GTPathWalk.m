@@ -0,0 +1,288 @@
+//
+//  GTPathWalk.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTPathWalk.h"
+#import "GTRepository.h"
+#import "GTRepository+Private.h"
+#import "GTCommitGraph.h"
+#import "GTCommitGraph+Private.h"
+#import "GTChangedPathIndex.h"
+#import "GTChangedPathIndex+Private.h"
+#import "GTCommit.h"
+#import "GTOID.h"
+#import "NSError+Git.h"
+
+// A queued commit. Commits come out newest first, like `git log`.
+typedef struct {
+	int64_t time;
+	uint32_t generation;
+	GTCommitGraphPosition position;
+} GTPathWalkQueueEntry;
+
+static inline BOOL GTPathWalkQueueEntryIsNewer(GTPathWalkQueueEntry a, GTPathWalkQueueEntry b) {
+	if (a.time != b.time) return a.time > b.time;
+	return a.generation > b.generation;
+}
+
+static void GTPathWalkQueuePush(GTPathWalkQueueEntry *queue, NSUInteger *count, GTPathWalkQueueEntry entry) {
+	NSUInteger i = (*count)++;
+	while (i > 0) {
+		NSUInteger parent = (i - 1) / 2;
+		if (!GTPathWalkQueueEntryIsNewer(entry, queue[parent])) break;
+
+		queue[i] = queue[parent];
+		i = parent;
+	}
+
+	queue[i] = entry;
+}
+
+static GTPathWalkQueueEntry GTPathWalkQueuePop(GTPathWalkQueueEntry *queue, NSUInteger *count) {
+	GTPathWalkQueueEntry top = queue[0];
+	GTPathWalkQueueEntry last = queue[--(*count)];
+
+	NSUInteger i = 0;
+	while (YES) {
+		NSUInteger child = 2 * i + 1;
+		if (child >= *count) break;
+		if (child + 1 < *count && GTPathWalkQueueEntryIsNewer(queue[child + 1], queue[child])) child++;
+		if (!GTPathWalkQueueEntryIsNewer(queue[child], last)) break;
+
+		queue[i] = queue[child];
+		i = child;
+	}
+
+	if (*count > 0) queue[i] = last;
+
+	return top;
+}
+
+@interface GTPathWalk () {
+	NSUInteger _pathCount;
+	char **_UTF8Paths;
+	GTChangedPathKey *_keys;
+
+	// Whether one of the paths is the root, which every change touches.
+	BOOL _includesRoot;
+}
+
+@property (nonatomic, assign) NSUInteger treeComparisonCount;
+@property (nonatomic, assign) NSUInteger filterRejectionCount;
+
+@end
+
+@implementation GTPathWalk
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> paths: %@", NSStringFromClass([self class]), self, self.paths];
+}
+
+- (void)dealloc {
+	for (NSUInteger i = 0; i < _pathCount; i++) {
+		free(_UTF8Paths[i]);
+	}
+
+	free(_UTF8Paths);
+	free(_keys);
+}
+
+#pragma mark API
+
+- (id)initWithRepository:(GTRepository *)repository paths:(NSArray *)paths {
+	NSParameterAssert(repository != nil);
+	NSParameterAssert(paths.count > 0);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_repository = repository;
+
+	NSCharacterSet *slashes = [NSCharacterSet characterSetWithCharactersInString:@"/"];
+	NSMutableArray *normalizedPaths = [NSMutableArray arrayWithCapacity:paths.count];
+	for (NSString *path in paths) {
+		[normalizedPaths addObject:[path stringByTrimmingCharactersInSet:slashes]];
+	}
+
+	_paths = [normalizedPaths copy];
+	_pathCount = _paths.count;
+	_UTF8Paths = malloc(_pathCount * sizeof(*_UTF8Paths));
+	_keys = malloc(_pathCount * sizeof(*_keys));
+
+	for (NSUInteger i = 0; i < _pathCount; i++) {
+		_UTF8Paths[i] = strdup([_paths[i] UTF8String]);
+		_keys[i] = GTChangedPathKeyMake(_UTF8Paths[i], strlen(_UTF8Paths[i]));
+		if (_UTF8Paths[i][0] == '\0') _includesRoot = YES;
+	}
+
+	return self;
+}
+
+- (BOOL)enumerateCommitsFromOID:(GTOID *)oid error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, BOOL *stop))block {
+	NSParameterAssert(oid != nil);
+	NSParameterAssert(block != nil);
+
+	self.treeComparisonCount = 0;
+	self.filterRejectionCount = 0;
+
+	GTCommitGraph *graph = [self.repository walkableCommitGraphWithError:error];
+	if (graph == nil) return NO;
+
+	// The filters don't record the root itself as changing.
+	GTChangedPathIndex *index = (_includesRoot ? nil : self.repository.changedPathIndex);
+
+	[graph lock];
+
+	GTCommitGraphPosition start = [graph addGitOid:oid.git_oid error:error];
+	if (start == GTCommitGraphPositionNotFound) {
+		[graph unlock];
+		return NO;
+	}
+
+	// Everything reachable from the start was added along with it, so the
+	// graph won't grow during the walk.
+	NSUInteger graphCount = graph.positionCount;
+	uint8_t *queued = calloc(graphCount, sizeof(*queued));
+	GTPathWalkQueueEntry *queue = malloc(graphCount * sizeof(*queue));
+	NSUInteger queueCount = 0;
+
+	queued[start] = 1;
+	GTPathWalkQueuePush(queue, &queueCount, (GTPathWalkQueueEntry){ [graph commitTimeAtPosition:start], [graph generationAtPosition:start], start });
+
+	BOOL success = YES;
+	while (queueCount > 0) {
+		GTCommitGraphPosition position = GTPathWalkQueuePop(queue, &queueCount).position;
+		git_oid commitOid = *[graph gitOidAtPosition:position];
+		git_oid tree = *[graph treeGitOidAtPosition:position];
+
+		NSUInteger parentCount = 0;
+		const GTCommitGraphPosition *parents = [graph parentPositionsAtPosition:position count:&parentCount];
+
+		// Find the first parent with the same contents at the paths. If there is
+		// one, only its history matters, and this commit didn't change anything.
+		BOOL changed = NO;
+		NSUInteger sameParent = NSNotFound;
+		if (parentCount == 0) {
+			BOOL same = NO;
+			success = [self tree:&tree isSameAsTree:NULL same:&same error:error];
+			changed = !same;
+		} else {
+			for (NSUInteger i = 0; i < parentCount && success; i++) {
+				BOOL same = NO;
+				if (i == 0 && index != nil && [index filterResultForGitOid:&commitOid keys:_keys count:_pathCount] == GTChangedPathFilterResultDefinitelyNot) {
+					self.filterRejectionCount++;
+					same = YES;
+				} else {
+					git_oid parentTree = *[graph treeGitOidAtPosition:parents[i]];
+					success = [self tree:&tree isSameAsTree:&parentTree same:&same error:error];
+				}
+
+				if (same) {
+					sameParent = i;
+					break;
+				}
+			}
+
+			changed = (sameParent == NSNotFound);
+		}
+
+		if (!success) break;
+
+		for (NSUInteger i = 0; i < parentCount; i++) {
+			if (sameParent != NSNotFound && i != sameParent) continue;
+			if (queued[parents[i]]) continue;
+
+			queued[parents[i]] = 1;
+			GTPathWalkQueuePush(queue, &queueCount, (GTPathWalkQueueEntry){ [graph commitTimeAtPosition:parents[i]], [graph generationAtPosition:parents[i]], parents[i] });
+		}
+
+		if (!changed) continue;
+
+		// Don't hold the graph's lock while running someone else's code.
+		[graph unlock];
+
+		BOOL stop = NO;
+		GTCommit *commit = (GTCommit *)[self.repository lookupObjectByOid:&commitOid objectType:GTObjectTypeCommit error:error];
+		if (commit == nil) {
+			success = NO;
+		} else {
+			block(commit, &stop);
+		}
+
+		[graph lock];
+
+		if (!success || stop) break;
+	}
+
+	free(queued);
+	free(queue);
+
+	[graph unlock];
+
+	return success;
+}
+
+#pragma mark Trees
+
+// Compares the entries at the paths in two trees. A NULL tree is empty.
+- (BOOL)tree:(const git_oid *)treeOid isSameAsTree:(const git_oid *)otherTreeOid same:(BOOL *)same error:(NSError **)error {
+	if (otherTreeOid != NULL && git_oid_cmp(treeOid, otherTreeOid) == 0) {
+		*same = YES;
+		return YES;
+	}
+
+	self.treeComparisonCount++;
+
+	git_repository *repository = self.repository.git_repository;
+	git_tree *tree = NULL;
+	git_tree *otherTree = NULL;
+	int gitError = git_tree_lookup(&tree, repository, treeOid);
+	if (gitError == GIT_OK && otherTreeOid != NULL) gitError = git_tree_lookup(&otherTree, repository, otherTreeOid);
+
+	BOOL isSame = YES;
+	for (NSUInteger i = 0; i < _pathCount && gitError == GIT_OK && isSame; i++) {
+		if (_UTF8Paths[i][0] == '\0') {
+			// The trees differ, so the root does, unless it's an empty tree
+			// compared to nothing.
+			isSame = (otherTree == NULL && git_tree_entrycount(tree) == 0);
+			continue;
+		}
+
+		git_tree_entry *entry = NULL;
+		git_tree_entry *otherEntry = NULL;
+
+		gitError = git_tree_entry_bypath(&entry, tree, _UTF8Paths[i]);
+		if (gitError == GIT_ENOTFOUND) gitError = GIT_OK;
+
+		if (gitError == GIT_OK && otherTree != NULL) {
+			gitError = git_tree_entry_bypath(&otherEntry, otherTree, _UTF8Paths[i]);
+			if (gitError == GIT_ENOTFOUND) gitError = GIT_OK;
+		}
+
+		if (entry == NULL || otherEntry == NULL) {
+			isSame = (entry == NULL && otherEntry == NULL);
+		} else {
+			isSame = git_oid_cmp(git_tree_entry_id(entry), git_tree_entry_id(otherEntry)) == 0 && git_tree_entry_filemode(entry) == git_tree_entry_filemode(otherEntry);
+		}
+
+		git_tree_entry_free(entry);
+		git_tree_entry_free(otherEntry);
+	}
+
+	git_tree_free(tree);
+	git_tree_free(otherTree);
+
+	if (gitError < GIT_OK) {
+		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to compare trees."];
+		return NO;
+	}
+
+	*same = isSame;
+	return YES;
+}
+
+@end
@@ -0,0 +1,76 @@
+//
+//  GTPipeline.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Runs a producer on the calling thread, a pool of workers transforming what
+// it produces, and a consumer receiving the results.
+//
+// The producer is called serially. Each input gets an index in the order it
+// was produced, and is handed to whichever worker is free. When the pipeline
+// is ordered, results are held in a reorder buffer and the consumer is called
+// serially in index order. Otherwise the consumer is called on the worker
+// that produced the result, as soon as it's ready, and so concurrently.
+//
+// When `maximumPendingCount` isn't 0, the producer blocks once that many inputs
+// are waiting for, or being processed by, a worker or waiting to be consumed,
+// so a slow consumer pushes back on the producer instead of results piling up.
+//
+// Stopping (from the consumer) or an error (from any stage) stops the producer,
+// and the remaining inputs are dropped without being processed. No new calls
+// are made to the consumer once it has stopped, though when unordered, calls
+// already under way on other workers still finish.
+@interface GTPipeline : NSObject
+
+// The number of workers.
+@property (nonatomic, readonly) NSUInteger workerCount;
+
+// The most inputs which may be pending at once, or 0 for no limit.
+@property (nonatomic, readonly) NSUInteger maximumPendingCount;
+
+// Whether the consumer receives results in the order the inputs were produced.
+@property (nonatomic, readonly, getter = isOrdered) BOOL ordered;
+
+// Whether to run every stage on the calling thread instead, one input at a
+// time, as a single worker, for when there's nothing to run workers with.
+// Results are then always delivered in order. Defaults to NO.
+@property (nonatomic, assign) BOOL runsOnCallingThread;
+
+// Called on each worker before it processes anything, to create a context to
+// pass to the work block, like a repository handle. Return nil and fill
+// `error` to fail. May be nil.
+@property (nonatomic, copy) id (^workerSetUpBlock)(NSError **error);
+
+// Called on each worker once it's done, with the context returned by
+// `workerSetUpBlock`. May be nil.
+@property (nonatomic, copy) void (^workerTearDownBlock)(id context);
+
+// Designated initializer.
+//
+// workerCount         - The number of workers. Must be at least 1.
+// maximumPendingCount - The most inputs which may be pending at once, or 0
+//                       for no limit.
+// ordered             - Whether to deliver results in order.
+- (id)initWithWorkerCount:(NSUInteger)workerCount maximumPendingCount:(NSUInteger)maximumPendingCount ordered:(BOOL)ordered;
+
+// Run the pipeline until the producer is done, the consumer stops, or an error
+// occurs.
+//
+// producer   - Returns the next input, or nil when there are no more. Fill
+//              `error` when returning nil because of an error. Cannot be nil.
+// worker     - Transforms an input into a result, using the worker's context.
+//              Return nil and fill `error` to fail. Cannot be nil.
+// consumer   - Receives each result and its input's index. Cannot be nil.
+// error(out) - will be filled if an error occurs. When several inputs fail,
+//              it's the error for the lowest index. A stage which fails
+//              without filling in its error gets a generic one.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)runWithProducer:(id (^)(NSError **error))producer worker:(id (^)(id input, id context, NSError **error))worker consumer:(void (^)(id result, NSUInteger index, BOOL *stop))consumer error:(NSError **)error;
+
+@end
@@ -0,0 +1,300 @@
+//
+//  GTPipeline.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTPipeline.h"
+#import "NSError+Git.h"
+#import "git2.h"
+
+// For stages which fail without saying why.
+static NSError *GTPipelineUnexplainedError(void) {
+	return [NSError errorWithDomain:GTGitErrorDomain code:GITERR_INVALID userInfo:@{ NSLocalizedDescriptionKey: NSLocalizedString(@"A pipeline stage failed without an error.", @"") }];
+}
+
+@implementation GTPipeline
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> workerCount: %lu, maximumPendingCount: %lu, ordered: %i", NSStringFromClass([self class]), self, (unsigned long)self.workerCount, (unsigned long)self.maximumPendingCount, (int)self.ordered];
+}
+
+#pragma mark API
+
+- (id)initWithWorkerCount:(NSUInteger)workerCount maximumPendingCount:(NSUInteger)maximumPendingCount ordered:(BOOL)ordered {
+	NSParameterAssert(workerCount > 0);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_workerCount = workerCount;
+	_maximumPendingCount = maximumPendingCount;
+	_ordered = ordered;
+
+	return self;
+}
+
+- (BOOL)runWithProducer:(id (^)(NSError **error))producer worker:(id (^)(id input, id context, NSError **error))worker consumer:(void (^)(id result, NSUInteger index, BOOL *stop))consumer error:(NSError **)error {
+	NSParameterAssert(producer != nil);
+	NSParameterAssert(worker != nil);
+	NSParameterAssert(consumer != nil);
+
+	if (self.runsOnCallingThread) return [self runOnCallingThreadWithProducer:producer worker:worker consumer:consumer error:error];
+
+	// Guards everything below, and wakes workers when there's input.
+	NSCondition *condition = [[NSCondition alloc] init];
+
+	NSMutableArray *inputs = [NSMutableArray array];
+	__block NSUInteger dequeuedCount = 0;
+	__block BOOL producerFinished = NO;
+	__block BOOL stopped = NO;
+	__block NSError *firstError = nil;
+	__block NSUInteger firstErrorIndex = NSNotFound;
+
+	// Results waiting for the ones before them, when ordered.
+	NSMutableDictionary *reorderBuffer = [NSMutableDictionary dictionary];
+	__block NSUInteger nextDeliveryIndex = 0;
+	__block BOOL delivering = NO;
+
+	// The producer takes a slot per input, and it's given back once the input
+	// has been consumed or dropped.
+	dispatch_semaphore_t slots = (self.maximumPendingCount > 0 ? dispatch_semaphore_create((long)self.maximumPendingCount) : NULL);
+	__block NSInteger slotsTaken = 0;
+
+	// These must be called with the condition locked.
+	void (^releaseSlot)(void) = ^{
+		if (slots == NULL) return;
+
+		slotsTaken--;
+		dispatch_semaphore_signal(slots);
+	};
+
+	void (^stopLocked)(void) = ^{
+		if (stopped) return;
+
+		stopped = YES;
+
+		// Wake the producer if it's waiting for a slot, so it sees the stop.
+		releaseSlot();
+	};
+
+	void (^failLocked)(NSError *, NSUInteger) = ^(NSError *failure, NSUInteger index) {
+		// A block which failed without saying why still has to fail the run.
+		if (failure == nil) failure = GTPipelineUnexplainedError();
+
+		if (firstErrorIndex == NSNotFound || index < firstErrorIndex) {
+			firstErrorIndex = index;
+			firstError = failure;
+		}
+
+		stopLocked();
+	};
+
+	// Delivers results from the reorder buffer for as long as the next one is
+	// there. Only one worker delivers at a time.
+	void (^deliverLocked)(void) = ^{
+		if (delivering) return;
+
+		delivering = YES;
+		while (!stopped) {
+			id result = reorderBuffer[@(nextDeliveryIndex)];
+			if (result == nil) break;
+
+			[reorderBuffer removeObjectForKey:@(nextDeliveryIndex)];
+			NSUInteger index = nextDeliveryIndex++;
+
+			[condition unlock];
+			BOOL stop = NO;
+			consumer(result, index, &stop);
+			[condition lock];
+
+			releaseSlot();
+			if (stop) stopLocked();
+		}
+
+		delivering = NO;
+	};
+
+	id (^workerSetUpBlock)(NSError **) = self.workerSetUpBlock;
+	void (^workerTearDownBlock)(id) = self.workerTearDownBlock;
+	BOOL ordered = self.ordered;
+
+	dispatch_block_t workerLoop = ^{
+		id context = nil;
+		if (workerSetUpBlock != nil) {
+			NSError *setUpError = nil;
+			context = workerSetUpBlock(&setUpError);
+			if (context == nil) {
+				[condition lock];
+				failLocked(setUpError, 0);
+				[condition unlock];
+			}
+		}
+
+		while (YES) {
+			@autoreleasepool {
+				[condition lock];
+				while (inputs.count == 0 && !producerFinished) {
+					[condition wait];
+				}
+
+				if (inputs.count == 0) {
+					[condition unlock];
+					break;
+				}
+
+				id input = inputs[0];
+				[inputs removeObjectAtIndex:0];
+				NSUInteger index = dequeuedCount++;
+
+				// Keep draining after a stop, so the producer's slots are given
+				// back, but don't do the work.
+				if (stopped) {
+					releaseSlot();
+					[condition unlock];
+					continue;
+				}
+
+				[condition unlock];
+
+				NSError *workError = nil;
+				id result = worker(input, context, &workError);
+
+				[condition lock];
+				if (result == nil) {
+					failLocked(workError, index);
+					releaseSlot();
+				} else if (stopped) {
+					releaseSlot();
+				} else if (ordered) {
+					reorderBuffer[@(index)] = result;
+					deliverLocked();
+				} else {
+					[condition unlock];
+					BOOL stop = NO;
+					consumer(result, index, &stop);
+					[condition lock];
+
+					releaseSlot();
+					if (stop) stopLocked();
+				}
+
+				[condition unlock];
+			}
+		}
+
+		if (context != nil && workerTearDownBlock != nil) workerTearDownBlock(context);
+	};
+
+	dispatch_group_t group = dispatch_group_create();
+	dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+	for (NSUInteger i = 0; i < self.workerCount; i++) {
+		dispatch_group_async(group, queue, workerLoop);
+	}
+
+	NSUInteger producedCount = 0;
+	while (YES) {
+		@autoreleasepool {
+			if (slots != NULL) dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+
+			[condition lock];
+			if (slots != NULL) slotsTaken++;
+			BOOL shouldStop = stopped;
+			[condition unlock];
+
+			if (shouldStop) break;
+
+			NSError *producerError = nil;
+			id input = producer(&producerError);
+			if (input == nil) {
+				if (producerError != nil) {
+					[condition lock];
+					failLocked(producerError, producedCount);
+					[condition unlock];
+				}
+
+				break;
+			}
+
+			[condition lock];
+			[inputs addObject:input];
+			producedCount++;
+			[condition signal];
+			[condition unlock];
+		}
+	}
+
+	[condition lock];
+	producerFinished = YES;
+	[condition broadcast];
+	[condition unlock];
+
+	dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+	dispatch_release(group);
+
+	if (slots != NULL) {
+		// A semaphore can't be released with a lower value than it started with.
+		while (slotsTaken > 0) {
+			slotsTaken--;
+			dispatch_semaphore_signal(slots);
+		}
+
+		dispatch_release(slots);
+	}
+
+	if (firstErrorIndex != NSNotFound) {
+		if (error != NULL) *error = firstError;
+		return NO;
+	}
+
+	return YES;
+}
+
+#pragma mark Calling Thread
+
+- (BOOL)runOnCallingThreadWithProducer:(id (^)(NSError **error))producer worker:(id (^)(id input, id context, NSError **error))worker consumer:(void (^)(id result, NSUInteger index, BOOL *stop))consumer error:(NSError **)error {
+	NSError *failure = nil;
+	id context = nil;
+	if (self.workerSetUpBlock != nil) {
+		context = self.workerSetUpBlock(&failure);
+		if (context == nil) {
+			if (error != NULL) *error = failure ?: GTPipelineUnexplainedError();
+			return NO;
+		}
+	}
+
+	BOOL success = YES;
+	BOOL stop = NO;
+	for (NSUInteger index = 0; success && !stop; index++) {
+		@autoreleasepool {
+			NSError *stageError = nil;
+			id input = producer(&stageError);
+			if (input == nil) {
+				if (stageError != nil) {
+					failure = stageError;
+					success = NO;
+				}
+
+				break;
+			}
+
+			id result = worker(input, context, &stageError);
+			if (result == nil) {
+				failure = stageError ?: GTPipelineUnexplainedError();
+				success = NO;
+				break;
+			}
+
+			consumer(result, index, &stop);
+		}
+	}
+
+	if (context != nil && self.workerTearDownBlock != nil) self.workerTearDownBlock(context);
+
+	if (!success && error != NULL) *error = failure;
+	return success;
+}
+
+@end
@@ -38,6 +38,7 @@ typedef enum {
 } GTReferenceTypes;
 
 @class GTRepository;
+@class GTOID;
 
 
 @interface GTReference : NSObject <GTObject> {}
@@ -55,6 +56,10 @@ typedef enum {
 + (id)referenceByCreatingReferenceNamed:(NSString *)refName fromReferenceTarget:(NSString *)target inRepository:(GTRepository *)theRepo error:(NSError **)error;
 - (id)initByCreatingReferenceNamed:(NSString *)refName fromReferenceTarget:(NSString *)target inRepository:(GTRepository *)theRepo error:(NSError **)error;
 
+// Create a direct reference pointing at the given OID.
++ (id)referenceByCreatingReferenceNamed:(NSString *)refName fromReferenceTargetOID:(GTOID *)targetOID inRepository:(GTRepository *)theRepo error:(NSError **)error;
+- (id)initByCreatingReferenceNamed:(NSString *)refName fromReferenceTargetOID:(GTOID *)targetOID inRepository:(GTRepository *)theRepo error:(NSError **)error;
+
 + (id)referenceByResolvingSymbolicReference:(GTReference *)symbolicRef error:(NSError **)error;
 - (id)initByResolvingSymbolicReference:(GTReference *)symbolicRef error:(NSError **)error;
 
@@ -62,6 +67,18 @@ typedef enum {
 
 - (NSString *)target;
 - (BOOL)setTarget:(NSString *)newTarget error:(NSError **)error;
+
+// The OID the reference points at, or nil if the reference is symbolic or
+// invalid.
+- (GTOID *)targetOID;
+
+// Point a direct reference at a new OID.
+//
+// newTargetOID - The OID to point at. Cannot be nil.
+// error(out)   - will be filled if an error occurs
+//
+// returns YES if the target was changed.
+- (BOOL)setTargetOID:(GTOID *)newTargetOID error:(NSError **)error;
 - (NSString *)name;
 - (BOOL)setName:(NSString *)newName error:(NSError **)error;
 
@@ -27,6 +27,7 @@
 #import "GTRepository.h"
 #import "NSError+Git.h"
 #import "NSString+Git.h"
+#import "GTOID.h"
 
 @interface GTReference ()
 @property (nonatomic, readwrite) git_reference *git_reference;
@@ -61,6 +62,10 @@
 	return [[self alloc] initByCreatingReferenceNamed:refName fromReferenceTarget:target inRepository:theRepo error:error];
 }
 
++ (id)referenceByCreatingReferenceNamed:(NSString *)refName fromReferenceTargetOID:(GTOID *)targetOID inRepository:(GTRepository *)theRepo error:(NSError **)error {
+	return [[self alloc] initByCreatingReferenceNamed:refName fromReferenceTargetOID:targetOID inRepository:theRepo error:error];
+}
+
 + (id)referenceByResolvingSymbolicReference:(GTReference *)symbolicRef error:(NSError **)error {	
 	return [[self alloc] initByResolvingSymbolicReference:symbolicRef error:error];
 }
@@ -108,6 +113,21 @@
 	return self;
 }
 
+- (id)initByCreatingReferenceNamed:(NSString *)refName fromReferenceTargetOID:(GTOID *)targetOID inRepository:(GTRepository *)theRepo error:(NSError **)error {
+	NSParameterAssert(targetOID != nil);
+	
+	if((self = [super init])) {
+		self.repository = theRepo;
+		int gitError = git_reference_create(&git_reference, self.repository.git_repository, [refName UTF8String], targetOID.git_oid, 0);
+		if(gitError < GIT_OK) {
+			if(error != NULL)
+				*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to create reference."];
+			return nil;
+		}
+	}
+	return self;
+}
+
 - (id)initByResolvingSymbolicReference:(GTReference *)symbolicRef error:(NSError **)error {
 	if((self = [super init])) {
 		int gitError = git_reference_resolve(&git_reference, symbolicRef.git_reference);
@@ -211,6 +231,33 @@
 	return YES;
 }
 
+- (GTOID *)targetOID {
+	if(![self isValid]) return nil;
+	if(git_reference_type(self.git_reference) != GIT_REF_OID) return nil;
+	
+	return [GTOID oidWithGitOid:git_reference_target(self.git_reference)];
+}
+
+- (BOOL)setTargetOID:(GTOID *)newTargetOID error:(NSError **)error {
+	NSParameterAssert(newTargetOID != nil);
+	
+	if(![self isValid]) {
+		if(error != NULL) {
+			*error = [[self class] invalidReferenceError];
+		}
+		
+		return NO;
+	}
+	
+	int gitError = git_reference_set_target(self.git_reference, newTargetOID.git_oid);
+	if(gitError < GIT_OK) {
+		if(error != NULL)
+			*error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to set reference target."];
+		return NO;
+	}
+	return YES;
+}
+
 - (BOOL)deleteWithError:(NSError **)error {
 	if(![self isValid]) {
 		if(error != NULL) {
@@ -9,9 +9,60 @@
 #import "GTRepository.h"
 
 @class GTEnumerator;
+@class GTRepositoryPool;
+@class GTPipeline;
+@class GTCommitGraph;
 
 @interface GTRepository ()
 
+// Extra handles on this repository for reading it from other threads, opened
+// the first time they're needed, or nil if the repository has no git directory
+// to open them on.
+//
+// A parsed libgit2 object never goes back to the handle it was read through,
+// since nothing asks for its owner, so objects read on a handle may be handed
+// out as belonging to the receiver, and outlive the handle's checkout. Only
+// objects read through the receiver itself go into its `objectCache` though.
+@property (nonatomic, readonly, strong) GTRepositoryPool *readerPool;
+
+// Returns `readerPool`, or nil if there isn't one or the calling thread is
+// holding one of its handles, like a worker calling a block handed to one of
+// the concurrent methods. Then the caller should read through the receiver on
+// the calling thread instead, rather than wait for handles which the block's
+// caller may be holding.
+- (GTRepositoryPool *)readerPoolForCurrentThread;
+
+// A pipeline whose workers each read the repository through a handle from
+// `readerPool`, which is the context passed to the work block.
+//
+// When -readerPoolForCurrentThread is nil, the pipeline runs on the calling
+// thread instead, and the context is the receiver.
+//
+// pendingCountPerWorker - How many inputs may be pending per worker, or 0 for
+//                         no limit.
+// ordered               - Whether to deliver results in order.
+- (GTPipeline *)readerPipelineWithPendingCountPerWorker:(NSUInteger)pendingCountPerWorker ordered:(BOOL)ordered;
+
+// Finished blames, keyed by commit SHA and path, so blaming a file again at a
+// later commit can stop where the earlier blame started, and how files changed
+// between commits and their parents, so blames of related commits don't diff
+// them again. See GTBlame.m.
+@property (nonatomic, readonly, strong) NSCache *blameCache;
+
+// Sketches of blobs' contents, keyed by their GTOIDs, for finding renames.
+@property (nonatomic, readonly, strong) NSCache *blobSketchCache;
+
+// The OIDs of the commits every reference leads to. References to trees or
+// blobs are skipped.
+- (NSArray *)referencedCommitOIDsWithError:(NSError **)error;
+
+// The commit graph, or if there isn't one, an in-memory graph which reads
+// commits as they're needed, for walks that work on graph positions.
+//
+// The in-memory graph is kept and returned again by later calls, so commits it
+// has read are never read twice, until a commit graph is written.
+- (GTCommitGraph *)walkableCommitGraphWithError:(NSError **)error;
+
 - (void)addEnumerator:(GTEnumerator *)enumerator;
 - (void)removeEnumerator:(GTEnumerator *)enumerator;
 
@@ -38,6 +38,15 @@
 @class GTIndex;
 @class GTBranch;
 @class GTConfiguration;
+@class GTObjectCache;
+@class GTOID;
+@class GTCommitGraph;
+@class GTCommitCountCache;
+@class GTAheadBehindMatrix;
+@class GTChangedPathIndex;
+@class GTAuthorIndex;
+@class GTCommitMessageIndex;
+@class GTDiffCache;
 
 // Options returned from the enumerateFileStatusUsingBlock: function
 enum {
@@ -69,10 +78,38 @@ typedef void (^GTRepositoryStatusBlock)(NSURL *fileURL, GTRepositoryFileStatus s
 @property (nonatomic, readonly, strong) NSURL *fileURL;
 // The file URL for the repository's .git directory.
 @property (nonatomic, readonly, strong) NSURL *gitDirectoryURL;
-@property (nonatomic, readonly, strong) GTEnumerator *enumerator; // should only be used on the main thread
+// A shared enumerator, which should only be used on the main thread. The
+// convenience methods on GTRepository and GTBranch create their own
+// enumerators, so they can be called from any thread.
+@property (nonatomic, readonly, strong) GTEnumerator *enumerator;
 @property (nonatomic, readonly, strong) GTIndex *index;
 @property (nonatomic, readonly, strong) GTObjectDatabase *objectDatabase;
 @property (nonatomic, readonly, strong) GTConfiguration *configuration;
+// The cache of objects looked up in this repository. Looking up an object that
+// is in the cache returns the existing `GTObject` instead of creating a new one.
+@property (nonatomic, readonly, strong) GTObjectCache *objectCache;
+// The repository's commit graph, loaded the first time it's asked for. Commit
+// counts and merge bases are computed from it when it exists. This is nil if
+// no graph has been written (see -writeCommitGraphWithError:) or the graph
+// file could not be read.
+@property (nonatomic, readonly, strong) GTCommitGraph *commitGraph;
+// The repository's changed path index, loaded the first time it's asked for.
+// Path limited walks use it to skip most tree comparisons. This is nil if no
+// index has been written (see -writeChangedPathIndexWithError:) or the index
+// file could not be read.
+@property (nonatomic, readonly, strong) GTChangedPathIndex *changedPathIndex;
+// The repository's author index, loaded the first time it's asked for. This is
+// nil if no index has been written (see -writeAuthorIndexWithError:) or the
+// index file could not be read.
+@property (nonatomic, readonly, strong) GTAuthorIndex *authorIndex;
+// The repository's commit message index, loaded the first time it's asked for.
+// This is nil if no index has been written (see
+// -writeCommitMessageIndexWithError:) or the index file could not be read.
+@property (nonatomic, readonly, strong) GTCommitMessageIndex *commitMessageIndex;
+// The cache of branch commit counts, persisted in the git directory.
+@property (nonatomic, readonly, strong) GTCommitCountCache *commitCountCache;
+// The cache of tree-to-tree diffs, persisted in the git directory.
+@property (nonatomic, readonly, strong) GTDiffCache *diffCache;
 @property (nonatomic, readonly, getter=isBare) BOOL bare; // Is this a 'bare' repository?  i.e. created with git clone --bare
 @property (nonatomic, readonly, getter=isEmpty) BOOL empty; // Is this repository empty? Will only be YES for a freshly `git init`'d repo.
 @property (nonatomic, readonly, getter=isHeadDetached) BOOL headDetached; // Is HEAD detached? i.e., not pointing to any permanent ref.
@@ -104,10 +141,46 @@ typedef void (^GTRepositoryStatusBlock)(NSURL *fileURL, GTRepositoryFileStatus s
 + (NSString *)hash:(NSString *)data objectType:(GTObjectType)type error:(NSError **)error;
 
 // Lookup objects in the repo by oid or sha1
-- (GTObject *)lookupObjectByOid:(git_oid *)oid objectType:(GTObjectType)type error:(NSError **)error;
-- (GTObject *)lookupObjectByOid:(git_oid *)oid error:(NSError **)error;
+//
+// Objects are looked up in the `objectCache` first, so repeated lookups of the
+// same object return the same `GTObject`.
+- (GTObject *)lookupObjectByOid:(const git_oid *)oid objectType:(GTObjectType)type error:(NSError **)error;
+- (GTObject *)lookupObjectByOid:(const git_oid *)oid error:(NSError **)error;
 - (GTObject *)lookupObjectBySha:(NSString *)sha objectType:(GTObjectType)type error:(NSError **)error;
 - (GTObject *)lookupObjectBySha:(NSString *)sha error:(NSError **)error;
+- (GTObject *)lookupObjectByOID:(GTOID *)oid objectType:(GTObjectType)type error:(NSError **)error;
+- (GTObject *)lookupObjectByOID:(GTOID *)oid error:(NSError **)error;
+
+// Lookup many objects at once.
+//
+// Objects which aren't already in the `objectCache` are read from the object
+// database in parallel, each worker using its own handle on the repository,
+// so the cost of inflating and resolving deltas is spread across all cores.
+// Objects read that way aren't added to the cache, which only holds objects
+// read through the receiver's own handle.
+//
+// oids       - An array of GTOIDs to look up. Cannot be nil.
+// type       - The type each object is expected to have, or GTObjectTypeAny.
+// error(out) - will be filled if an error occurs
+//
+// returns the objects in the same order as `oids`, or nil if any lookup failed.
+- (NSArray *)lookupObjectsWithOIDs:(NSArray *)oids objectType:(GTObjectType)type error:(NSError **)error;
+
+// Lookup many objects at once, streaming them to a block.
+//
+// This works like -lookupObjectsWithOIDs:objectType:error:, but looks the
+// objects up in batches so that the block can start working on the first ones
+// while the rest are still being read. The block is always called on the
+// calling thread, in the same order as `oids`.
+//
+// oids       - An array of GTOIDs to look up. Cannot be nil.
+// type       - The type each object is expected to have, or GTObjectTypeAny.
+// error(out) - will be filled if an error occurs
+// block      - Called with each object and its index in `oids`. Setting `stop`
+//              to YES stops the lookup. Cannot be nil.
+//
+// returns NO if a lookup failed, YES otherwise.
+- (BOOL)enumerateObjectsWithOIDs:(NSArray *)oids objectType:(GTObjectType)type error:(NSError **)error usingBlock:(void (^)(GTObject *object, NSUInteger index, BOOL *stop))block;
 
 // Lookup an object in the repo using a revparse spec
 - (GTObject *)lookupObjectByRefspec:(NSString *)spec error:(NSError **)error;
@@ -132,11 +205,93 @@ typedef void (^GTRepositoryStatusBlock)(NSURL *fileURL, GTRepositoryFileStatus s
 // returns nil if an error occurred and fills the error parameter
 - (NSArray *)referenceNamesWithError:(NSError **)error;
 
+// Create a new enumerator which starts at a commit. Unlike `enumerator`, the
+// enumerator is the caller's own, so it can be given limits (see
+// GTEnumerator's `sinceDate`, `maximumCount` and friends) without affecting
+// anyone else.
+//
+// sha        - The commit to start at, or nil to start at HEAD.
+// options    - The order to enumerate commits in.
+// error(out) - will be filled if an error occurs
+//
+// returns the enumerator, or nil if an error occurred.
+- (GTEnumerator *)enumeratorBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options error:(NSError **)error;
+
 - (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options error:(NSError **)error usingBlock:(void (^)(GTCommit *, BOOL *))block;
 - (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha error:(NSError **)error usingBlock:(void (^)(GTCommit *, BOOL *))block;
 
+// Enumerate the commits made between two dates.
+//
+// When sorting by time, the walk ends soon after it passes `sinceDate`,
+// rather than going through the whole history. See -[GTEnumerator sinceDate].
+//
+// sha        - The commit to start at, or nil to start at HEAD.
+// options    - The order to enumerate commits in.
+// sinceDate  - The earliest commit date to enumerate, or nil for no limit.
+// untilDate  - The latest commit date to enumerate, or nil for no limit.
+// error(out) - will be filled if an error occurs
+// block      - The block to call with each commit. Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options sinceDate:(NSDate *)sinceDate untilDate:(NSDate *)untilDate error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, BOOL *stop))block;
+
+// Enumerate commits as lightweight GTCommitRecords, in batches, instead of
+// creating a GTCommit for each one.
+//
+// sha        - The commit to start at, or nil to start at HEAD.
+// options    - The order to enumerate commits in.
+// error(out) - will be filled if an error occurs
+// block      - The block to call with each batch of up to
+//              GTCommitRecordDefaultBatchSize records. Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateCommitRecordsBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options error:(NSError **)error usingBlock:(GTCommitRecordBlock)block;
+
+// Enumerate commits on a pool of worker threads while this thread walks the
+// history. See -[GTEnumerator enumerateCommitsConcurrentlyWithOptions:error:usingBlock:].
+//
+// sha                - The commit to start at, or nil to start at HEAD.
+// options            - The order to walk commits in.
+// concurrencyOptions - How to deliver commits to the block.
+// error(out)         - will be filled if an error occurs
+// block              - The block to call with each commit. Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateCommitsConcurrentlyBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options concurrencyOptions:(GTEnumeratorConcurrencyOptions)concurrencyOptions error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, NSUInteger index, BOOL *stop))block;
+
+// Enumerate the commits which changed any of the given paths, like
+// `git log -- <paths>`.
+//
+// History is simplified the way git simplifies it by default: a commit which
+// has the same contents at the paths as one of its parents isn't enumerated,
+// and for merges, only that parent's history is followed. The repository's
+// changed path index, if any, is used to avoid comparing trees.
+//
+// sha        - The commit to start at, or nil to start at HEAD.
+// paths      - An array of file or directory paths, relative to the root of
+//              the repository. Cannot be nil or empty.
+// error(out) - will be filled if an error occurs
+// block      - The block to call with each commit, newest first. Cannot be nil.
+//
+// returns NO if an error occurred, YES otherwise (including when stopped).
+- (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha touchingPaths:(NSArray *)paths error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, BOOL *stop))block;
+
 - (NSArray *)selectCommitsBeginningAtSha:(NSString *)sha error:(NSError **)error block:(BOOL (^)(GTCommit *commit, BOOL *stop))block;
 
+// Select commits made between two dates, newest first, stopping once enough
+// have been selected.
+//
+// sha          - The commit to start at, or nil to start at HEAD.
+// sinceDate    - The earliest commit date to consider, or nil for no limit.
+// untilDate    - The latest commit date to consider, or nil for no limit.
+// maximumCount - The most commits to select, or 0 for no limit.
+// error(out)   - will be filled if an error occurs
+// block        - The block which decides whether to select each commit. Cannot
+//                be nil.
+//
+// returns the selected commits, or nil if an error occurred.
+- (NSArray *)selectCommitsBeginningAtSha:(NSString *)sha sinceDate:(NSDate *)sinceDate untilDate:(NSDate *)untilDate maximumCount:(NSUInteger)maximumCount error:(NSError **)error block:(BOOL (^)(GTCommit *commit, BOOL *stop))block;
+
 // For each file in the repository calls your block with the URL of the file and the status of that file in the repository,
 //
 // block - the block that gets called for each file
@@ -163,6 +318,40 @@ typedef void (^GTRepositoryStatusBlock)(NSURL *fileURL, GTRepositoryFileStatus s
 // returns number of commits in the current branch or NSNotFound if an error occurred
 - (NSUInteger)numberOfCommitsInCurrentBranch:(NSError **)error;
 
+// Add every commit reachable from a reference to the commit graph, creating
+// the graph if there isn't one yet, and write it to disk.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns YES if the graph was written.
+- (BOOL)writeCommitGraphWithError:(NSError **)error;
+
+// Add every commit reachable from a reference to the changed path index,
+// creating the index if there isn't one yet, and write it to disk.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns YES if the index was written.
+- (BOOL)writeChangedPathIndexWithError:(NSError **)error;
+
+// Add every commit reachable from a reference to the author index, creating
+// the index if there isn't one yet, and write it to disk. Only commits which
+// aren't in the index yet are read.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns YES if the index was written.
+- (BOOL)writeAuthorIndexWithError:(NSError **)error;
+
+// Add every commit reachable from a reference to the commit message index,
+// creating the index if there isn't one yet, and write it to disk. Only commits
+// which aren't in the index yet are read.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns YES if the index was written.
+- (BOOL)writeCommitMessageIndexWithError:(NSError **)error;
+
 // Create a new branch with this name and based off this reference.
 //
 // name - the name for the new branch
@@ -186,6 +375,26 @@ typedef void (^GTRepositoryStatusBlock)(NSURL *fileURL, GTRepositoryFileStatus s
 // returns the local commits, an empty array if there is no remote branch, or nil if an error occurred
 - (NSArray *)localCommitsRelativeToRemoteBranch:(GTBranch *)remoteBranch error:(NSError **)error;
 
+// Calculate how far every local branch has diverged from its tracking branch.
+//
+// All the branches are compared in one traversal of the history, so commits
+// shared by several branches are only visited once. Local branches without a
+// tracking branch are left out.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns the matrix or nil if an error occurred.
+- (GTAheadBehindMatrix *)aheadBehindMatrixForLocalBranchesWithError:(NSError **)error;
+
+// Calculate how far every local branch has diverged from the same base, such
+// as `refs/heads/master`, in one traversal of the history.
+//
+// baseBranch - The branch to compare every local branch to. Cannot be nil.
+// error(out) - will be filled if an error occurs
+//
+// returns the matrix or nil if an error occurred.
+- (GTAheadBehindMatrix *)aheadBehindMatrixForLocalBranchesRelativeToBranch:(GTBranch *)baseBranch error:(NSError **)error;
+
 // Pack all references in the repository.
 //
 // error(out) - will be filled if an error occurs
@@ -39,6 +39,19 @@
 #import "NSString+Git.h"
 #import "GTConfiguration.h"
 #import "GTConfiguration+Private.h"
+#import "GTObjectCache.h"
+#import "GTOID.h"
+#import "GTRepositoryPool.h"
+#import "GTPipeline.h"
+#import "GTCommitGraph.h"
+#import "GTCommitCountCache.h"
+#import "GTAheadBehindMatrix.h"
+#import "GTChangedPathIndex.h"
+#import "GTAuthorIndex.h"
+#import "GTCommitMessageIndex.h"
+#import "GTDiffCache.h"
+#import "GTPathWalk.h"
+#import "GTRepository+Private.h"
 
 @interface GTRepository ()
 @property (nonatomic, assign) git_repository *git_repository;
@@ -47,8 +60,49 @@
 @property (nonatomic, strong) GTObjectDatabase *objectDatabase;
 @property (nonatomic, strong) NSMutableSet *weakEnumerators;
 @property (nonatomic, strong) GTConfiguration *configuration;
+@property (nonatomic, strong) GTObjectCache *objectCache;
+@property (nonatomic, strong) GTRepositoryPool *readerPool;
+@property (nonatomic, strong) NSCache *blameCache;
+@property (nonatomic, strong) NSCache *blobSketchCache;
+@property (nonatomic, strong) GTCommitGraph *commitGraph;
+
+// Whether we've already tried to load `commitGraph`.
+@property (nonatomic, assign) BOOL commitGraphLoaded;
+
+// The in-memory graph -walkableCommitGraphWithError: hands out while there's
+// no commit graph file, kept so history is only read once.
+@property (nonatomic, strong) GTCommitGraph *scratchCommitGraph;
+@property (nonatomic, strong) GTCommitCountCache *commitCountCache;
+@property (nonatomic, strong) GTDiffCache *diffCache;
+@property (nonatomic, strong) GTChangedPathIndex *changedPathIndex;
+
+// Whether we've already tried to load `changedPathIndex`.
+@property (nonatomic, assign) BOOL changedPathIndexLoaded;
+@property (nonatomic, strong) GTAuthorIndex *authorIndex;
+
+// Whether we've already tried to load `authorIndex`.
+@property (nonatomic, assign) BOOL authorIndexLoaded;
+
+@property (nonatomic, strong) GTCommitMessageIndex *commitMessageIndex;
+
+// Whether we've already tried to load `commitMessageIndex`.
+@property (nonatomic, assign) BOOL commitMessageIndexLoaded;
+
+// The commit HEAD points at, or nil with an error if there's no such commit,
+// as when HEAD is unborn.
+- (GTOID *)headOIDWithError:(NSError **)error;
+
+// Like -headOIDWithError:, for a HEAD which has already been resolved.
+- (GTOID *)targetOIDOfHeadReference:(GTReference *)head error:(NSError **)error;
 @end
 
+// The number of objects each worker looks up per batch in
+// -enumerateObjectsWithOIDs:objectType:error:usingBlock:.
+static const NSUInteger GTRepositoryLookupBatchSizePerWorker = 64;
+
+// The most bytes of blob sketches to keep cached.
+static const NSUInteger GTRepositoryBlobSketchCacheCostLimit = 32 * 1024 * 1024;
+
 @implementation GTRepository
 
 - (NSString *)description {
@@ -69,6 +123,11 @@
 		self.configuration.repository = nil;
 	}
 
+	// Cached objects hold on to git_objects owned by our repository (or by the
+	// reader pool, which outlives this method), so they need to go before it
+	// does.
+	[_objectCache removeAllObjects];
+
 	if (self.git_repository != NULL) git_repository_free(self.git_repository);
 }
 
@@ -110,6 +169,10 @@
 	if (self == nil) return nil;
 	
 	self.git_repository = repository;
+	self.objectCache = [[GTObjectCache alloc] init];
+	self.blameCache = [[NSCache alloc] init];
+	self.blobSketchCache = [[NSCache alloc] init];
+	self.blobSketchCache.totalCostLimit = GTRepositoryBlobSketchCacheCostLimit;
 	return self;
 }
 
@@ -131,6 +194,10 @@
 	}
 
 	self.git_repository = r;
+	self.objectCache = [[GTObjectCache alloc] init];
+	self.blameCache = [[NSCache alloc] init];
+	self.blobSketchCache = [[NSCache alloc] init];
+	self.blobSketchCache.totalCostLimit = GTRepositoryBlobSketchCacheCostLimit;
 
 	return self;
 }
@@ -191,7 +258,11 @@ static void transferProgressCallback(const git_transfer_progress *progress, void
 	return [NSString git_stringWithOid:&oid];
 }
 
-- (GTObject *)lookupObjectByOid:(git_oid *)oid objectType:(GTObjectType)type error:(NSError **)error {
+- (GTObject *)lookupObjectByOid:(const git_oid *)oid objectType:(GTObjectType)type error:(NSError **)error {
+	GTObject *cachedObject = [self.objectCache objectForOid:oid];
+	// If the types don't match, let libgit2 come up with the appropriate error.
+	if (cachedObject != nil && (type == GTObjectTypeAny || git_object_type(cachedObject.git_object) == (git_otype)type)) return cachedObject;
+
 	git_object *obj;
 
 	int gitError = git_object_lookup(&obj, self.git_repository, oid, (git_otype) type);
@@ -200,10 +271,13 @@ static void transferProgressCallback(const git_transfer_progress *progress, void
 		return nil;
 	}
 
-    return [GTObject objectWithObj:obj inRepository:self];
+	GTObject *object = [GTObject objectWithObj:obj inRepository:self];
+	[self.objectCache addObject:object];
+
+	return object;
 }
 
-- (GTObject *)lookupObjectByOid:(git_oid *)oid error:(NSError **)error {
+- (GTObject *)lookupObjectByOid:(const git_oid *)oid error:(NSError **)error {
 	return [self lookupObjectByOid:oid objectType:GTObjectTypeAny error:error];
 }
 
@@ -223,6 +297,154 @@ static void transferProgressCallback(const git_transfer_progress *progress, void
 	return [self lookupObjectBySha:sha objectType:GTObjectTypeAny error:error];
 }
 
+- (GTObject *)lookupObjectByOID:(GTOID *)oid objectType:(GTObjectType)type error:(NSError **)error {
+	NSParameterAssert(oid != nil);
+
+	return [self lookupObjectByOid:oid.git_oid objectType:type error:error];
+}
+
+- (GTObject *)lookupObjectByOID:(GTOID *)oid error:(NSError **)error {
+	return [self lookupObjectByOID:oid objectType:GTObjectTypeAny error:error];
+}
+
+- (NSArray *)lookupObjectsWithOIDs:(NSArray *)oids objectType:(GTObjectType)type error:(NSError **)error {
+	NSParameterAssert(oids != nil);
+
+	NSMutableArray *objects = [NSMutableArray arrayWithCapacity:oids.count];
+	BOOL success = [self enumerateObjectsWithOIDs:oids objectType:type error:error usingBlock:^(GTObject *object, NSUInteger index, BOOL *stop) {
+		[objects addObject:object];
+	}];
+
+	return (success ? objects : nil);
+}
+
+- (BOOL)enumerateObjectsWithOIDs:(NSArray *)oids objectType:(GTObjectType)type error:(NSError **)error usingBlock:(void (^)(GTObject *object, NSUInteger index, BOOL *stop))block {
+	NSParameterAssert(oids != nil);
+	NSParameterAssert(block != NULL);
+
+	NSUInteger count = oids.count;
+	if (count == 0) return YES;
+
+	// Without a pool, there's only this handle to look everything up on.
+	GTRepositoryPool *pool = [self readerPoolForCurrentThread];
+	if (pool == nil) {
+		BOOL stop = NO;
+		for (NSUInteger i = 0; i < count && !stop; i++) {
+			GTObject *object = [self lookupObjectByOID:oids[i] objectType:type error:error];
+			if (object == nil) return NO;
+
+			block(object, i, &stop);
+		}
+
+		return YES;
+	}
+
+	NSUInteger workerCount = pool.maximumCount;
+	NSUInteger batchSize = workerCount * GTRepositoryLookupBatchSizePerWorker;
+
+	git_object **gitObjects = calloc(batchSize, sizeof(*gitObjects));
+	NSUInteger *missIndexes = calloc(batchSize, sizeof(*missIndexes));
+	NSMutableArray *batchObjects = [NSMutableArray arrayWithCapacity:batchSize];
+
+	BOOL success = YES;
+	BOOL stop = NO;
+	for (NSUInteger batchStart = 0; batchStart < count && success && !stop; batchStart += batchSize) {
+		NSUInteger batchCount = MIN(batchSize, count - batchStart);
+		NSUInteger missCount = 0;
+
+		[batchObjects removeAllObjects];
+		for (NSUInteger i = 0; i < batchCount; i++) {
+			GTOID *oid = oids[batchStart + i];
+			GTObject *cachedObject = [self.objectCache objectForOid:oid.git_oid];
+			if (cachedObject != nil && (type == GTObjectTypeAny || git_object_type(cachedObject.git_object) == (git_otype)type)) {
+				[batchObjects addObject:cachedObject];
+			} else {
+				[batchObjects addObject:NSNull.null];
+				missIndexes[missCount++] = i;
+			}
+		}
+
+		// Handles are only held for the batch, so the block can read
+		// concurrently too.
+		NSUInteger activeWorkerCount = MIN(workerCount, missCount);
+		NSMutableArray *workers = [NSMutableArray arrayWithCapacity:activeWorkerCount];
+		while (workers.count < activeWorkerCount) {
+			GTRepository *worker = [pool checkOutRepositoryWithError:error];
+			if (worker == nil) {
+				success = NO;
+				break;
+			}
+
+			[workers addObject:worker];
+		}
+
+		// Inflate everything we didn't have cached. Each worker takes the misses
+		// whose position is congruent to its index.
+		__block NSError *workerError = nil;
+		__block NSUInteger workerErrorIndex = NSNotFound;
+		NSObject *workerErrorLock = [[NSObject alloc] init];
+
+		if (success) {
+			dispatch_apply(activeWorkerCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t workerIndex) {
+				git_repository *workerRepository = [workers[workerIndex] git_repository];
+				for (NSUInteger j = workerIndex; j < missCount; j += activeWorkerCount) {
+					NSUInteger i = missIndexes[j];
+					GTOID *oid = oids[batchStart + i];
+
+					int gitError = git_object_lookup(&gitObjects[i], workerRepository, oid.git_oid, (git_otype)type);
+					if (gitError < GIT_OK) {
+						gitObjects[i] = NULL;
+
+						// libgit2's error messages are per-thread, so build the error here.
+						NSError *lookupError = [NSError git_errorFor:gitError withAdditionalDescription:[NSString stringWithFormat:@"Failed to lookup object %@ in repository.", oid.sha]];
+						@synchronized (workerErrorLock) {
+							if (batchStart + i < workerErrorIndex) {
+								workerErrorIndex = batchStart + i;
+								workerError = lookupError;
+							}
+						}
+
+						break;
+					}
+				}
+			});
+		}
+
+		if (workerError != nil) {
+			for (NSUInteger j = 0; j < missCount; j++) {
+				NSUInteger i = missIndexes[j];
+				if (gitObjects[i] != NULL) git_object_free(gitObjects[i]);
+				gitObjects[i] = NULL;
+			}
+
+			if (error != NULL) *error = workerError;
+			success = NO;
+		}
+
+		// The objects are ours as far as everyone else is concerned, but since
+		// they weren't read through this handle, they aren't cached.
+		for (NSUInteger j = 0; j < missCount && success; j++) {
+			NSUInteger i = missIndexes[j];
+			batchObjects[i] = [GTObject objectWithObj:gitObjects[i] inRepository:self];
+			gitObjects[i] = NULL;
+		}
+
+		for (GTRepository *worker in workers) {
+			[pool checkInRepository:worker];
+		}
+
+		for (NSUInteger i = 0; i < batchCount && success; i++) {
+			block(batchObjects[i], batchStart + i, &stop);
+			if (stop) break;
+		}
+	}
+
+	free(gitObjects);
+	free(missIndexes);
+
+	return success;
+}
+
 - (GTObject *)lookupObjectByRefspec:(NSString *)spec error:(NSError **)error {
 	git_object *obj;
 	int gitError = git_revparse_single(&obj, self.git_repository, spec.UTF8String);
@@ -230,25 +452,53 @@ static void transferProgressCallback(const git_transfer_progress *progress, void
 		if (error != NULL) *error = [NSError git_errorFor:gitError withAdditionalDescription:@"Failed to lookup object by refspec."];
 		return nil;
 	}
-	return [GTObject objectWithObj:obj inRepository:self];
+
+	GTObject *cachedObject = [self.objectCache objectForOid:git_object_id(obj)];
+	if (cachedObject != nil) {
+		git_object_free(obj);
+		return cachedObject;
+	}
+
+	GTObject *object = [GTObject objectWithObj:obj inRepository:self];
+	[self.objectCache addObject:object];
+
+	return object;
 }
 
-- (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options error:(NSError **)error usingBlock:(void (^)(GTCommit *, BOOL *))block {
-	NSParameterAssert(block != NULL);
+- (GTEnumerator *)enumeratorBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options error:(NSError **)error {
+	GTEnumerator *enumerator = [GTEnumerator enumeratorWithRepository:self error:error];
+	if (enumerator == nil) return nil;
 
+	[enumerator setOptions:options];
+
+	BOOL success = NO;
 	if (sha == nil) {
-		GTReference *head = [self headReferenceWithError:error];
-		if (head == nil) return NO;
-		sha = head.target;
+		GTOID *headOID = [self headOIDWithError:error];
+		if (headOID == nil) return nil;
+		success = [enumerator pushOID:headOID error:error];
+	} else {
+		success = [enumerator push:sha error:error];
 	}
+	if (!success) return nil;
 
-	[self.enumerator reset];
-	[self.enumerator setOptions:options];
-	BOOL success = [self.enumerator push:sha error:error];
-	if (!success) return NO;
+	return enumerator;
+}
+
+- (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options error:(NSError **)error usingBlock:(void (^)(GTCommit *, BOOL *))block {
+	return [self enumerateCommitsBeginningAtSha:sha sortOptions:options sinceDate:nil untilDate:nil error:error usingBlock:block];
+}
+
+- (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options sinceDate:(NSDate *)sinceDate untilDate:(NSDate *)untilDate error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, BOOL *stop))block {
+	NSParameterAssert(block != NULL);
+
+	GTEnumerator *enumerator = [self enumeratorBeginningAtSha:sha sortOptions:options error:error];
+	if (enumerator == nil) return NO;
+
+	enumerator.sinceDate = sinceDate;
+	enumerator.untilDate = untilDate;
 
 	GTCommit *commit = nil;
-	while ((commit = [self.enumerator nextObjectWithError:error]) != nil) {
+	while ((commit = [enumerator nextObjectWithError:error]) != nil) {
 		BOOL stop = NO;
 		block(commit, &stop);
 		if (stop) break;
@@ -265,6 +515,40 @@ static void transferProgressCallback(const git_transfer_progress *progress, void
 	return [self enumerateCommitsBeginningAtSha:sha sortOptions:GTEnumeratorOptionsTimeSort error:error usingBlock:block];
 }
 
+- (BOOL)enumerateCommitRecordsBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options error:(NSError **)error usingBlock:(GTCommitRecordBlock)block {
+	NSParameterAssert(block != nil);
+
+	GTEnumerator *enumerator = [self enumeratorBeginningAtSha:sha sortOptions:options error:error];
+	if (enumerator == nil) return NO;
+
+	return [enumerator enumerateCommitRecordsWithBatchSize:GTCommitRecordDefaultBatchSize error:error usingBlock:block];
+}
+
+- (BOOL)enumerateCommitsConcurrentlyBeginningAtSha:(NSString *)sha sortOptions:(GTEnumeratorOptions)options concurrencyOptions:(GTEnumeratorConcurrencyOptions)concurrencyOptions error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, NSUInteger index, BOOL *stop))block {
+	NSParameterAssert(block != nil);
+
+	GTEnumerator *enumerator = [self enumeratorBeginningAtSha:sha sortOptions:options error:error];
+	if (enumerator == nil) return NO;
+
+	return [enumerator enumerateCommitsConcurrentlyWithOptions:concurrencyOptions error:error usingBlock:block];
+}
+
+- (BOOL)enumerateCommitsBeginningAtSha:(NSString *)sha touchingPaths:(NSArray *)paths error:(NSError **)error usingBlock:(void (^)(GTCommit *commit, BOOL *stop))block {
+	NSParameterAssert(paths.count > 0);
+	NSParameterAssert(block != nil);
+
+	GTOID *oid = nil;
+	if (sha == nil) {
+		oid = [self headOIDWithError:error];
+	} else {
+		oid = [GTOID oidWithSha:sha error:error];
+	}
+	if (oid == nil) return NO;
+
+	GTPathWalk *walk = [[GTPathWalk alloc] initWithRepository:self paths:paths];
+	return [walk enumerateCommitsFromOID:oid error:error usingBlock:block];
+}
+
 - (NSArray *)selectCommitsBeginningAtSha:(NSString *)sha error:(NSError **)error block:(BOOL (^)(GTCommit *commit, BOOL *stop))block {
 	NSMutableArray *passingCommits = [NSMutableArray array];
     [self enumerateCommitsBeginningAtSha:sha error:error usingBlock:^(GTCommit *commit, BOOL *stop) {
@@ -276,6 +560,21 @@ static void transferProgressCallback(const git_transfer_progress *progress, void
     return passingCommits;
 }
 
+- (NSArray *)selectCommitsBeginningAtSha:(NSString *)sha sinceDate:(NSDate *)sinceDate untilDate:(NSDate *)untilDate maximumCount:(NSUInteger)maximumCount error:(NSError **)error block:(BOOL (^)(GTCommit *commit, BOOL *stop))block {
+	NSParameterAssert(block != nil);
+
+	NSMutableArray *passingCommits = [NSMutableArray array];
+	BOOL success = [self enumerateCommitsBeginningAtSha:sha sortOptions:GTEnumeratorOptionsTimeSort sinceDate:sinceDate untilDate:untilDate error:error usingBlock:^(GTCommit *commit, BOOL *stop) {
+		if (!block(commit, stop)) return;
+
+		[passingCommits addObject:commit];
+		if (maximumCount > 0 && passingCommits.count >= maximumCount) *stop = YES;
+	}];
+	if (!success) return nil;
+
+	return passingCommits;
+}
+
 struct gitPayload {
 	__unsafe_unretained GTRepository *repository;
 	__unsafe_unretained GTRepositoryStatusBlock block;
@@ -352,6 +651,20 @@ static int file_status_callback(const char *relativeFilePath, unsigned int gitSt
 	return [GTReference referenceByResolvingSymbolicReference:headSymRef error:error];
 }
 
+- (GTOID *)headOIDWithError:(NSError **)error {
+	GTReference *head = [self headReferenceWithError:error];
+	if (head == nil) return nil;
+
+	return [self targetOIDOfHeadReference:head error:error];
+}
+
+- (GTOID *)targetOIDOfHeadReference:(GTReference *)head error:(NSError **)error {
+	GTOID *headOID = head.targetOID;
+	if (headOID == nil && error != NULL) *error = [NSError git_errorFor:GIT_ENOTFOUND withAdditionalDescription:[NSString stringWithFormat:@"%@ does not point at a commit.", head.name ?: @"HEAD"]];
+
+	return headOID;
+}
+
 - (NSArray *)localBranchesWithError:(NSError **)error {
 	return [self branchesWithPrefix:[GTBranch localNamePrefix] error:error];
 }
@@ -421,7 +734,268 @@ static int file_status_callback(const char *relativeFilePath, unsigned int gitSt
 	GTReference *head = [self headReferenceWithError:error];
 	if (head == nil) return NSNotFound;
 
-	return [self.enumerator countFromSha:head.target error:error];
+	GTOID *headOID = [self targetOIDOfHeadReference:head error:error];
+	if (headOID == nil) return NSNotFound;
+
+	return [self.commitCountCache numberOfCommitsFromOID:headOID key:head.name error:error];
+}
+
+- (GTRepositoryPool *)readerPool {
+	@synchronized (self) {
+		// Handles are reopened by path, so there's no pool without one.
+		if (_readerPool == nil && self.gitDirectoryURL != nil) {
+			_readerPool = [[GTRepositoryPool alloc] initWithURL:self.gitDirectoryURL];
+		}
+
+		return _readerPool;
+	}
+}
+
+- (GTRepositoryPool *)readerPoolForCurrentThread {
+	GTRepositoryPool *pool = self.readerPool;
+	if ([pool isHeldByCurrentThread]) return nil;
+
+	return pool;
+}
+
+- (GTPipeline *)readerPipelineWithPendingCountPerWorker:(NSUInteger)pendingCountPerWorker ordered:(BOOL)ordered {
+	GTRepositoryPool *pool = [self readerPoolForCurrentThread];
+	NSUInteger workerCount = (pool != nil ? pool.maximumCount : 1);
+
+	GTPipeline *pipeline = [[GTPipeline alloc] initWithWorkerCount:workerCount maximumPendingCount:workerCount * pendingCountPerWorker ordered:ordered];
+	if (pool == nil) {
+		pipeline.runsOnCallingThread = YES;
+		pipeline.workerSetUpBlock = ^(NSError **error) {
+			return self;
+		};
+	} else {
+		pipeline.workerSetUpBlock = ^(NSError **error) {
+			return [pool checkOutRepositoryWithError:error];
+		};
+		pipeline.workerTearDownBlock = ^(GTRepository *worker) {
+			[pool checkInRepository:worker];
+		};
+	}
+
+	return pipeline;
+}
+
+- (GTCommitGraph *)commitGraph {
+	@synchronized (self) {
+		if (!self.commitGraphLoaded) {
+			self.commitGraphLoaded = YES;
+
+			NSURL *graphURL = [GTCommitGraph defaultFileURLForRepository:self];
+			if ([NSFileManager.defaultManager fileExistsAtPath:graphURL.path]) {
+				NSError *error = nil;
+				_commitGraph = [[GTCommitGraph alloc] initWithRepository:self fileURL:graphURL error:&error];
+				if (_commitGraph == nil) GTLog(@"Failed to load the commit graph: %@", error);
+			}
+		}
+
+		return _commitGraph;
+	}
+}
+
+- (GTCommitGraph *)walkableCommitGraphWithError:(NSError **)error {
+	GTCommitGraph *graph = self.commitGraph;
+	if (graph != nil) return graph;
+
+	@synchronized (self) {
+		if (_scratchCommitGraph == nil) {
+			// Point it somewhere nothing exists, so nothing is loaded.
+			NSURL *scratchURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSProcessInfo.processInfo.globallyUniqueString]];
+			_scratchCommitGraph = [[GTCommitGraph alloc] initWithRepository:self fileURL:scratchURL error:error];
+		}
+
+		return _scratchCommitGraph;
+	}
+}
+
+- (GTChangedPathIndex *)changedPathIndex {
+	@synchronized (self) {
+		if (!self.changedPathIndexLoaded) {
+			self.changedPathIndexLoaded = YES;
+
+			NSURL *indexURL = [GTChangedPathIndex defaultFileURLForRepository:self];
+			if ([NSFileManager.defaultManager fileExistsAtPath:indexURL.path]) {
+				NSError *error = nil;
+				_changedPathIndex = [[GTChangedPathIndex alloc] initWithRepository:self fileURL:indexURL error:&error];
+				if (_changedPathIndex == nil) GTLog(@"Failed to load the changed path index: %@", error);
+			}
+		}
+
+		return _changedPathIndex;
+	}
+}
+
+- (GTAuthorIndex *)authorIndex {
+	@synchronized (self) {
+		if (!self.authorIndexLoaded) {
+			self.authorIndexLoaded = YES;
+
+			NSURL *indexURL = [GTAuthorIndex defaultFileURLForRepository:self];
+			if ([NSFileManager.defaultManager fileExistsAtPath:indexURL.path]) {
+				NSError *error = nil;
+				_authorIndex = [[GTAuthorIndex alloc] initWithRepository:self fileURL:indexURL error:&error];
+				if (_authorIndex == nil) GTLog(@"Failed to load the author index: %@", error);
+			}
+		}
+
+		return _authorIndex;
+	}
+}
+
+- (GTCommitMessageIndex *)commitMessageIndex {
+	@synchronized (self) {
+		if (!self.commitMessageIndexLoaded) {
+			self.commitMessageIndexLoaded = YES;
+
+			NSURL *indexURL = [GTCommitMessageIndex defaultFileURLForRepository:self];
+			if ([NSFileManager.defaultManager fileExistsAtPath:indexURL.path]) {
+				NSError *error = nil;
+				_commitMessageIndex = [[GTCommitMessageIndex alloc] initWithRepository:self fileURL:indexURL error:&error];
+				if (_commitMessageIndex == nil) GTLog(@"Failed to load the commit message index: %@", error);
+			}
+		}
+
+		return _commitMessageIndex;
+	}
+}
+
+- (GTCommitCountCache *)commitCountCache {
+	@synchronized (self) {
+		if (_commitCountCache == nil) {
+			_commitCountCache = [[GTCommitCountCache alloc] initWithRepository:self fileURL:[GTCommitCountCache defaultFileURLForRepository:self]];
+		}
+
+		return _commitCountCache;
+	}
+}
+
+- (GTDiffCache *)diffCache {
+	@synchronized (self) {
+		if (_diffCache == nil) {
+			_diffCache = [[GTDiffCache alloc] initWithRepository:self directoryURL:[GTDiffCache defaultDirectoryURLForRepository:self] maximumSize:GTDiffCacheDefaultMaximumSize];
+		}
+
+		return _diffCache;
+	}
+}
+
+- (BOOL)writeCommitGraphWithError:(NSError **)error {
+	GTCommitGraph *graph = self.commitGraph;
+	if (graph == nil) {
+		// Don't trust a graph file we couldn't read, start over instead.
+		graph = [[GTCommitGraph alloc] initWithRepository:self fileURL:[GTCommitGraph defaultFileURLForRepository:self] error:NULL];
+		if (graph == nil) {
+			[NSFileManager.defaultManager removeItemAtURL:[GTCommitGraph defaultFileURLForRepository:self] error:NULL];
+			graph = [[GTCommitGraph alloc] initWithRepository:self fileURL:[GTCommitGraph defaultFileURLForRepository:self] error:error];
+			if (graph == nil) return NO;
+		}
+	}
+
+	if (![graph addCommitsReachableFromReferencesWithError:error]) return NO;
+	if (![graph writeWithError:error]) return NO;
+
+	@synchronized (self) {
+		self.commitGraph = graph;
+		self.commitGraphLoaded = YES;
+		self.scratchCommitGraph = nil;
+	}
+
+	return YES;
+}
+
+- (BOOL)writeChangedPathIndexWithError:(NSError **)error {
+	NSURL *indexURL = [GTChangedPathIndex defaultFileURLForRepository:self];
+	GTChangedPathIndex *index = self.changedPathIndex;
+	if (index == nil) {
+		// Don't trust an index file we couldn't read, start over instead.
+		[NSFileManager.defaultManager removeItemAtURL:indexURL error:NULL];
+		index = [[GTChangedPathIndex alloc] initWithRepository:self fileURL:indexURL error:error];
+		if (index == nil) return NO;
+	}
+
+	NSArray *oids = [self referencedCommitOIDsWithError:error];
+	if (oids == nil) return NO;
+
+	if (![index addCommitsReachableFromOIDs:oids error:error]) return NO;
+	if (![index writeWithError:error]) return NO;
+
+	@synchronized (self) {
+		self.changedPathIndex = index;
+		self.changedPathIndexLoaded = YES;
+	}
+
+	return YES;
+}
+
+- (BOOL)writeAuthorIndexWithError:(NSError **)error {
+	NSURL *indexURL = [GTAuthorIndex defaultFileURLForRepository:self];
+	GTAuthorIndex *index = self.authorIndex;
+	if (index == nil) {
+		// Don't trust an index file we couldn't read, start over instead.
+		[NSFileManager.defaultManager removeItemAtURL:indexURL error:NULL];
+		index = [[GTAuthorIndex alloc] initWithRepository:self fileURL:indexURL error:error];
+		if (index == nil) return NO;
+	}
+
+	NSArray *oids = [self referencedCommitOIDsWithError:error];
+	if (oids == nil) return NO;
+
+	if (![index addCommitsReachableFromOIDs:oids error:error]) return NO;
+	if (![index writeWithError:error]) return NO;
+
+	@synchronized (self) {
+		self.authorIndex = index;
+		self.authorIndexLoaded = YES;
+	}
+
+	return YES;
+}
+
+- (BOOL)writeCommitMessageIndexWithError:(NSError **)error {
+	NSURL *indexURL = [GTCommitMessageIndex defaultFileURLForRepository:self];
+	GTCommitMessageIndex *index = self.commitMessageIndex;
+	if (index == nil) {
+		// Don't trust an index file we couldn't read, start over instead.
+		[NSFileManager.defaultManager removeItemAtURL:indexURL error:NULL];
+		index = [[GTCommitMessageIndex alloc] initWithRepository:self fileURL:indexURL error:error];
+		if (index == nil) return NO;
+	}
+
+	NSArray *oids = [self referencedCommitOIDsWithError:error];
+	if (oids == nil) return NO;
+
+	if (![index addCommitsReachableFromOIDs:oids error:error]) return NO;
+	if (![index writeWithError:error]) return NO;
+
+	@synchronized (self) {
+		self.commitMessageIndex = index;
+		self.commitMessageIndexLoaded = YES;
+	}
+
+	return YES;
+}
+
+- (NSArray *)referencedCommitOIDsWithError:(NSError **)error {
+	NSArray *referenceNames = [self referenceNamesWithError:error];
+	if (referenceNames == nil) return nil;
+
+	NSMutableArray *oids = [NSMutableArray arrayWithCapacity:referenceNames.count];
+	for (NSString *referenceName in referenceNames) {
+		// Not every reference leads to a commit (tags can point at trees or
+		// blobs).
+		git_object *commit = NULL;
+		NSString *spec = [referenceName stringByAppendingString:@"^{commit}"];
+		if (git_revparse_single(&commit, self.git_repository, spec.UTF8String) < GIT_OK) continue;
+
+		[oids addObject:[GTOID oidWithGitOid:git_object_id(commit)]];
+		git_object_free(commit);
+	}
+
+	return oids;
 }
 
 - (GTBranch *)createBranchNamed:(NSString *)name fromReference:(GTReference *)ref error:(NSError **)error {
@@ -465,6 +1039,39 @@ static int file_status_callback(const char *relativeFilePath, unsigned int gitSt
 	return [localBranch uniqueCommitsRelativeToBranch:remoteBranch error:error];
 }
 
+- (GTAheadBehindMatrix *)aheadBehindMatrixForLocalBranchesWithError:(NSError **)error {
+	NSArray *localBranches = [self localBranchesWithError:error];
+	if (localBranches == nil) return nil;
+
+	NSMutableArray *branches = [NSMutableArray arrayWithCapacity:localBranches.count];
+	NSMutableArray *trackingBranches = [NSMutableArray arrayWithCapacity:localBranches.count];
+	for (GTBranch *branch in localBranches) {
+		BOOL success = NO;
+		GTBranch *trackingBranch = [branch trackingBranchWithError:error success:&success];
+		if (!success) return nil;
+		if (trackingBranch == nil) continue;
+
+		[branches addObject:branch];
+		[trackingBranches addObject:trackingBranch];
+	}
+
+	return [GTAheadBehindMatrix matrixWithBranches:branches baseBranches:trackingBranches inRepository:self error:error];
+}
+
+- (GTAheadBehindMatrix *)aheadBehindMatrixForLocalBranchesRelativeToBranch:(GTBranch *)baseBranch error:(NSError **)error {
+	NSParameterAssert(baseBranch != nil);
+
+	NSArray *localBranches = [self localBranchesWithError:error];
+	if (localBranches == nil) return nil;
+
+	NSMutableArray *baseBranches = [NSMutableArray arrayWithCapacity:localBranches.count];
+	for (NSUInteger i = 0; i < localBranches.count; i++) {
+		[baseBranches addObject:baseBranch];
+	}
+
+	return [GTAheadBehindMatrix matrixWithBranches:localBranches baseBranches:baseBranches inRepository:self error:error];
+}
+
 - (NSArray *)referenceNamesWithTypes:(GTReferenceTypes)types error:(NSError **)error {
 	git_strarray array;
 	int gitError = git_reference_list(&array, self.git_repository, types);
@@ -576,12 +1183,17 @@ static int file_status_callback(const char *relativeFilePath, unsigned int gitSt
 	return _index;
 }
 
+// Enumerators may be created and destroyed on any thread.
 - (void)addEnumerator:(GTEnumerator *)e {
-	[self.weakEnumerators addObject:[NSValue valueWithNonretainedObject:e]];
+	@synchronized (self) {
+		[self.weakEnumerators addObject:[NSValue valueWithNonretainedObject:e]];
+	}
 }
 
 - (void)removeEnumerator:(GTEnumerator *)e {
-	[self.weakEnumerators removeObject:[NSValue valueWithNonretainedObject:e]];
+	@synchronized (self) {
+		[self.weakEnumerators removeObject:[NSValue valueWithNonretainedObject:e]];
+	}
 }
 
 - (BOOL)resetToCommit:(GTCommit *)commit withResetType:(GTRepositoryResetType)resetType error:(NSError **)error {
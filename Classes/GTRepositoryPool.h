@@ -0,0 +1,77 @@
+//
+//  GTRepositoryPool.h
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class GTRepository;
+
+// A pool of `GTRepository` handles opened on the same repository.
+//
+// A `GTRepository` (and its `git_repository`) must only be used by one thread
+// at a time. Threads that want to read the same repository concurrently check
+// a handle out of the pool, use it exclusively, and check it back in. All the
+// handles read the same on-disk object database.
+//
+// Handles are opened lazily, up to `maximumCount`. Checking out blocks while
+// every handle is in use. Handles stay open until the pool is deallocated.
+//
+// This class is thread safe.
+@interface GTRepositoryPool : NSObject
+
+// The URL the handles are opened on.
+@property (nonatomic, readonly, strong) NSURL *URL;
+
+// The maximum number of handles the pool will open.
+@property (nonatomic, readonly) NSUInteger maximumCount;
+
+// The number of handles the pool has opened so far.
+@property (nonatomic, readonly) NSUInteger count;
+
+// Designated initializer.
+//
+// URL          - The file URL of the repository's working directory or git
+//                directory. Cannot be nil.
+// maximumCount - The maximum number of handles to open. Must be at least 1.
+- (id)initWithURL:(NSURL *)URL maximumCount:(NSUInteger)maximumCount;
+
+// Calls -initWithURL:maximumCount: with one handle per active processor.
+- (id)initWithURL:(NSURL *)URL;
+
+// Check a handle out of the pool, opening a new one if none are idle and the
+// pool isn't full. Blocks until a handle is available.
+//
+// error(out) - will be filled if an error occurs
+//
+// returns a handle for the exclusive use of the caller, or nil if a new handle
+// could not be opened. Every handle returned must be passed back to
+// -checkInRepository:.
+- (GTRepository *)checkOutRepositoryWithError:(NSError **)error;
+
+// Return a handle to the pool.
+//
+// repository - A handle previously returned by -checkOutRepositoryWithError:.
+//              Cannot be nil.
+- (void)checkInRepository:(GTRepository *)repository;
+
+// Whether the calling thread has one of the receiver's handles checked out.
+//
+// Such a thread, like a worker calling a block, must not wait for another
+// handle: the handles it's waiting for may be held by workers which are
+// waiting for it. It should keep using the handle it has, or not read
+// concurrently at all.
+- (BOOL)isHeldByCurrentThread;
+
+// Check out a handle, call the block with it, and check it back in.
+//
+// error(out) - will be filled if a handle could not be checked out
+// block      - Called with the handle. Cannot be nil.
+//
+// returns NO if a handle could not be checked out, YES otherwise.
+- (BOOL)performWithRepository:(void (^)(GTRepository *repository))block error:(NSError **)error;
+
+@end
@@ -0,0 +1,133 @@
+//
+//  GTRepositoryPool.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "GTRepositoryPool.h"
+#import "GTRepository.h"
+
+@interface GTRepositoryPool () {
+	// Counts the handles which are available to be checked out, whether or not
+	// they've been opened yet.
+	dispatch_semaphore_t _availableSemaphore;
+}
+
+// Every handle opened by the pool, those which are checked in, and the threads
+// the rest were checked out on. Only accessed while synchronized on
+// `allRepositories`.
+@property (nonatomic, strong) NSMutableArray *allRepositories;
+@property (nonatomic, strong) NSMutableArray *idleRepositories;
+@property (nonatomic, strong) NSMapTable *checkOutThreads;
+
+@end
+
+@implementation GTRepositoryPool
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %p> URL: %@, count: %lu, maximumCount: %lu", NSStringFromClass([self class]), self, self.URL, (unsigned long)self.count, (unsigned long)self.maximumCount];
+}
+
+- (void)dealloc {
+	#if !OS_OBJECT_USE_OBJC
+	if (_availableSemaphore != NULL) dispatch_release(_availableSemaphore);
+	#endif
+}
+
+#pragma mark API
+
+- (id)initWithURL:(NSURL *)URL {
+	return [self initWithURL:URL maximumCount:MAX(NSProcessInfo.processInfo.activeProcessorCount, (NSUInteger)1)];
+}
+
+- (id)initWithURL:(NSURL *)URL maximumCount:(NSUInteger)maximumCount {
+	NSParameterAssert(URL != nil);
+	NSParameterAssert(maximumCount > 0);
+
+	self = [super init];
+	if (self == nil) return nil;
+
+	_URL = [URL copy];
+	_maximumCount = maximumCount;
+	_availableSemaphore = dispatch_semaphore_create((long)maximumCount);
+	_allRepositories = [NSMutableArray arrayWithCapacity:maximumCount];
+	_idleRepositories = [NSMutableArray arrayWithCapacity:maximumCount];
+	_checkOutThreads = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory capacity:maximumCount];
+
+	return self;
+}
+
+- (NSUInteger)count {
+	@synchronized (self.allRepositories) {
+		return self.allRepositories.count;
+	}
+}
+
+- (GTRepository *)checkOutRepositoryWithError:(NSError **)error {
+	dispatch_semaphore_wait(_availableSemaphore, DISPATCH_TIME_FOREVER);
+
+	@synchronized (self.allRepositories) {
+		GTRepository *repository = self.idleRepositories.lastObject;
+		if (repository != nil) {
+			[self.idleRepositories removeLastObject];
+			[self.checkOutThreads setObject:NSThread.currentThread forKey:repository];
+			return repository;
+		}
+	}
+
+	// Nothing idle, but the semaphore let us through, so there's room for one
+	// more handle.
+	GTRepository *repository = [[GTRepository alloc] initWithURL:self.URL error:error];
+	if (repository == nil) {
+		dispatch_semaphore_signal(_availableSemaphore);
+		return nil;
+	}
+
+	@synchronized (self.allRepositories) {
+		[self.allRepositories addObject:repository];
+		[self.checkOutThreads setObject:NSThread.currentThread forKey:repository];
+	}
+
+	return repository;
+}
+
+- (void)checkInRepository:(GTRepository *)repository {
+	NSParameterAssert(repository != nil);
+
+	@synchronized (self.allRepositories) {
+		NSAssert([self.allRepositories indexOfObjectIdenticalTo:repository] != NSNotFound, @"%@ was not checked out of %@", repository, self);
+		NSAssert([self.idleRepositories indexOfObjectIdenticalTo:repository] == NSNotFound, @"%@ was checked into %@ twice", repository, self);
+
+		[self.idleRepositories addObject:repository];
+		[self.checkOutThreads removeObjectForKey:repository];
+	}
+
+	dispatch_semaphore_signal(_availableSemaphore);
+}
+
+- (BOOL)isHeldByCurrentThread {
+	@synchronized (self.allRepositories) {
+		NSThread *currentThread = NSThread.currentThread;
+		for (NSThread *thread in self.checkOutThreads.objectEnumerator) {
+			if (thread == currentThread) return YES;
+		}
+
+		return NO;
+	}
+}
+
+- (BOOL)performWithRepository:(void (^)(GTRepository *repository))block error:(NSError **)error {
+	NSParameterAssert(block != NULL);
+
+	GTRepository *repository = [self checkOutRepositoryWithError:error];
+	if (repository == nil) return NO;
+
+	block(repository);
+	[self checkInRepository:repository];
+
+	return YES;
+}
+
+@end
@@ -76,11 +76,8 @@
 }
 
 - (GTObject *)target {
-	git_object *t;
 	// todo: might want to actually return an error here
-	int gitError = git_tag_target(&t, self.git_tag);
-	if(gitError < GIT_OK) return nil;
-    return [GTObject objectWithObj:(git_object *)t inRepository:self.repository];
+	return [self.repository lookupObjectByOid:git_tag_target_id(self.git_tag) objectType:(GTObjectType)git_tag_target_type(self.git_tag) error:NULL];
 }
 
 - (NSString *)targetType {
@@ -30,6 +30,7 @@
 #import "GTObject.h"
 
 @class GTTree;
+@class GTOID;
 
 
 @interface GTTreeEntry : NSObject <GTObject> {}
@@ -44,6 +45,9 @@
 - (NSInteger)attributes;
 - (NSString *)sha;
 
+// The OID of the object the entry points at.
+- (GTOID *)OID;
+
 // Turn entry into an GTObject
 //
 // error(out) - will be filled if an error occurs
@@ -33,6 +33,7 @@
 #import "GTRepository.h"
 #import "NSError+Git.h"
 #import "NSString+Git.h"
+#import "GTOID.h"
 
 @interface GTTreeEntry()
 @property (nonatomic, assign) const git_tree_entry *git_tree_entry;
@@ -80,12 +81,16 @@
 	return [NSString git_stringWithOid:git_tree_entry_id(self.git_tree_entry)];
 }
 
+- (GTOID *)OID {
+	return [GTOID oidWithGitOid:git_tree_entry_id(self.git_tree_entry)];
+}
+
 - (GTRepository *)repository {
     return self.tree.repository;
 }
 
 - (GTObject *)toObjectAndReturnError:(NSError **)error {
-	return [GTObject objectWithTreeEntry:self error:error];
+	return [self.repository lookupObjectByOid:git_tree_entry_id(self.git_tree_entry) objectType:(GTObjectType)git_tree_entry_type(self.git_tree_entry) error:error];
 }
 
 @end
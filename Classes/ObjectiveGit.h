@@ -27,6 +27,7 @@
 
 #import <ObjectiveGit/GTRepository.h>
 #import <ObjectiveGit/GTEnumerator.h>
+#import <ObjectiveGit/GTEnumeratorCursor.h>
 #import <ObjectiveGit/GTCommit.h>
 #import <ObjectiveGit/GTSignature.h>
 #import <ObjectiveGit/GTTree.h>
@@ -42,6 +43,23 @@
 
 #import <ObjectiveGit/GTObjectDatabase.h>
 #import <ObjectiveGit/GTOdbObject.h>
+#import <ObjectiveGit/GTObjectCache.h>
+#import <ObjectiveGit/GTOID.h>
+#import <ObjectiveGit/GTRepositoryPool.h>
+#import <ObjectiveGit/GTCommitGraph.h>
+#import <ObjectiveGit/GTCommitCountCache.h>
+#import <ObjectiveGit/GTAheadBehindMatrix.h>
+#import <ObjectiveGit/GTCommitRecord.h>
+#import <ObjectiveGit/GTChangedPathIndex.h>
+#import <ObjectiveGit/GTAuthorIndex.h>
+#import <ObjectiveGit/GTCommitMessageIndex.h>
+#import <ObjectiveGit/GTBlame.h>
+#import <ObjectiveGit/GTBlameHunk.h>
+#import <ObjectiveGit/GTCachedDiffDelta.h>
+#import <ObjectiveGit/GTDiffCache.h>
+#import <ObjectiveGit/GTDiffLineChange.h>
+#import <ObjectiveGit/GTDiffOptions.h>
+#import <ObjectiveGit/GTDiffRename.h>
 
 #import <ObjectiveGit/NSError+Git.h>
 #import <ObjectiveGit/NSData+Git.h>
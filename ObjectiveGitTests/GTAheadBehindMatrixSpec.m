@@ -0,0 +1,85 @@
+//
+//  GTAheadBehindMatrixSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTAheadBehindMatrix.h"
+
+SpecBegin(GTAheadBehindMatrix)
+
+__block GTRepository *repository = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+});
+
+GTBranch * (^branchNamed)(NSString *) = ^(NSString *name) {
+	return [GTBranch branchWithName:name repository:repository error:NULL];
+};
+
+it(@"should compare local branches to their tracking branches", ^{
+	NSError *error = nil;
+	GTAheadBehindMatrix *matrix = [repository aheadBehindMatrixForLocalBranchesWithError:&error];
+	expect(matrix).toNot.beNil();
+	expect(error).to.beNil();
+
+	GTBranch *master = branchNamed(@"refs/heads/master");
+	expect([matrix baseBranchForBranch:master].name).to.equal(@"refs/remotes/origin/master");
+
+	NSUInteger ahead = NSNotFound;
+	NSUInteger behind = NSNotFound;
+	expect([matrix getAhead:&ahead behind:&behind forBranch:master]).to.beTruthy();
+	expect(ahead).to.equal(9);
+	expect(behind).to.equal(0);
+
+	// Branches without a tracking branch are left out.
+	expect([matrix getAhead:NULL behind:NULL forBranch:branchNamed(@"refs/heads/wat")]).to.beFalsy();
+});
+
+it(@"should compare local branches to a base branch", ^{
+	GTBranch *master = branchNamed(@"refs/heads/master");
+	GTAheadBehindMatrix *matrix = [repository aheadBehindMatrixForLocalBranchesRelativeToBranch:master error:NULL];
+	expect(matrix).toNot.beNil();
+	expect(matrix.branches.count).to.beGreaterThan(1);
+	expect(matrix.commitsVisited).to.beGreaterThan(0);
+	expect(matrix.wallTime).to.beGreaterThanOrEqualTo(0);
+
+	NSUInteger ahead = NSNotFound;
+	NSUInteger behind = NSNotFound;
+	[matrix getAhead:&ahead behind:&behind forBranch:branchNamed(@"refs/heads/feature")];
+	expect(ahead).to.equal(0);
+	expect(behind).to.equal(91);
+
+	[matrix getAhead:&ahead behind:&behind forBranch:branchNamed(@"refs/heads/new")];
+	expect(ahead).to.equal(1);
+	expect(behind).to.equal(9);
+
+	[matrix getAhead:&ahead behind:&behind forBranch:master];
+	expect(ahead).to.equal(0);
+	expect(behind).to.equal(0);
+});
+
+it(@"should agree with comparing branches one at a time", ^{
+	GTBranch *master = branchNamed(@"refs/heads/master");
+	GTAheadBehindMatrix *matrix = [repository aheadBehindMatrixForLocalBranchesRelativeToBranch:master error:NULL];
+	expect(matrix).toNot.beNil();
+
+	for (GTBranch *branch in matrix.branches) {
+		NSUInteger expectedAhead = 0;
+		NSUInteger expectedBehind = 0;
+		expect([branch aheadBehindRelativeToBranch:master ahead:&expectedAhead behind:&expectedBehind error:NULL]).to.beTruthy();
+
+		NSUInteger ahead = NSNotFound;
+		NSUInteger behind = NSNotFound;
+		[matrix getAhead:&ahead behind:&behind forBranch:branch];
+		expect(ahead).to.equal(expectedAhead);
+		expect(behind).to.equal(expectedBehind);
+	}
+});
+
+SpecEnd
@@ -0,0 +1,121 @@
+//
+//  GTAuthorIndexSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTAuthorIndex.h"
+#import "GTOID.h"
+
+SpecBegin(GTAuthorIndex)
+
+__block GTRepository *repository = nil;
+__block GTCommit *masterCommit = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+
+	masterCommit = (GTCommit *)[repository lookupObjectByRefspec:@"refs/heads/master" error:NULL];
+	expect(masterCommit).toNot.beNil();
+});
+
+it(@"should normalize identities to a lowercase email, or else name", ^{
+	expect([GTAuthorIndex normalizedIdentityWithName:@"Danny Greg" email:@" Danny@GitHub.com"]).to.equal(@"danny@github.com");
+	expect([GTAuthorIndex normalizedIdentityWithName:@"Danny Greg" email:@""]).to.equal(@"danny greg");
+});
+
+describe(@"GTAuthorIndex lookups", ^{
+	__block GTAuthorIndex *index = nil;
+
+	beforeEach(^{
+		// Never written, so there's nothing to clean up.
+		NSURL *fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSProcessInfo.processInfo.globallyUniqueString]];
+		index = [[GTAuthorIndex alloc] initWithRepository:repository fileURL:fileURL error:NULL];
+		expect(index).toNot.beNil();
+
+		expect([index addCommitsReachableFromOIDs:@[ masterCommit.OID ] error:NULL]).to.beTruthy();
+	});
+
+	it(@"should index every commit it's given", ^{
+		expect([index containsOID:masterCommit.OID]).to.beTruthy();
+		expect(index.hasUnsavedChanges).to.beTruthy();
+	});
+
+	it(@"should find commits by normalized identity, newest first", ^{
+		NSArray *oids = [index OIDsOfCommitsByIdentity:@" Danny@GitHub.com" roles:GTAuthorIndexRoleAuthor | GTAuthorIndexRoleCommitter sinceDate:nil untilDate:nil reachableFromOID:nil error:NULL];
+		NSArray *expectedOIDs = @[
+			[GTOID oidWithSha:@"a4bca6b67a5483169963572ee3da563da33712f7" error:NULL],
+			[GTOID oidWithSha:@"6b0c1c8b8816416089c534e474f4c692a76ac14f" error:NULL],
+		];
+		expect(oids).to.equal(expectedOIDs);
+	});
+
+	it(@"should find nothing for an unknown identity", ^{
+		NSArray *oids = [index OIDsOfCommitsByIdentity:@"nobody@example.com" roles:GTAuthorIndexRoleAuthor sinceDate:nil untilDate:nil reachableFromOID:nil error:NULL];
+		expect(oids).to.equal(@[]);
+	});
+
+	it(@"should limit commits by date", ^{
+		NSDate *since = [NSDate dateWithTimeIntervalSince1970:1328000000];
+		NSDate *until = [NSDate dateWithTimeIntervalSince1970:1330000000];
+
+		NSArray *oids = [index OIDsOfCommitsByIdentity:@"joshaber@gmail.com" roles:GTAuthorIndexRoleAuthor sinceDate:since untilDate:until reachableFromOID:nil error:NULL];
+		expect(oids.count).to.equal(7);
+	});
+
+	it(@"should limit commits to those reachable from a commit", ^{
+		NSError *error = nil;
+		NSArray *oids = [index OIDsOfCommitsByIdentity:@"spuufmail@mac.com" roles:GTAuthorIndexRoleCommitter sinceDate:nil untilDate:nil reachableFromOID:masterCommit.OID error:&error];
+		expect(oids.count).to.equal(8);
+		expect(error).to.beNil();
+	});
+});
+
+describe(@"GTAuthorIndex files", ^{
+	__block NSURL *fileURL = nil;
+
+	beforeEach(^{
+		fileURL = [GTAuthorIndex defaultFileURLForRepository:repository];
+		expect([repository writeAuthorIndexWithError:NULL]).to.beTruthy();
+	});
+
+	afterEach(^{
+		[NSFileManager.defaultManager removeItemAtURL:fileURL error:NULL];
+	});
+
+	it(@"should index every referenced commit", ^{
+		expect(repository.authorIndex.count).to.equal(168);
+		expect(repository.authorIndex.hasUnsavedChanges).to.beFalsy();
+	});
+
+	it(@"should be loaded from disk", ^{
+		NSError *error = nil;
+		GTAuthorIndex *index = [[GTAuthorIndex alloc] initWithRepository:repository fileURL:fileURL error:&error];
+		expect(index).toNot.beNil();
+		expect(error).to.beNil();
+		expect(index.count).to.equal(168);
+
+		NSArray *oids = [index OIDsOfCommitsByIdentity:@"danny@github.com" roles:GTAuthorIndexRoleAuthor sinceDate:nil untilDate:nil reachableFromOID:nil error:NULL];
+		expect(oids.count).to.equal(2);
+
+		expect([index addCommitsReachableFromOIDs:@[ masterCommit.OID ] error:NULL]).to.beTruthy();
+		expect(index.hasUnsavedChanges).to.beFalsy();
+	});
+
+	it(@"should refuse to load a corrupt file", ^{
+		NSMutableData *data = [NSMutableData dataWithContentsOfURL:fileURL];
+		((uint8_t *)data.mutableBytes)[data.length / 2] ^= 0xff;
+		expect([data writeToURL:fileURL atomically:YES]).to.beTruthy();
+
+		NSError *error = nil;
+		GTAuthorIndex *index = [[GTAuthorIndex alloc] initWithRepository:repository fileURL:fileURL error:&error];
+		expect(index).to.beNil();
+		expect(error.code).to.equal(GTAuthorIndexErrorCodeCorruptFile);
+	});
+});
+
+SpecEnd
@@ -0,0 +1,115 @@
+//
+//  GTBlameSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTBlame.h"
+#import "GTBlameHunk.h"
+#import "GTOID.h"
+
+SpecBegin(GTBlame)
+
+__block GTRepository *repository = nil;
+__block GTCommit *master = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+
+	master = (GTCommit *)[repository lookupObjectByRefspec:@"refs/heads/master" error:NULL];
+	expect(master).toNot.beNil();
+});
+
+NSArray * (^describeHunks)(NSArray *) = ^(NSArray *hunks) {
+	NSMutableArray *descriptions = [NSMutableArray array];
+	for (GTBlameHunk *hunk in hunks) {
+		[descriptions addObject:[NSString stringWithFormat:@"%@ %lu %lu %lu", [hunk.commitOID.sha substringToIndex:7], (unsigned long)hunk.originalStartLineNumber, (unsigned long)hunk.lineRange.location, (unsigned long)hunk.lineRange.length]];
+	}
+
+	return descriptions;
+};
+
+NSArray *expectedHunks = @[
+	@"5b91f8b 1 1 1",
+	@"4d5a6cc 2 2 12",
+	@"8fcd9e1 14 14 1",
+	@"2d7b8ac 15 15 1",
+	@"0759ca3 16 16 1",
+	@"adbc28c 17 17 1",
+	@"8898095 18 18 1",
+];
+
+it(@"should attribute every line to the commit which last changed it", ^{
+	NSError *error = nil;
+	GTBlame *blame = [GTBlame blameForFileAtPath:@"main.m" inCommit:master error:&error];
+	expect(blame).toNot.beNil();
+	expect(error).to.beNil();
+
+	expect(blame.lineCount).to.equal(18);
+	expect(describeHunks(blame.hunks)).to.equal(expectedHunks);
+	expect([[blame hunkAtLineNumber:5].commitOID.sha substringToIndex:7]).to.equal(@"4d5a6cc");
+	expect([blame hunkAtLineNumber:19]).to.beNil();
+});
+
+it(@"should hand hunks to the block as they're settled", ^{
+	NSMutableIndexSet *settledLines = [NSMutableIndexSet indexSet];
+	GTBlame *blame = [GTBlame blameForFileAtPath:@"main.m" inCommit:master error:NULL usingBlock:^(GTBlameHunk *hunk) {
+		expect([settledLines intersectsIndexesInRange:hunk.lineRange]).to.beFalsy();
+		[settledLines addIndexesInRange:hunk.lineRange];
+	}];
+
+	expect(blame).toNot.beNil();
+	expect(settledLines).to.equal([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 18)]);
+});
+
+it(@"should reuse an older blame of the same file", ^{
+	GTCommit *parent = master.parents[0];
+	GTBlame *olderBlame = [GTBlame blameForFileAtPath:@"main.m" inCommit:parent error:NULL];
+	expect(olderBlame).toNot.beNil();
+
+	GTBlame *blame = [GTBlame blameForFileAtPath:@"main.m" inCommit:master error:NULL];
+	expect(describeHunks(blame.hunks)).to.equal(expectedHunks);
+	expect(olderBlame.diffCount).to.beGreaterThan(0);
+	expect(blame.diffCount).to.equal(0);
+});
+
+it(@"should reuse the line mappings of blames at related commits", ^{
+	GTBlame *blame = [GTBlame blameForFileAtPath:@"main.m" inCommit:master error:NULL];
+	expect(blame.diffCount).to.beGreaterThan(0);
+
+	// The second parent of a merge master's blame walked through.
+	GTCommit *sideCommit = (GTCommit *)[repository lookupObjectBySha:@"88980951f8251fa1b0ed0111ecb45936d2534589" objectType:GTObjectTypeCommit error:NULL];
+	expect(sideCommit).toNot.beNil();
+
+	GTBlame *sideBlame = [GTBlame blameForFileAtPath:@"main.m" inCommit:sideCommit error:NULL];
+	expect(describeHunks(sideBlame.hunks)).to.equal(expectedHunks);
+	expect(sideBlame.diffCount).to.equal(0);
+});
+
+it(@"should hand a merge's lines to the parent with the same file", ^{
+	// d603d61 merges 8898095, which has the same main.m, into 47563e7, which
+	// doesn't.
+	GTCommit *merge = (GTCommit *)[repository lookupObjectBySha:@"d603d61ea756eb881ba440b3e66b561d070aec6e" objectType:GTObjectTypeCommit error:NULL];
+	expect(merge).toNot.beNil();
+
+	GTBlame *mergeBlame = [GTBlame blameForFileAtPath:@"main.m" inCommit:merge error:NULL];
+	expect(describeHunks(mergeBlame.hunks)).to.equal(expectedHunks);
+
+	GTRepository *otherRepository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	GTCommit *sideCommit = (GTCommit *)[otherRepository lookupObjectBySha:@"88980951f8251fa1b0ed0111ecb45936d2534589" objectType:GTObjectTypeCommit error:NULL];
+	GTBlame *sideBlame = [GTBlame blameForFileAtPath:@"main.m" inCommit:sideCommit error:NULL];
+	expect(mergeBlame.diffCount).to.equal(sideBlame.diffCount);
+});
+
+it(@"should fail for a file which isn't in the commit", ^{
+	NSError *error = nil;
+	GTBlame *blame = [GTBlame blameForFileAtPath:@"no such file" inCommit:master error:&error];
+	expect(blame).to.beNil();
+	expect(error).toNot.beNil();
+});
+
+SpecEnd
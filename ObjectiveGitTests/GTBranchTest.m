@@ -7,6 +7,7 @@
 //
 
 #import "Contants.h"
+#import "GTOID.h"
 
 @interface GTBranchTest : SenTestCase {
 
@@ -58,6 +59,34 @@
 	STAssertEquals((NSUInteger)3, n, nil);
 }
 
+- (void)testCanCalculateAheadBehind {
+	
+	NSError *error = nil;
+	GTBranch *master = [GTBranch branchWithName:@"refs/heads/master" repository:repo error:&error];
+	STAssertNotNil(master, [error localizedDescription]);
+	GTBranch *packed = [GTBranch branchWithName:@"refs/heads/packed" repository:repo error:&error];
+	STAssertNotNil(packed, [error localizedDescription]);
+	
+	NSUInteger ahead = 0;
+	NSUInteger behind = 0;
+	NSArray *aheadOIDs = nil;
+	NSArray *behindOIDs = nil;
+	BOOL success = [master aheadBehindRelativeToBranch:packed ahead:&ahead behind:&behind aheadOIDs:&aheadOIDs behindOIDs:&behindOIDs error:&error];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEquals((NSUInteger)3, ahead, nil);
+	STAssertEquals((NSUInteger)2, behind, nil);
+	STAssertEqualObjects(@"36060c58702ed4c2a40832c51758d5344201d89a", [[aheadOIDs objectAtIndex:0] sha], nil);
+	STAssertEqualObjects(@"41bc8c69075bbdb46c5c6f0566cc8cc5b46e8bd9", [[behindOIDs objectAtIndex:0] sha], nil);
+	
+	success = [master aheadBehindRelativeToBranch:master ahead:&ahead behind:&behind error:&error];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEquals((NSUInteger)0, ahead, nil);
+	STAssertEquals((NSUInteger)0, behind, nil);
+	
+	NSArray *uniqueCommits = [master uniqueCommitsRelativeToBranch:packed error:&error];
+	STAssertEquals((NSUInteger)3, uniqueCommits.count, nil);
+}
+
 - (void)testRetainOfBranchCreatedWithRef {
 
 	// Hard to test the autoreleasepool, so manually alloc/init instead.
@@ -0,0 +1,99 @@
+//
+//  GTChangedPathIndexSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTChangedPathIndex.h"
+#import "GTOID.h"
+
+SpecBegin(GTChangedPathIndex)
+
+NSArray * (^shortSHAsTouchingPaths)(GTRepository *, NSString *, NSArray *) = ^(GTRepository *repository, NSString *sha, NSArray *paths) {
+	NSMutableArray *SHAs = [NSMutableArray array];
+	BOOL success = [repository enumerateCommitsBeginningAtSha:sha touchingPaths:paths error:NULL usingBlock:^(GTCommit *commit, BOOL *stop) {
+		[SHAs addObject:commit.shortSha];
+	}];
+
+	expect(success).to.beTruthy();
+	return SHAs;
+};
+
+describe(@"path limited walks", ^{
+	__block GTRepository *repository = nil;
+
+	beforeEach(^{
+		repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_REPO_PATH(self.class)] error:NULL];
+		expect(repository).toNot.beNil();
+	});
+
+	it(@"should only return commits which changed a file", ^{
+		expect(shortSHAsTouchingPaths(repository, @"a4a7dce85cf63874e984719f4fdd239f5145052f", @[ @"README" ])).to.equal((@[ @"4a202b3", @"8496071" ]));
+		expect(shortSHAsTouchingPaths(repository, @"a4a7dce85cf63874e984719f4fdd239f5145052f", @[ @"new.txt" ])).to.equal((@[ @"9fd738e", @"5b5b025" ]));
+		expect(shortSHAsTouchingPaths(repository, @"a4a7dce85cf63874e984719f4fdd239f5145052f", @[ @"branch_file.txt" ])).to.equal((@[ @"c47800c" ]));
+	});
+
+	it(@"should return commits which changed any of several paths", ^{
+		expect(shortSHAsTouchingPaths(repository, @"a4a7dce85cf63874e984719f4fdd239f5145052f", @[ @"README", @"new.txt" ])).to.equal((@[ @"9fd738e", @"4a202b3", @"5b5b025", @"8496071" ]));
+	});
+
+	it(@"should return commits which changed a directory", ^{
+		expect(shortSHAsTouchingPaths(repository, nil, @[ @"subdir/" ])).to.equal((@[ @"36060c5" ]));
+	});
+
+	it(@"should return nothing for a path which never existed", ^{
+		expect(shortSHAsTouchingPaths(repository, nil, @[ @"no/such/file" ])).to.equal(@[]);
+	});
+});
+
+describe(@"with an index", ^{
+	__block GTRepository *repository = nil;
+
+	beforeEach(^{
+		repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+		expect(repository).toNot.beNil();
+	});
+
+	afterEach(^{
+		[NSFileManager.defaultManager removeItemAtURL:[GTChangedPathIndex defaultFileURLForRepository:repository] error:NULL];
+	});
+
+	it(@"should return the same commits as without one", ^{
+		expect(repository.changedPathIndex).to.beNil();
+
+		NSArray *SHAs = shortSHAsTouchingPaths(repository, nil, @[ @"main.m" ]);
+		expect(SHAs.count).to.equal(117);
+
+		NSError *error = nil;
+		expect([repository writeChangedPathIndexWithError:&error]).to.beTruthy();
+		expect(error).to.beNil();
+		expect(repository.changedPathIndex.count).to.equal(168);
+		expect(repository.changedPathIndex.hasUnsavedChanges).to.beFalsy();
+
+		expect(shortSHAsTouchingPaths(repository, nil, @[ @"main.m" ])).to.equal(SHAs);
+	});
+
+	it(@"should be loaded from disk", ^{
+		expect([repository writeChangedPathIndexWithError:NULL]).to.beTruthy();
+
+		NSError *error = nil;
+		GTChangedPathIndex *index = [[GTChangedPathIndex alloc] initWithRepository:repository fileURL:[GTChangedPathIndex defaultFileURLForRepository:repository] error:&error];
+		expect(index).toNot.beNil();
+		expect(error).to.beNil();
+		expect(index.count).to.equal(168);
+	});
+
+	it(@"should know which paths a commit didn't change", ^{
+		expect([repository writeChangedPathIndexWithError:NULL]).to.beTruthy();
+
+		GTCommit *head = (GTCommit *)[repository lookupObjectByRefspec:@"HEAD" error:NULL];
+		GTOID *headOID = head.OID;
+		expect([repository.changedPathIndex containsOID:headOID]).to.beTruthy();
+		expect([repository.changedPathIndex commitOID:headOID mayHaveChangedPath:@"there/is/no/such/file"]).to.beFalsy();
+	});
+});
+
+SpecEnd
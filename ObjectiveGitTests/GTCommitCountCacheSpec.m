@@ -0,0 +1,82 @@
+//
+//  GTCommitCountCacheSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTCommitCountCache.h"
+#import "GTOID.h"
+
+SpecBegin(GTCommitCountCache)
+
+__block GTRepository *repository = nil;
+__block NSURL *cacheURL = nil;
+__block GTCommitCountCache *cache = nil;
+
+GTOID * (^OID)(NSString *) = ^(NSString *sha) {
+	return [GTOID oidWithSha:sha error:NULL];
+};
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+
+	cacheURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"GTCommitCountCacheSpec-%@.plist", [[NSProcessInfo processInfo] globallyUniqueString]]]];
+	cache = [[GTCommitCountCache alloc] initWithRepository:repository fileURL:cacheURL];
+	expect(cache).toNot.beNil();
+});
+
+afterEach(^{
+	[cache removeAllCounts];
+});
+
+it(@"should count commits as a tip moves forward", ^{
+	expect([cache numberOfCommitsFromOID:OID(@"5b5b025afb0b4c913b4c338a42934a3863bf3644") key:@"refs/heads/test" error:NULL]).to.equal(2);
+	expect([cache numberOfCommitsFromOID:OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a") key:@"refs/heads/test" error:NULL]).to.equal(4);
+});
+
+it(@"should recount when history is rewritten", ^{
+	expect([cache numberOfCommitsFromOID:OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a") key:@"refs/heads/test" error:NULL]).to.equal(4);
+	expect([cache numberOfCommitsFromOID:OID(@"8496071c1b46c854b31185ea97743be6a8774479") key:@"refs/heads/test" error:NULL]).to.equal(1);
+});
+
+it(@"should persist counts", ^{
+	expect([cache numberOfCommitsFromOID:OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a") key:@"refs/heads/test" error:NULL]).to.equal(4);
+	[cache flush];
+	expect([NSFileManager.defaultManager fileExistsAtPath:cacheURL.path]).to.beTruthy();
+
+	GTCommitCountCache *loadedCache = [[GTCommitCountCache alloc] initWithRepository:repository fileURL:cacheURL];
+	expect([loadedCache numberOfCommitsFromOID:OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a") key:@"refs/heads/other" error:NULL]).to.equal(4);
+});
+
+it(@"should batch writes", ^{
+	expect([cache numberOfCommitsFromOID:OID(@"5b5b025afb0b4c913b4c338a42934a3863bf3644") key:@"refs/heads/test" error:NULL]).to.equal(2);
+	expect([cache numberOfCommitsFromOID:OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a") key:@"refs/heads/other" error:NULL]).to.equal(4);
+	expect([NSFileManager.defaultManager fileExistsAtPath:cacheURL.path]).to.beFalsy();
+
+	[cache flush];
+	expect([NSFileManager.defaultManager fileExistsAtPath:cacheURL.path]).to.beTruthy();
+});
+
+it(@"should keep counts written by other caches", ^{
+	GTCommitCountCache *otherCache = [[GTCommitCountCache alloc] initWithRepository:repository fileURL:cacheURL];
+	expect([otherCache numberOfCommitsFromOID:OID(@"5b5b025afb0b4c913b4c338a42934a3863bf3644") key:@"refs/heads/other" error:NULL]).to.equal(2);
+	expect([cache numberOfCommitsFromOID:OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a") key:@"refs/heads/test" error:NULL]).to.equal(4);
+	[otherCache flush];
+	[cache flush];
+
+	NSDictionary *branches = [NSDictionary dictionaryWithContentsOfURL:cacheURL][@"branches"];
+	expect(branches[@"refs/heads/other"][@"count"]).to.equal(@2);
+	expect(branches[@"refs/heads/test"][@"count"]).to.equal(@4);
+});
+
+it(@"should fail for commits that don't exist", ^{
+	NSError *error = nil;
+	expect([cache numberOfCommitsFromOID:OID(@"0000000000000000000000000000000000000001") key:@"refs/heads/test" error:&error]).to.equal(NSNotFound);
+	expect(error).toNot.beNil();
+});
+
+SpecEnd
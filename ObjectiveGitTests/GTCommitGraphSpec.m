@@ -0,0 +1,131 @@
+//
+//  GTCommitGraphSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTCommitGraph.h"
+#import "GTRepository+Private.h"
+#import "GTOID.h"
+
+SpecBegin(GTCommitGraph)
+
+__block GTRepository *repository = nil;
+__block NSURL *graphURL = nil;
+__block GTCommitGraph *graph = nil;
+
+GTOID * (^OID)(NSString *) = ^(NSString *sha) {
+	return [GTOID oidWithSha:sha error:NULL];
+};
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+
+	graphURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"GTCommitGraphSpec-%@", [[NSProcessInfo processInfo] globallyUniqueString]]]];
+	graph = [[GTCommitGraph alloc] initWithRepository:repository fileURL:graphURL error:NULL];
+	expect(graph).toNot.beNil();
+	expect(graph.count).to.equal(0);
+});
+
+afterEach(^{
+	[NSFileManager.defaultManager removeItemAtURL:graphURL error:NULL];
+	[NSFileManager.defaultManager removeItemAtURL:[GTCommitGraph defaultFileURLForRepository:repository] error:NULL];
+});
+
+it(@"should read commits it doesn't know about yet", ^{
+	expect([graph generationOfOID:OID(@"8496071c1b46c854b31185ea97743be6a8774479") error:NULL]).to.equal(1);
+	expect([graph generationOfOID:OID(@"5b5b025afb0b4c913b4c338a42934a3863bf3644") error:NULL]).to.equal(2);
+	expect(graph.count).to.equal(2);
+	expect(graph.hasUnsavedChanges).to.beTruthy();
+
+	expect([graph parentOIDsOfOID:OID(@"5b5b025afb0b4c913b4c338a42934a3863bf3644") error:NULL]).to.equal(@[ OID(@"8496071c1b46c854b31185ea97743be6a8774479") ]);
+	expect([graph parentOIDsOfOID:OID(@"a4a7dce85cf63874e984719f4fdd239f5145052f") error:NULL].count).to.equal(2);
+});
+
+it(@"should count commits like a walk does", ^{
+	GTOID *oid = OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a");
+	expect([graph countFromOID:oid error:NULL]).to.equal(4);
+
+	GTEnumerator *enumerator = [GTEnumerator enumeratorWithRepository:repository error:NULL];
+	expect([enumerator countFromOID:oid error:NULL]).to.equal(4);
+});
+
+it(@"should answer ancestry and merge base queries", ^{
+	GTOID *root = OID(@"8496071c1b46c854b31185ea97743be6a8774479");
+	GTOID *tip = OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a");
+	GTOID *middle = OID(@"5b5b025afb0b4c913b4c338a42934a3863bf3644");
+
+	BOOL success = NO;
+	expect([graph isOID:root ancestorOfOID:tip error:NULL success:&success]).to.beTruthy();
+	expect(success).to.beTruthy();
+	expect([graph isOID:tip ancestorOfOID:root error:NULL success:&success]).to.beFalsy();
+	expect(success).to.beTruthy();
+	expect([graph isOID:tip ancestorOfOID:tip error:NULL success:NULL]).to.beTruthy();
+
+	expect([graph mergeBaseOfOID:tip andOID:middle error:NULL]).to.equal(middle);
+	expect([graph mergeBaseOfOID:middle andOID:tip error:NULL]).to.equal(middle);
+});
+
+it(@"should fail for commits that don't exist", ^{
+	NSError *error = nil;
+	expect([graph countFromOID:OID(@"0000000000000000000000000000000000000001") error:&error]).to.equal(NSNotFound);
+	expect(error).toNot.beNil();
+});
+
+it(@"should round trip through its file", ^{
+	expect([graph addCommitsReachableFromReferencesWithError:NULL]).to.beTruthy();
+	NSUInteger count = graph.count;
+	expect(count).to.beGreaterThan(0);
+	expect([graph writeWithError:NULL]).to.beTruthy();
+	expect(graph.hasUnsavedChanges).to.beFalsy();
+
+	GTCommitGraph *loadedGraph = [[GTCommitGraph alloc] initWithRepository:repository fileURL:graphURL error:NULL];
+	expect(loadedGraph).toNot.beNil();
+	expect(loadedGraph.count).to.equal(count);
+	expect([loadedGraph containsOID:OID(@"a4a7dce85cf63874e984719f4fdd239f5145052f")]).to.beTruthy();
+	expect([loadedGraph countFromOID:OID(@"9fd738e8f7967c078dceed8190330fc8648ee56a") error:NULL]).to.equal(4);
+	expect([loadedGraph generationOfOID:OID(@"5b5b025afb0b4c913b4c338a42934a3863bf3644") error:NULL]).to.equal(2);
+	expect(loadedGraph.count).to.equal(count);
+});
+
+it(@"should refuse to load a corrupt file", ^{
+	expect([graph addCommitsReachableFromReferencesWithError:NULL]).to.beTruthy();
+	expect([graph writeWithError:NULL]).to.beTruthy();
+
+	NSMutableData *data = [NSMutableData dataWithContentsOfURL:graphURL];
+	((uint8_t *)data.mutableBytes)[20] ^= 0xff;
+	[data writeToURL:graphURL atomically:YES];
+
+	NSError *error = nil;
+	expect([[GTCommitGraph alloc] initWithRepository:repository fileURL:graphURL error:&error]).to.beNil();
+	expect(error.code).to.equal(GTCommitGraphErrorCodeCorruptFile);
+});
+
+it(@"should be used by the repository once written", ^{
+	expect(repository.commitGraph).to.beNil();
+	expect([repository writeCommitGraphWithError:NULL]).to.beTruthy();
+	expect(repository.commitGraph).toNot.beNil();
+	expect([repository numberOfCommitsInCurrentBranch:NULL]).to.equal(3);
+
+	GTRepository *otherRepository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_REPO_PATH(self.class)] error:NULL];
+	expect(otherRepository.commitGraph.count).to.equal(repository.commitGraph.count);
+});
+
+it(@"should only read history once without a graph file", ^{
+	GTCommitGraph *walkableGraph = [repository walkableCommitGraphWithError:NULL];
+	expect(walkableGraph).toNot.beNil();
+	expect([walkableGraph addCommitsReachableFromReferencesWithError:NULL]).to.beTruthy();
+
+	GTCommitGraph *secondGraph = [repository walkableCommitGraphWithError:NULL];
+	expect(secondGraph).to.beIdenticalTo(walkableGraph);
+	expect(secondGraph.count).to.beGreaterThan(0);
+
+	expect([repository writeCommitGraphWithError:NULL]).to.beTruthy();
+	expect([repository walkableCommitGraphWithError:NULL]).to.beIdenticalTo(repository.commitGraph);
+});
+
+SpecEnd
@@ -0,0 +1,116 @@
+//
+//  GTCommitMessageIndexSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTCommitMessageIndex.h"
+#import "GTOID.h"
+
+SpecBegin(GTCommitMessageIndex)
+
+__block GTRepository *repository = nil;
+__block GTOID *masterOID = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+
+	GTCommit *master = (GTCommit *)[repository lookupObjectByRefspec:@"refs/heads/master" error:NULL];
+	masterOID = master.OID;
+
+	NSError *error = nil;
+	expect([repository writeCommitMessageIndexWithError:&error]).to.beTruthy();
+	expect(error).to.beNil();
+});
+
+afterEach(^{
+	[NSFileManager.defaultManager removeItemAtURL:[GTCommitMessageIndex defaultFileURLForRepository:repository] error:NULL];
+});
+
+NSSet * (^shortSHAs)(NSArray *) = ^(NSArray *oids) {
+	NSMutableSet *SHAs = [NSMutableSet set];
+	for (GTOID *oid in oids) {
+		[SHAs addObject:[oid.sha substringToIndex:7]];
+	}
+
+	return SHAs;
+};
+
+it(@"should index every referenced commit", ^{
+	expect(repository.commitMessageIndex.count).to.equal(168);
+	expect(repository.commitMessageIndex.hasUnsavedChanges).to.beFalsy();
+	expect([repository.commitMessageIndex containsOID:masterOID]).to.beTruthy();
+});
+
+it(@"should find candidates for a substring", ^{
+	NSArray *oids = [repository.commitMessageIndex candidateOIDsForSubstring:@"Iñtërnâtiônàlizætiøn"];
+	expect(shortSHAs(oids)).to.equal([NSSet setWithObject:@"8f174ad"]);
+
+	oids = [repository.commitMessageIndex candidateOIDsForSubstring:@"MERGE BRANCH"];
+	expect(oids.count).to.beGreaterThanOrEqualTo(11);
+
+	expect([repository.commitMessageIndex candidateOIDsForSubstring:@"no such message"]).to.equal(@[]);
+	expect([repository.commitMessageIndex candidateOIDsForSubstring:@"ab"]).to.beNil();
+});
+
+it(@"should find commits matching a regular expression", ^{
+	NSRegularExpression *regularExpression = [NSRegularExpression regularExpressionWithPattern:@"Merge branch" options:0 error:NULL];
+	NSError *error = nil;
+	NSArray *oids = [repository.commitMessageIndex OIDsOfCommitsWithMessagesMatchingRegularExpression:regularExpression error:&error];
+	expect(oids.count).to.equal(11);
+	expect(error).to.beNil();
+
+	regularExpression = [NSRegularExpression regularExpressionWithPattern:@"stuff \\(more" options:0 error:NULL];
+	oids = [repository.commitMessageIndex OIDsOfCommitsWithMessagesMatchingRegularExpression:regularExpression error:NULL];
+	expect(shortSHAs(oids)).to.equal([NSSet setWithObject:@"32152e3"]);
+
+	regularExpression = [NSRegularExpression regularExpressionWithPattern:@"evil CONFLICTING" options:NSRegularExpressionCaseInsensitive error:NULL];
+	oids = [repository.commitMessageIndex OIDsOfCommitsWithMessagesMatchingRegularExpression:regularExpression error:NULL];
+	expect(oids.count).to.equal(20);
+});
+
+it(@"should check every commit when a pattern can't be narrowed down", ^{
+	NSRegularExpression *regularExpression = [NSRegularExpression regularExpressionWithPattern:@"^(asd|asdf)$" options:NSRegularExpressionAnchorsMatchLines error:NULL];
+	expect([repository.commitMessageIndex candidateOIDsForRegularExpression:regularExpression]).to.beNil();
+
+	NSArray *oids = [repository.commitMessageIndex OIDsOfCommitsWithMessagesMatchingRegularExpression:regularExpression error:NULL];
+	expect(shortSHAs(oids)).to.equal(([NSSet setWithObjects:@"f7ecd8f", @"54a556c", @"fd76a93", nil]));
+});
+
+it(@"should apply a quantifier after a quoted run to its last character", ^{
+	NSRegularExpression *regularExpression = [NSRegularExpression regularExpressionWithPattern:@"\\QMerge branchx\\E?" options:0 error:NULL];
+	NSArray *oids = [repository.commitMessageIndex OIDsOfCommitsWithMessagesMatchingRegularExpression:regularExpression error:NULL];
+	expect(oids.count).to.equal(11);
+});
+
+it(@"should check every commit when a pattern sets inline flags", ^{
+	NSRegularExpression *regularExpression = [NSRegularExpression regularExpressionWithPattern:@"(?i)merge BRANCH" options:0 error:NULL];
+	expect([repository.commitMessageIndex candidateOIDsForRegularExpression:regularExpression]).to.beNil();
+
+	NSRegularExpression *caseInsensitiveExpression = [NSRegularExpression regularExpressionWithPattern:@"merge BRANCH" options:NSRegularExpressionCaseInsensitive error:NULL];
+	NSArray *oids = [repository.commitMessageIndex OIDsOfCommitsWithMessagesMatchingRegularExpression:regularExpression error:NULL];
+	NSArray *expectedOIDs = [repository.commitMessageIndex OIDsOfCommitsWithMessagesMatchingRegularExpression:caseInsensitiveExpression error:NULL];
+	expect(oids).to.equal(expectedOIDs);
+	expect(oids.count).to.beGreaterThanOrEqualTo(11);
+});
+
+it(@"should be loaded from disk", ^{
+	NSError *error = nil;
+	GTCommitMessageIndex *index = [[GTCommitMessageIndex alloc] initWithRepository:repository fileURL:[GTCommitMessageIndex defaultFileURLForRepository:repository] error:&error];
+	expect(index).toNot.beNil();
+	expect(error).to.beNil();
+	expect(index.count).to.equal(168);
+
+	NSArray *oids = [index candidateOIDsForSubstring:@"Iñtërnâtiônàlizætiøn"];
+	expect(shortSHAs(oids)).to.equal([NSSet setWithObject:@"8f174ad"]);
+
+	// Nothing new to add.
+	expect([index addCommitsReachableFromOIDs:@[ masterOID ] error:NULL]).to.beTruthy();
+	expect(index.hasUnsavedChanges).to.beFalsy();
+});
+
+SpecEnd
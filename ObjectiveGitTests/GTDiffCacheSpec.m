@@ -0,0 +1,135 @@
+//
+//  GTDiffCacheSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTDiffCache.h"
+#import "GTCachedDiffDelta.h"
+#import "GTDiffOptions.h"
+
+SpecBegin(GTDiffCache)
+
+__block GTRepository *repository = nil;
+__block GTTree *oldTree = nil;
+__block GTTree *newTree = nil;
+__block NSURL *directoryURL = nil;
+__block GTDiffCache *cache = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+
+	oldTree = [(GTCommit *)[repository lookupObjectBySha:@"6b0c1c8b8816416089c534e474f4c692a76ac14f" objectType:GTObjectTypeCommit error:NULL] tree];
+	expect(oldTree).toNot.beNil();
+
+	newTree = [(GTCommit *)[repository lookupObjectBySha:@"a4bca6b67a5483169963572ee3da563da33712f7" objectType:GTObjectTypeCommit error:NULL] tree];
+	expect(newTree).toNot.beNil();
+
+	directoryURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"GTDiffCacheSpec-%@", [[NSProcessInfo processInfo] globallyUniqueString]]] isDirectory:YES];
+	cache = [[GTDiffCache alloc] initWithRepository:repository directoryURL:directoryURL maximumSize:GTDiffCacheDefaultMaximumSize];
+	expect(cache).toNot.beNil();
+});
+
+afterEach(^{
+	[cache removeAllDiffs];
+});
+
+it(@"should compute a diff once and read it back after", ^{
+	NSError *error = nil;
+	NSArray *deltas = [cache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:YES error:&error];
+	expect(deltas).toNot.beNil();
+	expect(error).to.beNil();
+	expect(cache.missCount).to.equal(1);
+	expect(cache.hitCount).to.equal(0);
+
+	GTDiffCache *otherCache = [[GTDiffCache alloc] initWithRepository:repository directoryURL:directoryURL maximumSize:GTDiffCacheDefaultMaximumSize];
+	NSArray *cachedDeltas = [otherCache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:YES error:NULL];
+	expect(otherCache.hitCount).to.equal(1);
+	expect(otherCache.missCount).to.equal(0);
+	expect(otherCache.hitRate).to.equal(1);
+
+	expect(cachedDeltas.count).to.equal(3);
+	for (NSUInteger i = 0; i < cachedDeltas.count; i++) {
+		GTCachedDiffDelta *delta = deltas[i];
+		GTCachedDiffDelta *cachedDelta = cachedDeltas[i];
+		expect(cachedDelta.type).to.equal(delta.type);
+		expect(cachedDelta.newFile.path).to.equal(delta.newFile.path);
+		expect(cachedDelta.newFile.OID).to.equal(delta.newFile.OID);
+		expect(cachedDelta.binary).to.equal(delta.binary);
+		expect(cachedDelta.addedLinesCount).to.equal(delta.addedLinesCount);
+		expect(cachedDelta.patchData).to.equal(delta.patchData);
+	}
+
+	GTCachedDiffDelta *readme = cachedDeltas[0];
+	expect(readme.type).to.equal(GTDiffFileDeltaAdded);
+	expect(readme.newFile.path).to.equal(@"README.md");
+	expect(readme.addedLinesCount).to.equal(70);
+	expect(readme.deletedLinesCount).to.equal(0);
+	expect(readme.binary).to.beFalsy();
+	expect([[NSString alloc] initWithData:readme.patchData encoding:NSUTF8StringEncoding]).to.startWith(@"diff --git a/README.md b/README.md");
+
+	expect([cachedDeltas[1] newFile].path).to.equal(@"hero_slide1.png");
+	expect([cachedDeltas[1] isBinary]).to.beTruthy();
+	expect([cachedDeltas[2] newFile].path).to.equal(@"jquery-1.8.1.min.js");
+	expect([cachedDeltas[2] isBinary]).to.beFalsy();
+});
+
+it(@"should compute a diff again when it needs patches the cached one lacks", ^{
+	NSArray *deltas = [cache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:NO error:NULL];
+	expect(deltas.count).to.equal(3);
+	expect([deltas[0] patchData]).to.beNil();
+
+	deltas = [cache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:NO error:NULL];
+	expect(cache.hitCount).to.equal(1);
+
+	deltas = [cache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:YES error:NULL];
+	expect(cache.missCount).to.equal(2);
+	expect([deltas[0] patchData]).toNot.beNil();
+});
+
+it(@"should keep diffs with different options apart", ^{
+	NSArray *deltas = [cache deltasForOldTree:oldTree newTree:newTree options:@{ GTDiffOptionsPathSpecArrayKey: @[ @"*.js" ] } findOptions:nil includePatches:NO error:NULL];
+	expect(deltas.count).to.equal(1);
+
+	deltas = [cache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:NO error:NULL];
+	expect(deltas.count).to.equal(3);
+	expect(cache.missCount).to.equal(2);
+});
+
+it(@"should share diffs between prepared options and their dictionaries", ^{
+	NSDictionary *jsOptions = @{ GTDiffOptionsPathSpecArrayKey: @[ @"*.js" ] };
+	NSArray *deltas = [cache deltasForOldTree:oldTree newTree:newTree options:jsOptions findOptions:nil includePatches:NO error:NULL];
+	expect(deltas.count).to.equal(1);
+
+	deltas = [cache deltasForOldTree:oldTree newTree:newTree diffOptions:[GTDiffOptions optionsWithDictionary:jsOptions] findOptions:nil includePatches:NO error:NULL];
+	expect(deltas.count).to.equal(1);
+	expect(cache.hitCount).to.equal(1);
+	expect(cache.missCount).to.equal(1);
+});
+
+it(@"should evict the least recently used diffs", ^{
+	GTDiffCache *tinyCache = [[GTDiffCache alloc] initWithRepository:repository directoryURL:directoryURL maximumSize:0];
+	expect([tinyCache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:NO error:NULL]).toNot.beNil();
+	expect([tinyCache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:NO error:NULL]).toNot.beNil();
+	expect(tinyCache.hitCount).to.equal(0);
+	expect(tinyCache.missCount).to.equal(2);
+});
+
+it(@"should only evict once the cache is too big", ^{
+	expect([cache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:NO error:NULL]).toNot.beNil();
+
+	NSDictionary *jsOptions = @{ GTDiffOptionsPathSpecArrayKey: @[ @"*.js" ] };
+	expect([cache deltasForOldTree:oldTree newTree:newTree options:jsOptions findOptions:nil includePatches:NO error:NULL]).toNot.beNil();
+
+	// Both fit, so both are read back.
+	expect([cache deltasForOldTree:oldTree newTree:newTree options:nil findOptions:nil includePatches:NO error:NULL]).toNot.beNil();
+	expect([cache deltasForOldTree:oldTree newTree:newTree options:jsOptions findOptions:nil includePatches:NO error:NULL]).toNot.beNil();
+	expect(cache.hitCount).to.equal(2);
+	expect(cache.missCount).to.equal(2);
+});
+
+SpecEnd
@@ -0,0 +1,127 @@
+//
+//  GTDiffLineChangeSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTDiffLineChange.h"
+
+SpecBegin(GTDiffLineChange)
+
+__block GTRepository *repository = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+});
+
+it(@"should find changed words", ^{
+	const char *oldLine = "let x = foo(1);\n";
+	const char *newLine = "let y = foo(2);\n";
+	NSIndexSet *oldRanges = nil;
+	NSIndexSet *newRanges = nil;
+	expect([GTDiffLineChange compareOldBytes:oldLine length:strlen(oldLine) newBytes:newLine length:strlen(newLine) granularity:GTDiffLineChangeGranularityWord oldChangedRanges:&oldRanges newChangedRanges:&newRanges]).to.beTruthy();
+
+	NSMutableIndexSet *expectedRanges = [NSMutableIndexSet indexSetWithIndex:4];
+	[expectedRanges addIndex:12];
+	expect(oldRanges).to.equal(expectedRanges);
+	expect(newRanges).to.equal(expectedRanges);
+});
+
+it(@"should find changed characters", ^{
+	const char *oldLine = "colour";
+	const char *newLine = "color";
+	NSIndexSet *oldRanges = nil;
+	NSIndexSet *newRanges = nil;
+	expect([GTDiffLineChange compareOldBytes:oldLine length:strlen(oldLine) newBytes:newLine length:strlen(newLine) granularity:GTDiffLineChangeGranularityCharacter oldChangedRanges:&oldRanges newChangedRanges:&newRanges]).to.beTruthy();
+	expect(oldRanges).to.equal([NSIndexSet indexSetWithIndex:4]);
+	expect(newRanges.count).to.equal(0);
+});
+
+it(@"should keep multibyte characters whole", ^{
+	const char *oldLine = "caf\xc3\xa9";
+	const char *newLine = "caf\xc3\xa8";
+	NSIndexSet *oldRanges = nil;
+	[GTDiffLineChange compareOldBytes:oldLine length:strlen(oldLine) newBytes:newLine length:strlen(newLine) granularity:GTDiffLineChangeGranularityCharacter oldChangedRanges:&oldRanges newChangedRanges:NULL];
+	expect(oldRanges).to.equal([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(3, 2)]);
+});
+
+it(@"should refine the changed lines of a hunk", ^{
+	GTCommit *oldCommit = (GTCommit *)[repository lookupObjectBySha:@"be0f001ff517a00b5b8e3c29ee6561e70f994e17" objectType:GTObjectTypeCommit error:NULL];
+	GTCommit *newCommit = (GTCommit *)[repository lookupObjectBySha:@"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe" objectType:GTObjectTypeCommit error:NULL];
+	GTDiff *diff = [GTDiff diffOldTree:oldCommit.tree withNewTree:newCommit.tree options:nil error:NULL];
+	expect(diff).toNot.beNil();
+
+	__block NSUInteger changeCount = 0;
+	[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+		[delta enumerateHunksWithBlock:^(GTDiffHunk *hunk, BOOL *stop) {
+			[hunk enumerateLineChangesWithGranularity:GTDiffLineChangeGranularityWord usingBlock:^(GTDiffLineChange *change, BOOL *stop) {
+				expect(change.oldLine.content).to.equal(@"//");
+				expect(change.newLine.content).to.equal(@"// duuuuuuuude");
+				expect(change.refined).to.beTruthy();
+				expect(change.oldChangedByteRanges.count).to.equal(0);
+				expect(change.newChangedByteRanges).to.equal([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 12)]);
+				changeCount++;
+			}];
+		}];
+	}];
+
+	expect(changeCount).to.equal(1);
+});
+
+it(@"should give up on pathological lines", ^{
+	NSUInteger length = 50000;
+	NSMutableData *oldData = [NSMutableData dataWithLength:length];
+	NSMutableData *newData = [NSMutableData dataWithLength:length];
+	char *oldBytes = oldData.mutableBytes;
+	char *newBytes = newData.mutableBytes;
+	srandom(1);
+	for (NSUInteger i = 0; i < length; i++) {
+		oldBytes[i] = 'a' + random() % 26;
+		newBytes[i] = 'a' + random() % 26;
+	}
+
+	NSIndexSet *oldRanges = nil;
+	NSDate *start = [NSDate date];
+	BOOL refined = [GTDiffLineChange compareOldBytes:oldBytes length:length newBytes:newBytes length:length granularity:GTDiffLineChangeGranularityCharacter oldChangedRanges:&oldRanges newChangedRanges:NULL];
+	NSTimeInterval time = -[start timeIntervalSinceNow];
+
+	expect(refined).to.beFalsy();
+	expect(oldRanges.count).to.beGreaterThan(length - 10);
+	expect(time).to.beLessThan(5);
+});
+
+it(@"should benchmark refining every change in history", ^{
+	__block NSUInteger changeCount = 0;
+	__block NSUInteger byteCount = 0;
+	NSDate *start = [NSDate date];
+	BOOL success = [repository enumerateCommitsBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTopologicalSort error:NULL usingBlock:^(GTCommit *commit, BOOL *stop) {
+		if (commit.parents.count == 0) return;
+
+		GTCommit *parent = commit.parents[0];
+
+		GTDiff *diff = [GTDiff diffOldTree:parent.tree withNewTree:commit.tree options:nil error:NULL];
+		[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+			if (delta.binary) return;
+
+			[delta enumerateHunksWithBlock:^(GTDiffHunk *hunk, BOOL *stop) {
+				for (NSNumber *granularity in @[ @(GTDiffLineChangeGranularityWord), @(GTDiffLineChangeGranularityCharacter) ]) {
+					[hunk enumerateLineChangesWithGranularity:granularity.intValue usingBlock:^(GTDiffLineChange *change, BOOL *stop) {
+						changeCount++;
+						byteCount += change.oldChangedByteRanges.count + change.newChangedByteRanges.count;
+					}];
+				}
+			}];
+		}];
+	}];
+	NSTimeInterval time = -[start timeIntervalSinceNow];
+
+	expect(success).to.beTruthy();
+	expect(changeCount).to.beGreaterThan(0);
+	NSLog(@"Refined %lu line changes (%lu changed bytes) in %.4fs", (unsigned long)changeCount, (unsigned long)byteCount, time);
+});
+
+SpecEnd
@@ -0,0 +1,150 @@
+//
+//  GTDiffOptionsSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTDiffOptions.h"
+
+SpecBegin(GTDiffOptions)
+
+describe(@"options structs", ^{
+	it(@"should use libgit2's defaults for an empty dictionary", ^{
+		GTDiffOptions *options = [GTDiffOptions optionsWithDictionary:nil];
+		expect(options.dictionary).to.equal(@{});
+		expect(options.git_diff_options == NULL).to.beTruthy();
+		expect(options.git_diff_find_options == NULL).to.beTruthy();
+	});
+
+	it(@"should keep sizes above 64KB", ^{
+		GTDiffOptions *options = [GTDiffOptions optionsWithDictionary:@{ GTDiffOptionsMaxSizeKey: @(1024 * 1024) }];
+		expect(options.git_diff_options != NULL).to.beTruthy();
+		expect(options.git_diff_options->max_size).to.equal(1024 * 1024);
+		expect(options.git_diff_find_options == NULL).to.beTruthy();
+	});
+
+	it(@"should own its strings", ^{
+		GTDiffOptions *options = nil;
+		@autoreleasepool {
+			NSMutableString *prefix = [NSMutableString stringWithString:@"old"];
+			options = [GTDiffOptions optionsWithDictionary:@{ GTDiffOptionsOldPrefixKey: prefix, GTDiffOptionsPathSpecArrayKey: @[ @"a", @"b/*.m" ] }];
+			[prefix setString:@"changed"];
+		}
+
+		expect(@(options.git_diff_options->old_prefix)).to.equal(@"old");
+		expect(options.git_diff_options->pathspec.count).to.equal(2);
+		expect(@(options.git_diff_options->pathspec.strings[1])).to.equal(@"b/*.m");
+	});
+
+	it(@"should set the break rewrite threshold on its own", ^{
+		GTDiffOptions *options = [GTDiffOptions optionsWithDictionary:@{ GTDiffFindOptionsBreakRewriteThresholdKey: @(80) }];
+		expect(options.git_diff_options == NULL).to.beTruthy();
+		expect(options.git_diff_find_options != NULL).to.beTruthy();
+		expect(options.git_diff_find_options->break_rewrite_threshold).to.equal(80);
+	});
+});
+
+describe(@"pathspec matching", ^{
+	BOOL (^matches)(NSArray *, NSString *) = ^(NSArray *pathspec, NSString *path) {
+		return [[GTDiffOptions optionsWithDictionary:@{ GTDiffOptionsPathSpecArrayKey: pathspec }] matchesPath:path];
+	};
+
+	it(@"should match everything without a pathspec", ^{
+		expect([[GTDiffOptions optionsWithDictionary:nil] matchesPath:@"any/path"]).to.beTruthy();
+	});
+
+	it(@"should match paths and the directories they name", ^{
+		expect(matches(@[ @"Classes" ], @"Classes")).to.beTruthy();
+		expect(matches(@[ @"Classes" ], @"Classes/GTDiff.m")).to.beTruthy();
+		expect(matches(@[ @"Classes/" ], @"Classes/GTDiff.m")).to.beTruthy();
+		expect(matches(@[ @"Classes" ], @"ClassesSpec.m")).to.beFalsy();
+		expect(matches(@[ @"Classes/GTDiff.m" ], @"Classes")).to.beFalsy();
+	});
+
+	it(@"should match globs across directories", ^{
+		expect(matches(@[ @"*.m" ], @"Classes/GTDiff.m")).to.beTruthy();
+		expect(matches(@[ @"Classes/GT?iff.[hm]" ], @"Classes/GTDiff.h")).to.beTruthy();
+		expect(matches(@[ @"Classes/GT?iff.[!hm]" ], @"Classes/GTDiff.h")).to.beFalsy();
+		expect(matches(@[ @"*.m" ], @"Classes/GTDiff.h")).to.beFalsy();
+	});
+
+	it(@"should match patterns with wildcards exactly too", ^{
+		expect(matches(@[ @"[abc].txt" ], @"[abc].txt")).to.beTruthy();
+		expect(matches(@[ @"[abc].txt" ], @"a.txt")).to.beTruthy();
+		expect(matches(@[ @"[abc].txt" ], @"d.txt")).to.beFalsy();
+		expect(matches(@[ @"[abc].txt" ], @"[abc].txt/file")).to.beFalsy();
+	});
+
+	it(@"should let the first matching pattern decide", ^{
+		NSArray *pathspec = @[ @"!Classes/GTDiff.m", @"Classes" ];
+		expect(matches(pathspec, @"Classes/GTDiff.m")).to.beFalsy();
+		expect(matches(pathspec, @"Classes/GTDiff.h")).to.beTruthy();
+
+		pathspec = @[ @"*.m", @"!Classes" ];
+		expect(matches(pathspec, @"Classes/GTDiff.m")).to.beTruthy();
+		expect(matches(pathspec, @"Classes/GTDiff.h")).to.beFalsy();
+	});
+
+	it(@"should ignore case when asked to", ^{
+		NSDictionary *dictionary = @{ GTDiffOptionsPathSpecArrayKey: @[ @"classes", @"*.H" ], GTDiffOptionsFlagsKey: @(GTDiffOptionsFlagsDeltasAreICase) };
+		GTDiffOptions *options = [GTDiffOptions optionsWithDictionary:dictionary];
+		expect([options matchesPath:@"Classes/GTDiff.m"]).to.beTruthy();
+		expect([options matchesPath:@"Tests/Spec.h"]).to.beTruthy();
+	});
+
+	it(@"should only compare whole paths when pathspec matching is disabled", ^{
+		NSDictionary *dictionary = @{ GTDiffOptionsPathSpecArrayKey: @[ @"*.m" ], GTDiffOptionsFlagsKey: @(GTDiffOptionsFlagsDisablePathspecMatch) };
+		GTDiffOptions *options = [GTDiffOptions optionsWithDictionary:dictionary];
+		expect([options matchesPath:@"*.m"]).to.beTruthy();
+		expect([options matchesPath:@"GTDiff.m"]).to.beFalsy();
+	});
+});
+
+describe(@"diffing", ^{
+	__block GTRepository *repository = nil;
+	__block GTCommit *firstCommit = nil;
+	__block GTCommit *secondCommit = nil;
+
+	beforeEach(^{
+		repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+		expect(repository).toNot.beNil();
+
+		firstCommit = (GTCommit *)[repository lookupObjectBySha:@"be0f001ff517a00b5b8e3c29ee6561e70f994e17" objectType:GTObjectTypeCommit error:NULL];
+		secondCommit = (GTCommit *)[repository lookupObjectBySha:@"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe" objectType:GTObjectTypeCommit error:NULL];
+		expect(firstCommit).toNot.beNil();
+		expect(secondCommit).toNot.beNil();
+	});
+
+	it(@"should limit diffs to the pathspec", ^{
+		GTDiffOptions *options = [GTDiffOptions optionsWithDictionary:@{ GTDiffOptionsPathSpecArrayKey: @[ @"ladflbahjgdf" ] }];
+		GTDiff *diff = [GTDiff diffOldTree:firstCommit.tree withNewTree:secondCommit.tree diffOptions:options error:NULL];
+		expect(diff.deltaCount).to.equal(0);
+
+		options = [GTDiffOptions optionsWithDictionary:@{ GTDiffOptionsPathSpecArrayKey: @[ @"TestAppWindowController.h" ] }];
+		diff = [GTDiff diffOldTree:firstCommit.tree withNewTree:secondCommit.tree diffOptions:options error:NULL];
+		expect(diff.deltaCount).to.equal(1);
+	});
+
+	it(@"should be reusable across diffs", ^{
+		GTDiffOptions *options = [GTDiffOptions optionsWithDictionary:@{ GTDiffOptionsContextLinesKey: @(5) }];
+		for (NSUInteger idx = 0; idx < 3; idx++) {
+			GTDiff *diff = [GTDiff diffOldTree:firstCommit.tree withNewTree:secondCommit.tree diffOptions:options error:NULL];
+			expect(diff.deltaCount).to.equal(1);
+
+			[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+				[delta enumerateHunksWithBlock:^(GTDiffHunk *hunk, BOOL *stop) {
+					__block NSUInteger contextCount = 0;
+					[hunk enumerateLinesInHunkUsingBlock:^(GTDiffLine *line, BOOL *stop) {
+						if (line.origin == GTDiffLineOriginContext) contextCount ++;
+					}];
+					expect(contextCount).to.equal(10);
+				}];
+			}];
+		}
+	});
+});
+
+SpecEnd
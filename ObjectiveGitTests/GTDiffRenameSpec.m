@@ -0,0 +1,152 @@
+//
+//  GTDiffRenameSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTBlobSketch.h"
+
+SpecBegin(GTDiffRename)
+
+__block GTRepository *repository = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+});
+
+GTDiff * (^diffBetweenCommits)(NSString *, NSString *) = ^(NSString *oldSHA, NSString *newSHA) {
+	GTCommit *oldCommit = (GTCommit *)[repository lookupObjectBySha:oldSHA objectType:GTObjectTypeCommit error:NULL];
+	GTCommit *newCommit = (GTCommit *)[repository lookupObjectBySha:newSHA objectType:GTObjectTypeCommit error:NULL];
+	return [GTDiff diffOldTree:oldCommit.tree withNewTree:newCommit.tree options:nil error:NULL];
+};
+
+// Writes a tree holding files with the given contents, keyed by path.
+GTTree * (^treeWithFiles)(NSDictionary *) = ^(NSDictionary *files) {
+	git_treebuilder *builder = NULL;
+	if (git_treebuilder_create(&builder, NULL) != GIT_OK) return (GTTree *)nil;
+
+	for (NSString *path in files) {
+		GTBlob *blob = [GTBlob blobWithString:files[path] inRepository:repository error:NULL];
+		if (blob == nil || git_treebuilder_insert(NULL, builder, path.UTF8String, blob.OID.git_oid, GIT_FILEMODE_BLOB) != GIT_OK) {
+			git_treebuilder_free(builder);
+			return (GTTree *)nil;
+		}
+	}
+
+	git_oid treeOid;
+	int gitError = git_treebuilder_write(&treeOid, repository.git_repository, builder);
+	git_treebuilder_free(builder);
+	if (gitError != GIT_OK) return (GTTree *)nil;
+
+	return (GTTree *)[repository lookupObjectByOid:&treeOid objectType:GTObjectTypeTree error:NULL];
+};
+
+NSString * (^numberedLines)(NSString *) = ^(NSString *changedLine) {
+	NSMutableString *contents = [NSMutableString string];
+	for (NSUInteger line = 0; line < 100; line++) {
+		[contents appendFormat:@"line %lu\n", (unsigned long)line];
+	}
+
+	if (changedLine != nil) [contents replaceOccurrencesOfString:[NSString stringWithFormat:@"%@\n", changedLine] withString:[NSString stringWithFormat:@"%@ changed\n", changedLine] options:0 range:NSMakeRange(0, contents.length)];
+	return contents;
+};
+
+it(@"should detect renames", ^{
+	GTDiff *diff = diffBetweenCommits(@"f7ecd8f4404d3a388efbff6711f1bdf28ffd16a0", @"6b0c1c8b8816416089c534e474f4c692a76ac14f");
+	expect(diff.deltaCount).to.equal(2);
+
+	NSError *error = nil;
+	NSArray *renames = [diff detectRenamesUsingSketchesWithOptions:nil error:&error];
+	expect(renames).toNot.beNil();
+	expect(error).to.beNil();
+	expect(renames.count).to.equal(1);
+
+	GTDiffRename *rename = renames[0];
+	expect((NSUInteger)rename.type).to.equal(GTDiffFileDeltaRenamed);
+	expect(rename.oldFile.path).to.equal(@"README");
+	expect(rename.newFile.path).to.equal(@"README_renamed");
+	expect(rename.similarity).to.equal(100);
+
+	// The diff itself is left alone.
+	expect(diff.deltaCount).to.equal(2);
+});
+
+it(@"should detect renames of files which were also changed", ^{
+	GTTree *oldTree = treeWithFiles(@{ @"lines.txt": numberedLines(nil), @"other.txt": @"something else entirely\n" });
+	GTTree *newTree = treeWithFiles(@{ @"renamed.txt": numberedLines(@"line 5"), @"other.txt": @"something else entirely\n" });
+	expect(oldTree).toNot.beNil();
+	expect(newTree).toNot.beNil();
+
+	GTDiff *diff = [GTDiff diffOldTree:oldTree withNewTree:newTree options:nil error:NULL];
+	expect(diff.deltaCount).to.equal(2);
+
+	NSArray *renames = [diff detectRenamesUsingSketchesWithOptions:nil error:NULL];
+	expect(renames.count).to.equal(1);
+
+	// The blobs differ, so the rename could only be found by its sketch.
+	GTDiffRename *rename = renames[0];
+	expect((NSUInteger)rename.type).to.equal(GTDiffFileDeltaRenamed);
+	expect(rename.oldFile.path).to.equal(@"lines.txt");
+	expect(rename.newFile.path).to.equal(@"renamed.txt");
+	expect(rename.oldFile.OID).toNot.equal(rename.newFile.OID);
+	expect(rename.similarity).to.beGreaterThanOrEqualTo(80);
+	expect(rename.similarity).to.beLessThan(100);
+});
+
+it(@"should only detect copies of modified files when asked to", ^{
+	GTTree *oldTree = treeWithFiles(@{ @"lines.txt": numberedLines(nil) });
+	GTTree *newTree = treeWithFiles(@{ @"lines.txt": numberedLines(@"line 5"), @"copy.txt": numberedLines(@"line 50") });
+	expect(oldTree).toNot.beNil();
+	expect(newTree).toNot.beNil();
+
+	GTDiff *diff = [GTDiff diffOldTree:oldTree withNewTree:newTree options:nil error:NULL];
+	expect(diff.deltaCount).to.equal(2);
+
+	expect([diff detectRenamesUsingSketchesWithOptions:nil error:NULL]).to.equal(@[]);
+
+	NSArray *copies = [diff detectRenamesUsingSketchesWithOptions:@{ GTDiffFindOptionsFlagsKey: @(GTDiffFindOptionsFlagsFindCopies) } error:NULL];
+	expect(copies.count).to.equal(1);
+
+	GTDiffRename *copy = copies[0];
+	expect((NSUInteger)copy.type).to.equal(GTDiffFileDeltaCopied);
+	expect(copy.oldFile.path).to.equal(@"lines.txt");
+	expect(copy.newFile.path).to.equal(@"copy.txt");
+	expect(copy.similarity).to.beGreaterThanOrEqualTo(80);
+	expect(copy.similarity).to.beLessThan(100);
+});
+
+it(@"should not find renames in a diff which only modifies files", ^{
+	GTDiff *diff = diffBetweenCommits(@"be0f001ff517a00b5b8e3c29ee6561e70f994e17", @"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe");
+
+	NSArray *renames = [diff detectRenamesUsingSketchesWithOptions:nil error:NULL];
+	expect(renames).to.equal(@[]);
+});
+
+it(@"should score similar contents like git", ^{
+	NSMutableString *oldContents = [NSMutableString string];
+	for (NSUInteger line = 0; line < 100; line++) {
+		[oldContents appendFormat:@"line %lu\n", (unsigned long)line];
+	}
+
+	NSMutableString *newContents = [oldContents mutableCopy];
+	[newContents replaceOccurrencesOfString:@"line 5" withString:@"LINE 5" options:0 range:NSMakeRange(0, newContents.length)];
+
+	NSData *oldData = [oldContents dataUsingEncoding:NSUTF8StringEncoding];
+	NSData *newData = [newContents dataUsingEncoding:NSUTF8StringEncoding];
+	GTBlobSketch *oldSketch = [[GTBlobSketch alloc] initWithBytes:oldData.bytes length:oldData.length];
+	GTBlobSketch *newSketch = [[GTBlobSketch alloc] initWithBytes:newData.bytes length:newData.length];
+
+	expect([oldSketch similarityToSketch:oldSketch]).to.equal(100);
+	expect([oldSketch similarityToSketch:newSketch]).to.beGreaterThanOrEqualTo(80);
+	expect([newSketch similarityToSketch:oldSketch]).to.beLessThan(100);
+
+	NSData *otherData = [@"something else entirely\n" dataUsingEncoding:NSUTF8StringEncoding];
+	GTBlobSketch *otherSketch = [[GTBlobSketch alloc] initWithBytes:otherData.bytes length:otherData.length];
+	expect([oldSketch similarityToSketch:otherSketch]).to.equal(0);
+});
+
+SpecEnd
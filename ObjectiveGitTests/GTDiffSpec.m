@@ -7,6 +7,7 @@
 //
 
 #import "Contants.h"
+#import "GTDiffDelta+Private.h"
 
 SpecBegin(GTDiff)
 
@@ -117,6 +118,32 @@ describe(@"GTDiff diffing", ^{
 		}];
 	});
 	
+	it(@"should enumerate raw lines without copying them", ^{
+		setupDiffFromCommitSHAsAndOptions(@"be0f001ff517a00b5b8e3c29ee6561e70f994e17", @"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe", nil);
+		
+		[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+			[delta enumerateHunksWithBlock:^(GTDiffHunk *hunk, BOOL *stop) {
+				expect([[NSString alloc] initWithBytes:hunk.headerBytes length:hunk.headerLength encoding:NSUTF8StringEncoding]).to.equal(@"@@ -4,7 +4,7 @@\n");
+				
+				__block NSUInteger lineIndex = 0;
+				[hunk enumerateRawLinesInHunkUsingBlock:^(const GTDiffRawLine *line, BOOL *stop) {
+					if (lineIndex == 4) {
+						expect((NSUInteger)line->origin).to.equal(GTDiffLineOriginAddition);
+						expect(line->oldLineNumber).to.equal(-1);
+						expect(line->newLineNumber).to.equal(7);
+						expect([[NSString alloc] initWithBytes:line->content length:line->contentLength encoding:NSUTF8StringEncoding]).to.equal(@"// duuuuuuuude\n");
+					}
+					
+					lineIndex ++;
+				}];
+				
+				expect(lineIndex).to.equal(8);
+			}];
+			
+			*stop = YES;
+		}];
+	});
+	
 	it(@"should recognised added files", ^{
 		setupDiffFromCommitSHAsAndOptions(@"4d5a6cc7a4d810be71bd47331c947b22580a5997", @"38f1e536cfc2ee41e07d55b38baec00149b2b0d1", nil);
 		expect(diff.deltaCount).to.equal(1);
@@ -213,6 +240,161 @@ describe(@"GTDiff diffing", ^{
 		}];
 	});
 	
+	it(@"should generate patches only when they're needed", ^{
+		setupDiffFromCommitSHAsAndOptions(@"6b0c1c8b8816416089c534e474f4c692a76ac14f", @"a4bca6b67a5483169963572ee3da563da33712f7", nil);
+		
+		NSMutableSet *paths = [NSMutableSet set];
+		__block GTDiffDelta *scriptDelta = nil;
+		[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+			expect(delta.patchLoaded).to.beFalsy();
+			[paths addObject:delta.newFile.path];
+			if ([delta.newFile.path isEqualToString:@"jquery-1.8.1.min.js"]) scriptDelta = delta;
+		}];
+		
+		expect(paths).to.equal(([NSSet setWithObjects:@"README.md", @"hero_slide1.png", @"jquery-1.8.1.min.js", nil]));
+		
+		// The delta keeps its diff alive, so the patch can still be generated.
+		diff = nil;
+		expect((NSUInteger)scriptDelta.type).to.equal(GTDiffFileDeltaAdded);
+		expect(scriptDelta.patchLoaded).to.beFalsy();
+		
+		expect(scriptDelta.hunkCount).to.equal(1);
+		expect(scriptDelta.patchLoaded).to.beTruthy();
+		expect(scriptDelta.addedLinesCount).to.equal(2);
+	});
+	
+	it(@"should generate patches concurrently, in order", ^{
+		setupDiffFromCommitSHAsAndOptions(@"6b0c1c8b8816416089c534e474f4c692a76ac14f", @"a4bca6b67a5483169963572ee3da563da33712f7", nil);
+		
+		NSMutableArray *expectedDescriptions = [NSMutableArray array];
+		[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+			[expectedDescriptions addObject:[NSString stringWithFormat:@"%@ %lu %lu %d", delta.newFile.path, (unsigned long)delta.hunkCount, (unsigned long)delta.addedLinesCount, delta.binary]];
+		}];
+		
+		// A fresh diff, so nothing has been learnt from the serial enumeration.
+		setupDiffFromCommitSHAsAndOptions(@"6b0c1c8b8816416089c534e474f4c692a76ac14f", @"a4bca6b67a5483169963572ee3da563da33712f7", nil);
+		
+		NSMutableArray *descriptions = [NSMutableArray array];
+		NSMutableDictionary *binaryness = [NSMutableDictionary dictionary];
+		NSError *error = nil;
+		BOOL success = [diff enumerateDeltasConcurrentlyWithError:&error usingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+			binaryness[delta.newFile.path] = @(delta.binary);
+			[descriptions addObject:[NSString stringWithFormat:@"%@ %lu %lu %d", delta.newFile.path, (unsigned long)delta.hunkCount, (unsigned long)delta.addedLinesCount, delta.binary]];
+		}];
+		
+		expect(success).to.beTruthy();
+		expect(error).to.beNil();
+		expect(descriptions).to.equal(expectedDescriptions);
+		expect(binaryness).to.equal((@{ @"README.md": @NO, @"hero_slide1.png": @YES, @"jquery-1.8.1.min.js": @NO }));
+	});
+	
+	it(@"should honour attributes when generating patches concurrently", ^{
+		NSURL *attributesURL = [repository.gitDirectoryURL URLByAppendingPathComponent:@"info/attributes"];
+		expect([@"*.js binary\n" writeToURL:attributesURL atomically:YES encoding:NSUTF8StringEncoding error:NULL]).to.beTruthy();
+		
+		setupDiffFromCommitSHAsAndOptions(@"6b0c1c8b8816416089c534e474f4c692a76ac14f", @"a4bca6b67a5483169963572ee3da563da33712f7", nil);
+		
+		NSMutableDictionary *binaryness = [NSMutableDictionary dictionary];
+		NSMutableDictionary *hunkCounts = [NSMutableDictionary dictionary];
+		NSError *error = nil;
+		BOOL success = [diff enumerateDeltasConcurrentlyWithError:&error usingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+			binaryness[delta.newFile.path] = @(delta.binary);
+			hunkCounts[delta.newFile.path] = @(delta.hunkCount);
+		}];
+		
+		[NSFileManager.defaultManager removeItemAtURL:attributesURL error:NULL];
+		
+		expect(success).to.beTruthy();
+		expect(error).to.beNil();
+		expect(binaryness).to.equal((@{ @"README.md": @NO, @"hero_slide1.png": @YES, @"jquery-1.8.1.min.js": @YES }));
+		expect(hunkCounts[@"jquery-1.8.1.min.js"]).to.equal(@0);
+	});
+	
+	it(@"should count lines without creating deltas", ^{
+		setupDiffFromCommitSHAsAndOptions(@"6b0c1c8b8816416089c534e474f4c692a76ac14f", @"a4bca6b67a5483169963572ee3da563da33712f7", nil);
+		
+		for (NSNumber *options in @[ @(GTDiffStatsOptionsNone), @(GTDiffStatsOptionsConcurrent) ]) {
+			GTDiffStats totals;
+			NSError *error = nil;
+			NSData *statsData = [diff deltaStatsWithOptions:options.unsignedIntValue totals:&totals error:&error];
+			expect(statsData).toNot.beNil();
+			expect(error).to.beNil();
+			expect(statsData.length).to.equal(3 * sizeof(GTDiffDeltaStats));
+			
+			const GTDiffDeltaStats *stats = statsData.bytes;
+			expect(stats[0].addedLinesCount).to.equal(70);
+			expect(stats[0].binary).to.beFalsy();
+			expect(stats[1].binary).to.beTruthy();
+			expect(stats[2].addedLinesCount).to.equal(2);
+			expect(stats[2].deletedLinesCount).to.equal(0);
+			
+			expect(totals.filesChanged).to.equal(3);
+			expect(totals.addedLinesCount).to.equal(72);
+			expect(totals.deletedLinesCount).to.equal(0);
+			expect(totals.binaryFilesChanged).to.equal(1);
+		}
+	});
+	
+	it(@"should stream the patch with the given prefixes", ^{
+		setupDiffFromCommitSHAsAndOptions(@"be0f001ff517a00b5b8e3c29ee6561e70f994e17", @"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe", (@{ GTDiffOptionsOldPrefixKey: @"old/", GTDiffOptionsNewPrefixKey: @"new/" }));
+		
+		NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+		[stream open];
+		NSError *error = nil;
+		expect([diff writePatchToOutputStream:stream error:&error]).to.beTruthy();
+		expect(error).to.beNil();
+		[stream close];
+		
+		NSData *streamedData = [stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+		NSString *patch = [[NSString alloc] initWithData:streamedData encoding:NSUTF8StringEncoding];
+		expect(patch).to.startWith(@"diff --git old/TestAppWindowController.h new/TestAppWindowController.h\n");
+		expect([patch rangeOfString:@"--- old/TestAppWindowController.h\n+++ new/TestAppWindowController.h\n@@ -4,7 +4,7 @@"].location).toNot.equal(NSNotFound);
+		expect([patch rangeOfString:@"\n-//\n+// duuuuuuuude\n \n"].location).toNot.equal(NSNotFound);
+		
+		NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSProcessInfo processInfo] globallyUniqueString]];
+		[NSFileManager.defaultManager createFileAtPath:path contents:nil attributes:nil];
+		NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:path];
+		expect([diff writePatchToFileDescriptor:fileHandle.fileDescriptor error:NULL]).to.beTruthy();
+		[fileHandle closeFile];
+		
+		expect([NSData dataWithContentsOfFile:path]).to.equal(streamedData);
+		[NSFileManager.defaultManager removeItemAtPath:path error:NULL];
+	});
+	
+	it(@"should stream the same bytes as libgit2 formats each patch", ^{
+		for (NSArray *SHAs in @[ @[ @"be0f001ff517a00b5b8e3c29ee6561e70f994e17", @"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe" ], @[ @"6b0c1c8b8816416089c534e474f4c692a76ac14f", @"a4bca6b67a5483169963572ee3da563da33712f7" ] ]) {
+			setupDiffFromCommitSHAsAndOptions(SHAs[0], SHAs[1], nil);
+			
+			NSMutableData *expectedData = [NSMutableData data];
+			[diff enumerateDeltasUsingBlock:^(GTDiffDelta *delta, BOOL *stop) {
+				char *string = NULL;
+				expect(git_diff_patch_to_str(&string, delta.git_diff_patch)).to.equal(GIT_OK);
+				[expectedData appendBytes:string length:strlen(string)];
+				free(string);
+			}];
+			
+			NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+			[stream open];
+			expect([diff writePatchToOutputStream:stream error:NULL]).to.beTruthy();
+			[stream close];
+			
+			expect([stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey]).to.equal(expectedData);
+		}
+	});
+	
+	it(@"should mark binary files in streamed patches", ^{
+		setupDiffFromCommitSHAsAndOptions(@"6b0c1c8b8816416089c534e474f4c692a76ac14f", @"a4bca6b67a5483169963572ee3da563da33712f7", nil);
+		
+		NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+		[stream open];
+		expect([diff writePatchToOutputStream:stream error:NULL]).to.beTruthy();
+		[stream close];
+		
+		NSString *patch = [[NSString alloc] initWithData:[stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey] encoding:NSUTF8StringEncoding];
+		expect([patch rangeOfString:@"Binary files"].location).toNot.equal(NSNotFound);
+		expect([patch rangeOfString:@"+++ b/jquery-1.8.1.min.js"].location).toNot.equal(NSNotFound);
+	});
+	
 	it(@"should correctly find untracked files if asked", ^{
 		diff = [GTDiff diffIndexToWorkingDirectoryInRepository:repository options:@{ GTDiffOptionsFlagsKey: @(GTDiffOptionsFlagsIncludeUntracked) } error:NULL];
 		__block BOOL foundImage = NO;
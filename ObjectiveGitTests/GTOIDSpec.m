@@ -0,0 +1,66 @@
+//
+//  GTOIDSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTOID.h"
+
+SpecBegin(GTOID)
+
+it(@"should round trip a SHA", ^{
+	NSString *sha = @"8496071c1b46c854b31185ea97743be6a8774479";
+	GTOID *oid = [GTOID oidWithSha:sha error:NULL];
+	expect(oid).toNot.beNil();
+	expect(oid.sha).to.equal(sha);
+
+	GTOID *copy = [GTOID oidWithGitOid:oid.git_oid];
+	expect(copy.sha).to.equal(sha);
+	expect(copy).to.equal(oid);
+	expect(copy.hash).to.equal(oid.hash);
+});
+
+it(@"should fail to parse an invalid SHA", ^{
+	NSError *error = nil;
+	GTOID *oid = [GTOID oidWithSha:@"not a sha" error:&error];
+	expect(oid).to.beNil();
+	expect(error).toNot.beNil();
+});
+
+it(@"should be usable as a dictionary key", ^{
+	GTOID *oid1 = [GTOID oidWithSha:@"8496071c1b46c854b31185ea97743be6a8774479" error:NULL];
+	GTOID *oid2 = [GTOID oidWithSha:@"8496071C1B46C854B31185EA97743BE6A8774479" error:NULL];
+	GTOID *oid3 = [GTOID oidWithSha:@"5b5b025afb0b4c913b4c338a42934a3863bf3644" error:NULL];
+
+	NSDictionary *dictionary = @{ oid1: @1, oid3: @3 };
+	expect(dictionary[oid2]).to.equal(@1);
+	expect(dictionary[oid3]).to.equal(@3);
+	expect([oid1 compare:oid3]).toNot.equal(NSOrderedSame);
+});
+
+it(@"should look up and enumerate objects by OID", ^{
+	GTRepository *repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+
+	GTOID *oid = [GTOID oidWithSha:@"9fd738e8f7967c078dceed8190330fc8648ee56a" error:NULL];
+	GTCommit *commit = (GTCommit *)[repository lookupObjectByOID:oid objectType:GTObjectTypeCommit error:NULL];
+	expect(commit).toNot.beNil();
+	expect(commit.OID).to.equal(oid);
+
+	GTEnumerator *enumerator = [GTEnumerator enumeratorWithRepository:repository error:NULL];
+	expect([enumerator pushOID:oid error:NULL]).to.beTruthy();
+
+	NSMutableArray *shas = [NSMutableArray array];
+	GTOID *nextOID = nil;
+	while ((nextOID = [enumerator nextOIDWithError:NULL]) != nil) {
+		[shas addObject:nextOID.sha];
+	}
+
+	expect(shas).to.equal((@[ @"9fd738e8f7967c078dceed8190330fc8648ee56a", @"4a202b346bb0fb0db7eff3cffeb3c70babbd2045", @"5b5b025afb0b4c913b4c338a42934a3863bf3644", @"8496071c1b46c854b31185ea97743be6a8774479" ]));
+	expect([enumerator countFromOID:oid error:NULL]).to.equal(4);
+});
+
+SpecEnd
@@ -0,0 +1,82 @@
+//
+//  GTObjectCacheSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTObjectCache.h"
+
+SpecBegin(GTObjectCache)
+
+__block GTRepository *repository = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+	expect(repository.objectCache).toNot.beNil();
+});
+
+it(@"should return the same object for repeated lookups", ^{
+	GTObject *first = [repository lookupObjectBySha:@"8496071c1b46c854b31185ea97743be6a8774479" error:NULL];
+	expect(first).toNot.beNil();
+
+	GTObject *second = [repository lookupObjectBySha:@"8496071c1b46c854b31185ea97743be6a8774479" error:NULL];
+	expect(second).to.beIdenticalTo(first);
+
+	expect(repository.objectCache.hitCount).to.equal(1);
+	expect(repository.objectCache.missCount).to.equal(1);
+});
+
+it(@"should share objects between lookups and commit accessors", ^{
+	GTCommit *commit = (GTCommit *)[repository lookupObjectBySha:@"5b5b025afb0b4c913b4c338a42934a3863bf3644" objectType:GTObjectTypeCommit error:NULL];
+	expect(commit).toNot.beNil();
+	expect(commit.parents.count).to.equal(1);
+
+	GTCommit *parent = (GTCommit *)[repository lookupObjectBySha:@"8496071c1b46c854b31185ea97743be6a8774479" objectType:GTObjectTypeCommit error:NULL];
+	expect(commit.parents[0]).to.beIdenticalTo(parent);
+	expect(commit.tree).to.beIdenticalTo(commit.tree);
+});
+
+it(@"shouldn't keep parents alive once they're evicted", ^{
+	GTCommit *commit = (GTCommit *)[repository lookupObjectBySha:@"5b5b025afb0b4c913b4c338a42934a3863bf3644" objectType:GTObjectTypeCommit error:NULL];
+	expect(commit).toNot.beNil();
+
+	__weak GTCommit *parent = nil;
+	@autoreleasepool {
+		parent = commit.parents[0];
+		expect(parent).toNot.beNil();
+
+		[repository.objectCache removeAllObjects];
+	}
+
+	expect(parent).to.beNil();
+	expect(commit.parents[0]).toNot.beNil();
+});
+
+it(@"should fail lookups with the wrong type even if the object is cached", ^{
+	GTObject *commit = [repository lookupObjectBySha:@"8496071c1b46c854b31185ea97743be6a8774479" error:NULL];
+	expect(commit).toNot.beNil();
+
+	NSError *error = nil;
+	GTObject *tree = [repository lookupObjectBySha:@"8496071c1b46c854b31185ea97743be6a8774479" objectType:GTObjectTypeTree error:&error];
+	expect(tree).to.beNil();
+	expect(error).toNot.beNil();
+});
+
+it(@"should evict the least recently used objects", ^{
+	repository.objectCache.countLimit = 2;
+	[repository.objectCache resetStatistics];
+
+	GTObject *first = [repository lookupObjectBySha:@"8496071c1b46c854b31185ea97743be6a8774479" error:NULL];
+	[repository lookupObjectBySha:@"5b5b025afb0b4c913b4c338a42934a3863bf3644" error:NULL];
+	[repository lookupObjectBySha:@"4a202b346bb0fb0db7eff3cffeb3c70babbd2045" error:NULL];
+
+	expect(repository.objectCache.count).to.equal(2);
+	expect(repository.objectCache.evictionCount).to.equal(1);
+	expect([repository.objectCache objectForOid:git_object_id(first.git_object)]).to.beNil();
+});
+
+SpecEnd
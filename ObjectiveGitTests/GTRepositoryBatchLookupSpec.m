@@ -0,0 +1,150 @@
+//
+//  GTRepositoryBatchLookupSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTOID.h"
+#import "GTRepository+Private.h"
+#import "GTRepositoryPool.h"
+
+SpecBegin(GTRepositoryBatchLookup)
+
+// Collects the OIDs of every commit, tree and blob reachable from HEAD.
+NSArray * (^allOIDsInRepository)(GTRepository *) = ^(GTRepository *repository) {
+	NSMutableOrderedSet *oids = [NSMutableOrderedSet orderedSet];
+	NSMutableArray *pendingTrees = [NSMutableArray array];
+
+	[repository enumerateCommitsBeginningAtSha:nil error:NULL usingBlock:^(GTCommit *commit, BOOL *stop) {
+		[oids addObject:commit.OID];
+		[pendingTrees addObject:commit.tree];
+	}];
+
+	while (pendingTrees.count > 0) {
+		GTTree *tree = pendingTrees.lastObject;
+		[pendingTrees removeLastObject];
+		if ([oids containsObject:tree.OID]) continue;
+
+		[oids addObject:tree.OID];
+		for (NSUInteger i = 0; i < tree.numberOfEntries; i++) {
+			GTTreeEntry *entry = [tree entryAtIndex:i];
+			if (git_tree_entry_type(entry.git_tree_entry) == GIT_OBJ_TREE) {
+				GTTree *subtree = (GTTree *)[entry toObjectAndReturnError:NULL];
+				if (subtree != nil) [pendingTrees addObject:subtree];
+			} else if (git_tree_entry_type(entry.git_tree_entry) == GIT_OBJ_BLOB) {
+				[oids addObject:entry.OID];
+			}
+		}
+	}
+
+	return oids.array;
+};
+
+__block GTRepository *repository = nil;
+
+beforeEach(^{
+	repository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	expect(repository).toNot.beNil();
+});
+
+it(@"should return objects in the order they were asked for", ^{
+	NSArray *oids = allOIDsInRepository(repository);
+	expect(oids.count).to.beGreaterThan(0);
+
+	GTRepository *otherRepository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	NSError *error = nil;
+	NSArray *objects = [otherRepository lookupObjectsWithOIDs:oids objectType:GTObjectTypeAny error:&error];
+	expect(objects).toNot.beNil();
+	expect(error).to.beNil();
+	expect(objects.count).to.equal(oids.count);
+
+	[objects enumerateObjectsUsingBlock:^(GTObject *object, NSUInteger index, BOOL *stop) {
+		expect(object.OID).to.equal(oids[index]);
+		expect(object.repository).to.beIdenticalTo(otherRepository);
+	}];
+});
+
+it(@"should use cached objects", ^{
+	GTRepository *otherRepository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	NSArray *oids = allOIDsInRepository(otherRepository);
+
+	GTObject *cachedObject = [otherRepository lookupObjectByOID:oids[0] error:NULL];
+	NSArray *objects = [otherRepository lookupObjectsWithOIDs:oids objectType:GTObjectTypeAny error:NULL];
+	expect(objects[0]).to.beIdenticalTo(cachedObject);
+});
+
+it(@"should give its handles back to the pool", ^{
+	NSArray *oids = allOIDsInRepository(repository);
+
+	// A fresh repository, so nothing is cached.
+	GTRepository *otherRepository = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:NULL];
+	NSArray *objects = [otherRepository lookupObjectsWithOIDs:oids objectType:GTObjectTypeAny error:NULL];
+	expect(objects.count).to.equal(oids.count);
+
+	GTRepositoryPool *pool = otherRepository.readerPool;
+	NSUInteger handleCount = pool.count;
+	expect(handleCount).to.beLessThanOrEqualTo(pool.maximumCount);
+
+	// Objects read on the handles stay usable while others use them.
+	NSArray *moreObjects = [otherRepository lookupObjectsWithOIDs:oids objectType:GTObjectTypeAny error:NULL];
+	expect(moreObjects.count).to.equal(oids.count);
+	expect(pool.count).to.equal(handleCount);
+
+	[objects enumerateObjectsUsingBlock:^(GTObject *object, NSUInteger index, BOOL *stop) {
+		expect(object.OID).to.equal(oids[index]);
+		expect(object).to.equal(moreObjects[index]);
+	}];
+});
+
+it(@"should fail if any object can't be found", ^{
+	GTOID *commitOID = [GTOID oidWithSha:@"be0f001ff517a00b5b8e3c29ee6561e70f994e17" error:NULL];
+	GTOID *missingOID = [GTOID oidWithSha:@"0000000000000000000000000000000000000001" error:NULL];
+
+	NSError *error = nil;
+	NSArray *objects = [repository lookupObjectsWithOIDs:@[ commitOID, missingOID ] objectType:GTObjectTypeAny error:&error];
+	expect(objects).to.beNil();
+	expect(error).toNot.beNil();
+});
+
+it(@"should stream objects and stop when asked", ^{
+	NSArray *oids = allOIDsInRepository(repository);
+	__block NSUInteger lastIndex = NSNotFound;
+	__block NSUInteger callCount = 0;
+
+	BOOL success = [repository enumerateObjectsWithOIDs:oids objectType:GTObjectTypeAny error:NULL usingBlock:^(GTObject *object, NSUInteger index, BOOL *stop) {
+		expect(index).to.equal(callCount);
+		callCount++;
+		lastIndex = index;
+		if (index == 2) *stop = YES;
+	}];
+
+	expect(success).to.beTruthy();
+	expect(lastIndex).to.equal(2);
+	expect(callCount).to.equal(3);
+});
+
+it(@"should benchmark serial and parallel lookups", ^{
+	NSArray *oids = allOIDsInRepository(repository);
+	NSURL *repositoryURL = [NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)];
+
+	// Fresh repositories, so neither run benefits from the other's caches.
+	GTRepository *serialRepository = [GTRepository repositoryWithURL:repositoryURL error:NULL];
+	NSDate *serialStart = [NSDate date];
+	for (GTOID *oid in oids) {
+		expect([serialRepository lookupObjectByOID:oid error:NULL]).toNot.beNil();
+	}
+	NSTimeInterval serialTime = -[serialStart timeIntervalSinceNow];
+
+	GTRepository *parallelRepository = [GTRepository repositoryWithURL:repositoryURL error:NULL];
+	NSDate *parallelStart = [NSDate date];
+	NSArray *objects = [parallelRepository lookupObjectsWithOIDs:oids objectType:GTObjectTypeAny error:NULL];
+	NSTimeInterval parallelTime = -[parallelStart timeIntervalSinceNow];
+
+	expect(objects.count).to.equal(oids.count);
+	NSLog(@"Looked up %lu objects: serial %.4fs (%.0f objects/s), parallel %.4fs (%.0f objects/s)", (unsigned long)oids.count, serialTime, oids.count / serialTime, parallelTime, oids.count / parallelTime);
+});
+
+SpecEnd
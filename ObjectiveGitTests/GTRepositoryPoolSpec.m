@@ -0,0 +1,76 @@
+//
+//  GTRepositoryPoolSpec.m
+//  ObjectiveGitFramework
+//
+//  Created by ObjectiveGit on 16/10/2026.
+//  Copyright (c) 2026 GitHub, Inc. All rights reserved.
+//
+
+#import "Contants.h"
+#import "GTRepositoryPool.h"
+
+SpecBegin(GTRepositoryPool)
+
+__block NSURL *repositoryURL = nil;
+
+beforeEach(^{
+	repositoryURL = [NSURL fileURLWithPath:TEST_REPO_PATH(self.class)];
+});
+
+it(@"should open handles lazily and reuse them", ^{
+	GTRepositoryPool *pool = [[GTRepositoryPool alloc] initWithURL:repositoryURL maximumCount:2];
+	expect(pool.count).to.equal(0);
+
+	GTRepository *first = [pool checkOutRepositoryWithError:NULL];
+	expect(first).toNot.beNil();
+	GTRepository *second = [pool checkOutRepositoryWithError:NULL];
+	expect(second).toNot.beNil();
+	expect(second).notTo.beIdenticalTo(first);
+	expect(pool.count).to.equal(2);
+
+	[pool checkInRepository:first];
+	expect([pool checkOutRepositoryWithError:NULL]).to.beIdenticalTo(first);
+	expect(pool.count).to.equal(2);
+
+	[pool checkInRepository:first];
+	[pool checkInRepository:second];
+});
+
+it(@"should block check outs while every handle is in use", ^{
+	GTRepositoryPool *pool = [[GTRepositoryPool alloc] initWithURL:repositoryURL maximumCount:1];
+	GTRepository *repository = [pool checkOutRepositoryWithError:NULL];
+	expect(repository).toNot.beNil();
+
+	dispatch_semaphore_t checkedOut = dispatch_semaphore_create(0);
+	dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		[pool performWithRepository:^(GTRepository *otherRepository) {
+			expect(otherRepository).to.beIdenticalTo(repository);
+		} error:NULL];
+		dispatch_semaphore_signal(checkedOut);
+	});
+
+	expect(dispatch_semaphore_wait(checkedOut, dispatch_time(DISPATCH_TIME_NOW, 100 * NSEC_PER_MSEC))).notTo.equal(0);
+
+	[pool checkInRepository:repository];
+	expect(dispatch_semaphore_wait(checkedOut, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC))).to.equal(0);
+	expect(pool.count).to.equal(1);
+});
+
+it(@"should let convenience methods be called concurrently", ^{
+	GTRepository *repository = [GTRepository repositoryWithURL:repositoryURL error:NULL];
+	expect(repository).toNot.beNil();
+
+	NSUInteger iterations = 32;
+	NSUInteger *counts = calloc(iterations, sizeof(*counts));
+	dispatch_apply(iterations, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+		counts[i] = [repository numberOfCommitsInCurrentBranch:NULL];
+	});
+
+	for (NSUInteger i = 0; i < iterations; i++) {
+		expect(counts[i]).to.equal(3);
+	}
+
+	free(counts);
+});
+
+SpecEnd
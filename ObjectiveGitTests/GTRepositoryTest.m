@@ -74,6 +74,32 @@
 	STAssertNotNil(newRepo.repository, nil);
 }
 
+- (void)testFailsToWalkFromAnUnbornHead {
+	
+	NSError *error = nil;
+	NSURL *newRepoURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"unit_test_unborn"]];
+
+	[self removeDirectoryAtURL:newRepoURL];
+	
+	STAssertTrue([GTRepository initializeEmptyRepositoryAtURL:newRepoURL error:&error], nil);
+	GTRepository *newRepo = [GTRepository repositoryWithURL:newRepoURL error:&error];
+	STAssertNotNil(newRepo, [error localizedDescription]);
+	
+	error = nil;
+	STAssertEquals([newRepo numberOfCommitsInCurrentBranch:&error], (NSUInteger)NSNotFound, nil);
+	STAssertNotNil(error, nil);
+	
+	error = nil;
+	STAssertFalse([newRepo enumerateCommitsBeginningAtSha:nil error:&error usingBlock:^(GTCommit *commit, BOOL *stop) {}], nil);
+	STAssertNotNil(error, nil);
+	
+	error = nil;
+	STAssertFalse([newRepo enumerateCommitsBeginningAtSha:nil touchingPaths:@[ @"README" ] error:&error usingBlock:^(GTCommit *commit, BOOL *stop) {}], nil);
+	STAssertNotNil(error, nil);
+	
+	[self removeDirectoryAtURL:newRepoURL];
+}
+
 - (void)testFailsToOpenNonExistentRepo {
 	
 	NSError *error = nil;
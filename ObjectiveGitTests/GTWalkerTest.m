@@ -28,6 +28,11 @@
 //
 
 #import "Contants.h"
+#import "GTOID.h"
+#import "GTEnumeratorCursor.h"
+#import "GTCachedDiffDelta.h"
+#import "GTDiffFile.h"
+#import "GTDiffOptions.h"
 
 
 @interface GTWalkerTest : SenTestCase {}
@@ -86,6 +91,185 @@
 	STAssertEquals(3, count, nil);
 }
 
+- (void)testCanWalkCommitRecords {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_REPO_PATH(self.class)] error:&error];
+	GTEnumerator *enumerator = [GTEnumerator enumeratorWithRepository:repo error:&error];
+	BOOL success = [enumerator push:@"9fd738e8f7967c078dceed8190330fc8648ee56a" error:&error];
+	STAssertTrue(success, [error localizedDescription]);
+	
+	__block NSUInteger batchCount = 0;
+	NSMutableArray *shas = [NSMutableArray array];
+	success = [enumerator enumerateCommitRecordsWithBatchSize:3 error:&error usingBlock:^(const GTCommitRecord *records, NSUInteger count, const char *buffer, BOOL *stop) {
+		batchCount++;
+		for (NSUInteger i = 0; i < count; i++) {
+			[shas addObject:[GTOID oidWithGitOid:&records[i].oid].sha];
+		}
+		
+		if (batchCount == 1) {
+			const GTCommitRecord *record = &records[0];
+			STAssertEqualObjects(GTCommitRecordString(buffer, record->authorName), @"Scott Chacon", nil);
+			STAssertEqualObjects(GTCommitRecordString(buffer, record->authorEmail), @"schacon@gmail.com", nil);
+			STAssertEqualObjects(GTCommitRecordString(buffer, record->message), @"a fourth commit\n", nil);
+			STAssertEquals(record->commitTime, (git_time_t)1274721559, nil);
+			STAssertEquals(record->commitOffset, -7 * 60, nil);
+			STAssertEquals(record->parentCount, (NSUInteger)1, nil);
+			STAssertEqualObjects([GTOID oidWithGitOid:&record->parents[0]].sha, @"4a202b346bb0fb0db7eff3cffeb3c70babbd2045", nil);
+			STAssertEqualObjects([GTOID oidWithGitOid:&record->tree].sha, @"814889a078c031f61ed08ab5fa863aea9314344d", nil);
+		}
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	
+	STAssertEquals(batchCount, (NSUInteger)2, nil);
+	STAssertEquals(shas.count, (NSUInteger)4, nil);
+	STAssertEqualObjects([[shas objectAtIndex:0] substringToIndex:5], @"9fd73", nil);
+	STAssertEqualObjects([[shas objectAtIndex:3] substringToIndex:5], @"84960", nil);
+}
+
+- (void)testCanWalkConcurrentlyInOrder {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	
+	NSMutableArray *expectedShas = [NSMutableArray array];
+	BOOL success = [repo enumerateCommitsBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTopologicalSort error:&error usingBlock:^(GTCommit *commit, BOOL *stop) {
+		[expectedShas addObject:commit.sha];
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	
+	NSMutableArray *shas = [NSMutableArray array];
+	success = [repo enumerateCommitsConcurrentlyBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTopologicalSort concurrencyOptions:GTEnumeratorConcurrencyOptionsOrdered error:&error usingBlock:^(GTCommit *commit, NSUInteger index, BOOL *stop) {
+		STAssertEquals(index, shas.count, nil);
+		[shas addObject:commit.sha];
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEqualObjects(shas, expectedShas, nil);
+}
+
+- (void)testCanWalkConcurrentlyOutOfOrder {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	
+	NSMutableSet *expectedShas = [NSMutableSet set];
+	BOOL success = [repo enumerateCommitsBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort error:&error usingBlock:^(GTCommit *commit, BOOL *stop) {
+		[expectedShas addObject:commit.sha];
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	
+	NSMutableSet *shas = [NSMutableSet set];
+	success = [repo enumerateCommitsConcurrentlyBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort concurrencyOptions:GTEnumeratorConcurrencyOptionsUnbounded error:&error usingBlock:^(GTCommit *commit, NSUInteger index, BOOL *stop) {
+		@synchronized (shas) {
+			[shas addObject:commit.sha];
+		}
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEqualObjects(shas, expectedShas, nil);
+}
+
+- (void)testCanLookUpObjectsConcurrentlyWhileWalkingConcurrently {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	
+	// Every handle in the reader pool is held by the walk while the block runs.
+	__block NSUInteger count = 0;
+	BOOL success = [repo enumerateCommitsConcurrentlyBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort concurrencyOptions:GTEnumeratorConcurrencyOptionsOrdered error:&error usingBlock:^(GTCommit *commit, NSUInteger index, BOOL *stop) {
+		GTOID *treeOID = [GTOID oidWithGitOid:git_commit_tree_id(commit.git_commit)];
+		NSError *lookupError = nil;
+		NSArray *trees = [repo lookupObjectsWithOIDs:@[ treeOID ] objectType:GTObjectTypeTree error:&lookupError];
+		STAssertEquals(trees.count, (NSUInteger)1, [lookupError localizedDescription]);
+		count++;
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertTrue(count > 0, nil);
+}
+
+- (void)testCanStopWalkingConcurrently {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	
+	__block NSUInteger count = 0;
+	BOOL success = [repo enumerateCommitsConcurrentlyBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort concurrencyOptions:GTEnumeratorConcurrencyOptionsOrdered error:&error usingBlock:^(GTCommit *commit, NSUInteger index, BOOL *stop) {
+		count++;
+		*stop = (count == 5);
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEquals(count, (NSUInteger)5, nil);
+}
+
+- (void)testCanLimitWalkByDate {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	GTEnumerator *enumerator = [repo enumeratorBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort error:&error];
+	STAssertNotNil(enumerator, [error localizedDescription]);
+	
+	enumerator.sinceDate = [NSDate dateWithTimeIntervalSince1970:1330370000];
+	enumerator.clockSkewTolerance = 0;
+	STAssertEquals([enumerator allObjectsWithError:&error].count, (NSUInteger)8, nil);
+	
+	__block NSUInteger count = 0;
+	BOOL success = [repo enumerateCommitsBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort sinceDate:[NSDate dateWithTimeIntervalSince1970:1326212105] untilDate:[NSDate dateWithTimeIntervalSince1970:1330370125] error:&error usingBlock:^(GTCommit *commit, BOOL *stop) {
+		count++;
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEquals(count, (NSUInteger)14, nil);
+	
+	NSArray *commits = [repo selectCommitsBeginningAtSha:nil sinceDate:nil untilDate:nil maximumCount:3 error:&error block:^(GTCommit *commit, BOOL *stop) {
+		return YES;
+	}];
+	STAssertEquals(commits.count, (NSUInteger)3, nil);
+}
+
+- (void)testCanSkipAndLimitWalk {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	GTEnumerator *enumerator = [repo enumeratorBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort error:&error];
+	STAssertNotNil(enumerator, [error localizedDescription]);
+	
+	enumerator.skipCount = 2;
+	enumerator.maximumCount = 3;
+	NSArray *shortShas = [[enumerator allObjectsWithError:&error] valueForKey:@"shortSha"];
+	STAssertEqualObjects(shortShas, (@[ @"f7ecd8f", @"82dc47f", @"93f5b55" ]), nil);
+}
+
+- (void)testCanResumeWalkFromCursor {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	GTEnumerator *enumerator = [repo enumeratorBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort error:&error];
+	NSArray *allCommits = [enumerator allObjectsWithError:&error];
+	STAssertEquals(allCommits.count, (NSUInteger)164, nil);
+	STAssertNil(enumerator.cursor, nil);
+	
+	NSMutableArray *pagedCommits = [NSMutableArray array];
+	GTEnumeratorCursor *cursor = nil;
+	do {
+		enumerator = [repo enumeratorBeginningAtSha:nil sortOptions:GTEnumeratorOptionsTimeSort error:&error];
+		enumerator.maximumCount = 50;
+		if (cursor != nil) {
+			// Cursors survive being handed out as strings.
+			cursor = [GTEnumeratorCursor cursorWithString:cursor.stringValue error:&error];
+			STAssertNotNil(cursor, [error localizedDescription]);
+			STAssertTrue([enumerator resumeFromCursor:cursor error:&error], [error localizedDescription]);
+		}
+		
+		NSArray *page = [enumerator allObjectsWithError:&error];
+		STAssertTrue(page.count <= 50, nil);
+		[pagedCommits addObjectsFromArray:page];
+		cursor = enumerator.cursor;
+	} while (cursor != nil);
+	
+	// Commits made in the same second may come out in a different order.
+	STAssertEquals(pagedCommits.count, allCommits.count, nil);
+	STAssertEqualObjects([NSSet setWithArray:pagedCommits], [NSSet setWithArray:allCommits], nil);
+	STAssertNil([GTEnumeratorCursor cursorWithString:@"not a cursor" error:NULL], nil);
+}
+
 - (void)testCanWalkPartOfARevList {
 	
 	NSError *error = nil;
@@ -204,4 +388,79 @@
 //	}		
 //}
 
+- (void)testCanDiffCommitsAgainstTheirFirstParents {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	GTEnumerator *enumerator = [repo enumeratorBeginningAtSha:@"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe" sortOptions:GTEnumeratorOptionsTopologicalSort error:&error];
+	STAssertNotNil(enumerator, [error localizedDescription]);
+	
+	NSMutableArray *shas = [NSMutableArray array];
+	NSMutableArray *deltaLists = [NSMutableArray array];
+	BOOL success = [enumerator enumerateFirstParentDiffsWithOptions:GTEnumeratorDiffOptionsOrdered | GTEnumeratorDiffOptionsIncludePatches diffOptions:nil error:&error usingBlock:^(GTOID *commitOID, NSArray *deltas, NSUInteger index, BOOL *stop) {
+		STAssertEquals(index, shas.count, nil);
+		[shas addObject:commitOID.sha];
+		[deltaLists addObject:deltas];
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEquals(shas.count, (NSUInteger)9, nil);
+	STAssertEqualObjects(shas[0], @"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe", nil);
+	
+	NSArray *deltas = deltaLists[0];
+	STAssertEquals(deltas.count, (NSUInteger)1, nil);
+	GTCachedDiffDelta *delta = deltas[0];
+	STAssertEquals((NSUInteger)delta.type, (NSUInteger)GTDiffFileDeltaModified, nil);
+	STAssertEqualObjects(delta.newFile.path, @"TestAppWindowController.h", nil);
+	STAssertEquals(delta.addedLinesCount, (NSUInteger)1, nil);
+	STAssertEquals(delta.deletedLinesCount, (NSUInteger)1, nil);
+	STAssertNotNil(delta.patchData, nil);
+	
+	// The root commit is diffed against nothing.
+	for (GTCachedDiffDelta *rootDelta in deltaLists.lastObject) {
+		STAssertEquals((NSUInteger)rootDelta.type, (NSUInteger)GTDiffFileDeltaAdded, nil);
+	}
+	STAssertEquals([deltaLists.lastObject count], (NSUInteger)9, nil);
+}
+
+- (void)testCanStopDiffingCommits {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	GTEnumerator *enumerator = [repo enumeratorBeginningAtSha:@"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe" sortOptions:GTEnumeratorOptionsTopologicalSort error:&error];
+	STAssertNotNil(enumerator, [error localizedDescription]);
+	
+	// The commits are diffed in runs, but handed out one at a time.
+	__block NSUInteger count = 0;
+	BOOL success = [enumerator enumerateFirstParentDiffsWithOptions:GTEnumeratorDiffOptionsOrdered diffOptions:nil error:&error usingBlock:^(GTOID *commitOID, NSArray *deltas, NSUInteger index, BOOL *stop) {
+		STAssertEquals(index, count, nil);
+		count++;
+		*stop = (count == 4);
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertEquals(count, (NSUInteger)4, nil);
+}
+
+- (void)testCanDiffCommitsWithoutPatches {
+	
+	NSError *error = nil;
+	GTRepository *repo = [GTRepository repositoryWithURL:[NSURL fileURLWithPath:TEST_APP_REPO_PATH(self.class)] error:&error];
+	GTEnumerator *enumerator = [repo enumeratorBeginningAtSha:@"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe" sortOptions:GTEnumeratorOptionsTopologicalSort error:&error];
+	STAssertNotNil(enumerator, [error localizedDescription]);
+	
+	GTDiffOptions *diffOptions = [GTDiffOptions optionsWithDictionary:@{ GTDiffOptionsPathSpecArrayKey: @[ @"TestAppWindowController.h" ] }];
+	NSMutableSet *changedShas = [NSMutableSet set];
+	BOOL success = [enumerator enumerateFirstParentDiffsWithOptions:GTEnumeratorDiffOptionsNone diffOptions:diffOptions error:&error usingBlock:^(GTOID *commitOID, NSArray *deltas, NSUInteger index, BOOL *stop) {
+		for (GTCachedDiffDelta *delta in deltas) {
+			STAssertNil(delta.patchData, nil);
+			STAssertEqualObjects(delta.newFile.path, @"TestAppWindowController.h", nil);
+		}
+		
+		@synchronized (changedShas) {
+			if (deltas.count > 0) [changedShas addObject:commitOID.sha];
+		}
+	}];
+	STAssertTrue(success, [error localizedDescription]);
+	STAssertTrue([changedShas containsObject:@"fe89ea0a8e70961b8a6344d9660c326d3f2eb0fe"], nil);
+}
+
 @end